@@ -0,0 +1,47 @@
+/**
+ * @brief Runtime detection of the SIMD instruction sets of the CPU, used to
+ * dispatch the batched kernels of this package without -march flags.
+ */
+#ifndef ALT_MATH_UTILITIES_CPU_FEATURES_H
+#define ALT_MATH_UTILITIES_CPU_FEATURES_H
+
+namespace alt_math_utilities
+{
+
+/**
+ * Instruction set level of the batched kernels, ordered by capability.
+ */
+enum SimdLevel
+{
+   SIMD_SCALAR = 0,
+   SIMD_SSE2,
+   SIMD_AVX2,
+   SIMD_AVX512
+};
+
+/**
+ * Most capable level supported by CPU and OS (queried once via CPUID).
+ * Always SIMD_SCALAR on non-x86 targets.
+ */
+SimdLevel supportedSimdLevel();
+
+/**
+ * Level currently used by the batched kernels (defaults to the supported one).
+ */
+SimdLevel activeSimdLevel();
+
+/**
+ * Override the level used by the batched kernels, e.g. for benchmarking or
+ * to force the scalar path. Requests above the supported level are clamped.
+ * @return level in effect
+ */
+SimdLevel setSimdLevel(SimdLevel level);
+
+/**
+ * Short name of a level ("scalar", "sse2", "avx2", "avx512").
+ */
+const char* simdLevelName(SimdLevel level);
+
+}
+
+#endif // ALT_MATH_UTILITIES_CPU_FEATURES_H
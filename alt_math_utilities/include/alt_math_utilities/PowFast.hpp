@@ -55,6 +55,30 @@ public:
 
            unsigned int precision()                                       const;
 
+/// batched queries ------------------------------------------------------------
+          /**
+           * Array versions of the queries above: out[i] = op( in[i] ) for
+           * i < n (in and out may be the same array). Vectorised at the
+           * activeSimdLevel() (see CpuFeatures.hpp); results are identical to
+           * the scalar queries.
+           */
+           void  two( const float* in,
+                      float*       out,
+                      unsigned int n )                                    const;
+
+           void  e  ( const float* in,
+                      float*       out,
+                      unsigned int n )                                    const;
+
+           void  ten( const float* in,
+                      float*       out,
+                      unsigned int n )                                    const;
+
+           void  r  ( float        logr,
+                      const float* in,
+                      float*       out,
+                      unsigned int n )                                    const;
+
 /// fields ---------------------------------------------------------------------
 private:
    unsigned int  precision_m;
@@ -0,0 +1,67 @@
+#include "alt_math_utilities/CpuFeatures.hpp"
+
+namespace alt_math_utilities
+{
+
+namespace
+{
+
+// Negative until first queried; detection is idempotent, so concurrent first
+// calls only race to store the same value.
+int active_level = -1;
+
+}
+
+SimdLevel supportedSimdLevel()
+{
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+   // __builtin_cpu_supports also accounts for OS support of the wide registers
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx512f"))
+      return SIMD_AVX512;
+   if (__builtin_cpu_supports("avx2"))
+      return SIMD_AVX2;
+   if (__builtin_cpu_supports("sse2"))
+      return SIMD_SSE2;
+#endif
+   return SIMD_SCALAR;
+}
+
+SimdLevel activeSimdLevel()
+{
+   int level = __atomic_load_n(&active_level, __ATOMIC_RELAXED);
+   if (level < 0)
+   {
+      level = supportedSimdLevel();
+      __atomic_store_n(&active_level, level, __ATOMIC_RELAXED);
+   }
+   return static_cast<SimdLevel>(level);
+}
+
+SimdLevel setSimdLevel(SimdLevel level)
+{
+   const SimdLevel supported = supportedSimdLevel();
+   if (level > supported)
+      level = supported;
+   if (level < SIMD_SCALAR)
+      level = SIMD_SCALAR;
+   __atomic_store_n(&active_level, static_cast<int>(level), __ATOMIC_RELAXED);
+   return level;
+}
+
+const char* simdLevelName(SimdLevel level)
+{
+   switch (level)
+   {
+   case SIMD_SSE2:
+      return "sse2";
+   case SIMD_AVX2:
+      return "avx2";
+   case SIMD_AVX512:
+      return "avx512";
+   default:
+      return "scalar";
+   }
+}
+
+}
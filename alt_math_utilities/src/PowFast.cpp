@@ -11,6 +11,12 @@
 #include <math.h>
 
 #include "alt_math_utilities/PowFast.hpp"
+#include "alt_math_utilities/CpuFeatures.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define POWFAST_SIMD
+#include <immintrin.h>
+#endif
 
 
 
@@ -103,6 +109,180 @@ float powFastLookup
 
 
 
+/// batched lookup -------------------------------------------------------------
+
+/**
+ * The vector kernels perform exactly the scalar operations (multiply, add,
+ * truncate, mask, lookup), so every level yields the same bits. Remainders
+ * shorter than one vector go through the scalar lookup.
+ */
+
+void powFastLookupScalar
+(
+   const float* const  pIn,
+   float* const        pOut,
+   const unsigned int  n,
+   const float         ilog2,
+   unsigned int* const pTable,
+   const unsigned int  precision
+)
+{
+   for( unsigned int k = 0;  k < n;  ++k )
+   {
+      pOut[k] = powFastLookup( pIn[k], ilog2, pTable, precision );
+   }
+}
+
+
+#ifdef POWFAST_SIMD
+
+__attribute__((target("sse2")))
+void powFastLookupSse2
+(
+   const float* const  pIn,
+   float* const        pOut,
+   const unsigned int  n,
+   const float         ilog2,
+   unsigned int* const pTable,
+   const unsigned int  precision
+)
+{
+   const __m128  scale    = _mm_set1_ps( _2p23 * ilog2 );
+   const __m128  bias     = _mm_set1_ps( 127.0f * _2p23 );
+   const __m128i expMask  = _mm_set1_epi32( static_cast<int>(0xFF800000) );
+   const __m128i manMask  = _mm_set1_epi32( 0x7FFFFF );
+   const __m128i shift    = _mm_cvtsi32_si128( static_cast<int>(23 - precision) );
+
+   unsigned int k = 0;
+   for( ;  k + 4 <= n;  k += 4 )
+   {
+      const __m128i i = _mm_cvttps_epi32(
+         _mm_add_ps( _mm_mul_ps( _mm_loadu_ps( pIn + k ), scale ), bias ) );
+
+      // no gather before AVX2: look the four indices up one by one
+      int index[4];
+      _mm_storeu_si128( reinterpret_cast<__m128i*>(index),
+         _mm_srl_epi32( _mm_and_si128( i, manMask ), shift ) );
+      const __m128i mantissa = _mm_setr_epi32(
+         static_cast<int>(pTable[index[0]]), static_cast<int>(pTable[index[1]]),
+         static_cast<int>(pTable[index[2]]), static_cast<int>(pTable[index[3]]) );
+
+      _mm_storeu_ps( pOut + k, _mm_castsi128_ps(
+         _mm_or_si128( _mm_and_si128( i, expMask ), mantissa ) ) );
+   }
+
+   powFastLookupScalar( pIn + k, pOut + k, n - k, ilog2, pTable, precision );
+}
+
+
+__attribute__((target("avx2")))
+void powFastLookupAvx2
+(
+   const float* const  pIn,
+   float* const        pOut,
+   const unsigned int  n,
+   const float         ilog2,
+   unsigned int* const pTable,
+   const unsigned int  precision
+)
+{
+   const __m256  scale    = _mm256_set1_ps( _2p23 * ilog2 );
+   const __m256  bias     = _mm256_set1_ps( 127.0f * _2p23 );
+   const __m256i expMask  = _mm256_set1_epi32( static_cast<int>(0xFF800000) );
+   const __m256i manMask  = _mm256_set1_epi32( 0x7FFFFF );
+   const __m128i shift    = _mm_cvtsi32_si128( static_cast<int>(23 - precision) );
+   const int*    table    = reinterpret_cast<const int*>(pTable);
+
+   unsigned int k = 0;
+   for( ;  k + 8 <= n;  k += 8 )
+   {
+      const __m256i i = _mm256_cvttps_epi32(
+         _mm256_add_ps( _mm256_mul_ps( _mm256_loadu_ps( pIn + k ), scale ), bias ) );
+
+      const __m256i mantissa = _mm256_i32gather_epi32( table,
+         _mm256_srl_epi32( _mm256_and_si256( i, manMask ), shift ), 4 );
+
+      _mm256_storeu_ps( pOut + k, _mm256_castsi256_ps(
+         _mm256_or_si256( _mm256_and_si256( i, expMask ), mantissa ) ) );
+   }
+
+   powFastLookupScalar( pIn + k, pOut + k, n - k, ilog2, pTable, precision );
+}
+
+
+__attribute__((target("avx512f")))
+void powFastLookupAvx512
+(
+   const float* const  pIn,
+   float* const        pOut,
+   const unsigned int  n,
+   const float         ilog2,
+   unsigned int* const pTable,
+   const unsigned int  precision
+)
+{
+   const __m512  scale    = _mm512_set1_ps( _2p23 * ilog2 );
+   const __m512  bias     = _mm512_set1_ps( 127.0f * _2p23 );
+   const __m512i expMask  = _mm512_set1_epi32( static_cast<int>(0xFF800000) );
+   const __m512i manMask  = _mm512_set1_epi32( 0x7FFFFF );
+   const __m128i shift    = _mm_cvtsi32_si128( static_cast<int>(23 - precision) );
+   const int*    table    = reinterpret_cast<const int*>(pTable);
+
+   // the remainder is handled by masked loads/stores rather than the scalar
+   // lookup, which the compiler would contract into an FMA under this target
+   for( unsigned int k = 0;  k < n;  k += 16 )
+   {
+      const __mmask16 mask = (n - k >= 16) ? static_cast<__mmask16>(0xFFFF) :
+         static_cast<__mmask16>((1u << (n - k)) - 1u);
+
+      // explicit rounding keeps the multiply and add from being fused
+      const __m512i i = _mm512_cvttps_epi32( _mm512_add_ps( _mm512_mul_round_ps(
+         _mm512_maskz_loadu_ps( mask, pIn + k ), scale,
+         _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ), bias ) );
+
+      const __m512i mantissa = _mm512_mask_i32gather_epi32( _mm512_setzero_si512(),
+         mask, _mm512_srl_epi32( _mm512_and_si512( i, manMask ), shift ), table, 4 );
+
+      _mm512_mask_storeu_ps( pOut + k, mask, _mm512_castsi512_ps(
+         _mm512_or_si512( _mm512_and_si512( i, expMask ), mantissa ) ) );
+   }
+}
+
+#endif // POWFAST_SIMD
+
+
+void powFastLookupBatch
+(
+   const float* const  pIn,
+   float* const        pOut,
+   const unsigned int  n,
+   const float         ilog2,
+   unsigned int* const pTable,
+   const unsigned int  precision
+)
+{
+#ifdef POWFAST_SIMD
+   switch( activeSimdLevel() )
+   {
+   case SIMD_AVX512:
+      powFastLookupAvx512( pIn, pOut, n, ilog2, pTable, precision );
+      return;
+   case SIMD_AVX2:
+      powFastLookupAvx2( pIn, pOut, n, ilog2, pTable, precision );
+      return;
+   case SIMD_SSE2:
+      powFastLookupSse2( pIn, pOut, n, ilog2, pTable, precision );
+      return;
+   default:
+      break;
+   }
+#endif
+   powFastLookupScalar( pIn, pOut, n, ilog2, pTable, precision );
+}
+
+
+
+
 /// wrapper class --------------------------------------------------------------
 
 PowFast::PowFast
@@ -165,6 +345,52 @@ unsigned int PowFast::precision() const
 }
 
 
+void PowFast::two
+(
+   const float* const pIn,
+   float* const       pOut,
+   const unsigned int n
+) const
+{
+   powFastLookupBatch( pIn, pOut, n, 1.0f, pTable_m, precision_m );
+}
+
+
+void PowFast::e
+(
+   const float* const pIn,
+   float* const       pOut,
+   const unsigned int n
+) const
+{
+   powFastLookupBatch( pIn, pOut, n, 1.44269504088896f, pTable_m, precision_m );
+}
+
+
+void PowFast::ten
+(
+   const float* const pIn,
+   float* const       pOut,
+   const unsigned int n
+) const
+{
+   powFastLookupBatch( pIn, pOut, n, 3.32192809488736f, pTable_m, precision_m );
+}
+
+
+void PowFast::r
+(
+   const float        logr,
+   const float* const pIn,
+   float* const       pOut,
+   const unsigned int n
+) const
+{
+   powFastLookupBatch( pIn, pOut, n, (logr * 1.44269504088896f), pTable_m,
+      precision_m );
+}
+
+
 
 
 /// default instance -----------------------------------------------------------
@@ -5,7 +5,9 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <vector>
 #include <alt_math_utilities/PowFast.hpp>
+#include <alt_math_utilities/CpuFeatures.hpp>
 
 using namespace std;
 using namespace alt_math_utilities;
@@ -30,6 +32,46 @@ TEST(powfast, general_precision)
     }
 }
 
+TEST(powfast, batch_matches_scalar)
+{
+    // Odd length, so that every kernel also runs its scalar remainder
+    const unsigned int count = 1001;
+    std::vector<float> x(count), y(count);
+    for (unsigned int i = 0; i < count; ++i)
+        x[i] = -30.f + 60.f * i / (count - 1);
+
+    const PowFast& pf = POWFAST();
+    const SimdLevel initial = activeSimdLevel();
+    for (int level = SIMD_SCALAR; level <= supportedSimdLevel(); ++level)
+    {
+        EXPECT_EQ(level, setSimdLevel(static_cast<SimdLevel>(level)));
+        SCOPED_TRACE(simdLevelName(activeSimdLevel()));
+
+        pf.e(&x[0], &y[0], count);
+        for (unsigned int i = 0; i < count; ++i)
+            EXPECT_EQ(pf.e(x[i]), y[i]);
+        pf.two(&x[0], &y[0], count);
+        for (unsigned int i = 0; i < count; ++i)
+            EXPECT_EQ(pf.two(x[i]), y[i]);
+        pf.ten(&x[0], &y[0], count);
+        for (unsigned int i = 0; i < count; ++i)
+            EXPECT_EQ(pf.ten(x[i]), y[i]);
+        pf.r(0.5f, &x[0], &y[0], count);
+        for (unsigned int i = 0; i < count; ++i)
+            EXPECT_EQ(pf.r(0.5f, x[i]), y[i]);
+
+        // In place
+        y = x;
+        pf.e(&y[0], &y[0], count);
+        for (unsigned int i = 0; i < count; ++i)
+            EXPECT_EQ(pf.e(x[i]), y[i]);
+    }
+
+    // Requests beyond the CPU's capabilities are clamped
+    EXPECT_EQ(supportedSimdLevel(), setSimdLevel(SIMD_AVX512));
+    setSimdLevel(initial);
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
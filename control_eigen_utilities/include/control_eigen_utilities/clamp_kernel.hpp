@@ -0,0 +1,28 @@
+/**
+ * @brief Element-wise clamp over raw arrays, vectorized at the SIMD level
+ * selected at runtime (see alt_math_utilities/CpuFeatures.hpp)
+ */
+#ifndef CONTROL_EIGEN_UTILITIES_CLAMP_KERNEL_HPP_
+    #define CONTROL_EIGEN_UTILITIES_CLAMP_KERNEL_HPP_
+
+#include <cstddef>
+
+namespace control_eigen_utilities
+{
+
+/**
+ * @brief clamp_array Clamp value[i] within [min[i], max[i]] with the same
+ * semantics as control_utilities::clamp(): NAN bounds are disabled and NAN
+ * values are passed through
+ * @param pclamped If not null, receives the clamped values (may alias value)
+ * @param presult If not null, receives {0: No clamping, -1: Lower bounded, 1: Upper bounded}
+ * @param pinvalid If not null, set to the first index with min > max, or -1.
+ * Such elements are still processed; checking is left to the caller.
+ * @return Number of clamped elements
+ */
+int clamp_array(const double *value, const double *min, const double *max, int size,
+    double *pclamped = NULL, int *presult = NULL, int *pinvalid = NULL);
+
+}
+
+#endif // CONTROL_EIGEN_UTILITIES_CLAMP_KERNEL_HPP_
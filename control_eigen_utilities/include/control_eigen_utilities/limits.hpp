@@ -11,6 +11,7 @@
 #include <Eigen/Dense>
 #include <eigen_utilities/assert_size.hpp>
 #include <control_utilities/limits.hpp>
+#include <control_eigen_utilities/clamp_kernel.hpp>
 
 namespace control_eigen_utilities
 {
@@ -34,19 +35,15 @@ inline bool clamp(const Eigen::VectorXd &value, const Eigen::VectorXd &min, cons
     if (presult)
         presult->resize(size);
 
-    bool is_clamped = false;
-    for (int i = 0; i < size; ++i)
-    {
-        int result;
-        double clamped = control_utilities::clamp(value.coeff(i), min.coeff(i), max.coeff(i), &result);
-        if (pclamped)
-            pclamped->coeffRef(i) = clamped;
-        if (presult)
-            presult->coeffRef(i) = result;
-        if (result != 0)
-            is_clamped = true;
-    }
-    return is_clamped;
+    // Vectorized kernel; inconsistent bounds are re-checked by the scalar
+    // clamp, so that they trip the same assertion
+    int invalid;
+    int count = clamp_array(value.data(), min.data(), max.data(), size,
+        pclamped ? pclamped->data() : NULL, presult ? presult->data() : NULL, &invalid);
+    if (invalid >= 0)
+        control_utilities::clamp(value.coeff(invalid), min.coeff(invalid), max.coeff(invalid));
+
+    return count > 0;
 }
 
 }
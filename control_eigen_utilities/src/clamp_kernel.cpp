@@ -0,0 +1,193 @@
+/**
+ * @brief SIMD variants of clamp_array(). Each variant is compiled with a
+ * function-level target attribute and chosen at runtime, so the package
+ * itself needs no -march flags. Comparisons are ordered (false if either side
+ * is NAN), which gives the NAN semantics of control_utilities::clamp() for
+ * free.
+ */
+#include <cstddef>
+
+#include <control_eigen_utilities/clamp_kernel.hpp>
+#include <alt_math_utilities/CpuFeatures.hpp>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    #define CLAMP_KERNEL_SIMD
+    #include <immintrin.h>
+#endif
+
+namespace control_eigen_utilities
+{
+
+namespace
+{
+
+int clamp_scalar(const double *value, const double *min, const double *max, int begin, int size,
+    double *pclamped, int *presult, int *pinvalid)
+{
+    int count = 0;
+    for (int i = begin; i < size; ++i)
+    {
+        if (*pinvalid < 0 && min[i] > max[i])
+            *pinvalid = i;
+
+        double clamped = value[i];
+        int result = 0;
+        if (value[i] < min[i])
+        {
+            result = -1;
+            clamped = min[i];
+        }
+        else if (value[i] > max[i])
+        {
+            result = 1;
+            clamped = max[i];
+        }
+
+        if (pclamped)
+            pclamped[i] = clamped;
+        if (presult)
+            presult[i] = result;
+        if (result != 0)
+            ++count;
+    }
+    return count;
+}
+
+#ifdef CLAMP_KERNEL_SIMD
+
+/// Writes the result codes of one vector from the lower / upper bit masks
+inline void store_results(int *presult, int lower, int upper, int width)
+{
+    for (int j = 0; j < width; ++j)
+        presult[j] = ((upper >> j) & 1) - ((lower >> j) & 1);
+}
+
+__attribute__((target("sse2")))
+int clamp_sse2(const double *value, const double *min, const double *max, int size,
+    double *pclamped, int *presult, int *pinvalid)
+{
+    int count = 0;
+    int i = 0;
+    for (; i + 2 <= size; i += 2)
+    {
+        __m128d v = _mm_loadu_pd(value + i);
+        __m128d lo = _mm_loadu_pd(min + i);
+        __m128d hi = _mm_loadu_pd(max + i);
+
+        int invalid = _mm_movemask_pd(_mm_cmpgt_pd(lo, hi));
+        if (invalid && *pinvalid < 0)
+            *pinvalid = i + __builtin_ctz(invalid);
+
+        __m128d is_lower = _mm_cmplt_pd(v, lo);
+        __m128d is_upper = _mm_andnot_pd(is_lower, _mm_cmpgt_pd(v, hi));
+        int lower = _mm_movemask_pd(is_lower);
+        int upper = _mm_movemask_pd(is_upper);
+
+        if (pclamped)
+        {
+            // Select without blendv (SSE4.1): (mask & a) | (~mask & b)
+            __m128d c = _mm_or_pd(_mm_and_pd(is_lower, lo), _mm_andnot_pd(is_lower, v));
+            c = _mm_or_pd(_mm_and_pd(is_upper, hi), _mm_andnot_pd(is_upper, c));
+            _mm_storeu_pd(pclamped + i, c);
+        }
+        if (presult)
+            store_results(presult + i, lower, upper, 2);
+        count += __builtin_popcount(lower | upper);
+    }
+    return count + clamp_scalar(value, min, max, i, size, pclamped, presult, pinvalid);
+}
+
+__attribute__((target("avx2")))
+int clamp_avx2(const double *value, const double *min, const double *max, int size,
+    double *pclamped, int *presult, int *pinvalid)
+{
+    int count = 0;
+    int i = 0;
+    for (; i + 4 <= size; i += 4)
+    {
+        __m256d v = _mm256_loadu_pd(value + i);
+        __m256d lo = _mm256_loadu_pd(min + i);
+        __m256d hi = _mm256_loadu_pd(max + i);
+
+        int invalid = _mm256_movemask_pd(_mm256_cmp_pd(lo, hi, _CMP_GT_OQ));
+        if (invalid && *pinvalid < 0)
+            *pinvalid = i + __builtin_ctz(invalid);
+
+        __m256d is_lower = _mm256_cmp_pd(v, lo, _CMP_LT_OQ);
+        __m256d is_upper = _mm256_andnot_pd(is_lower, _mm256_cmp_pd(v, hi, _CMP_GT_OQ));
+        int lower = _mm256_movemask_pd(is_lower);
+        int upper = _mm256_movemask_pd(is_upper);
+
+        if (pclamped)
+            _mm256_storeu_pd(pclamped + i,
+                _mm256_blendv_pd(_mm256_blendv_pd(v, lo, is_lower), hi, is_upper));
+        if (presult)
+            store_results(presult + i, lower, upper, 4);
+        count += __builtin_popcount(lower | upper);
+    }
+    return count + clamp_scalar(value, min, max, i, size, pclamped, presult, pinvalid);
+}
+
+__attribute__((target("avx512f")))
+int clamp_avx512(const double *value, const double *min, const double *max, int size,
+    double *pclamped, int *presult, int *pinvalid)
+{
+    int count = 0;
+    int i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        __m512d v = _mm512_loadu_pd(value + i);
+        __m512d lo = _mm512_loadu_pd(min + i);
+        __m512d hi = _mm512_loadu_pd(max + i);
+
+        int invalid = _mm512_cmp_pd_mask(lo, hi, _CMP_GT_OQ);
+        if (invalid && *pinvalid < 0)
+            *pinvalid = i + __builtin_ctz(invalid);
+
+        __mmask8 is_lower = _mm512_cmp_pd_mask(v, lo, _CMP_LT_OQ);
+        __mmask8 is_upper = _mm512_cmp_pd_mask(v, hi, _CMP_GT_OQ) & ~is_lower;
+
+        if (pclamped)
+            _mm512_storeu_pd(pclamped + i,
+                _mm512_mask_blend_pd(is_upper, _mm512_mask_blend_pd(is_lower, v, lo), hi));
+        if (presult)
+            store_results(presult + i, is_lower, is_upper, 8);
+        count += __builtin_popcount(is_lower | is_upper);
+    }
+    return count + clamp_scalar(value, min, max, i, size, pclamped, presult, pinvalid);
+}
+
+#endif // CLAMP_KERNEL_SIMD
+
+}
+
+int clamp_array(const double *value, const double *min, const double *max, int size,
+    double *pclamped, int *presult, int *pinvalid)
+{
+    int invalid = -1;
+    int count;
+
+    switch (alt_math_utilities::activeSimdLevel())
+    {
+#ifdef CLAMP_KERNEL_SIMD
+    case alt_math_utilities::SIMD_AVX512:
+        count = clamp_avx512(value, min, max, size, pclamped, presult, &invalid);
+        break;
+    case alt_math_utilities::SIMD_AVX2:
+        count = clamp_avx2(value, min, max, size, pclamped, presult, &invalid);
+        break;
+    case alt_math_utilities::SIMD_SSE2:
+        count = clamp_sse2(value, min, max, size, pclamped, presult, &invalid);
+        break;
+#endif
+    default:
+        count = clamp_scalar(value, min, max, 0, size, pclamped, presult, &invalid);
+        break;
+    }
+
+    if (pinvalid)
+        *pinvalid = invalid;
+    return count;
+}
+
+}
@@ -6,7 +6,9 @@
  */
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <control_eigen_utilities/limits.hpp>
+#include <alt_math_utilities/CpuFeatures.hpp>
 
 using Eigen::VectorXd;
 using Eigen::VectorXi;
@@ -52,6 +54,58 @@ TEST(limits_test, clamp_values)
     }
 }
 
+TEST(limits_test, clamp_simd_levels)
+{
+    // Odd size with disabled (NAN) bounds and NAN values, so that every
+    // kernel runs its remainder and the NAN handling of each level is covered
+    int size = 37;
+    VectorXd min(size), max(size), values(size);
+    for (int i = 0; i < size; ++i)
+    {
+        min(i) = (i % 7 == 3) ? NAN : -1. - 0.1 * i;
+        max(i) = (i % 5 == 2) ? NAN : 1. + 0.1 * i;
+        values(i) = (i % 11 == 6) ? NAN : 3. * std::sin(1.3 * i);
+    }
+
+    VectorXd clamped_expected(size);
+    VectorXi results_expected(size);
+    bool was_clamped_expected = false;
+    for (int i = 0; i < size; ++i)
+    {
+        clamped_expected(i) = control_utilities::clamp(values(i), min(i), max(i), &results_expected(i));
+        was_clamped_expected = was_clamped_expected || results_expected(i) != 0;
+    }
+
+    using namespace alt_math_utilities;
+    SimdLevel initial = activeSimdLevel();
+    for (int level = SIMD_SCALAR; level <= supportedSimdLevel(); ++level)
+    {
+        setSimdLevel(static_cast<SimdLevel>(level));
+        SCOPED_TRACE(simdLevelName(activeSimdLevel()));
+
+        VectorXd clamped;
+        VectorXi results;
+        bool was_clamped = control_eigen_utilities::clamp(values, min, max, &clamped, &results);
+        EXPECT_EQ(was_clamped_expected, was_clamped);
+        EXPECT_EQ(results_expected, results);
+        for (int i = 0; i < size; ++i)
+        {
+            if (std::isnan(values(i)))
+                EXPECT_TRUE(std::isnan(clamped(i)));
+            else
+                EXPECT_EQ(clamped_expected(i), clamped(i));
+        }
+
+        // Inconsistent bounds are reported
+        int invalid;
+        VectorXd bad_min = min;
+        bad_min(size - 2) = max(size - 2) + 1;
+        clamp_array(values.data(), bad_min.data(), max.data(), size, NULL, NULL, &invalid);
+        EXPECT_EQ(size - 2, invalid);
+    }
+    setSimdLevel(initial);
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -34,15 +34,22 @@
 
 #include <MessageHandling.cpp>
 #include <Utils.cpp>
+#include <AsyncOutput.cpp>
 #include <Indexlist.cpp>
 #include <SubjectTo.cpp>
 #include <Bounds.cpp>
 #include <Constraints.cpp>
+#include <WorkingSet.cpp>
+#include <SimdKernels.cpp>
 
 #if !defined(__MATLAB__) || defined(WIN32)
+#if defined(__EIGEN_BLAS_LAPACK__)
+#include <EigenReplacement.cpp>
+#elif !defined(__EXTERNAL_BLAS_LAPACK__)
 #include <BLASReplacement.cpp>
 #include <LAPACKReplacement.cpp>
 #endif
+#endif
 
 #include <Matrices.cpp>
 #include <Options.cpp>
@@ -50,6 +57,7 @@
 #include <Flipper.cpp>
 #include <QProblem.cpp>
 #include <SQProblem.cpp>
+#include <Condenser.cpp>
 
 #if defined(SOLVER_MA27) || defined(SOLVER_MA57)
 #include <SparseSolver.cpp>
@@ -59,15 +67,27 @@
 #if !defined(__C_WRAPPER__) && !defined(__MATLAB__)
 #include <OQPinterface.cpp>
 #include <SolutionAnalysis.cpp>
+#include <RacingSolver.cpp>
+#include <SolverService.cpp>
+#include <KktChecker.cpp>
+#include <ActiveSetPredictor.cpp>
 #endif
 
 #else /* default compilation mode */
 
+#include <qpOASES/AsyncOutput.hpp>
+#include <qpOASES/SimdKernels.hpp>
+#include <qpOASES/WorkingSet.hpp>
 #include <qpOASES/QProblemB.hpp>
 #include <qpOASES/QProblem.hpp>
 #include <qpOASES/SQProblem.hpp>
 #include <qpOASES/SQProblemSchur.hpp>
+#include <qpOASES/Condenser.hpp>
 #include <qpOASES/extras/OQPinterface.hpp>
 #include <qpOASES/extras/SolutionAnalysis.hpp>
+#include <qpOASES/extras/RacingSolver.hpp>
+#include <qpOASES/extras/SolverService.hpp>
+#include <qpOASES/extras/KktChecker.hpp>
+#include <qpOASES/extras/ActiveSetPredictor.hpp>
 
 #endif
@@ -0,0 +1,200 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file include/qpOASES/AsyncOutput.hpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Declaration of the AsyncOutput class which moves all message output
+ *	of qpOASES off the solver thread.
+ */
+
+
+#ifndef QPOASES_ASYNCOUTPUT_HPP
+#define QPOASES_ASYNCOUTPUT_HPP
+
+
+#include <qpOASES/MessageHandling.hpp>
+
+#ifndef __NO_THREADS__
+  #include <pthread.h>
+#endif
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/**
+ *	\brief Asynchronous output backend for the global message handler.
+ *
+ *	Messages are copied into a fixed number of pre-allocated slots of a
+ *	single-producer/single-consumer ring buffer; a background thread drains
+ *	the buffer into the output file. The producer side (i.e. the solver thread
+ *	calling myPrintf()) never blocks, never allocates memory and never calls
+ *	into the C library's stream functions. If the buffer cannot take the whole
+ *	message, the message is dropped and counted instead.
+ *
+ *	Only one thread may write messages at a time. Once started, attach the
+ *	object with MessageHandling::setAsyncOutput(). If threads are not
+ *	available (__NO_THREADS__), messages are written synchronously.
+ *
+ *	\version 3.2
+ *	\date 2018
+ */
+class AsyncOutput
+{
+	/*
+	 *	PUBLIC MEMBER FUNCTIONS
+	 */
+	public:
+		/** Constructor which takes the number of message slots, the output
+		 *  file and the polling period of the output thread. */
+		AsyncOutput(	uint_t _nSlots = 256,					/**< Number of message slots (rounded up to a power of two). */
+						FILE* _outputFile = stdFile,			/**< Output file the messages are drained to. */
+						uint_t _pollingPeriod = 1000			/**< Idle polling period of output thread [microseconds]. */
+						);
+
+		/** Destructor (stops output thread and writes all pending messages). */
+		~AsyncOutput( );
+
+
+		/** Starts the output thread.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_ASYNC_OUTPUT_START_FAILED */
+		returnValue start( );
+
+		/** Stops the output thread after all pending messages have been written.
+		 *	\return SUCCESSFUL_RETURN */
+		returnValue stop( );
+
+		/** Blocks until all pending messages have been written
+		 *  (not to be called from within a real-time loop).
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_ASYNC_OUTPUT_NOT_RUNNING */
+		returnValue flush( );
+
+
+		/** Enqueues a message. Messages longer than one slot are split; all
+		 *  of their chunks are enqueued together or the whole message is dropped.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_ASYNC_OUTPUT_MESSAGE_DROPPED \n
+					RET_INVALID_ARGUMENTS */
+		returnValue write(	const char* s			/**< Null-terminated message. */
+							);
+
+		/** Formats a message directly into the next free slot.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_ASYNC_OUTPUT_MESSAGE_DROPPED \n
+					RET_INVALID_ARGUMENTS */
+		returnValue writef(	const char* format,		/**< printf-style format string. */
+							...
+							);
+
+
+		/** Returns if the output thread is running.
+		 *	\return BT_TRUE:  output thread running \n
+		 			BT_FALSE: output thread not running */
+		inline BooleanType isRunning( ) const;
+
+		/** Returns the number of message slots.
+		 *	\return Number of message slots. */
+		inline uint_t getNumSlots( ) const;
+
+		/** Returns the number of messages currently waiting to be written.
+		 *	\return Number of pending messages. */
+		inline uint_t getNumPending( ) const;
+
+		/** Returns the number of messages dropped due to a full buffer.
+		 *	\return Number of dropped messages. */
+		inline uint_t getNumDropped( ) const;
+
+		/** Resets the counter of dropped messages (to zero).
+		 *	\return SUCCESSFUL_RETURN */
+		inline returnValue resetNumDropped( );
+
+		/** Returns pointer to output file.
+		 *	\return Pointer to output file. */
+		inline FILE* getOutputFile( ) const;
+
+
+	/*
+	 *	PROTECTED MEMBER FUNCTIONS
+	 */
+	protected:
+		/** Writes all pending messages to the output file (consumer side).
+		 *	\return Number of messages written. */
+		uint_t drain( );
+
+		/** Entry point of the output thread. */
+		static void* run(	void* arg	/**< Pointer to AsyncOutput object. */
+							);
+
+
+	/*
+	 *	PRIVATE MEMBER FUNCTIONS
+	 */
+	private:
+		/** Copy constructor (not allowed, owns a thread). */
+		AsyncOutput(	const AsyncOutput& rhs	/**< Rhs object. */
+						);
+
+		/** Assignment operator (not allowed, owns a thread). */
+		AsyncOutput& operator=(	const AsyncOutput& rhs	/**< Rhs object. */
+								);
+
+
+	/*
+	 *	PROTECTED MEMBER VARIABLES
+	 */
+	protected:
+		char* buffer;					/**< Message slots, each MAX_STRING_LENGTH characters long. */
+		uint_t nSlots;					/**< Number of message slots (power of two). */
+
+		uint_t head;					/**< Number of messages enqueued so far (written by producer only). */
+		uint_t tail;					/**< Number of messages written so far (written by consumer only). */
+		uint_t nDropped;				/**< Number of messages dropped due to a full buffer. */
+
+		FILE* outputFile;				/**< Output file for messages. */
+		uint_t pollingPeriod;			/**< Idle polling period of output thread [microseconds]. */
+
+		BooleanType running;			/**< Flag indicating whether output thread is running. */
+		BooleanType stopRequested;		/**< Flag requesting the output thread to terminate. */
+
+		#ifndef __NO_THREADS__
+		pthread_t thread;				/**< Output thread. */
+		#endif
+};
+
+
+END_NAMESPACE_QPOASES
+
+#include <qpOASES/AsyncOutput.ipp>
+
+#endif	/* QPOASES_ASYNCOUTPUT_HPP */
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,105 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/**
+ *	\file include/qpOASES/AsyncOutput.ipp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Implementation of inlined member functions of the AsyncOutput class which
+ *	moves all message output of qpOASES off the solver thread.
+ */
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+/*
+ *	i s R u n n i n g
+ */
+inline BooleanType AsyncOutput::isRunning( ) const
+{
+	return running;
+}
+
+
+/*
+ *	g e t N u m S l o t s
+ */
+inline uint_t AsyncOutput::getNumSlots( ) const
+{
+	return nSlots;
+}
+
+
+/*
+ *	g e t N u m P e n d i n g
+ */
+inline uint_t AsyncOutput::getNumPending( ) const
+{
+	#ifndef __NO_THREADS__
+	return __atomic_load_n( &head,__ATOMIC_ACQUIRE ) - __atomic_load_n( &tail,__ATOMIC_ACQUIRE );
+	#else
+	return head - tail;
+	#endif
+}
+
+
+/*
+ *	g e t N u m D r o p p e d
+ */
+inline uint_t AsyncOutput::getNumDropped( ) const
+{
+	return nDropped;
+}
+
+
+/*
+ *	r e s e t N u m D r o p p e d
+ */
+inline returnValue AsyncOutput::resetNumDropped( )
+{
+	nDropped = 0;
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	g e t O u t p u t F i l e
+ */
+inline FILE* AsyncOutput::getOutputFile( ) const
+{
+	return outputFile;
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
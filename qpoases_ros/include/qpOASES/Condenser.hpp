@@ -0,0 +1,340 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file include/qpOASES/Condenser.hpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Declaration of the Condenser class which builds dense QPs from
+ *	stage-wise MPC data and keeps them up to date incrementally.
+ */
+
+
+#ifndef QPOASES_CONDENSER_HPP
+#define QPOASES_CONDENSER_HPP
+
+
+#include <qpOASES/SQProblem.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/**
+ *	\brief Incremental condensing of linear MPC problems.
+ *
+ *	Condenses the optimal control problem
+ *
+ *	  min  sum_{k=0}^{N-1} ( 1/2 x_k'Q_k x_k + q_k'x_k + 1/2 u_k'R_k u_k + r_k'u_k )
+ *	       + 1/2 x_N'Q_N x_N + q_N'x_N
+ *	  s.t. x_{k+1} = A_k x_k + B_k u_k + c_k,   x_0 given,
+ *	       lbu_k <= u_k <= ubu_k,   lbx_k <= x_k <= ubx_k (k=1,...,N)
+ *
+ *	into a dense QP in the inputs u_0,...,u_{N-1}, whose Hessian, gradient,
+ *	constraint matrix and bounds can be passed directly to an SQProblem.
+ *	All matrices are stored row-wise (like all dense matrices in qpOASES).
+ *
+ *	Stage data that is set to values differing from the previous ones marks
+ *	the stage as changed; update() then recomputes only those blocks of the
+ *	Hessian and the constraint matrix that depend on a changed stage (e.g. a
+ *	new linearisation of the first stages only touches the corresponding
+ *	block rows). All products are carried out block-wise on contiguous
+ *	blocks of size nX x nU. Gradient and constraints' bounds depend on the
+ *	initial state and are always recomputed at linear cost.
+ *
+ *	\version 3.2
+ *	\date 2018
+ */
+class Condenser
+{
+	/*
+	 *	PUBLIC MEMBER FUNCTIONS
+	 */
+	public:
+		/** Default constructor. */
+		Condenser( );
+
+		/** Constructor which takes the problem dimensions. */
+		Condenser(	uint_t _nX,				/**< Number of states. */
+					uint_t _nU,				/**< Number of inputs. */
+					uint_t _nN				/**< Length of horizon. */
+					);
+
+		/** Copy constructor (deep copy). */
+		Condenser(	const Condenser& rhs	/**< Rhs object. */
+					);
+
+		/** Destructor. */
+		~Condenser( );
+
+		/** Assignment operator (deep copy). */
+		Condenser& operator=(	const Condenser& rhs	/**< Rhs object. */
+								);
+
+
+		/** Initialises object with given problem dimensions. All dynamics and
+		 *  costs are set to zero, all bounds are set to +/-INFTY.
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_INVALID_ARGUMENTS */
+		returnValue init(	uint_t _nX,				/**< Number of states. */
+							uint_t _nU,				/**< Number of inputs. */
+							uint_t _nN				/**< Length of horizon. */
+							);
+
+
+		/** Sets dynamics of one stage, i.e. x_{k+1} = A_k x_k + B_k u_k + c_k.
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_INDEX_OUT_OF_BOUNDS \n
+		 			RET_INVALID_ARGUMENTS */
+		returnValue setDynamics(	uint_t stage,						/**< Stage k (0,...,N-1). */
+									const real_t* const _A,				/**< State transition matrix (nX x nX). */
+									const real_t* const _B,				/**< Input matrix (nX x nU). */
+									const real_t* const _c = 0			/**< Affine term (or null pointer if zero). */
+									);
+
+		/** Sets cost of one stage.
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_INDEX_OUT_OF_BOUNDS \n
+		 			RET_INVALID_ARGUMENTS */
+		returnValue setStageCost(	uint_t stage,						/**< Stage k (0,...,N-1). */
+									const real_t* const _Q,				/**< State weighting matrix (nX x nX, symmetric). */
+									const real_t* const _R,				/**< Input weighting matrix (nU x nU, symmetric). */
+									const real_t* const _q = 0,			/**< State gradient (or null pointer if zero). */
+									const real_t* const _r = 0			/**< Input gradient (or null pointer if zero). */
+									);
+
+		/** Sets terminal cost.
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_INVALID_ARGUMENTS */
+		returnValue setTerminalCost(	const real_t* const _Q,			/**< State weighting matrix (nX x nX, symmetric). */
+										const real_t* const _q = 0		/**< State gradient (or null pointer if zero). */
+										);
+
+		/** Sets input bounds of one stage (null pointers remove bounds).
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_INDEX_OUT_OF_BOUNDS */
+		returnValue setInputBounds(	uint_t stage,						/**< Stage k (0,...,N-1). */
+									const real_t* const _lbu,			/**< Lower input bounds (or null pointer). */
+									const real_t* const _ubu			/**< Upper input bounds (or null pointer). */
+									);
+
+		/** Sets state bounds of one stage (null pointers remove bounds).
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_INDEX_OUT_OF_BOUNDS */
+		returnValue setStateBounds(	uint_t stage,						/**< Stage k (1,...,N). */
+									const real_t* const _lbx,			/**< Lower state bounds (or null pointer). */
+									const real_t* const _ubx			/**< Upper state bounds (or null pointer). */
+									);
+
+		/** Sets initial state x_0.
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_INVALID_ARGUMENTS */
+		returnValue setInitialState(	const real_t* const _x0			/**< Initial state. */
+										);
+
+
+		/** Recomputes all blocks of the condensed QP affected by changed stages
+		 *  as well as gradient and constraints' bounds.
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_QPOBJECT_NOT_SETUP */
+		returnValue update( );
+
+		/** Updates the condensed QP and initialises the given QP with it.
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_QPOBJECT_NOT_SETUP \n
+		 			RET_INVALID_ARGUMENTS \n
+		 			return values of SQProblem::init */
+		returnValue init(	SQProblem& qp,						/**< QP of dimensions getNV() x getNC(). */
+							int_t& nWSR,						/**< Input: Maximum number of working set recalculations; \n
+																	 Output: Number of performed working set recalculations. */
+							real_t* const cputime = 0			/**< Input: Maximum CPU time allowed for QP initialisation. \n
+																	 Output: CPU time spent for QP initialisation (if pointer passed). */
+							);
+
+		/** Updates the condensed QP and solves it by a hotstart of the given QP.
+		 *  New matrices are only passed to the QP if a stage affecting them has
+		 *  changed since the last hotstart; otherwise a (cheaper) hotstart with
+		 *  new vectors only is performed.
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_QPOBJECT_NOT_SETUP \n
+		 			return values of SQProblem::hotstart */
+		returnValue hotstart(	SQProblem& qp,					/**< QP initialised by init(). */
+								int_t& nWSR,					/**< Input: Maximum number of working set recalculations; \n
+																	 Output: Number of performed working set recalculations. */
+								real_t* const cputime = 0		/**< Input: Maximum CPU time allowed for QP solution. \n
+																	 Output: CPU time spent for QP solution (if pointer passed). */
+								);
+
+		/** Computes the state trajectory x_0,...,x_N resulting from given inputs.
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_INVALID_ARGUMENTS */
+		returnValue expandSolution(	const real_t* const uOpt,			/**< Inputs u_0,...,u_{N-1} (e.g. primal solution of the QP). */
+									real_t* const xOpt					/**< Output: States x_0,...,x_N. */
+									) const;
+
+
+		/** Returns number of states.
+		 *	\return Number of states. */
+		inline uint_t getNX( ) const;
+
+		/** Returns number of inputs.
+		 *	\return Number of inputs. */
+		inline uint_t getNU( ) const;
+
+		/** Returns length of horizon.
+		 *	\return Length of horizon. */
+		inline uint_t getNN( ) const;
+
+		/** Returns number of variables of the condensed QP.
+		 *	\return Number of variables. */
+		inline uint_t getNV( ) const;
+
+		/** Returns number of constraints of the condensed QP.
+		 *	\return Number of constraints. */
+		inline uint_t getNC( ) const;
+
+		/** Returns Hessian matrix of the condensed QP (valid until next update;
+		 *  its diagonal might have been regularised by a QP it has been passed to).
+		 *	\return Hessian matrix. */
+		inline SymDenseMat* getH( ) const;
+
+		/** Returns constraint matrix of the condensed QP (valid until next update).
+		 *	\return Constraint matrix. */
+		inline DenseMatrix* getA( ) const;
+
+		/** Returns gradient of the condensed QP.
+		 *	\return Gradient vector. */
+		inline const real_t* getG( ) const;
+
+		/** Returns lower bounds of the condensed QP.
+		 *	\return Lower bounds vector. */
+		inline const real_t* getLB( ) const;
+
+		/** Returns upper bounds of the condensed QP.
+		 *	\return Upper bounds vector. */
+		inline const real_t* getUB( ) const;
+
+		/** Returns lower constraints' bounds of the condensed QP.
+		 *	\return Lower constraints' bounds vector. */
+		inline const real_t* getLBA( ) const;
+
+		/** Returns upper constraints' bounds of the condensed QP.
+		 *	\return Upper constraints' bounds vector. */
+		inline const real_t* getUBA( ) const;
+
+
+	/*
+	 *	PROTECTED MEMBER FUNCTIONS
+	 */
+	protected:
+		/** Frees all allocated memory.
+		 *  \return SUCCESSFUL_RETURN */
+		returnValue clear( );
+
+		/** Copies all members from given rhs object.
+		 *  \return SUCCESSFUL_RETURN */
+		returnValue copy(	const Condenser& rhs	/**< Rhs object. */
+							);
+
+		/** Copies given values into a stage block and reports whether they differ.
+		 *  \return BT_TRUE iff block has changed */
+		static BooleanType assign(	real_t* const block,		/**< Stage block. */
+									const real_t* const values,	/**< New values (or null pointer for zero). */
+									uint_t n					/**< Number of entries. */
+									);
+
+		/** Block product C = A*B or C += A*B of row-wise stored matrices
+		 *  (A: m x p, B: p x n, C: m x n). */
+		static void multiplyNN(	uint_t m, uint_t n, uint_t p,
+								const real_t* const A, uint_t ldA,
+								const real_t* const B, uint_t ldB,
+								real_t* const C, uint_t ldC,
+								BooleanType add
+								);
+
+		/** Block product C = A'*B or C += A'*B of row-wise stored matrices
+		 *  (A: p x m, B: p x n, C: m x n). */
+		static void multiplyTN(	uint_t m, uint_t n, uint_t p,
+								const real_t* const A, uint_t ldA,
+								const real_t* const B, uint_t ldB,
+								real_t* const C, uint_t ldC,
+								BooleanType add
+								);
+
+
+	/*
+	 *	PROTECTED MEMBER VARIABLES
+	 */
+	protected:
+		uint_t nX;						/**< Number of states. */
+		uint_t nU;						/**< Number of inputs. */
+		uint_t nN;						/**< Length of horizon. */
+
+		real_t* dynA;					/**< State transition matrices A_0,...,A_{N-1}. */
+		real_t* dynB;					/**< Input matrices B_0,...,B_{N-1}. */
+		real_t* dynC;					/**< Affine terms c_0,...,c_{N-1}. */
+		real_t* costQ;					/**< State weighting matrices Q_0,...,Q_N. */
+		real_t* costR;					/**< Input weighting matrices R_0,...,R_{N-1}. */
+		real_t* costq;					/**< State gradients q_0,...,q_N. */
+		real_t* costr;					/**< Input gradients r_0,...,r_{N-1}. */
+		real_t* lbx;					/**< Lower state bounds of stages 1,...,N. */
+		real_t* ubx;					/**< Upper state bounds of stages 1,...,N. */
+		real_t* x0;						/**< Initial state. */
+
+		BooleanType* changedDynamics;	/**< Flags indicating changed A_k or B_k since last update. */
+		BooleanType* changedQ;			/**< Flags indicating changed Q_k since last update. */
+		BooleanType* changedR;			/**< Flags indicating changed R_k since last update. */
+		BooleanType matricesChanged;	/**< Flag indicating whether H or A changed since last init/hotstart. */
+
+		real_t* sens;					/**< Sensitivities V_{k,j} = sum_{l>=k} A_{l-1}'*...*A_k'*Q_l*(dx_l/du_j), stored as N x N blocks (nX x nU). */
+		uint_t* firstGamma;				/**< First block row of each block column of constraint matrix recomputed by update. */
+		uint_t* firstSens;				/**< Highest sensitivity of each block column recomputed by update (0 if none). */
+		real_t* traj;					/**< Free state trajectory (inputs zero) x_0,...,x_N. */
+		real_t* adj;					/**< Adjoint trajectory of gradient computation. */
+
+		real_t* hessian;				/**< Values of Hessian matrix (nV x nV). */
+		real_t* constraintMatrix;		/**< Values of constraint matrix (nC x nV), block row k-1 holds dx_k/du. */
+		SymDenseMat* H;					/**< Hessian matrix (wrapping hessian). */
+		DenseMatrix* A;					/**< Constraint matrix (wrapping constraintMatrix). */
+
+		real_t* g;						/**< Gradient. */
+		real_t* lb;						/**< Lower bounds. */
+		real_t* ub;						/**< Upper bounds. */
+		real_t* lbA;					/**< Lower constraints' bounds. */
+		real_t* ubA;					/**< Upper constraints' bounds. */
+};
+
+
+END_NAMESPACE_QPOASES
+
+#include <qpOASES/Condenser.ipp>
+
+#endif	/* QPOASES_CONDENSER_HPP */
+
+
+/*
+ *	end of file
+ */
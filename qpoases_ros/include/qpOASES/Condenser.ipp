@@ -0,0 +1,158 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file include/qpOASES/Condenser.ipp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Implementation of inlined member functions of the Condenser class which
+ *	builds dense QPs from stage-wise MPC data.
+ */
+
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	g e t N X
+ */
+inline uint_t Condenser::getNX( ) const
+{
+	return nX;
+}
+
+
+/*
+ *	g e t N U
+ */
+inline uint_t Condenser::getNU( ) const
+{
+	return nU;
+}
+
+
+/*
+ *	g e t N N
+ */
+inline uint_t Condenser::getNN( ) const
+{
+	return nN;
+}
+
+
+/*
+ *	g e t N V
+ */
+inline uint_t Condenser::getNV( ) const
+{
+	return nN*nU;
+}
+
+
+/*
+ *	g e t N C
+ */
+inline uint_t Condenser::getNC( ) const
+{
+	return nN*nX;
+}
+
+
+/*
+ *	g e t H
+ */
+inline SymDenseMat* Condenser::getH( ) const
+{
+	return H;
+}
+
+
+/*
+ *	g e t A
+ */
+inline DenseMatrix* Condenser::getA( ) const
+{
+	return A;
+}
+
+
+/*
+ *	g e t G
+ */
+inline const real_t* Condenser::getG( ) const
+{
+	return g;
+}
+
+
+/*
+ *	g e t L B
+ */
+inline const real_t* Condenser::getLB( ) const
+{
+	return lb;
+}
+
+
+/*
+ *	g e t U B
+ */
+inline const real_t* Condenser::getUB( ) const
+{
+	return ub;
+}
+
+
+/*
+ *	g e t L B A
+ */
+inline const real_t* Condenser::getLBA( ) const
+{
+	return lbA;
+}
+
+
+/*
+ *	g e t U B A
+ */
+inline const real_t* Condenser::getUBA( ) const
+{
+	return ubA;
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
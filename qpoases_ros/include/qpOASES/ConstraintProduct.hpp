@@ -83,6 +83,31 @@ class ConstraintProduct
 									const real_t* const x,		/**< Array containing current primal iterate. */
 									real_t* const constrValue	/**< Output: Scalar value of the evaluated constraint. */
 									) const = 0;
+
+		/** Evaluates the products of a whole set of constraints with the current
+		 *	iterate in one call. The default implementation calls operator() for
+		 *	each index; derived classes may overwrite it to avoid the per-constraint
+		 *	virtual call and to evaluate the products vectorised.
+		 *	\return 0:         successful \n
+					otherwise: not successful */
+		virtual int_t evaluate(	int_t nConstr,						/**< Number of constraints to be evaluated. */
+								const int_t* const constrIndices,	/**< Numbers of constraints to be evaluated. */
+								const real_t* const x,				/**< Array containing current primal iterate. */
+								real_t* const constrValues			/**< Output: Contiguous values of the evaluated constraints,
+																	 *   i.e. constrValues[i] belongs to constrIndices[i]. */
+								) const
+		{
+			int_t i, ret;
+
+			for( i=0; i<nConstr; ++i )
+			{
+				ret = (*this)( constrIndices[i],x,&(constrValues[i]) );
+				if ( ret != 0 )
+					return ret;
+			}
+
+			return 0;
+		}
 };
 
 END_NAMESPACE_QPOASES
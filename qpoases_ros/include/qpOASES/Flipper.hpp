@@ -92,6 +92,7 @@ class Flipper
 
 
 		/** Copies current values to non-null arguments (assumed to be allocated with consistent size).
+		 *  Only the leading parts of the matrices saved by set() are overwritten.
 		 *	\return SUCCESSFUL_RETURN */
 		returnValue get(	Bounds* const _bounds,					/**< Pointer to new bounds. */
 							real_t* const R,						/**< New matrix R. */
@@ -100,7 +101,9 @@ class Flipper
 							real_t* const _T = 0					/**< New matrix T. */
 							) const;
 
-		/** Assigns new values to non-null arguments.
+		/** Assigns new values to non-null arguments. Only the leading columns of R and Q
+		 *  corresponding to free variables and the leading rows of T corresponding to
+		 *  active constraints are stored.
 		 *	\return SUCCESSFUL_RETURN */
 		returnValue set(	const Bounds* const _bounds,				/**< Pointer to new bounds. */
 							const real_t* const _R,						/**< New matrix R. */
@@ -123,6 +126,10 @@ class Flipper
 		returnValue copy(	const Flipper& rhs	/**< Rhs object. */
 							);
 
+		/** Returns number of rows (and columns) of matrix T.
+		 *  \return Number of rows of matrix T. */
+		uint_t getSizeT( ) const;
+
 		/** Returns dimension of matrix T.
 		 *  \return Dimension of matrix T. */
 		uint_t getDimT( ) const;
@@ -141,6 +148,10 @@ class Flipper
 		real_t* R;						/**< Cholesky factor of H (i.e. H = R^T*R). */
 		real_t* Q;						/**< Orthonormal quadratic matrix, A = [0 T]*Q'. */
 		real_t* T;						/**< Reverse triangular matrix, A = [0 T]*Q'. */
+
+		uint_t lenR;					/**< Number of leading entries of R currently stored. */
+		uint_t lenQ;					/**< Number of leading entries of Q currently stored. */
+		uint_t lenT;					/**< Number of leading entries of T currently stored. */
 };
 
 
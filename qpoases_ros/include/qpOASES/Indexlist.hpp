@@ -106,7 +106,8 @@ class Indexlist
 									) const;
 
 
-		/** Determines the index within the index list at which a given number is stored.
+		/** Determines the index within the index list at which a given number is stored
+		 *  (in constant time for numbers below the physical length).
 		 *	\return >= 0: Index of given number. \n
 		 			-1: Number not found. */
 		int_t getIndex(	int_t givennumber	/**< Number whose index shall be determined. */
@@ -165,6 +166,12 @@ class Indexlist
 		returnValue copy(	const Indexlist& rhs	/**< Rhs object. */
 							);
 
+		/** Copies all members from given rhs object of the same physical length
+		 *  into the already allocated arrays.
+		 *  \return SUCCESSFUL_RETURN */
+		returnValue copyInPlace(	const Indexlist& rhs	/**< Rhs object. */
+									);
+
 		/** Find first index j between -1 and length in sorted list of indices
 		 *  iSort such that numbers[iSort[j]] <= i < numbers[iSort[j+1]]. Uses
 		 *  bisection.
@@ -179,6 +186,7 @@ class Indexlist
 	protected:
 		int_t* number;			/**< Array to store numbers of constraints or bounds. */
 		int_t* iSort;			/**< Index list to sort vector \a number */
+		int_t* position;		/**< Physical index of each number below the physical length (-1 if not contained). */
 
 		int_t	length;			/**< Length of index list. */
 		int_t	first;			/**< Physical index of first element. */
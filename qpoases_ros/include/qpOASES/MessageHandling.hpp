@@ -227,10 +227,31 @@ RET_SIMPLE_STATUS_P1,							/**< QP problem could not be solved within given num
 RET_SIMPLE_STATUS_P0,							/**< QP problem solved. */
 RET_SIMPLE_STATUS_M1,							/**< QP problem could not be solved due to an internal error. */
 RET_SIMPLE_STATUS_M2,							/**< QP problem is infeasible (and thus could not be solved). */
-RET_SIMPLE_STATUS_M3							/**< QP problem is unbounded (and thus could not be solved). (150) */
+RET_SIMPLE_STATUS_M3,							/**< QP problem is unbounded (and thus could not be solved). (150) */
+/* Asynchronous output */
+RET_ASYNC_OUTPUT_START_FAILED,					/**< Unable to start output thread. */
+RET_ASYNC_OUTPUT_NOT_RUNNING,					/**< Output thread is not running. */
+RET_ASYNC_OUTPUT_MESSAGE_DROPPED,				/**< Output buffer full, message dropped. */
+/* Racing solver */
+RET_RACE_NOT_INITIALISED,						/**< Racing solver needs to be initialised with at least one candidate. */
+RET_RACE_START_FAILED,							/**< Unable to start thread of candidate solver, running it on calling thread. */
+RET_RACE_NO_WINNER,								/**< No candidate solver succeeded in solving the QP. */
+/* Solver service */
+RET_SERVICE_SETUP_FAILED,						/**< Unable to set up shared memory of solver service. */
+RET_SERVICE_ATTACH_FAILED,						/**< Unable to attach to channel of solver service. */
+RET_SERVICE_BUSY,								/**< All request slots (or matrix buffers) of solver service channel are in use. */
+RET_SERVICE_NO_REQUEST,							/**< No request has been submitted to solver service. */
+RET_SERVICE_IN_USE,								/**< Shared memory region of solver service belongs to a running server. */
+RET_SERVICE_TIMEOUT,							/**< Solver service did not answer request in time. */
+/* Active set predictor */
+RET_PREDICTION_NO_HISTORY,						/**< No working set has been recorded to predict from. */
+RET_PREDICTION_INVALID_DIMENSIONS				/**< Dimensions of QP do not match those of active set predictor. */
 };
 
 
+class AsyncOutput;
+
+
 /**
  *	\brief Handles all kind of error messages, warnings and other information.
  *
@@ -372,6 +393,10 @@ class MessageHandling
 		 *	\return Error count value. */
 		inline int_t getErrorCount( ) const;
 
+		/** Returns pointer to asynchronous output backend (0, if none).
+		 *	\return Pointer to asynchronous output backend. */
+		inline AsyncOutput* getAsyncOutput( ) const;
+
 
 		/** Changes visibility status for error messages. */
 		inline void setErrorVisibilityStatus(	VisibilityStatus _errorVisibility	/**< New visibility status for error messages. */
@@ -395,6 +420,11 @@ class MessageHandling
 		inline returnValue setErrorCount(	int_t _errorCount	/**< New error count value. */
 											);
 
+		/** Routes all output through given asynchronous backend (0 restores
+		 *  synchronous output). The backend is not owned and is kept by reset(). */
+		inline void setAsyncOutput(	AsyncOutput* _asyncOutput	/**< New asynchronous output backend. */
+									);
+
 		/** Provides message text corresponding to given \a returnValue.
 		 * \return String containing message text. */
 		static const char* getErrorCodeMessage(	const returnValue _returnValue
@@ -432,6 +462,8 @@ class MessageHandling
 		FILE* outputFile;						/**< Output file for messages. */
 
 		int_t errorCount; 						/**< Counts number of errors (for nicer output only). */
+
+		AsyncOutput* asyncOutput;				/**< Asynchronous output backend (0, if output is written synchronously). */
 };
 
 
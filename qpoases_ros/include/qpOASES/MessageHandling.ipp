@@ -85,6 +85,15 @@ inline int_t MessageHandling::getErrorCount( ) const
 }
 
 
+/*
+ *	g e t A s y n c O u t p u t
+ */
+inline AsyncOutput* MessageHandling::getAsyncOutput( ) const
+{
+ 	return asyncOutput;
+}
+
+
 /*
  *	s e t E r r o r V i s i b i l i t y S t a t u s
  */
@@ -121,6 +130,15 @@ inline void MessageHandling::setOutputFile( FILE* _outputFile )
 }
 
 
+/*
+ *	s e t A s y n c O u t p u t
+ */
+inline void MessageHandling::setAsyncOutput( AsyncOutput* _asyncOutput )
+{
+ 	asyncOutput = _asyncOutput;
+}
+
+
 /*
  *	s e t E r r o r C o u n t
  */
@@ -154,6 +154,7 @@ class Options
 		real_t epsNZCTests;						/**< Tolerance for nonzero curvature tests. */
 
 		real_t rcondSMin;						/**< Minimum reciprocal condition number of S before refactorization is triggered */
+		real_t schurResetCostRatio;				/**< Refactorization is triggered once the estimated flops of Schur complement updates and solves exceed this multiple of those of the last factorization (0: only when S is full). */
 		BooleanType enableInertiaCorrection;	/**< Specifies whether the working set should be repaired when negative curvature is discovered during hotstart. */
 
 		BooleanType enableDropInfeasibles;		/**< ... */
@@ -63,6 +63,12 @@ class QProblem : public QProblemB
 	/* allow SolutionAnalysis class to access private members */
 	friend class SolutionAnalysis;
 
+	/* allow RacingSolver class to restore options of its candidates */
+	friend class RacingSolver;
+
+	/* allow KktChecker class to read the cached products A*x and the working set */
+	friend class KktChecker;
+
 	/*
 	 *	PUBLIC MEMBER FUNCTIONS
 	 */
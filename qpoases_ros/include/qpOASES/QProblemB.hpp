@@ -65,6 +65,12 @@ class QProblemB
 	/* allow SolutionAnalysis class to access private members */
 	friend class SolutionAnalysis;
 
+	/* allow RacingSolver class to restore options of its candidates */
+	friend class RacingSolver;
+
+	/* allow KktChecker class to read the current iterate and the working set */
+	friend class KktChecker;
+
 	/*
 	 *	PUBLIC MEMBER FUNCTIONS
 	 */
@@ -431,6 +437,23 @@ class QProblemB
 		 *	\return SUCCESSFUL_RETURN. */
 		inline returnValue resetCounter( );
 
+		/** Returns the counters of internal solver events accumulated since
+		 *  the last call to resetStatistics() (or since construction).
+		 *	\return Solver statistics struct. */
+		inline SolverStatistics getStatistics( ) const;
+
+		/** Resets all counters of internal solver events (to zero).
+		 *	\return SUCCESSFUL_RETURN. */
+		inline returnValue resetStatistics( );
+
+		/** Sets a flag that allows to cancel the solution process from another
+		 *  thread: once the flag is non-zero, the current homotopy stops before
+		 *  its next iteration (as if the maximum number of working set
+		 *  recalculations were reached). Copies of the QP do not inherit the flag.
+		 *	\return SUCCESSFUL_RETURN */
+		inline returnValue setCancelFlag(	const int_t* const _cancelFlag	/**< Cancel flag (0 disables cancelling). */
+											);
+
 
 		/** Prints concise list of properties of the current QP.
 		 *	\return  SUCCESSFUL_RETURN \n */
@@ -483,6 +506,14 @@ class QProblemB
 		 *			RET_INDEXLIST_CORRUPTED */
 		virtual returnValue computeCholesky( );
 
+		/** Copies the upper triangle of the leading nR columns of a full, column-wise
+		 *  stored nV x nV matrix into R (which might be stored in compact form,
+		 *  see __COMPACT_FACTORS__); all other entries of R are set to zero.
+		 *	\return SUCCESSFUL_RETURN */
+		returnValue packR(	const real_t* const Rfull,	/**< Full nV x nV matrix. */
+							int_t nR					/**< Number of leading columns to be copied. */
+							);
+
 
 		/** Computes initial Cholesky decomposition of the (simply projected) Hessian
 		 *  making use of the function computeCholesky().
@@ -614,7 +645,13 @@ class QProblemB
 											);
 
 
-		/** Determines if next QP iteration can be performed within given CPU time limit.
+		/** Determines if the solution process has been cancelled via the cancel flag.
+		 *	\return BT_TRUE: solution process has been cancelled. \n
+					BT_FALSE: otherwise. */
+		inline BooleanType isCancelled( ) const;
+
+		/** Determines if next QP iteration can be performed within given CPU time limit
+		 *  (and the solution process has not been cancelled).
 		 *	\return BT_TRUE: CPU time limit is exceeded, stop QP solution. \n
 					BT_FALSE: Sufficient CPU time for next QP iteration. */
 		BooleanType isCPUtimeLimitExceeded(	const real_t* const cputime,	/**< Maximum CPU time allowed for QP solution. */
@@ -1006,6 +1043,9 @@ class QProblemB
 		Flipper flipper;			/**< Struct for making a temporary copy of the matrix factorisations. */
 
 		TabularOutput tabularOutput;	/**< Struct storing information for tabular output (printLevel == PL_TABULAR). */
+		SolverStatistics statistics;	/**< Struct storing counters of internal solver events. */
+
+		const int_t* cancelFlag;		/**< Flag for cancelling the solution process from another thread (0, if none). */
 };
 
 
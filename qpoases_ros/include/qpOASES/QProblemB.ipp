@@ -229,10 +229,71 @@ inline returnValue QProblemB::resetCounter( )
 }
 
 
+/*
+ *	g e t S t a t i s t i c s
+ */
+inline SolverStatistics QProblemB::getStatistics( ) const
+{
+	return statistics;
+}
+
+
+/*
+ *	r e s e t S t a t i s t i c s
+ */
+inline returnValue QProblemB::resetStatistics( )
+{
+	statistics.nAddedBounds         = 0;
+	statistics.nRemovedBounds       = 0;
+	statistics.nAddedConstraints    = 0;
+	statistics.nRemovedConstraints  = 0;
+	statistics.nFlips               = 0;
+	statistics.nRefactorisations    = 0;
+	statistics.nRegularisationSteps = 0;
+	statistics.nDriftCorrections    = 0;
+	statistics.nRampings            = 0;
+	statistics.nFarBoundGrowths     = 0;
+	statistics.nInertiaCorrections  = 0;
+	statistics.nHomotopyIterations  = 0;
+	statistics.homotopyLength       = 0.0;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s e t C a n c e l F l a g
+ */
+inline returnValue QProblemB::setCancelFlag( const int_t* const _cancelFlag )
+{
+	cancelFlag = _cancelFlag;
+	return SUCCESSFUL_RETURN;
+}
+
+
 /*****************************************************************************
  *  P R O T E C T E D                                                        *
  *****************************************************************************/
 
+/*
+ *	i s C a n c e l l e d
+ */
+inline BooleanType QProblemB::isCancelled( ) const
+{
+	if ( cancelFlag == 0 )
+		return BT_FALSE;
+
+	#ifndef __NO_THREADS__
+	if ( __atomic_load_n( cancelFlag,__ATOMIC_RELAXED ) != 0 )
+	#else
+	if ( *cancelFlag != 0 )
+	#endif
+		return BT_TRUE;
+	else
+		return BT_FALSE;
+}
+
+
 /*
  *	s e t H
  */
@@ -344,6 +344,19 @@ class SQProblemSchur : public SQProblem
 		/** Update QR factorization and determinant of Schur complement after a row and column have been added or removed */
 		returnValue updateSchurQR( int_t idxDel );
 
+		/** Applies a sequence of Givens rotations to pairs of columns of Q**T. */
+		void applySchurRotations(	int_t nRows,						/**< Number of rows of Q**T to be transformed. */
+									int_t nRotations,					/**< Number of rotations. */
+									const real_t* const rotations,		/**< Triples (c,s,nu) of each rotation. */
+									const int_t* const rotationCols		/**< Pairs of columns transformed by each rotation. */
+									);
+
+		/** Determines whether resetting the Schur complement is cheaper than continuing to update it,
+		 *  i.e. whether the estimated flops spent on updates and solves since the last factorization
+		 *  exceed options.schurResetCostRatio times the estimated flops of that factorization.
+		 *	\return BT_TRUE iff Schur complement should be reset */
+		inline BooleanType isSchurResetDue( ) const;
+
 		/** Compute the solution to QRx = rhs and store it in sol */
 		returnValue backsolveSchurQR( int_t dimS, const real_t* const rhs, int_t dimRhs, real_t* const sol );
 
@@ -400,6 +413,9 @@ class SQProblemSchur : public SQProblem
 		real_t detS;						/**< Determinant of Schur complement */
 		real_t rcondS;						/**< Reciprocal of condition number of S (estimate) */
 		int_t numFactorizations;			/**< Total number of factorizations performed */
+		int_t nnzKKT;						/**< Number of nonzeros of the last factorized KKT matrix */
+		real_t resetCost;					/**< Estimated flops of last factorization of the KKT matrix */
+		real_t schurCost;					/**< Estimated flops spent on Schur complement updates and solves since last factorization */
 
 		int_t* schurUpdateIndex;			/**< Indices of variables or constraints for each update in Schur complement. */
 		SchurUpdateType* schurUpdate;		/**< Type of update for each update in Schur complement. */
@@ -49,6 +49,26 @@ inline int_t SQProblemSchur::getNumFactorizations( ) const
 	return numFactorizations;
 }
 
+
+/*****************************************************************************
+ *  P R O T E C T E D                                                        *
+ *****************************************************************************/
+
+/*
+ *	i s S c h u r R e s e t D u e
+ */
+inline BooleanType SQProblemSchur::isSchurResetDue( ) const
+{
+	if ( ( options.schurResetCostRatio <= 0.0 ) || ( nS <= 0 ) )
+		return BT_FALSE;
+
+	if ( schurCost > options.schurResetCostRatio * resetCost )
+		return BT_TRUE;
+	else
+		return BT_FALSE;
+}
+
+
 END_NAMESPACE_QPOASES
 
 
@@ -0,0 +1,92 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file include/qpOASES/SimdKernels.hpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Declaration of the vectorised kernels used by the BLAS/LAPACK replacement
+ *	and of the functions selecting their instruction set variant at runtime.
+ */
+
+
+#ifndef QPOASES_SIMDKERNELS_HPP
+#define QPOASES_SIMDKERNELS_HPP
+
+
+#include <qpOASES/MessageHandling.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/** Returns the most capable instruction set variant supported by the CPU
+ *  and operating system (determined once via CPUID).
+ *	\return SV_AVX512, SV_AVX2, SV_SSE2 or SV_SCALAR (if not on x86) */
+SimdVariant getSupportedSimdVariant( );
+
+/** Returns the instruction set variant currently used by the kernels
+ *  (by default the most capable supported one).
+ *	\return Active instruction set variant. */
+SimdVariant getSimdVariant( );
+
+/** Selects the instruction set variant used by the kernels, e.g. SV_SCALAR for
+ *  results bitwise identical to the original replacement loops.
+ *	\return SUCCESSFUL_RETURN \n
+			RET_INVALID_ARGUMENTS (variant not supported) */
+returnValue setSimdVariant(	SimdVariant variant		/**< Instruction set variant. */
+							);
+
+/** Returns the name of an instruction set variant.
+ *	\return Null-terminated name ("scalar", "sse2", "avx2" or "avx512"). */
+const char* getSimdVariantName(	SimdVariant variant		/**< Instruction set variant. */
+								);
+
+
+/** Computes the dot product x'*y with the active instruction set variant.
+ *	\return Dot product. */
+double simdDot(	la_uint_t n,			/**< Length of vectors. */
+				const double* const x,	/**< First vector. */
+				const double* const y	/**< Second vector. */
+				);
+
+/** Computes y += alpha*x with the active instruction set variant. */
+void simdAxpy(	la_uint_t n,			/**< Length of vectors. */
+				double alpha,			/**< Scaling factor. */
+				const double* const x,	/**< Vector to be added. */
+				double* const y			/**< Input: Vector to be updated; \n
+											 Output: Updated vector. */
+				);
+
+
+END_NAMESPACE_QPOASES
+
+
+#endif	/* QPOASES_SIMDKERNELS_HPP */
+
+
+/*
+ *	end of file
+ */
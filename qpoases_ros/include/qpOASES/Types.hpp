@@ -125,6 +125,16 @@
 #endif
 
 
+/* Background threads (e.g. for asynchronous output) rely on POSIX threads;
+ * they are not used on embedded platforms or within Matlab/Windows builds.
+ * Define __NO_THREADS__ to disable them explicitly. */
+#if defined(__DSPACE__) || defined(__XPCTARGET__) || defined(__MATLAB__) || defined(_MSC_VER) || defined(WIN32)
+  #ifndef __NO_THREADS__
+    #define __NO_THREADS__
+  #endif
+#endif
+
+
 #ifdef __NO_SNPRINTF__
   #if (!defined(_MSC_VER)) || defined(__DSPACE__) || defined(__XPCTARGET__)
     /* If snprintf is not available, provide an empty implementation... */
@@ -137,15 +147,46 @@
 
 
 
+#ifndef __COMPACT_FACTORS__
+
 /** Macro for accessing the Cholesky factor R. */
 #define RR( I,J )  R[(I)+nV*(J)]
 
-/** Macro for accessing the orthonormal matrix Q of the QT factorisation. */
-#define QQ( I,J )  Q[(I)+nV*(J)]
-
 /** Macro for accessing the triangular matrix T of the QT factorisation. */
 #define TT( I,J )  T[(I)*sizeT+(J)]
 
+/** Number of entries spanned by the leading N columns of R. */
+#define RR_SIZE( NV,N )  ( (N)*(NV) )
+
+/** Number of entries spanned by the leading N rows of T. */
+#define TT_SIZE( ST,N )  ( (N)*(ST) )
+
+#else /* __COMPACT_FACTORS__ */
+
+/* Compact storage of the factors: only the upper Hessenberg part of R and the
+ * reverse upper Hessenberg part of T (i.e. the triangle plus the one (anti-)
+ * subdiagonal used by the Givens updates) are stored, which roughly halves
+ * the memory needed for both matrices. */
+
+/** Macro for accessing the Cholesky factor R
+ *  (stored column-wise, column J holds rows 0,...,J+1). */
+#define RR( I,J )  R[(I)+(((J)*((J)+3))/2)]
+
+/** Macro for accessing the triangular matrix T of the QT factorisation
+ *  (stored row-wise, row I holds columns sizeT-2-I,...,sizeT-1). */
+#define TT( I,J )  T[(((I)*((I)+5))/2)+(J)+2-sizeT]
+
+/** Number of entries spanned by the leading N columns of R. */
+#define RR_SIZE( NV,N )  ( ((N)*((N)+3))/2 )
+
+/** Number of entries spanned by the leading N rows of T. */
+#define TT_SIZE( ST,N )  ( ((N)*((N)+3))/2 )
+
+#endif /* __COMPACT_FACTORS__ */
+
+/** Macro for accessing the orthonormal matrix Q of the QT factorisation. */
+#define QQ( I,J )  Q[(I)+nV*(J)]
+
 
 /* If neither MA57 nor MA27 are selected, activate the dummy solver */
 #if !defined(SOLVER_MA27) && !defined(SOLVER_MA57) && !defined(SOLVER_NONE)
@@ -289,6 +330,33 @@ enum SchurUpdateType
 	SUT_UNDEFINED			/**< Type of Schur update is undefined. */
 };
 
+/** Strategy used by the ActiveSetPredictor to guess the next working set. */
+enum PredictionMode
+{
+	PM_MARKOV,				/**< Most frequent successor of the last working set. */
+	PM_NEARESTNEIGHBOUR		/**< Working set recorded for the nearest parameter vector. */
+};
+
+/** Instruction set variant of the vectorised kernels of the BLAS/LAPACK replacement. */
+enum SimdVariant
+{
+	SV_SCALAR,				/**< Plain loops (bitwise identical to the original replacement). */
+	SV_SSE2,				/**< SSE2 kernels. */
+	SV_AVX2,				/**< AVX2 kernels with fused multiply-add. */
+	SV_AVX512				/**< AVX-512 kernels with fused multiply-add. */
+};
+
+/** Blocks of the variance-covariance matrices handled by the SolutionAnalysis
+ *  (inputs and outputs are partitioned alike; values may be combined bitwise). */
+enum CovarianceBlock
+{
+	CB_NONE = 0,			/**< No block. */
+	CB_VARIABLES = 1,		/**< Gradient g (input) or primal variables x (output). */
+	CB_BOUNDS = 2,			/**< Bounds lb/ub (input) or dual variables of bounds (output). */
+	CB_CONSTRAINTS = 4,		/**< Constraints lbA/ubA (input) or dual variables of constraints (output). */
+	CB_ALL = 7				/**< All blocks. */
+};
+
 /**
  *	\brief Stores internal information for tabular (debugging) output.
  *
@@ -311,6 +379,33 @@ struct TabularOutput {
 };
 
 
+/**
+ *	\brief Stores counters of internal solver events.
+ *
+ *	Struct storing cumulative counts of working set changes and of the
+ *	numerical safeguards triggered while solving a QP sequence with the
+ *	(S)QProblem(B) objects. All counters are plain increments (no timing,
+ *	no output), so they are kept in any build configuration and can be
+ *	queried after each hotstart to tune the Options struct.
+ */
+struct SolverStatistics {
+	uint_t nAddedBounds;			/**< Number of bounds added to the working set. */
+	uint_t nRemovedBounds;			/**< Number of bounds removed from the working set. */
+	uint_t nAddedConstraints;		/**< Number of constraints added to the working set. */
+	uint_t nRemovedConstraints;		/**< Number of constraints removed from the working set. */
+	uint_t nFlips;					/**< Number of bound/constraint flips (flipping bounds strategy). */
+	uint_t nRefactorisations;		/**< Number of matrix factorisations computed afresh instead of updated (periodic refactorisations,
+											 working sets set up from a guess, Schur complement resets); counted in init() as well as in hotstart(). */
+	uint_t nRegularisationSteps;	/**< Number of successive regularisation steps performed. */
+	uint_t nDriftCorrections;		/**< Number of drift corrections performed. */
+	uint_t nRampings;				/**< Number of ramping strategy applications on zero homotopy steps. */
+	uint_t nFarBoundGrowths;		/**< Number of times the far bounds have been grown. */
+	uint_t nInertiaCorrections;		/**< Number of working set exchanges/corrections performed to keep a regular projected Hessian. */
+	uint_t nHomotopyIterations;		/**< Number of homotopy iterations (working set recalculations) performed. */
+	real_t homotopyLength;			/**< Relative homotopy length at the last homotopy iteration. */
+};
+
+
 
 /**
  *	\brief Struct containing the variable header for mat file.
@@ -0,0 +1,203 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file include/qpOASES/WorkingSet.hpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Declaration of the WorkingSet class, a compact bitset representation of
+ *	the status of all bounds and constraints.
+ */
+
+
+#ifndef QPOASES_WORKINGSET_HPP
+#define QPOASES_WORKINGSET_HPP
+
+
+#include <qpOASES/Bounds.hpp>
+#include <qpOASES/Constraints.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/**
+ *	\brief Compact representation of a working set.
+ *
+ *	Stores the status of nV bounds followed by nC constraints in two bitsets:
+ *	one flagging active entries and one flagging entries at their upper bound
+ *	(inactive and lower bounded entries are its complement). Membership and
+ *	status queries take constant time, while comparisons, counting and hashing
+ *	process one machine word per 32 entries. This makes it cheap to keep many
+ *	working sets in caches or to take snapshots.
+ *
+ *	The order of the index lists, which determines the factorisations, is not
+ *	represented; working sets are restored as guesses for hotstarts.
+ *
+ *	\version 3.2
+ *	\date 2018
+ */
+class WorkingSet
+{
+	/*
+	 *	PUBLIC MEMBER FUNCTIONS
+	 */
+	public:
+		/** Default constructor. */
+		WorkingSet( );
+
+		/** Constructor which takes the number of bounds and constraints. */
+		WorkingSet(	int_t _nV,			/**< Number of bounds. */
+					int_t _nC = 0		/**< Number of constraints. */
+					);
+
+		/** Copy constructor (deep copy). */
+		WorkingSet(	const WorkingSet& rhs	/**< Rhs object. */
+					);
+
+		/** Destructor. */
+		~WorkingSet( );
+
+		/** Assignment operator (deep copy). */
+		WorkingSet& operator=(	const WorkingSet& rhs	/**< Rhs object. */
+								);
+
+
+		/** Initialises object with given dimensions, all entries inactive.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_INVALID_ARGUMENTS */
+		returnValue init(	int_t _nV = 0,		/**< Number of bounds. */
+							int_t _nC = 0		/**< Number of constraints. */
+							);
+
+		/** Marks all entries inactive.
+		 *	\return SUCCESSFUL_RETURN */
+		returnValue reset( );
+
+
+		/** Reads the status of all bounds (and constraints).
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_INVALID_ARGUMENTS */
+		returnValue set(	const Bounds* const bounds,					/**< Bounds to be read. */
+							const Constraints* const constraints = 0	/**< Constraints to be read (only if nC > 0). */
+							);
+
+		/** Reads a working set as returned by QProblemB::getWorkingSet
+		 *  (-1: at lower bound, 0: inactive, +1: at upper bound).
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_INVALID_ARGUMENTS */
+		returnValue set(	const real_t* const workingSet		/**< Working set of bounds followed by constraints (nV+nC). */
+							);
+
+		/** Initialises given bounds (and constraints) with the stored status,
+		 *  e.g. as guessed working set for a hotstart.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_INVALID_ARGUMENTS */
+		returnValue get(	Bounds* const bounds,					/**< Output: Bounds with stored status. */
+							Constraints* const constraints = 0		/**< Output: Constraints with stored status (only if nC > 0). */
+							) const;
+
+
+		/** Sets the status of an entry (infeasible statuses are stored as the
+		 *  corresponding active status, undefined ones as inactive). */
+		inline void setStatus(	int_t number,				/**< Number of entry (bounds first, then constraints). */
+								SubjectToStatus _status		/**< New status. */
+								);
+
+		/** Returns the status of an entry.
+		 *	\return ST_LOWER, ST_INACTIVE or ST_UPPER */
+		inline SubjectToStatus getStatus(	int_t number	/**< Number of entry (bounds first, then constraints). */
+											) const;
+
+		/** Returns if an entry is active.
+		 *	\return BT_TRUE iff entry is active */
+		inline BooleanType isActive(	int_t number		/**< Number of entry (bounds first, then constraints). */
+										) const;
+
+
+		/** Returns number of bounds.
+		 *	\return Number of bounds. */
+		inline int_t getNV( ) const;
+
+		/** Returns number of constraints.
+		 *	\return Number of constraints. */
+		inline int_t getNC( ) const;
+
+		/** Returns number of active entries.
+		 *	\return Number of active bounds and constraints. */
+		int_t getNumActive( ) const;
+
+		/** Returns number of entries whose status differs from the given working set.
+		 *	\return Number of differing entries (or -1 on dimension mismatch). */
+		int_t getNumDifferences(	const WorkingSet& rhs	/**< Working set to compare with. */
+									) const;
+
+		/** Returns if the given working set is identical.
+		 *	\return BT_TRUE iff dimensions and all statuses coincide */
+		BooleanType isEqual(	const WorkingSet& rhs	/**< Working set to compare with. */
+								) const;
+
+		/** Returns a hash of the working set (FNV-1a over the bitsets).
+		 *	\return Hash value. */
+		uint_t getHash( ) const;
+
+
+	/*
+	 *	PROTECTED MEMBER FUNCTIONS
+	 */
+	protected:
+		/** Frees all allocated memory.
+		 *	\return SUCCESSFUL_RETURN */
+		returnValue clear( );
+
+		/** Copies all members from given rhs object.
+		 *	\return SUCCESSFUL_RETURN */
+		returnValue copy(	const WorkingSet& rhs	/**< Rhs object. */
+							);
+
+
+	/*
+	 *	PROTECTED MEMBER VARIABLES
+	 */
+	protected:
+		int_t nV;					/**< Number of bounds. */
+		int_t nC;					/**< Number of constraints. */
+		int_t nWords;				/**< Number of words of each bitset. */
+
+		uint_t* active;				/**< Bitset flagging active entries. */
+		uint_t* upper;				/**< Bitset flagging entries at their upper bound. */
+};
+
+
+END_NAMESPACE_QPOASES
+
+#include <qpOASES/WorkingSet.ipp>
+
+#endif	/* QPOASES_WORKINGSET_HPP */
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,126 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/**
+ *	\file include/qpOASES/WorkingSet.ipp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Implementation of inlined member functions of the WorkingSet class, a
+ *	compact bitset representation of the status of all bounds and constraints.
+ */
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/** Number of entries stored per word of a bitset. */
+#define QPOASES_WORKINGSET_BITS ( 8*sizeof(uint_t) )
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	s e t S t a t u s
+ */
+inline void WorkingSet::setStatus( int_t number, SubjectToStatus _status )
+{
+	uint_t word = ( (uint_t)number ) / QPOASES_WORKINGSET_BITS;
+	uint_t mask = ( (uint_t)1 ) << ( ( (uint_t)number ) % QPOASES_WORKINGSET_BITS );
+
+	switch ( _status )
+	{
+		case ST_LOWER:
+		case ST_INFEASIBLE_LOWER:
+			active[word] |= mask;
+			upper[word]  &= ~mask;
+			break;
+
+		case ST_UPPER:
+		case ST_INFEASIBLE_UPPER:
+			active[word] |= mask;
+			upper[word]  |= mask;
+			break;
+
+		default:
+			active[word] &= ~mask;
+			upper[word]  &= ~mask;
+			break;
+	}
+}
+
+
+/*
+ *	g e t S t a t u s
+ */
+inline SubjectToStatus WorkingSet::getStatus( int_t number ) const
+{
+	uint_t word = ( (uint_t)number ) / QPOASES_WORKINGSET_BITS;
+	uint_t mask = ( (uint_t)1 ) << ( ( (uint_t)number ) % QPOASES_WORKINGSET_BITS );
+
+	if ( ( active[word] & mask ) == 0 )
+		return ST_INACTIVE;
+
+	return ( ( upper[word] & mask ) != 0 ) ? ST_UPPER : ST_LOWER;
+}
+
+
+/*
+ *	i s A c t i v e
+ */
+inline BooleanType WorkingSet::isActive( int_t number ) const
+{
+	uint_t word = ( (uint_t)number ) / QPOASES_WORKINGSET_BITS;
+	uint_t mask = ( (uint_t)1 ) << ( ( (uint_t)number ) % QPOASES_WORKINGSET_BITS );
+
+	return ( ( active[word] & mask ) != 0 ) ? BT_TRUE : BT_FALSE;
+}
+
+
+/*
+ *	g e t N V
+ */
+inline int_t WorkingSet::getNV( ) const
+{
+	return nV;
+}
+
+
+/*
+ *	g e t N C
+ */
+inline int_t WorkingSet::getNC( ) const
+{
+	return nC;
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,238 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file include/qpOASES/extras/ActiveSetPredictor.hpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Declaration of the ActiveSetPredictor class which guesses the optimal
+ *	working set of the next QP of a sequence from the working sets of the
+ *	previous ones.
+ */
+
+
+#ifndef QPOASES_ACTIVESETPREDICTOR_HPP
+#define QPOASES_ACTIVESETPREDICTOR_HPP
+
+
+#include <qpOASES/QProblem.hpp>
+#include <qpOASES/WorkingSet.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/**
+ *	\brief Predicts working sets of a QP sequence from its history.
+ *
+ *	A plain hotstart always starts from the working set of the previous QP.
+ *	For sequences that run through recurring patterns (e.g. the phases of a
+ *	gait), the optimal working set of the next QP is often one that has been
+ *	seen before. The predictor records the optimal working sets of the last
+ *	ticks (each with an optional parameter vector, e.g. the gait phase or the
+ *	current state) and guesses the next one either as the most frequent
+ *	successor of the last working set (first-order Markov model) or as the
+ *	working set recorded for the nearest parameter vector.
+ *
+ *	The guesses can be passed to init() or hotstart() of the QP, or the
+ *	hotstart() function of the predictor can be used, which predicts,
+ *	solves and records in one go.
+ *
+ *	\version 3.2
+ *	\date 2018
+ */
+class ActiveSetPredictor
+{
+	/*
+	 *	PUBLIC MEMBER FUNCTIONS
+	 */
+	public:
+		/** Constructor which takes the QP dimensions, the number of parameters
+		 *  and the number of ticks to be remembered. */
+		ActiveSetPredictor(	int_t _nV,								/**< Number of variables. */
+							int_t _nC,								/**< Number of constraints. */
+							int_t _nP = 0,							/**< Number of parameters recorded with each working set. */
+							uint_t _capacity = 64,					/**< Number of ticks to be remembered. */
+							PredictionMode _mode = PM_MARKOV		/**< Prediction mode. */
+							);
+
+		/** Destructor. */
+		~ActiveSetPredictor( );
+
+
+		/** Forgets all recorded working sets.
+		 *	\return SUCCESSFUL_RETURN */
+		returnValue reset( );
+
+		/** Sets prediction mode (nearest neighbour lookup requires parameters).
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_INVALID_ARGUMENTS */
+		returnValue setMode(	PredictionMode _mode		/**< Prediction mode. */
+								);
+
+		/** Records the current working set of a QP (which shall be optimal).
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_PREDICTION_INVALID_DIMENSIONS \n
+					RET_INVALID_ARGUMENTS */
+		returnValue record(	QProblemB* const qp,			/**< QP whose working set is recorded. */
+							const real_t* const p = 0		/**< Parameters of the QP (only needed if nP > 0). */
+							);
+
+		/** Predicts the optimal working set of the next QP.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_PREDICTION_NO_HISTORY \n
+					RET_INVALID_ARGUMENTS */
+		returnValue predict(	Bounds* const guessedBounds,					/**< Output: Guessed working set of bounds. */
+								Constraints* const guessedConstraints = 0,		/**< Output: Guessed working set of constraints (only if nC > 0). */
+								const real_t* const p = 0						/**< Parameters of the next QP (only needed for nearest neighbour lookup). */
+								);
+
+		/** Solves the next QP of the sequence by a hotstart from the predicted
+		 *  working set (or from the previous one if nothing can be predicted)
+		 *  and records its working set if it has been solved.
+		 *	\return Return value of QProblemB::hotstart() \n
+					RET_PREDICTION_INVALID_DIMENSIONS */
+		returnValue hotstart(	QProblemB* const qp,			/**< QP to be solved. */
+								const real_t* const g_new,		/**< Gradient of neighbouring QP to be solved. */
+								const real_t* const lb_new,		/**< Lower bounds of neighbouring QP to be solved. */
+								const real_t* const ub_new,		/**< Upper bounds of neighbouring QP to be solved. */
+								int_t& nWSR,					/**< Input: Maximum number of working set recalculations; \n
+																	 Output: Number of performed working set recalculations. */
+								real_t* const cputime = 0,		/**< Input: Maximum CPU time allowed for QP solution. \n
+																	 Output: CPU time spent for QP solution. */
+								const real_t* const p = 0		/**< Parameters of neighbouring QP to be solved. */
+								);
+
+		/** Solves the next QP of the sequence by a hotstart from the predicted
+		 *  working set (or from the previous one if nothing can be predicted)
+		 *  and records its working set if it has been solved.
+		 *	\return Return value of QProblem::hotstart() \n
+					RET_PREDICTION_INVALID_DIMENSIONS */
+		returnValue hotstart(	QProblem* const qp,				/**< QP to be solved. */
+								const real_t* const g_new,		/**< Gradient of neighbouring QP to be solved. */
+								const real_t* const lb_new,		/**< Lower bounds of neighbouring QP to be solved. */
+								const real_t* const ub_new,		/**< Upper bounds of neighbouring QP to be solved. */
+								const real_t* const lbA_new,	/**< Lower constraints' bounds of neighbouring QP to be solved. */
+								const real_t* const ubA_new,	/**< Upper constraints' bounds of neighbouring QP to be solved. */
+								int_t& nWSR,					/**< Input: Maximum number of working set recalculations; \n
+																	 Output: Number of performed working set recalculations. */
+								real_t* const cputime = 0,		/**< Input: Maximum CPU time allowed for QP solution. \n
+																	 Output: CPU time spent for QP solution. */
+								const real_t* const p = 0		/**< Parameters of neighbouring QP to be solved. */
+								);
+
+
+		/** Returns prediction mode.
+		 *	\return Prediction mode. */
+		inline PredictionMode getMode( ) const;
+
+		/** Returns number of ticks currently remembered.
+		 *	\return Number of ticks. */
+		inline uint_t getNumRecorded( ) const;
+
+		/** Returns number of distinct working sets currently remembered.
+		 *	\return Number of working sets. */
+		inline uint_t getNumWorkingSets( ) const;
+
+		/** Returns number of hotstarts started from a predicted working set
+		 *  that differed from the previous one.
+		 *	\return Number of guided hotstarts. */
+		inline uint_t getNumGuided( ) const;
+
+
+	/*
+	 *	PROTECTED MEMBER FUNCTIONS
+	 */
+	protected:
+		/** Reads the current working set of a QP into the workspace.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_PREDICTION_INVALID_DIMENSIONS */
+		returnValue readWorkingSet(	QProblemB* const qp		/**< QP whose working set is read. */
+									);
+
+		/** Looks up the working set in the workspace among the remembered ones.
+		 *	\return Number of working set (or -1 if not found). */
+		int_t findWorkingSet(	uint_t hash				/**< Hash of the working set. */
+								) const;
+
+		/** Determines the working set to be predicted.
+		 *	\return Number of working set (or -1 if nothing recorded). */
+		int_t selectWorkingSet(	const real_t* const p	/**< Parameters of the next QP. */
+								);
+
+
+	/*
+	 *	PRIVATE MEMBER FUNCTIONS
+	 */
+	private:
+		/** Copy constructor (not allowed). */
+		ActiveSetPredictor(	const ActiveSetPredictor& rhs	/**< Rhs object. */
+							);
+
+		/** Assignment operator (not allowed). */
+		ActiveSetPredictor& operator=(	const ActiveSetPredictor& rhs	/**< Rhs object. */
+										);
+
+
+	/*
+	 *	PROTECTED MEMBER VARIABLES
+	 */
+	protected:
+		int_t nV;								/**< Number of variables. */
+		int_t nC;								/**< Number of constraints. */
+		int_t nP;								/**< Number of parameters recorded with each working set. */
+		uint_t capacity;						/**< Number of ticks to be remembered. */
+		PredictionMode mode;					/**< Prediction mode. */
+
+		int_t* history;							/**< Working set of each remembered tick (ring buffer, oldest first). */
+		real_t* historyParams;					/**< Parameters of each remembered tick (capacity*nP). */
+		uint_t historyStart;					/**< Position of oldest tick within ring buffer. */
+		uint_t nRecorded;						/**< Number of remembered ticks. */
+
+		WorkingSet* workingSets;				/**< Status of all bounds and constraints of each remembered working set (capacity). */
+		uint_t* workingSetHash;					/**< Hash of each remembered working set. */
+		uint_t* workingSetRefs;					/**< Number of remembered ticks referring to each working set (0: unused). */
+		uint_t nWorkingSets;					/**< Number of distinct working sets remembered. */
+
+		real_t* workingSet;						/**< Workspace for reading working sets of QPs (nV+nC). */
+		WorkingSet current;						/**< Workspace holding the status of a working set. */
+		uint_t* counts;							/**< Workspace for counting successors of a working set (capacity). */
+
+		Bounds guessedBounds;					/**< Guessed working set of bounds passed to hotstarts. */
+		Constraints guessedConstraints;			/**< Guessed working set of constraints passed to hotstarts. */
+		uint_t nGuided;							/**< Number of hotstarts started from a predicted working set. */
+};
+
+
+END_NAMESPACE_QPOASES
+
+#include <qpOASES/extras/ActiveSetPredictor.ipp>
+
+#endif	/* QPOASES_ACTIVESETPREDICTOR_HPP */
+
+
+/*
+ *	end of file
+ */
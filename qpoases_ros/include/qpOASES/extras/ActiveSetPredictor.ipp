@@ -0,0 +1,84 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file include/qpOASES/extras/ActiveSetPredictor.ipp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Implementation of inlined member functions of the ActiveSetPredictor class.
+ */
+
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	g e t M o d e
+ */
+inline PredictionMode ActiveSetPredictor::getMode( ) const
+{
+	return mode;
+}
+
+
+/*
+ *	g e t N u m R e c o r d e d
+ */
+inline uint_t ActiveSetPredictor::getNumRecorded( ) const
+{
+	return nRecorded;
+}
+
+
+/*
+ *	g e t N u m W o r k i n g S e t s
+ */
+inline uint_t ActiveSetPredictor::getNumWorkingSets( ) const
+{
+	return nWorkingSets;
+}
+
+
+/*
+ *	g e t N u m G u i d e d
+ */
+inline uint_t ActiveSetPredictor::getNumGuided( ) const
+{
+	return nGuided;
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,248 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file include/qpOASES/extras/KktChecker.hpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Declaration of the KktChecker class for cheap checks of the
+ *	KKT optimality conditions after each (hot)start.
+ */
+
+
+#ifndef QPOASES_KKTCHECKER_HPP
+#define QPOASES_KKTCHECKER_HPP
+
+
+#include <qpOASES/QProblem.hpp>
+
+#ifndef __NO_THREADS__
+  #include <pthread.h>
+#endif
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/**
+ *	\brief Checks the KKT optimality conditions of the current iterate of a QP.
+ *
+ *	Unlike getKktViolation() in Utils and SolutionAnalysis, no dense copies of
+ *	the QP matrices are formed and nothing is recomputed that the solver keeps
+ *	anyway: feasibility and complementarity of the constraints are read from the
+ *	cached products A*x, and the working set is read from the status of bounds
+ *	and constraints. Only the stationarity residual g + H*x - y_B - A'*y_C is
+ *	evaluated, with A'*y_C taken over the active constraints only.
+ *
+ *	The stationarity residual may be split between several threads. The
+ *	worker threads are started once together with the workspace and wait for
+ *	the next check in between, so a check costs two condition variable round
+ *	trips instead of creating and joining threads. If a
+ *	tolerance is set, the cheap conditions are checked first and the check
+ *	stops as soon as one of them is exceeded.
+ *
+ *	Only solved QPs are checked. After an interrupted (hot)start, e.g. when
+ *	the nWSR limit was hit, the QP object stores the data of an intermediate
+ *	QP on the homotopy path rather than those passed by the caller, so the
+ *	KKT conditions are reported as violated (INFTY).
+ *
+ *	\version 3.2
+ *	\date 2018
+ */
+class KktChecker
+{
+	/*
+	 *	PUBLIC MEMBER FUNCTIONS
+	 */
+	public:
+		/** Constructor which takes the number of threads and the early exit tolerance. */
+		KktChecker(	uint_t _nThreads = 1,		/**< Number of threads (including the calling one). */
+					real_t _tolerance = 0.0		/**< Early exit tolerance (0: always evaluate all conditions). */
+					);
+
+		/** Destructor. */
+		~KktChecker( );
+
+
+		/** Sets number of threads used to evaluate the stationarity residual
+		 *  (including the calling one, 1: no additional threads).
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_INVALID_ARGUMENTS */
+		returnValue setNumThreads(	uint_t _nThreads		/**< Number of threads. */
+									);
+
+		/** Sets tolerance for early exit (0: always evaluate all conditions).
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_INVALID_ARGUMENTS */
+		returnValue setTolerance(	real_t _tolerance		/**< Early exit tolerance. */
+									);
+
+		/** Returns number of threads.
+		 *	\return Number of threads. */
+		inline uint_t getNumThreads( ) const;
+
+		/** Returns early exit tolerance.
+		 *	\return Early exit tolerance. */
+		inline real_t getTolerance( ) const;
+
+
+		/** Computes the maximum violation of the KKT optimality conditions
+		 *  of the current iterate within the QProblemB object. If an early
+		 *  exit occurs, the returned value exceeds the tolerance and all
+		 *  residuals that have not been evaluated are reported as zero.
+		 *  If the QP is not solved, all residuals are reported as INFTY.
+		 *	\return Maximum violation of the KKT conditions (or INFTY on error). */
+		real_t getKktViolation(	QProblemB* const qp,		/**< QProblemB to be checked. */
+								real_t* const maxStat = 0,	/**< Output: maximum value of stationarity condition residual. */
+								real_t* const maxFeas = 0,	/**< Output: maximum value of primal feasibility violation. */
+								real_t* const maxCmpl = 0	/**< Output: maximum value of complementarity residual. */
+								);
+
+		/** Computes the maximum violation of the KKT optimality conditions
+		 *  of the current iterate within the QProblem object. If an early
+		 *  exit occurs, the returned value exceeds the tolerance and all
+		 *  residuals that have not been evaluated are reported as zero.
+		 *  If the QP is not solved, all residuals are reported as INFTY.
+		 *	\return Maximum violation of the KKT conditions (or INFTY on error). */
+		real_t getKktViolation(	QProblem* const qp,			/**< QProblem to be checked. */
+								real_t* const maxStat = 0,	/**< Output: maximum value of stationarity condition residual. */
+								real_t* const maxFeas = 0,	/**< Output: maximum value of primal feasibility violation. */
+								real_t* const maxCmpl = 0	/**< Output: maximum value of complementarity residual. */
+								);
+
+
+	/*
+	 *	PROTECTED MEMBER FUNCTIONS
+	 */
+	protected:
+		/** Frees all allocated memory.
+		 *	\return SUCCESSFUL_RETURN */
+		returnValue clear( );
+
+		/** Ensures that the workspace fits QPs with the given number of variables
+		 *  and that the worker threads are running.
+		 *	\return SUCCESSFUL_RETURN */
+		returnValue allocate(	int_t _nV				/**< Number of variables. */
+								);
+
+		/** Reports all residuals as INFTY.
+		 *	\return INFTY */
+		real_t refuse(	real_t* const maxStat,			/**< Output: maximum value of stationarity condition residual. */
+						real_t* const maxFeas,			/**< Output: maximum value of primal feasibility violation. */
+						real_t* const maxCmpl			/**< Output: maximum value of complementarity residual. */
+						) const;
+
+		/** Determines the primal feasibility violation and complementarity
+		 *  residual of the bounds. */
+		void checkBounds(	const QProblemB* const qp,	/**< QP to be checked. */
+							real_t& feas,				/**< Output: maximum primal feasibility violation. */
+							real_t& cmpl				/**< Output: maximum complementarity residual. */
+							) const;
+
+		/** Determines the primal feasibility violation and complementarity
+		 *  residual of the constraints (based on the cached products A*x). */
+		void checkConstraints(	const QProblem* const qp,	/**< QP to be checked. */
+								real_t& feas,				/**< Output: maximum primal feasibility violation. */
+								real_t& cmpl				/**< Output: maximum complementarity residual. */
+								) const;
+
+		/** Determines the maximum stationarity residual g + H*x - y_B - A'*y_C.
+		 *	\return Maximum stationarity residual (or INFTY on error). */
+		real_t checkStationarity(	QProblemB* const qp,		/**< QP to be checked. */
+									QProblem* const qpC			/**< Same QP if it has constraints (or null pointer). */
+									);
+
+		/** Evaluates the share of one thread of the stationarity residual. */
+		void evaluate(	uint_t number			/**< Number of thread. */
+						);
+
+		/** Entry point of the worker threads, which evaluate their share of
+		 *  each check until clear() is called. */
+		static void* run(	void* arg			/**< Pointer to KktCheckerTask. */
+							);
+
+
+	/*
+	 *	PRIVATE MEMBER FUNCTIONS
+	 */
+	private:
+		/** Copy constructor (not allowed, owns workspace of threads). */
+		KktChecker(	const KktChecker& rhs	/**< Rhs object. */
+					);
+
+		/** Assignment operator (not allowed, owns workspace of threads). */
+		KktChecker& operator=(	const KktChecker& rhs	/**< Rhs object. */
+								);
+
+
+	/*
+	 *	PROTECTED MEMBER VARIABLES
+	 */
+	protected:
+		/** Argument passed to a worker thread. */
+		struct KktCheckerTask
+		{
+			KktChecker* checker;				/**< KKT checker the thread works for. */
+			uint_t number;						/**< Number of thread. */
+		};
+
+		uint_t nThreads;						/**< Number of threads (including the calling one). */
+		real_t tolerance;						/**< Early exit tolerance (0: disabled). */
+
+		int_t nV;								/**< Number of variables the workspace fits. */
+		real_t* residual;						/**< Stationarity residual. */
+		real_t* partial;						/**< Partial sums A'*y_C of each thread (nThreads*nV). */
+		real_t* rowBuffer;						/**< Matrix row buffer of each thread (nThreads*nV). */
+		KktCheckerTask* tasks;					/**< Arguments passed to the worker threads. */
+
+		QProblemB* qp;							/**< QP currently checked. */
+		const int_t* activeIdx;					/**< Indices of active constraints of QP currently checked. */
+		int_t nActive;							/**< Number of active constraints of QP currently checked. */
+		BooleanType rowwiseH;					/**< Flag indicating whether H*x is evaluated row by row. */
+		BooleanType rowwiseA;					/**< Flag indicating whether A'*y_C is evaluated row by row. */
+
+		#ifndef __NO_THREADS__
+		pthread_t* threads;						/**< Worker threads. */
+		uint_t nWorkers;						/**< Number of running worker threads (threads 1,...,nWorkers). */
+		uint_t generation;						/**< Number of checks handed to the worker threads so far. */
+		uint_t nDone;							/**< Number of worker threads that finished the current check. */
+		BooleanType stopRequested;				/**< Flag requesting the worker threads to terminate. */
+		pthread_mutex_t mutex;					/**< Mutex protecting the thread bookkeeping above. */
+		pthread_cond_t started;					/**< Signalled when a check is handed to the worker threads. */
+		pthread_cond_t done;					/**< Signalled once all worker threads finished the current check. */
+		#endif
+};
+
+
+END_NAMESPACE_QPOASES
+
+#include <qpOASES/extras/KktChecker.ipp>
+
+#endif	/* QPOASES_KKTCHECKER_HPP */
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,269 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file include/qpOASES/extras/RacingSolver.hpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Declaration of the RacingSolver class which performs the same hotstart
+ *	concurrently on several clones of a QP with different options.
+ */
+
+
+#ifndef QPOASES_RACINGSOLVER_HPP
+#define QPOASES_RACINGSOLVER_HPP
+
+
+#include <qpOASES/QProblem.hpp>
+
+#ifndef __NO_THREADS__
+  #include <pthread.h>
+#endif
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/**
+ *	\brief Speculative solver racing several candidate QPs.
+ *
+ *	Keeps a number of clones (candidates) of an initialised QP, each equipped
+ *	with its own options preset and, optionally, a guessed working set. Each
+ *	hotstart is run concurrently on all candidates; the first candidate that
+ *	returns successfully wins and all others are cancelled cooperatively (they
+ *	stop at their next iteration). Afterwards, the losing candidates are
+ *	resynchronised to the state of the winner in the background, so that all
+ *	candidates start the next hotstart from the same working set.
+ *
+ *	Each candidate is served by a worker thread that is started once by init()
+ *	and waits for the next hotstart in between, so a hotstart costs two
+ *	condition variable round trips instead of creating and joining threads.
+ *	As candidates run concurrently, they always use printLevel PL_NONE (which
+ *	is set for the global message handler by init()), whatever their presets
+ *	say. If threads are not available (__NO_THREADS__), candidates are run
+ *	one after the other until the first one succeeds.
+ *
+ *	\version 3.2
+ *	\date 2018
+ */
+class RacingSolver
+{
+	/*
+	 *	PUBLIC MEMBER FUNCTIONS
+	 */
+	public:
+		/** Default constructor. */
+		RacingSolver( );
+
+		/** Constructor which clones the given QP once for each options preset. */
+		RacingSolver(	const QProblem& _qp,						/**< Initialised QP to be cloned. */
+						uint_t _nCandidates,						/**< Number of candidates. */
+						const Options* const _candidateOptions		/**< Array of options presets, one per candidate. */
+						);
+
+		/** Destructor. */
+		~RacingSolver( );
+
+
+		/** Clones the given QP once for each options preset.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_INVALID_ARGUMENTS */
+		returnValue init(	const QProblem& _qp,					/**< Initialised QP to be cloned. */
+							uint_t _nCandidates,					/**< Number of candidates. */
+							const Options* const _candidateOptions	/**< Array of options presets, one per candidate. */
+							);
+
+		/** Sets (or, if null pointers are passed, clears) the guessed working set
+		 *  one candidate uses for all subsequent hotstarts.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_INDEX_OUT_OF_BOUNDS */
+		returnValue setGuessedWorkingSet(	uint_t number,							/**< Number of candidate. */
+											const Bounds* const _guessedBounds,		/**< Guessed working set of bounds (or null pointer). */
+											const Constraints* const _guessedConstraints = 0	/**< Guessed working set of constraints (or null pointer). */
+											);
+
+
+		/** Solves the QP with the new data on all candidates concurrently and
+		 *  returns the result of the first successful candidate.
+		 *	Losing candidates are resynchronised in the background; all input
+		 *	arrays may be modified as soon as this function returns.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_RACE_NOT_INITIALISED \n
+					return value of first candidate if no candidate succeeded */
+		returnValue hotstart(	const real_t* const g_new,		/**< Gradient of neighbouring QP to be solved. */
+								const real_t* const lb_new,		/**< Lower bounds of neighbouring QP to be solved. \n
+																	 If no lower bounds exist, a NULL pointer can be passed. */
+								const real_t* const ub_new,		/**< Upper bounds of neighbouring QP to be solved. \n
+																	 If no upper bounds exist, a NULL pointer can be passed. */
+								const real_t* const lbA_new,	/**< Lower constraints' bounds of neighbouring QP to be solved. \n
+																	 If no lower constraints' bounds exist, a NULL pointer can be passed. */
+								const real_t* const ubA_new,	/**< Upper constraints' bounds of neighbouring QP to be solved. \n
+																	 If no upper constraints' bounds exist, a NULL pointer can be passed. */
+								int_t& nWSR,					/**< Input: Maximum number of working set recalculations per candidate; \n
+																	 Output: Number of performed working set recalculations of the winner. */
+								real_t* const cputime = 0		/**< Input: Maximum CPU time allowed per candidate. \n
+																	 Output: CPU time spent by the winner (if pointer passed). */
+								);
+
+		/** Waits until the losing candidates of the last hotstart
+		 *  have been resynchronised to the state of the winner.
+		 *	\return SUCCESSFUL_RETURN */
+		returnValue synchronise( );
+
+
+		/** Returns number of candidates.
+		 *	\return Number of candidates. */
+		inline uint_t getNumCandidates( ) const;
+
+		/** Returns number of the candidate that won the last hotstart.
+		 *	\return Number of winner (or -1 if no candidate succeeded). */
+		inline int_t getWinner( ) const;
+
+		/** Returns a candidate (after waiting for its resynchronisation).
+		 *	\return Pointer to candidate (or null pointer if number is invalid). */
+		QProblem* getCandidate(	uint_t number			/**< Number of candidate. */
+								);
+
+		/** Returns the primal solution of the winner of the last hotstart.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_RACE_NO_WINNER */
+		returnValue getPrimalSolution(	real_t* const xOpt			/**< Output: Primal solution vector (if QP has been solved). */
+										) const;
+
+		/** Returns the dual solution of the winner of the last hotstart.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_RACE_NO_WINNER */
+		returnValue getDualSolution(	real_t* const yOpt			/**< Output: Dual solution vector (if QP has been solved). */
+										) const;
+
+		/** Returns the optimal objective function value of the winner of the last hotstart.
+		 *	\return finite value: Optimal objective function value (QP was solved) \n
+		 			+infinity:	  QP was not yet solved */
+		real_t getObjVal( ) const;
+
+
+	/*
+	 *	PROTECTED MEMBER FUNCTIONS
+	 */
+	protected:
+		/** Frees all allocated memory.
+		 *	\return SUCCESSFUL_RETURN */
+		returnValue clear( );
+
+		/** Runs the current hotstart on one candidate and claims
+		 *  the win if it is the first one to succeed. */
+		void race(	uint_t number				/**< Number of candidate. */
+					);
+
+		/** Copies the state of the winner into a losing candidate
+		 *  while keeping the candidate's own options. */
+		void resync(	uint_t number			/**< Number of candidate. */
+						);
+
+		/** Applies the options preset of a candidate, including the
+		 *  ramping values derived from it. */
+		void applyOptions(	uint_t number		/**< Number of candidate. */
+							);
+
+		/** Signals that a candidate finished the current hotstart. */
+		void signalFinished( );
+
+		/** Entry point of the candidate threads (loops until clear() stops it). */
+		static void* run(	void* arg			/**< Pointer to RacingSolverTask. */
+							);
+
+
+	/*
+	 *	PRIVATE MEMBER FUNCTIONS
+	 */
+	private:
+		/** Copy constructor (not allowed, owns threads). */
+		RacingSolver(	const RacingSolver& rhs	/**< Rhs object. */
+						);
+
+		/** Assignment operator (not allowed, owns threads). */
+		RacingSolver& operator=(	const RacingSolver& rhs	/**< Rhs object. */
+									);
+
+
+	/*
+	 *	PROTECTED MEMBER VARIABLES
+	 */
+	protected:
+		/** Argument passed to a candidate thread. */
+		struct RacingSolverTask
+		{
+			RacingSolver* solver;				/**< Racing solver the candidate belongs to. */
+			uint_t number;						/**< Number of candidate. */
+		};
+
+		uint_t nCandidates;						/**< Number of candidates. */
+		QProblem** candidates;					/**< Candidate QPs. */
+		Options* candidateOptions;				/**< Options preset of each candidate. */
+		Bounds** guessedBounds;					/**< Guessed working set of bounds of each candidate (or null pointers). */
+		Constraints** guessedConstraints;		/**< Guessed working set of constraints of each candidate (or null pointers). */
+
+		returnValue* candidateStatus;			/**< Return value of the last hotstart of each candidate. */
+		int_t* candidateNWSR;					/**< Number of working set recalculations of each candidate. */
+		real_t* candidateTime;					/**< CPU time of each candidate. */
+		RacingSolverTask* tasks;				/**< Arguments passed to the candidate threads. */
+
+		int_t winner;							/**< Number of winner of the last hotstart (or -1). */
+		int_t cancelFlag;						/**< Flag shared by all candidates, set once a winner is found. */
+
+		const real_t* g;						/**< Gradient of the current hotstart. */
+		const real_t* lb;						/**< Lower bounds of the current hotstart. */
+		const real_t* ub;						/**< Upper bounds of the current hotstart. */
+		const real_t* lbA;						/**< Lower constraints' bounds of the current hotstart. */
+		const real_t* ubA;						/**< Upper constraints' bounds of the current hotstart. */
+		BooleanType useTime;					/**< Flag indicating whether a CPU time limit is imposed. */
+		BooleanType resyncPending;				/**< Flag indicating whether candidates without thread still need to be resynchronised. */
+
+		#ifndef __NO_THREADS__
+		pthread_t* threads;						/**< Candidate threads. */
+		uint_t nThreads;						/**< Number of running candidate threads (candidates 0,...,nThreads-1). */
+		uint_t generation;						/**< Number of hotstarts handed to the candidate threads so far. */
+		uint_t nFinished;						/**< Number of candidates that finished the current hotstart. */
+		uint_t nIdle;							/**< Number of candidate threads that are done with the current hotstart (including resync). */
+		BooleanType stopRequested;				/**< Flag requesting the candidate threads to terminate. */
+		pthread_mutex_t mutex;					/**< Mutex protecting the thread bookkeeping above. */
+		pthread_cond_t started;					/**< Signalled when a hotstart is handed to the candidate threads. */
+		pthread_cond_t finished;				/**< Signalled once all candidates finished the current hotstart. */
+		pthread_cond_t idle;					/**< Signalled once all candidate threads are done with the current hotstart. */
+		#endif
+};
+
+
+END_NAMESPACE_QPOASES
+
+#include <qpOASES/extras/RacingSolver.ipp>
+
+#endif	/* QPOASES_RACINGSOLVER_HPP */
+
+
+/*
+ *	end of file
+ */
@@ -40,6 +40,10 @@
 #include <qpOASES/SQProblem.hpp>
 #include <qpOASES/SQProblemSchur.hpp>
 
+#ifndef __NO_THREADS__
+  #include <pthread.h>
+#endif
+
 
 BEGIN_NAMESPACE_QPOASES
 
@@ -63,6 +67,12 @@ class SolutionAnalysis
 		/** Default constructor. */
 		SolutionAnalysis( );
 
+		/** Constructor which takes the number of threads and the block size
+		 *  used for evaluating selected blocks of variance-covariance matrices. */
+		SolutionAnalysis(	uint_t _nThreads,			/**< Number of threads (including the calling one). */
+							int_t _blockSize = 16		/**< Number of right-hand sides solved at once. */
+							);
+
 		/** Copy constructor (deep copy). */
 		SolutionAnalysis(	const SolutionAnalysis& rhs		/**< Rhs object. */
 							);
@@ -142,15 +152,151 @@ class SolutionAnalysis
 																			 *			 and dual variables. Dimension:  (2nV+nC) x (2nV+nC) */
 											) const;
 
+		/** Computes selected blocks of the variance-covariance matrix of the QP output
+		 *  for uncertain inputs. Rows and columns of the input variance-covariance
+		 *  outside of the given input blocks are treated as zero, and only rows and
+		 *  columns of the output within the given output blocks are computed (all
+		 *  other entries are set to zero). Right-hand sides are solved in blocks
+		 *  against the current factorisation and split between several threads;
+		 *  iterative refinement stops once the residual of the whole block is small
+		 *  enough.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_HOTSTART_FAILED \n
+		 			RET_STEPDIRECTION_FAILED_TQ \n
+					RET_STEPDIRECTION_FAILED_CHOLESKY \n
+					RET_INVALID_ARGUMENTS */
+		returnValue getVarianceCovariance(	QProblem* const qp,				/**< QProblem to be analysed. */
+											const real_t* const g_b_bA_VAR,	/**< Input:  Variance-covariance of g, the bounds lb and ub,
+																			 *			 and lbA and ubA respectively. Dimension:  (2nV+nC) x (2nV+nC) */
+											real_t* const Primal_Dual_VAR,	/**< Output: The result for the variance-covariance of the primal
+																			 *			 and dual variables. Dimension:  (2nV+nC) x (2nV+nC) */
+											int_t inputBlocks,				/**< Blocks of the input that are uncertain (combination of CovarianceBlock values). */
+											int_t outputBlocks = CB_ALL		/**< Blocks of the output to be computed (combination of CovarianceBlock values). */
+											) const;
+
+		/** Computes selected blocks of the variance-covariance matrix of the QP output
+		 *  for uncertain inputs (see QProblem variant).
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_HOTSTART_FAILED \n
+		 			RET_STEPDIRECTION_FAILED_TQ \n
+					RET_STEPDIRECTION_FAILED_CHOLESKY \n
+					RET_INVALID_ARGUMENTS */
+		returnValue getVarianceCovariance(	SQProblem* const qp,			/**< SQProblem to be analysed. */
+											const real_t* const g_b_bA_VAR,	/**< Input:  Variance-covariance of g, the bounds lb and ub,
+																			 *			 and lbA and ubA respectively. Dimension:  (2nV+nC) x (2nV+nC) */
+											real_t* const Primal_Dual_VAR,	/**< Output: The result for the variance-covariance of the primal
+																			 *			 and dual variables. Dimension:  (2nV+nC) x (2nV+nC) */
+											int_t inputBlocks,				/**< Blocks of the input that are uncertain (combination of CovarianceBlock values). */
+											int_t outputBlocks = CB_ALL		/**< Blocks of the output to be computed (combination of CovarianceBlock values). */
+											) const;
+
+
+		/** Sets number of threads used for evaluating selected blocks of
+		 *  variance-covariance matrices (including the calling one). Fewer
+		 *  threads are used if there is too little work to share, small
+		 *  problems are always evaluated on the calling thread.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_INVALID_ARGUMENTS */
+		returnValue setNumThreads(	uint_t _nThreads		/**< Number of threads. */
+									);
+
+		/** Sets number of right-hand sides solved at once.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_INVALID_ARGUMENTS */
+		returnValue setBlockSize(	int_t _blockSize		/**< Block size. */
+									);
+
+		/** Returns number of threads.
+		 *	\return Number of threads. */
+		inline uint_t getNumThreads( ) const;
+
+		/** Returns number of right-hand sides solved at once.
+		 *	\return Block size. */
+		inline int_t getBlockSize( ) const;
+
+
 		/** Checks if a direction of negative curvature shows up if we remove all bounds that just recently became active */
 		returnValue checkCurvatureOnStronglyActiveConstraints(	SQProblemSchur* qp );
 		returnValue checkCurvatureOnStronglyActiveConstraints(	SQProblem* qp );
 
 	/*
-	 *	PROTECTED MEMBER VARIABLES
+	 *	PROTECTED MEMBER FUNCTIONS
 	 */
 	protected:
+		/** Data shared by all threads applying the inverse KKT matrix to a set of columns. */
+		struct CovarianceStage
+		{
+			QProblem* qp;						/**< QP to be analysed. */
+			const real_t* QFR;					/**< Rows of Q belonging to free variables, [Z Y] (nFR x nFR). */
+			const real_t* HFR;					/**< Hessian submatrix of free variables (nFR x nFR). */
+			const real_t* HFX;					/**< Hessian submatrix of free and fixed variables (nFR x nFX). */
+			const real_t* HXX;					/**< Hessian submatrix of fixed variables (nFX x nFX). */
+			const real_t* AFR;					/**< Constraint submatrix of active constraints and free variables (nAC x nFR). */
+			const real_t* AFX;					/**< Constraint submatrix of active constraints and fixed variables (nAC x nFX). */
+			const int_t* columns;				/**< Numbers of the columns to be processed. */
+			const real_t* in;					/**< Input matrix. */
+			int_t inRowStride;					/**< Distance of two entries of one input column. */
+			int_t inColStride;					/**< Distance of two input columns. */
+			int_t inputBlocks;					/**< Blocks of the input columns to be read (others are treated as zero). */
+			real_t* out;						/**< Output matrix. */
+			int_t outRowStride;					/**< Distance of two entries of one output column. */
+			int_t outColStride;					/**< Distance of two output columns. */
+			int_t outputBlocks;					/**< Blocks of the output columns to be written. */
+		};
+
+		/** Argument passed to a worker thread. */
+		struct CovarianceTask
+		{
+			const SolutionAnalysis* analysis;	/**< SolutionAnalysis the thread works for. */
+			const CovarianceStage* stage;		/**< Data shared by all threads. */
+			int_t begin;						/**< First column (position within list of columns). */
+			int_t end;							/**< Column after the last one (position within list of columns). */
+			returnValue status;					/**< Return value of the thread. */
+		};
+
+		/** Applies the inverse of the KKT matrix of the current working set to the
+		 *  given columns, splitting them between several threads.
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_STEPDIRECTION_FAILED_TQ \n
+					RET_STEPDIRECTION_FAILED_CHOLESKY */
+		returnValue applyKktInverse(	const CovarianceStage& stage,	/**< Columns to be processed. */
+										int_t nColumns					/**< Number of columns. */
+										) const;
+
+		/** Applies the inverse of the KKT matrix to the columns of one task, blockSize at a time.
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_STEPDIRECTION_FAILED_TQ \n
+					RET_STEPDIRECTION_FAILED_CHOLESKY */
+		returnValue solveColumns(	const CovarianceStage& stage,	/**< Columns to be processed. */
+									int_t begin,					/**< First column (position within list of columns). */
+									int_t end						/**< Column after the last one (position within list of columns). */
+									) const;
+
+		/** Solves the KKT system of the free variables and active constraints for
+		 *  nRhs right-hand sides (stored column-wise); gFR is overwritten.
+		 *	\return SUCCESSFUL_RETURN \n
+		 			RET_STEPDIRECTION_FAILED_TQ \n
+					RET_STEPDIRECTION_FAILED_CHOLESKY */
+		returnValue solveReducedKkt(	const CovarianceStage& stage,	/**< Factorisation and submatrices of the current working set. */
+										int_t nRhs,						/**< Number of right-hand sides. */
+										real_t* const gFR,				/**< Gradient part of right-hand sides (nFR x nRhs). */
+										const real_t* const bAC,		/**< Constraint part of right-hand sides (nAC x nRhs). */
+										real_t* const xFR,				/**< Output: primal solutions (nFR x nRhs). */
+										real_t* const yAC,				/**< Output: dual solutions (nAC x nRhs). */
+										real_t* const work				/**< Workspace of size (nFR+2*nAC+nZ)*nRhs. */
+										) const;
+
+		/** Entry point of the worker threads. */
+		static void* run(	void* arg			/**< Pointer to CovarianceTask. */
+							);
+
 
+	/*
+	 *	PROTECTED MEMBER VARIABLES
+	 */
+	protected:
+		uint_t nThreads;						/**< Number of threads (including the calling one). */
+		int_t blockSize;						/**< Number of right-hand sides solved at once. */
 };
 
 
@@ -43,6 +43,24 @@
 BEGIN_NAMESPACE_QPOASES
 
 
+/*
+ *	g e t N u m T h r e a d s
+ */
+inline uint_t SolutionAnalysis::getNumThreads( ) const
+{
+	return nThreads;
+}
+
+
+/*
+ *	g e t B l o c k S i z e
+ */
+inline int_t SolutionAnalysis::getBlockSize( ) const
+{
+	return blockSize;
+}
+
+
 END_NAMESPACE_QPOASES
 
 
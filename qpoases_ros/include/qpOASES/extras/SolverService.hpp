@@ -0,0 +1,528 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file include/qpOASES/extras/SolverService.hpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Declaration of the SolverServer and SolverClient classes which allow
+ *	several processes to share QP solvers via POSIX shared memory.
+ */
+
+
+#ifndef QPOASES_SOLVERSERVICE_HPP
+#define QPOASES_SOLVERSERVICE_HPP
+
+
+#include <qpOASES/SQProblem.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/** Types of requests sent to a solver service. */
+enum ServiceRequestType
+{
+	SRT_INIT,							/**< Initialise QP with new matrices and vectors. */
+	SRT_HOTSTART,						/**< Hotstart with new vectors only. */
+	SRT_HOTSTART_MATRICES				/**< Hotstart with new matrices and vectors. */
+};
+
+
+/**
+ *	\brief Shared memory layout of a solver service.
+ *
+ *	A solver service is a named POSIX shared memory region created by a
+ *	SolverServer. It consists of a number of channels, each one being served
+ *	by one SQProblem of fixed dimensions and used by one SolverClient. Each
+ *	channel holds a single-producer/single-consumer ring of request slots
+ *	(containing the QP vectors, the solver settings and the solution) and
+ *	two buffers for the QP matrices. The server passes the constraint matrix
+ *	of the latest matrix request to the SQProblem in place, while the client
+ *	fills the other buffer; the Hessian is copied into a private buffer of
+ *	the server first, as the SQProblem may regularise it in place. Request
+ *	counters and completion flags are accessed atomically, all other data is
+ *	handed over with release/acquire semantics; no locks are involved.
+ *
+ *	This base class only manages the mapping of the region.
+ *
+ *	\version 3.2
+ *	\date 2018
+ */
+class SolverService
+{
+	/*
+	 *	PUBLIC MEMBER FUNCTIONS
+	 */
+	public:
+		/** Default constructor. */
+		SolverService( );
+
+		/** Destructor (unmaps shared memory). */
+		virtual ~SolverService( );
+
+
+		/** Returns number of channels of the service.
+		 *	\return Number of channels. */
+		inline uint_t getNumChannels( ) const;
+
+		/** Returns number of request slots per channel.
+		 *	\return Number of request slots. */
+		inline uint_t getNumSlots( ) const;
+
+
+	/*
+	 *	PROTECTED MEMBER FUNCTIONS
+	 */
+	protected:
+		/** Unmaps the shared memory region (and removes it if owned).
+		 *	\return SUCCESSFUL_RETURN */
+		returnValue unmap( );
+
+		/** Returns size of the region for given channel dimensions.
+		 *	\return Size of region [bytes]. */
+		static size_t computeLayout(	uint_t _nChannels,			/**< Number of channels. */
+										const uint_t* const _nV,	/**< Number of variables of each channel. */
+										const uint_t* const _nC,	/**< Number of constraints of each channel. */
+										uint_t _nSlots,				/**< Number of request slots per channel. */
+										void* const base			/**< Start of region to be set up (or null pointer to only compute size). */
+										);
+
+		/** Rounds size up to a multiple of the cache line size.
+		 *	\return Rounded size. */
+		static inline size_t align(	size_t size					/**< Size [bytes]. */
+									);
+
+
+	/*
+	 *	PRIVATE MEMBER FUNCTIONS
+	 */
+	private:
+		/** Copy constructor (not allowed, maps shared memory). */
+		SolverService(	const SolverService& rhs	/**< Rhs object. */
+						);
+
+		/** Assignment operator (not allowed, maps shared memory). */
+		SolverService& operator=(	const SolverService& rhs	/**< Rhs object. */
+									);
+
+
+	/*
+	 *	PROTECTED MEMBER VARIABLES
+	 */
+	protected:
+		/** Header at the start of the region. */
+		struct Header
+		{
+			uint_t magic;					/**< Identifies an initialised region (written last). */
+			uint_t sizeofReal;				/**< Size of real_t of server. */
+			uint_t sizeofInt;				/**< Size of int_t of server. */
+			uint_t nChannels;				/**< Number of channels. */
+			uint_t nSlots;					/**< Number of request slots per channel (power of two). */
+			uint_t shutdown;				/**< Flag requesting the server to terminate. */
+			int_t pid;						/**< Process id of server (identifies regions left by a crashed server). */
+		};
+
+		/** Channel descriptor (one cache line per counter to avoid false sharing). */
+		struct Channel
+		{
+			uint_t nV;						/**< Number of variables. */
+			uint_t nC;						/**< Number of constraints. */
+			size_t slotOffset;				/**< Offset of first request slot. */
+			size_t slotSize;				/**< Size of one request slot. */
+			size_t matrixOffset;			/**< Offset of first matrix buffer. */
+			size_t matrixSize;				/**< Size of one matrix buffer. */
+			uint_t attached;				/**< Flag indicating that a client uses the channel. */
+			int_t matrixBuffer;				/**< Matrix buffer of the last request with new matrices (written by client only). */
+			char pad0[64];
+			uint_t head;					/**< Number of requests submitted (written by client only). */
+			char pad1[64];
+			uint_t tail;					/**< Number of requests processed (written by server only). */
+			char pad2[64];
+		};
+
+		/** Request slot; followed by g, lb, ub, lbA, ubA, xOpt and yOpt. */
+		struct Slot
+		{
+			uint_t done;					/**< Number of requests processed once this slot is processed. */
+			int_t type;						/**< Type of request (ServiceRequestType). */
+			int_t matrixBuffer;				/**< Matrix buffer the request refers to. */
+			int_t nWSR;						/**< Input/output: number of working set recalculations. */
+			real_t cputime;					/**< Input/output: CPU time (non-positive input: no limit). */
+			int_t status;					/**< Output: return value of solver. */
+			real_t objVal;					/**< Output: optimal objective function value. */
+		};
+
+		/** Returns descriptor of a channel. */
+		inline Channel* getChannel(	uint_t number			/**< Number of channel. */
+									) const;
+
+		/** Returns a request slot of a channel. */
+		inline Slot* getSlot(	const Channel* const _channel,	/**< Channel. */
+								uint_t sequence					/**< Sequence number of request. */
+								) const;
+
+		/** Returns a vector of a request slot (0: g, 1: lb, 2: ub, 3: lbA, 4: ubA, 5: xOpt, 6: yOpt). */
+		inline real_t* getVector(	const Channel* const _channel,	/**< Channel. */
+									Slot* const slot,				/**< Request slot. */
+									uint_t number					/**< Number of vector. */
+									) const;
+
+		/** Returns Hessian (0) or constraint matrix (1) of a matrix buffer. */
+		inline real_t* getMatrix(	const Channel* const _channel,	/**< Channel. */
+									int_t buffer,					/**< Number of matrix buffer. */
+									uint_t number					/**< Number of matrix. */
+									) const;
+
+		char name[MAX_STRING_LENGTH];	/**< Name of shared memory region. */
+		void* base;						/**< Start of mapped region. */
+		size_t size;					/**< Size of mapped region. */
+		BooleanType owner;				/**< Flag indicating whether the region is removed on unmap. */
+		Header* header;					/**< Header of region. */
+};
+
+
+/**
+ *	\brief Server side of a solver service.
+ *
+ *	Creates a solver service region and owns one SQProblem per channel. The
+ *	server polls all channels for pending requests and processes them in the
+ *	order of submission; unless run() is given an idle period, it busy-polls.
+ *	It is meant to run in a dedicated process pinned to an isolated core
+ *	(see tools/solver_server.cpp).
+ *
+ *	\version 3.2
+ *	\date 2018
+ */
+class SolverServer : public SolverService
+{
+	/*
+	 *	PUBLIC MEMBER FUNCTIONS
+	 */
+	public:
+		/** Default constructor. */
+		SolverServer( );
+
+		/** Destructor (removes shared memory region). */
+		~SolverServer( );
+
+
+		/** Creates the shared memory region and one QP per channel. A region of
+		 *  the same name is only replaced if the server that created it is no
+		 *  longer running.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_INVALID_ARGUMENTS \n
+					RET_SERVICE_IN_USE \n
+					RET_SERVICE_SETUP_FAILED */
+		returnValue init(	const char* const _name,				/**< Name of shared memory region (e.g. "/qpoases"). */
+							uint_t _nChannels,						/**< Number of channels. */
+							const uint_t* const _nV,				/**< Number of variables of each channel. */
+							const uint_t* const _nC,				/**< Number of constraints of each channel. */
+							uint_t _nSlots = 4,						/**< Number of request slots per channel (rounded up to a power of two). */
+							const Options* const _options = 0		/**< Options of all QPs (or null pointer for default options without output). */
+							);
+
+		/** Pins the calling thread to one CPU core.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_INVALID_ARGUMENTS \n
+					RET_NOT_YET_IMPLEMENTED */
+		returnValue pinToCore(	int_t core				/**< Number of core. */
+								);
+
+		/** Processes all pending requests of all channels once.
+		 *	\return Number of processed requests. */
+		uint_t poll( );
+
+		/** Polls all channels until shutdown is requested.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_SERVICE_SETUP_FAILED */
+		returnValue run(	uint_t idlePeriod = 0		/**< Sleep period after a poll without requests [microseconds] (0: busy polling). */
+							);
+
+		/** Requests run() to return (async-signal-safe). */
+		void requestShutdown( );
+
+		/** Returns QP of a channel.
+		 *	\return Pointer to QP (or null pointer if number is invalid). */
+		inline SQProblem* getProblem(	uint_t number		/**< Number of channel. */
+										) const;
+
+
+	/*
+	 *	PROTECTED MEMBER FUNCTIONS
+	 */
+	protected:
+		/** Frees all allocated memory and removes the region.
+		 *	\return SUCCESSFUL_RETURN */
+		returnValue clear( );
+
+		/** Determines whether an existing region has been left by a server that is
+		 *  no longer running. Regions whose server cannot be identified (e.g. as it
+		 *  is still being set up) are not considered stale.
+		 *	\return BT_TRUE iff region is stale */
+		static BooleanType isStale(	const char* const _name		/**< Name of shared memory region. */
+									);
+
+		/** Solves the QP of one request slot. */
+		void process(	uint_t number,			/**< Number of channel. */
+						Slot* const slot		/**< Request slot. */
+						);
+
+
+	/*
+	 *	PROTECTED MEMBER VARIABLES
+	 */
+	protected:
+		SQProblem** problems;			/**< QP of each channel. */
+		real_t** hessians;				/**< Private copies of the two Hessian buffers of each channel. */
+};
+
+
+/**
+ *	\brief Client side of a solver service.
+ *
+ *	Attaches to one channel of a running solver service. QP data can either
+ *	be written directly into the shared request slots and matrix buffers
+ *	(getVectors(), getMatrices(), submit(), wait()), or be copied there by
+ *	the convenience functions init() and hotstart() that mirror those of
+ *	SQProblem. Up to getNumSlots() requests may be outstanding at a time;
+ *	new matrices can only be submitted once the previous request with
+ *	matrices has been waited for. The convenience functions require all
+ *	outstanding requests to have been waited for. Waiting for a request
+ *	gives up after a timeout (1 s by default), so that a client does not
+ *	hang if the server has died.
+ *
+ *	\version 3.2
+ *	\date 2018
+ */
+class SolverClient : public SolverService
+{
+	/*
+	 *	PUBLIC MEMBER FUNCTIONS
+	 */
+	public:
+		/** Default constructor. */
+		SolverClient( );
+
+		/** Destructor (detaches from channel). */
+		~SolverClient( );
+
+
+		/** Attaches to a channel of a running solver service. Requests of a
+		 *  previous client of the channel are waited for (up to the timeout).
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_SERVICE_ATTACH_FAILED \n
+					RET_SERVICE_TIMEOUT */
+		returnValue attach(	const char* const _name,		/**< Name of shared memory region. */
+							uint_t _channel					/**< Number of channel. */
+							);
+
+		/** Detaches from channel (after waiting for all outstanding requests,
+		 *  each up to the timeout).
+		 *	\return SUCCESSFUL_RETURN */
+		returnValue detach( );
+
+
+		/** Returns the vectors of the next request (written in place).
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_SERVICE_ATTACH_FAILED \n
+					RET_SERVICE_BUSY */
+		returnValue getVectors(	real_t*& g,				/**< Output: gradient. */
+								real_t*& lb,			/**< Output: lower bounds. */
+								real_t*& ub,			/**< Output: upper bounds. */
+								real_t*& lbA,			/**< Output: lower constraints' bounds. */
+								real_t*& ubA			/**< Output: upper constraints' bounds. */
+								);
+
+		/** Returns the matrix buffer for the next request with new matrices (written in place).
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_SERVICE_ATTACH_FAILED \n
+					RET_SERVICE_BUSY */
+		returnValue getMatrices(	real_t*& H,			/**< Output: Hessian matrix (nV x nV). */
+									real_t*& A			/**< Output: constraint matrix (nC x nV). */
+									);
+
+		/** Submits the next request.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_SERVICE_ATTACH_FAILED \n
+					RET_SERVICE_BUSY */
+		returnValue submit(	ServiceRequestType type,		/**< Type of request. */
+							int_t nWSR,						/**< Maximum number of working set recalculations. */
+							real_t cputime = 0.0			/**< Maximum CPU time (non-positive: no limit). */
+							);
+
+		/** Sets maximum time wait() waits for the server to answer a request.
+		 *	\return SUCCESSFUL_RETURN */
+		returnValue setTimeout(	real_t _timeout					/**< Timeout [s] (non-positive: wait forever). */
+								);
+
+		/** Waits for the oldest outstanding request to be processed. If the server
+		 *  does not answer within the timeout, the request stays outstanding and
+		 *  may be waited for again.
+		 *	\return return value of solver \n
+					RET_SERVICE_NO_REQUEST \n
+					RET_SERVICE_TIMEOUT */
+		returnValue wait(	int_t& nWSR,					/**< Output: Number of performed working set recalculations. */
+							real_t* const cputime = 0		/**< Output: CPU time spent by server (if pointer passed). */
+							);
+
+
+		/** Initialises the QP of the channel (copies data and waits for solution).
+		 *	\return return value of solver \n
+					RET_SERVICE_ATTACH_FAILED \n
+					RET_SERVICE_BUSY \n
+					RET_SERVICE_TIMEOUT */
+		returnValue init(	const real_t* const _H,			/**< Hessian matrix. */
+							const real_t* const _g,			/**< Gradient vector. */
+							const real_t* const _A,			/**< Constraint matrix. */
+							const real_t* const _lb,		/**< Lower bounds (or null pointer). */
+							const real_t* const _ub,		/**< Upper bounds (or null pointer). */
+							const real_t* const _lbA,		/**< Lower constraints' bounds (or null pointer). */
+							const real_t* const _ubA,		/**< Upper constraints' bounds (or null pointer). */
+							int_t& nWSR,					/**< Input: Maximum number of working set recalculations; \n
+																 Output: Number of performed working set recalculations. */
+							real_t* const cputime = 0		/**< Input: Maximum CPU time allowed for QP initialisation. \n
+																 Output: CPU time spent by server (if pointer passed). */
+							);
+
+		/** Hotstarts the QP of the channel with new matrices (copies data and waits for solution).
+		 *	A matrix passed as null pointer is kept; if both are null pointers, only
+		 *	the vectors are updated.
+		 *	\return return value of solver \n
+					RET_SERVICE_ATTACH_FAILED \n
+					RET_SERVICE_BUSY \n
+					RET_SERVICE_TIMEOUT */
+		returnValue hotstart(	const real_t* const H_new,		/**< Hessian matrix (or null pointer). */
+								const real_t* const g_new,		/**< Gradient vector. */
+								const real_t* const A_new,		/**< Constraint matrix (or null pointer). */
+								const real_t* const lb_new,		/**< Lower bounds (or null pointer). */
+								const real_t* const ub_new,		/**< Upper bounds (or null pointer). */
+								const real_t* const lbA_new,	/**< Lower constraints' bounds (or null pointer). */
+								const real_t* const ubA_new,	/**< Upper constraints' bounds (or null pointer). */
+								int_t& nWSR,					/**< Input: Maximum number of working set recalculations; \n
+																	 Output: Number of performed working set recalculations. */
+								real_t* const cputime = 0		/**< Input: Maximum CPU time allowed for QP solution. \n
+																	 Output: CPU time spent by server (if pointer passed). */
+								);
+
+		/** Hotstarts the QP of the channel with new vectors (copies data and waits for solution).
+		 *	\return return value of solver \n
+					RET_SERVICE_ATTACH_FAILED \n
+					RET_SERVICE_BUSY \n
+					RET_SERVICE_TIMEOUT */
+		returnValue hotstart(	const real_t* const g_new,		/**< Gradient vector. */
+								const real_t* const lb_new,		/**< Lower bounds (or null pointer). */
+								const real_t* const ub_new,		/**< Upper bounds (or null pointer). */
+								const real_t* const lbA_new,	/**< Lower constraints' bounds (or null pointer). */
+								const real_t* const ubA_new,	/**< Upper constraints' bounds (or null pointer). */
+								int_t& nWSR,					/**< Input: Maximum number of working set recalculations; \n
+																	 Output: Number of performed working set recalculations. */
+								real_t* const cputime = 0		/**< Input: Maximum CPU time allowed for QP solution. \n
+																	 Output: CPU time spent by server (if pointer passed). */
+								);
+
+
+		/** Returns primal solution of the last request waited for (valid until its slot is reused).
+		 *	\return Pointer to primal solution (or null pointer). */
+		inline const real_t* getPrimalSolution( ) const;
+
+		/** Returns dual solution of the last request waited for (valid until its slot is reused).
+		 *	\return Pointer to dual solution (or null pointer). */
+		inline const real_t* getDualSolution( ) const;
+
+		/** Returns optimal objective function value of the last request waited for.
+		 *	\return Optimal objective function value (or +infinity). */
+		inline real_t getObjVal( ) const;
+
+		/** Returns number of variables of the channel.
+		 *	\return Number of variables. */
+		inline uint_t getNV( ) const;
+
+		/** Returns number of constraints of the channel.
+		 *	\return Number of constraints. */
+		inline uint_t getNC( ) const;
+
+		/** Asks the server to terminate.
+		 *	\return SUCCESSFUL_RETURN \n
+					RET_SERVICE_ATTACH_FAILED */
+		returnValue requestShutdown( );
+
+
+	/*
+	 *	PROTECTED MEMBER FUNCTIONS
+	 */
+	protected:
+		/** Copies data of a request into the next slot, submits it and waits for the solution.
+		 *	\return return value of solver \n
+					RET_SERVICE_ATTACH_FAILED \n
+					RET_SERVICE_BUSY */
+		returnValue request(	ServiceRequestType type,		/**< Type of request. */
+								const real_t* const _H,			/**< Hessian matrix (or null pointer). */
+								const real_t* const _g,			/**< Gradient vector. */
+								const real_t* const _A,			/**< Constraint matrix (or null pointer). */
+								const real_t* const _lb,		/**< Lower bounds (or null pointer). */
+								const real_t* const _ub,		/**< Upper bounds (or null pointer). */
+								const real_t* const _lbA,		/**< Lower constraints' bounds (or null pointer). */
+								const real_t* const _ubA,		/**< Upper constraints' bounds (or null pointer). */
+								int_t& nWSR,					/**< Input: Maximum number of working set recalculations; \n
+																	 Output: Number of performed working set recalculations. */
+								real_t* const cputime			/**< Input: Maximum CPU time. \n
+																	 Output: CPU time spent by server (if pointer passed). */
+								);
+
+		/** Copies given vector (or fills it with given value if null pointer is passed). */
+		static void copyVector(	real_t* const dest,				/**< Destination. */
+								const real_t* const src,		/**< Source (or null pointer). */
+								uint_t n,						/**< Length of vector. */
+								real_t value					/**< Value used for null pointer. */
+								);
+
+
+	/*
+	 *	PROTECTED MEMBER VARIABLES
+	 */
+	protected:
+		Channel* channel;				/**< Channel the client is attached to. */
+		uint_t submitted;				/**< Number of requests submitted. */
+		uint_t completed;				/**< Number of requests waited for. */
+		int_t nextBuffer;				/**< Matrix buffer to be used by the next request with new matrices. */
+		uint_t matrixRequest;			/**< Number of requests submitted up to the last one with new matrices (0 if none). */
+		BooleanType matricesWritten;	/**< Flag indicating that getMatrices() has been called for the next request. */
+		Slot* lastSlot;					/**< Slot of the last request waited for. */
+		real_t timeout;					/**< Maximum time waited for the server per request [s] (non-positive: no limit). */
+};
+
+
+END_NAMESPACE_QPOASES
+
+#include <qpOASES/extras/SolverService.ipp>
+
+#endif	/* QPOASES_SOLVERSERVICE_HPP */
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,208 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file include/qpOASES/extras/SolverService.ipp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Implementation of inlined member functions of the SolverService,
+ *	SolverServer and SolverClient classes.
+ */
+
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	g e t N u m C h a n n e l s
+ */
+inline uint_t SolverService::getNumChannels( ) const
+{
+	if ( header == 0 )
+		return 0;
+
+	return header->nChannels;
+}
+
+
+/*
+ *	g e t N u m S l o t s
+ */
+inline uint_t SolverService::getNumSlots( ) const
+{
+	if ( header == 0 )
+		return 0;
+
+	return header->nSlots;
+}
+
+
+/*
+ *	g e t P r o b l e m
+ */
+inline SQProblem* SolverServer::getProblem( uint_t number ) const
+{
+	if ( number >= getNumChannels( ) )
+		return 0;
+
+	return problems[number];
+}
+
+
+/*
+ *	g e t P r i m a l S o l u t i o n
+ */
+inline const real_t* SolverClient::getPrimalSolution( ) const
+{
+	if ( lastSlot == 0 )
+		return 0;
+
+	return getVector( channel,lastSlot,5 );
+}
+
+
+/*
+ *	g e t D u a l S o l u t i o n
+ */
+inline const real_t* SolverClient::getDualSolution( ) const
+{
+	if ( lastSlot == 0 )
+		return 0;
+
+	return getVector( channel,lastSlot,6 );
+}
+
+
+/*
+ *	g e t O b j V a l
+ */
+inline real_t SolverClient::getObjVal( ) const
+{
+	if ( lastSlot == 0 )
+		return INFTY;
+
+	return lastSlot->objVal;
+}
+
+
+/*
+ *	g e t N V
+ */
+inline uint_t SolverClient::getNV( ) const
+{
+	if ( channel == 0 )
+		return 0;
+
+	return channel->nV;
+}
+
+
+/*
+ *	g e t N C
+ */
+inline uint_t SolverClient::getNC( ) const
+{
+	if ( channel == 0 )
+		return 0;
+
+	return channel->nC;
+}
+
+
+
+/*****************************************************************************
+ *  P R O T E C T E D                                                        *
+ *****************************************************************************/
+
+
+/*
+ *	a l i g n
+ */
+inline size_t SolverService::align( size_t size )
+{
+	return ( ( size + 63 ) / 64 ) * 64;
+}
+
+
+/*
+ *	g e t C h a n n e l
+ */
+inline SolverService::Channel* SolverService::getChannel( uint_t number ) const
+{
+	return (Channel*)( (char*)base + align( sizeof(Header) ) + number*align( sizeof(Channel) ) );
+}
+
+
+/*
+ *	g e t S l o t
+ */
+inline SolverService::Slot* SolverService::getSlot( const Channel* const _channel, uint_t sequence ) const
+{
+	return (Slot*)( (char*)base + _channel->slotOffset + ( sequence & ( header->nSlots-1 ) )*_channel->slotSize );
+}
+
+
+/*
+ *	g e t V e c t o r
+ */
+inline real_t* SolverService::getVector( const Channel* const _channel, Slot* const slot, uint_t number ) const
+{
+	/* g, lb, ub are of length nV, lbA, ubA of length nC, xOpt of length nV */
+	static const uint_t offsetV[7] = { 0,1,2,3,3,3,4 };
+	static const uint_t offsetC[7] = { 0,0,0,0,1,2,2 };
+
+	real_t* vectors = (real_t*)( (char*)slot + align( sizeof(Slot) ) );
+
+	return &( vectors[ offsetV[number]*_channel->nV + offsetC[number]*_channel->nC ] );
+}
+
+
+/*
+ *	g e t M a t r i x
+ */
+inline real_t* SolverService::getMatrix( const Channel* const _channel, int_t buffer, uint_t number ) const
+{
+	real_t* matrices = (real_t*)( (char*)base + _channel->matrixOffset + buffer*_channel->matrixSize );
+
+	if ( number == 0 )
+		return matrices;
+	else
+		return &( matrices[_channel->nV*_channel->nV] );
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
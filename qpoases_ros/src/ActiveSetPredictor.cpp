@@ -0,0 +1,407 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file src/ActiveSetPredictor.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Implementation of the ActiveSetPredictor class which guesses the optimal
+ *	working set of the next QP of a sequence from the working sets of the
+ *	previous ones.
+ */
+
+
+#include <qpOASES/extras/ActiveSetPredictor.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	A c t i v e S e t P r e d i c t o r
+ */
+ActiveSetPredictor::ActiveSetPredictor(	int_t _nV, int_t _nC, int_t _nP, uint_t _capacity,
+										PredictionMode _mode
+										)
+{
+	uint_t i;
+
+	nV = ( _nV > 0 ) ? _nV : 0;
+	nC = ( _nC > 0 ) ? _nC : 0;
+	nP = ( _nP > 0 ) ? _nP : 0;
+	capacity = ( _capacity > 0 ) ? _capacity : 1;
+	mode = PM_MARKOV;
+
+	history = new int_t[capacity];
+	historyParams = ( nP > 0 ) ? new real_t[capacity*nP] : 0;
+
+	workingSets = new WorkingSet[capacity];
+	workingSetHash = new uint_t[capacity];
+	workingSetRefs = new uint_t[capacity];
+	for( i=0; i<capacity; ++i )
+	{
+		workingSets[i].init( nV,nC );
+		workingSetRefs[i] = 0;
+	}
+
+	workingSet = new real_t[nV+nC];
+	current.init( nV,nC );
+	counts = new uint_t[capacity];
+
+	guessedBounds.init( nV );
+	guessedConstraints.init( nC );
+
+	reset( );
+	setMode( _mode );
+}
+
+
+/*
+ *	~ A c t i v e S e t P r e d i c t o r
+ */
+ActiveSetPredictor::~ActiveSetPredictor( )
+{
+	delete[] history;
+
+	if ( historyParams != 0 )
+		delete[] historyParams;
+
+	delete[] workingSets;
+	delete[] workingSetHash;
+	delete[] workingSetRefs;
+
+	delete[] workingSet;
+	delete[] counts;
+}
+
+
+/*
+ *	r e s e t
+ */
+returnValue ActiveSetPredictor::reset( )
+{
+	uint_t i;
+
+	for( i=0; i<capacity; ++i )
+		workingSetRefs[i] = 0;
+
+	historyStart = 0;
+	nRecorded = 0;
+	nWorkingSets = 0;
+	nGuided = 0;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s e t M o d e
+ */
+returnValue ActiveSetPredictor::setMode(	PredictionMode _mode
+											)
+{
+	if ( ( _mode == PM_NEARESTNEIGHBOUR ) && ( nP == 0 ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	mode = _mode;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	r e c o r d
+ */
+returnValue ActiveSetPredictor::record(	QProblemB* const qp,
+										const real_t* const p
+										)
+{
+	int_t i;
+	uint_t j;
+
+	if ( ( nP > 0 ) && ( p == 0 ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	returnValue returnvalue = readWorkingSet( qp );
+	if ( returnvalue != SUCCESSFUL_RETURN )
+		return THROWERROR( returnvalue );
+
+	/* forget oldest tick (and possibly its working set) if history is full */
+	if ( nRecorded == capacity )
+	{
+		if ( --workingSetRefs[ history[historyStart] ] == 0 )
+			--nWorkingSets;
+
+		historyStart = ( historyStart+1 ) % capacity;
+		--nRecorded;
+	}
+
+	uint_t hash = current.getHash( );
+	int_t number = findWorkingSet( hash );
+
+	if ( number < 0 )
+	{
+		/* at most capacity-1 working sets are referenced at this point */
+		for( j=0; j<capacity; ++j )
+			if ( workingSetRefs[j] == 0 )
+				break;
+
+		number = (int_t)j;
+		workingSets[number] = current;
+		workingSetHash[number] = hash;
+		++nWorkingSets;
+	}
+
+	uint_t pos = ( historyStart+nRecorded ) % capacity;
+	history[pos] = number;
+	for( i=0; i<nP; ++i )
+		historyParams[pos*nP+i] = p[i];
+
+	++workingSetRefs[number];
+	++nRecorded;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	p r e d i c t
+ */
+returnValue ActiveSetPredictor::predict(	Bounds* const _guessedBounds,
+											Constraints* const _guessedConstraints,
+											const real_t* const p
+											)
+{
+	if ( ( _guessedBounds == 0 ) || ( ( nC > 0 ) && ( _guessedConstraints == 0 ) ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	if ( ( mode == PM_NEARESTNEIGHBOUR ) && ( p == 0 ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	int_t number = selectWorkingSet( p );
+	if ( number < 0 )
+		return RET_PREDICTION_NO_HISTORY;
+
+	return workingSets[number].get( _guessedBounds,_guessedConstraints );
+}
+
+
+/*
+ *	h o t s t a r t
+ */
+returnValue ActiveSetPredictor::hotstart(	QProblemB* const qp,
+											const real_t* const g_new,
+											const real_t* const lb_new, const real_t* const ub_new,
+											int_t& nWSR, real_t* const cputime,
+											const real_t* const p
+											)
+{
+	if ( qp == 0 )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	if ( readWorkingSet( qp ) != SUCCESSFUL_RETURN )
+		return THROWERROR( RET_PREDICTION_INVALID_DIMENSIONS );
+
+	/* only pass a guess if it differs from the current working set */
+	const Bounds* guess = 0;
+	int_t number = ( ( mode == PM_MARKOV ) || ( p != 0 ) ) ? selectWorkingSet( p ) : -1;
+
+	if ( ( number >= 0 ) && ( number != findWorkingSet( current.getHash( ) ) ) )
+	{
+		predict( &guessedBounds,0,p );
+		guess = &guessedBounds;
+		++nGuided;
+	}
+
+	returnValue returnvalue = qp->hotstart( g_new,lb_new,ub_new,nWSR,cputime,guess );
+
+	if ( ( returnvalue == SUCCESSFUL_RETURN ) && ( ( nP == 0 ) || ( p != 0 ) ) )
+		record( qp,p );
+
+	return returnvalue;
+}
+
+
+/*
+ *	h o t s t a r t
+ */
+returnValue ActiveSetPredictor::hotstart(	QProblem* const qp,
+											const real_t* const g_new,
+											const real_t* const lb_new, const real_t* const ub_new,
+											const real_t* const lbA_new, const real_t* const ubA_new,
+											int_t& nWSR, real_t* const cputime,
+											const real_t* const p
+											)
+{
+	if ( qp == 0 )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	if ( readWorkingSet( qp ) != SUCCESSFUL_RETURN )
+		return THROWERROR( RET_PREDICTION_INVALID_DIMENSIONS );
+
+	/* only pass a guess if it differs from the current working set */
+	const Bounds* guessB = 0;
+	const Constraints* guessC = 0;
+	int_t number = ( ( mode == PM_MARKOV ) || ( p != 0 ) ) ? selectWorkingSet( p ) : -1;
+
+	if ( ( number >= 0 ) && ( number != findWorkingSet( current.getHash( ) ) ) )
+	{
+		predict( &guessedBounds,&guessedConstraints,p );
+		guessB = &guessedBounds;
+		guessC = &guessedConstraints;
+		++nGuided;
+	}
+
+	returnValue returnvalue = qp->hotstart( g_new,lb_new,ub_new,lbA_new,ubA_new,nWSR,cputime,guessB,guessC );
+
+	if ( ( returnvalue == SUCCESSFUL_RETURN ) && ( ( nP == 0 ) || ( p != 0 ) ) )
+		record( qp,p );
+
+	return returnvalue;
+}
+
+
+
+/*****************************************************************************
+ *  P R O T E C T E D                                                        *
+ *****************************************************************************/
+
+
+/*
+ *	r e a d W o r k i n g S e t
+ */
+returnValue ActiveSetPredictor::readWorkingSet(	QProblemB* const qp
+												)
+{
+	if ( qp == 0 )
+		return RET_INVALID_ARGUMENTS;
+
+	QProblem* qpC = dynamic_cast<QProblem*>( qp );
+	int_t qpNC = ( qpC != 0 ) ? qpC->getNC( ) : 0;
+
+	if ( ( qp->getNV( ) != nV ) || ( qpNC != nC ) )
+		return RET_PREDICTION_INVALID_DIMENSIONS;
+
+	/* -1: at lower bound, 0: inactive, +1: at upper bound */
+	qp->getWorkingSet( workingSet );
+
+	return current.set( workingSet );
+}
+
+
+/*
+ *	f i n d W o r k i n g S e t
+ */
+int_t ActiveSetPredictor::findWorkingSet(	uint_t hash
+											) const
+{
+	uint_t j;
+
+	for( j=0; j<capacity; ++j )
+	{
+		if ( ( workingSetRefs[j] == 0 ) || ( workingSetHash[j] != hash ) )
+			continue;
+
+		if ( workingSets[j].isEqual( current ) == BT_TRUE )
+			return (int_t)j;
+	}
+
+	return -1;
+}
+
+
+/*
+ *	s e l e c t W o r k i n g S e t
+ */
+int_t ActiveSetPredictor::selectWorkingSet(	const real_t* const p
+											)
+{
+	uint_t j, pos;
+	int_t i;
+
+	if ( nRecorded == 0 )
+		return -1;
+
+	int_t best = history[ ( historyStart+nRecorded-1 ) % capacity ];
+
+	if ( mode == PM_NEARESTNEIGHBOUR )
+	{
+		/* working set of the tick with nearest parameters (most recent on ties) */
+		real_t bestDistance = INFTY;
+
+		for( j=0; j<nRecorded; ++j )
+		{
+			pos = ( historyStart+j ) % capacity;
+
+			real_t distance = 0.0;
+			for( i=0; i<nP; ++i )
+				distance += ( historyParams[pos*nP+i] - p[i] ) * ( historyParams[pos*nP+i] - p[i] );
+
+			if ( distance <= bestDistance )
+			{
+				bestDistance = distance;
+				best = history[pos];
+			}
+		}
+	}
+	else
+	{
+		/* most frequent successor of the last working set (most recent on ties);
+		 * if it has no successor yet, it is kept */
+		int_t last = best;
+		uint_t bestCount = 0;
+
+		for( j=0; j<capacity; ++j )
+			counts[j] = 0;
+
+		for( j=0; j+1<nRecorded; ++j )
+		{
+			if ( history[ ( historyStart+j ) % capacity ] != last )
+				continue;
+
+			int_t next = history[ ( historyStart+j+1 ) % capacity ];
+			if ( ++counts[next] >= bestCount )
+			{
+				bestCount = counts[next];
+				best = next;
+			}
+		}
+	}
+
+	return best;
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,317 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/**
+ *	\file src/AsyncOutput.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Implementation of the AsyncOutput class which moves all message output
+ *	of qpOASES off the solver thread.
+ */
+
+
+#include <stdarg.h>
+
+#ifndef __NO_THREADS__
+  #include <unistd.h>
+#endif
+
+#include <qpOASES/AsyncOutput.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	A s y n c O u t p u t
+ */
+AsyncOutput::AsyncOutput(	uint_t _nSlots,
+							FILE* _outputFile,
+							uint_t _pollingPeriod
+							)
+{
+	/* round number of slots up to a power of two (allows cheap wrap-around) */
+	nSlots = 1;
+	while ( nSlots < _nSlots )
+		nSlots *= 2;
+
+	buffer = new char[nSlots*MAX_STRING_LENGTH];
+
+	head     = 0;
+	tail     = 0;
+	nDropped = 0;
+
+	outputFile    = _outputFile;
+	pollingPeriod = _pollingPeriod;
+
+	running       = BT_FALSE;
+	stopRequested = BT_FALSE;
+}
+
+
+/*
+ *	~ A s y n c O u t p u t
+ */
+AsyncOutput::~AsyncOutput( )
+{
+	/* make sure the global message handler does not refer to a dead backend */
+	if ( getGlobalMessageHandler( )->getAsyncOutput( ) == this )
+		getGlobalMessageHandler( )->setAsyncOutput( 0 );
+
+	stop( );
+
+	if ( buffer != 0 )
+	{
+		delete[] buffer;
+		buffer = 0;
+	}
+}
+
+
+/*
+ *	s t a r t
+ */
+returnValue AsyncOutput::start( )
+{
+	if ( running == BT_TRUE )
+		return SUCCESSFUL_RETURN;
+
+	#ifndef __NO_THREADS__
+	__atomic_store_n( &stopRequested,BT_FALSE,__ATOMIC_RELEASE );
+
+	if ( pthread_create( &thread,0,AsyncOutput::run,this ) != 0 )
+		return THROWERROR( RET_ASYNC_OUTPUT_START_FAILED );
+
+	running = BT_TRUE;
+	#endif /* __NO_THREADS__ */
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s t o p
+ */
+returnValue AsyncOutput::stop( )
+{
+	#ifndef __NO_THREADS__
+	if ( running == BT_TRUE )
+	{
+		__atomic_store_n( &stopRequested,BT_TRUE,__ATOMIC_RELEASE );
+		pthread_join( thread,0 );
+		running = BT_FALSE;
+	}
+	#endif /* __NO_THREADS__ */
+
+	/* write whatever might have been left over */
+	drain( );
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	f l u s h
+ */
+returnValue AsyncOutput::flush( )
+{
+	if ( running == BT_FALSE )
+	{
+		drain( );
+		return RET_ASYNC_OUTPUT_NOT_RUNNING;
+	}
+
+	#ifndef __NO_THREADS__
+	while ( getNumPending( ) > 0 )
+		usleep( pollingPeriod );
+	#endif /* __NO_THREADS__ */
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	w r i t e
+ */
+returnValue AsyncOutput::write( const char* s )
+{
+	if ( s == 0 )
+		return RET_INVALID_ARGUMENTS;
+
+	if ( running == BT_FALSE )
+	{
+		/* no output thread, fall back to synchronous output */
+		if ( outputFile != 0 )
+			fputs( s,outputFile );
+		return SUCCESSFUL_RETURN;
+	}
+
+	#ifndef __NO_THREADS__
+	/* split message into chunks of at most MAX_STRING_LENGTH-1 characters;
+	 * reserve all of them up front so that a message is either enqueued
+	 * completely or dropped completely */
+	uint_t length = 0;
+	while ( s[length] != '\0' )
+		++length;
+
+	uint_t nChunks = ( length + MAX_STRING_LENGTH-2 ) / ( MAX_STRING_LENGTH-1 );
+	if ( nChunks == 0 )
+		nChunks = 1;
+
+	uint_t h = head;
+	if ( h - __atomic_load_n( &tail,__ATOMIC_ACQUIRE ) + nChunks > nSlots )
+	{
+		++nDropped;
+		return RET_ASYNC_OUTPUT_MESSAGE_DROPPED;
+	}
+
+	for( uint_t i=0; i<nChunks; ++i )
+	{
+		char* slot = &(buffer[ ((h+i) & (nSlots-1)) * MAX_STRING_LENGTH ]);
+		uint_t len = 0;
+		while ( ( len < MAX_STRING_LENGTH-1 ) && ( s[len] != '\0' ) )
+		{
+			slot[len] = s[len];
+			++len;
+		}
+		slot[len] = '\0';
+		s += len;
+	}
+
+	/* publish all chunks at once */
+	__atomic_store_n( &head,h+nChunks,__ATOMIC_RELEASE );
+	#endif /* __NO_THREADS__ */
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	w r i t e f
+ */
+returnValue AsyncOutput::writef( const char* format, ... )
+{
+	if ( format == 0 )
+		return RET_INVALID_ARGUMENTS;
+
+	va_list args;
+
+	if ( running == BT_FALSE )
+	{
+		if ( outputFile != 0 )
+		{
+			va_start( args,format );
+			vfprintf( outputFile,format,args );
+			va_end( args );
+		}
+		return SUCCESSFUL_RETURN;
+	}
+
+	#ifndef __NO_THREADS__
+	uint_t h = head;
+	if ( h - __atomic_load_n( &tail,__ATOMIC_ACQUIRE ) >= nSlots )
+	{
+		++nDropped;
+		return RET_ASYNC_OUTPUT_MESSAGE_DROPPED;
+	}
+
+	/* format directly into the slot, longer messages are truncated */
+	char* slot = &(buffer[ (h & (nSlots-1)) * MAX_STRING_LENGTH ]);
+	va_start( args,format );
+	vsnprintf( slot,MAX_STRING_LENGTH,format,args );
+	va_end( args );
+
+	__atomic_store_n( &head,h+1,__ATOMIC_RELEASE );
+	#endif /* __NO_THREADS__ */
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+
+/*****************************************************************************
+ *  P R O T E C T E D                                                        *
+ *****************************************************************************/
+
+/*
+ *	d r a i n
+ */
+uint_t AsyncOutput::drain( )
+{
+	uint_t nWritten = 0;
+
+	#ifndef __NO_THREADS__
+	uint_t t = tail;
+	uint_t h = __atomic_load_n( &head,__ATOMIC_ACQUIRE );
+
+	while ( t != h )
+	{
+		if ( outputFile != 0 )
+			fputs( &(buffer[ (t & (nSlots-1)) * MAX_STRING_LENGTH ]),outputFile );
+
+		++t;
+		++nWritten;
+		__atomic_store_n( &tail,t,__ATOMIC_RELEASE );
+	}
+
+	if ( ( nWritten > 0 ) && ( outputFile != 0 ) )
+		fflush( outputFile );
+	#endif /* __NO_THREADS__ */
+
+	return nWritten;
+}
+
+
+/*
+ *	r u n
+ */
+void* AsyncOutput::run( void* arg )
+{
+	#ifndef __NO_THREADS__
+	AsyncOutput* self = static_cast<AsyncOutput*>( arg );
+
+	while ( __atomic_load_n( &(self->stopRequested),__ATOMIC_ACQUIRE ) == BT_FALSE )
+	{
+		if ( self->drain( ) == 0 )
+			usleep( self->pollingPeriod );
+	}
+
+	self->drain( );
+	#endif /* __NO_THREADS__ */
+
+	return 0;
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
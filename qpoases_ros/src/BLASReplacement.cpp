@@ -33,6 +33,7 @@
 
 
 #include <qpOASES/Utils.hpp>
+#include <qpOASES/SimdKernels.hpp>
 
 
 extern "C" void dgemm_(	const char* TRANSA, const char* TRANSB,
@@ -56,6 +57,24 @@ extern "C" void dgemm_(	const char* TRANSA, const char* TRANSB,
 			for (j = 0; j < *M; j++)
 				C[j+(*LDC)*k] *= *BETA;
 
+	/* vectorised kernels run along contiguous columns of A and C */
+	if ( REFER_NAMESPACE_QPOASES getSimdVariant( ) != REFER_NAMESPACE_QPOASES SV_SCALAR )
+	{
+		if (TRANSA[0] == 'N')
+		{
+			for (k = 0; k < *N; k++)
+				for (i = 0; i < *K; i++)
+					REFER_NAMESPACE_QPOASES simdAxpy( *M,*ALPHA * B[i+(*LDB)*k],&(A[(*LDA)*i]),&(C[(*LDC)*k]) );
+		}
+		else
+		{
+			for (k = 0; k < *N; k++)
+				for (j = 0; j < *M; j++)
+					C[j+(*LDC)*k] += *ALPHA * REFER_NAMESPACE_QPOASES simdDot( *K,&(A[(*LDA)*j]),&(B[(*LDB)*k]) );
+		}
+		return;
+	}
+
 	if (TRANSA[0] == 'N')
 		if ( REFER_NAMESPACE_QPOASES isEqual(*ALPHA,1.0) == REFER_NAMESPACE_QPOASES BT_TRUE )
 			for (k = 0; k < *N; k++)
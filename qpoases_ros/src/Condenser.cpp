@@ -0,0 +1,955 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file src/Condenser.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Implementation of the Condenser class which builds dense QPs from
+ *	stage-wise MPC data and keeps them up to date incrementally.
+ */
+
+
+#include <qpOASES/Condenser.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	C o n d e n s e r
+ */
+Condenser::Condenser( )
+{
+	nX = nU = nN = 0;
+
+	dynA = dynB = dynC = 0;
+	costQ = costR = costq = costr = 0;
+	lbx = ubx = x0 = 0;
+
+	changedDynamics = changedQ = changedR = 0;
+	matricesChanged = BT_FALSE;
+
+	sens = traj = adj = 0;
+	firstGamma = firstSens = 0;
+
+	hessian = constraintMatrix = 0;
+	H = 0;
+	A = 0;
+
+	g = lb = ub = lbA = ubA = 0;
+}
+
+
+/*
+ *	C o n d e n s e r
+ */
+Condenser::Condenser( uint_t _nX, uint_t _nU, uint_t _nN )
+{
+	nX = nU = nN = 0;
+
+	dynA = dynB = dynC = 0;
+	costQ = costR = costq = costr = 0;
+	lbx = ubx = x0 = 0;
+
+	changedDynamics = changedQ = changedR = 0;
+	matricesChanged = BT_FALSE;
+
+	sens = traj = adj = 0;
+	firstGamma = firstSens = 0;
+
+	hessian = constraintMatrix = 0;
+	H = 0;
+	A = 0;
+
+	g = lb = ub = lbA = ubA = 0;
+
+	init( _nX,_nU,_nN );
+}
+
+
+/*
+ *	C o n d e n s e r
+ */
+Condenser::Condenser( const Condenser& rhs )
+{
+	nX = nU = nN = 0;
+
+	dynA = dynB = dynC = 0;
+	costQ = costR = costq = costr = 0;
+	lbx = ubx = x0 = 0;
+
+	changedDynamics = changedQ = changedR = 0;
+	matricesChanged = BT_FALSE;
+
+	sens = traj = adj = 0;
+	firstGamma = firstSens = 0;
+
+	hessian = constraintMatrix = 0;
+	H = 0;
+	A = 0;
+
+	g = lb = ub = lbA = ubA = 0;
+
+	copy( rhs );
+}
+
+
+/*
+ *	~ C o n d e n s e r
+ */
+Condenser::~Condenser( )
+{
+	clear( );
+}
+
+
+/*
+ *	o p e r a t o r =
+ */
+Condenser& Condenser::operator=( const Condenser& rhs )
+{
+	if ( this != &rhs )
+	{
+		clear( );
+		copy( rhs );
+	}
+
+	return *this;
+}
+
+
+/*
+ *	i n i t
+ */
+returnValue Condenser::init( uint_t _nX, uint_t _nU, uint_t _nN )
+{
+	uint_t i;
+
+	if ( ( _nX == 0 ) || ( _nU == 0 ) || ( _nN == 0 ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	clear( );
+
+	nX = _nX;
+	nU = _nU;
+	nN = _nN;
+
+	uint_t nV = getNV( );
+	uint_t nC = getNC( );
+
+	dynA  = new real_t[nN*nX*nX];
+	dynB  = new real_t[nN*nX*nU];
+	dynC  = new real_t[nN*nX];
+	costQ = new real_t[(nN+1)*nX*nX];
+	costR = new real_t[nN*nU*nU];
+	costq = new real_t[(nN+1)*nX];
+	costr = new real_t[nN*nU];
+	lbx   = new real_t[nC];
+	ubx   = new real_t[nC];
+	x0    = new real_t[nX];
+
+	memset( dynA,0,nN*nX*nX*sizeof(real_t) );
+	memset( dynB,0,nN*nX*nU*sizeof(real_t) );
+	memset( dynC,0,nN*nX*sizeof(real_t) );
+	memset( costQ,0,(nN+1)*nX*nX*sizeof(real_t) );
+	memset( costR,0,nN*nU*nU*sizeof(real_t) );
+	memset( costq,0,(nN+1)*nX*sizeof(real_t) );
+	memset( costr,0,nN*nU*sizeof(real_t) );
+	memset( x0,0,nX*sizeof(real_t) );
+
+	for( i=0; i<nC; ++i )
+	{
+		lbx[i] = -INFTY;
+		ubx[i] =  INFTY;
+	}
+
+	/* first update has to compute everything */
+	changedDynamics = new BooleanType[nN];
+	changedQ = new BooleanType[nN+1];
+	changedR = new BooleanType[nN];
+
+	for( i=0; i<nN; ++i )
+	{
+		changedDynamics[i] = BT_TRUE;
+		changedR[i] = BT_TRUE;
+	}
+	for( i=0; i<=nN; ++i )
+		changedQ[i] = BT_TRUE;
+
+	matricesChanged = BT_TRUE;
+
+	sens = new real_t[nN*nN*nX*nU];
+	firstGamma = new uint_t[nN];
+	firstSens = new uint_t[nN];
+	traj = new real_t[(nN+1)*nX];
+	adj = new real_t[(nN+1)*nX];
+
+	memset( sens,0,nN*nN*nX*nU*sizeof(real_t) );
+
+	/* blocks above the block diagonal of the constraint matrix stay zero */
+	hessian = new real_t[nV*nV];
+	constraintMatrix = new real_t[nC*nV];
+
+	memset( hessian,0,nV*nV*sizeof(real_t) );
+	memset( constraintMatrix,0,nC*nV*sizeof(real_t) );
+
+	H = new SymDenseMat( (int_t)nV,(int_t)nV,(int_t)nV,hessian );
+	A = new DenseMatrix( (int_t)nC,(int_t)nV,(int_t)nV,constraintMatrix );
+
+	g   = new real_t[nV];
+	lb  = new real_t[nV];
+	ub  = new real_t[nV];
+	lbA = new real_t[nC];
+	ubA = new real_t[nC];
+
+	memset( g,0,nV*sizeof(real_t) );
+
+	for( i=0; i<nV; ++i )
+	{
+		lb[i] = -INFTY;
+		ub[i] =  INFTY;
+	}
+
+	for( i=0; i<nC; ++i )
+	{
+		lbA[i] = -INFTY;
+		ubA[i] =  INFTY;
+	}
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s e t D y n a m i c s
+ */
+returnValue Condenser::setDynamics(	uint_t stage,
+									const real_t* const _A, const real_t* const _B, const real_t* const _c
+									)
+{
+	if ( stage >= nN )
+		return THROWERROR( RET_INDEX_OUT_OF_BOUNDS );
+
+	if ( ( _A == 0 ) || ( _B == 0 ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	if ( assign( &(dynA[stage*nX*nX]),_A,nX*nX ) == BT_TRUE )
+		changedDynamics[stage] = BT_TRUE;
+
+	if ( assign( &(dynB[stage*nX*nU]),_B,nX*nU ) == BT_TRUE )
+		changedDynamics[stage] = BT_TRUE;
+
+	assign( &(dynC[stage*nX]),_c,nX );
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s e t S t a g e C o s t
+ */
+returnValue Condenser::setStageCost(	uint_t stage,
+										const real_t* const _Q, const real_t* const _R,
+										const real_t* const _q, const real_t* const _r
+										)
+{
+	if ( stage >= nN )
+		return THROWERROR( RET_INDEX_OUT_OF_BOUNDS );
+
+	if ( ( _Q == 0 ) || ( _R == 0 ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	if ( assign( &(costQ[stage*nX*nX]),_Q,nX*nX ) == BT_TRUE )
+		changedQ[stage] = BT_TRUE;
+
+	if ( assign( &(costR[stage*nU*nU]),_R,nU*nU ) == BT_TRUE )
+		changedR[stage] = BT_TRUE;
+
+	assign( &(costq[stage*nX]),_q,nX );
+	assign( &(costr[stage*nU]),_r,nU );
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s e t T e r m i n a l C o s t
+ */
+returnValue Condenser::setTerminalCost(	const real_t* const _Q, const real_t* const _q
+										)
+{
+	if ( ( nN == 0 ) || ( _Q == 0 ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	if ( assign( &(costQ[nN*nX*nX]),_Q,nX*nX ) == BT_TRUE )
+		changedQ[nN] = BT_TRUE;
+
+	assign( &(costq[nN*nX]),_q,nX );
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s e t I n p u t B o u n d s
+ */
+returnValue Condenser::setInputBounds(	uint_t stage,
+										const real_t* const _lbu, const real_t* const _ubu
+										)
+{
+	uint_t i;
+
+	if ( stage >= nN )
+		return THROWERROR( RET_INDEX_OUT_OF_BOUNDS );
+
+	for( i=0; i<nU; ++i )
+	{
+		lb[stage*nU+i] = ( _lbu != 0 ) ? _lbu[i] : -INFTY;
+		ub[stage*nU+i] = ( _ubu != 0 ) ? _ubu[i] :  INFTY;
+	}
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s e t S t a t e B o u n d s
+ */
+returnValue Condenser::setStateBounds(	uint_t stage,
+										const real_t* const _lbx, const real_t* const _ubx
+										)
+{
+	uint_t i;
+
+	if ( ( stage == 0 ) || ( stage > nN ) )
+		return THROWERROR( RET_INDEX_OUT_OF_BOUNDS );
+
+	for( i=0; i<nX; ++i )
+	{
+		lbx[(stage-1)*nX+i] = ( _lbx != 0 ) ? _lbx[i] : -INFTY;
+		ubx[(stage-1)*nX+i] = ( _ubx != 0 ) ? _ubx[i] :  INFTY;
+	}
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s e t I n i t i a l S t a t e
+ */
+returnValue Condenser::setInitialState(	const real_t* const _x0
+										)
+{
+	if ( ( nN == 0 ) || ( _x0 == 0 ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	memcpy( x0,_x0,nX*sizeof(real_t) );
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	u p d a t e
+ */
+returnValue Condenser::update( )
+{
+	uint_t i, j, k;
+
+	if ( nN == 0 )
+		return THROWERROR( RET_QPOBJECT_NOT_SETUP );
+
+	uint_t nV  = getNV( );
+	uint_t nXX = nX*nX;
+	uint_t nXU = nX*nU;
+	uint_t ldA = nV;	/* leading dimension of the constraint matrix */
+
+	for( k=0; k<nN; ++k )
+		if ( ( changedDynamics[k] == BT_TRUE ) || ( changedR[k] == BT_TRUE ) || ( changedQ[k+1] == BT_TRUE ) )
+			matricesChanged = BT_TRUE;
+
+
+	/* 1) Block column j of the constraint matrix holds Gamma_{k,j} = dx_k/du_j
+	 *    = A_{k-1}*...*A_{j+1}*B_j (k>j), which depends on the dynamics of
+	 *    stages j,...,k-1 only. Recompute it from the first changed stage on. */
+	for( j=0; j<nN; ++j )
+	{
+		firstGamma[j] = nN+1;
+		for( k=j; k<nN; ++k )
+		{
+			if ( changedDynamics[k] == BT_TRUE )
+			{
+				firstGamma[j] = k+1;
+				break;
+			}
+		}
+
+		for( k=firstGamma[j]; k<=nN; ++k )
+		{
+			real_t* Gamma = &(constraintMatrix[(k-1)*nX*ldA + j*nU]);
+
+			if ( k == j+1 )
+			{
+				for( i=0; i<nX; ++i )
+					memcpy( &(Gamma[i*ldA]),&(dynB[j*nXU + i*nU]),nU*sizeof(real_t) );
+			}
+			else
+				multiplyNN( nX,nU,nX, &(dynA[(k-1)*nXX]),nX, &(constraintMatrix[(k-2)*nX*ldA + j*nU]),ldA, Gamma,ldA, BT_FALSE );
+		}
+	}
+
+
+	/* 2) Sensitivities V_{k,j} = [k>j]*Q_k*Gamma_{k,j} + A_k'*V_{k+1,j} of block
+	 *    column j change for all k <= k0, where k0 is the last stage with changed
+	 *    A_k, changed Q_k (k>j) or changed Gamma_{k,j}. */
+	uint_t lastDynamics = 0;
+	for( k=nN-1; k>0; --k )
+	{
+		if ( changedDynamics[k] == BT_TRUE )
+		{
+			lastDynamics = k;
+			break;
+		}
+	}
+
+	for( j=0; j<nN; ++j )
+	{
+		uint_t k0 = lastDynamics;
+
+		for( k=nN; k>j; --k )
+		{
+			if ( changedQ[k] == BT_TRUE )
+			{
+				if ( k > k0 )
+					k0 = k;
+				break;
+			}
+		}
+
+		if ( firstGamma[j] <= nN )
+			k0 = nN;
+
+		firstSens[j] = k0;
+
+		for( k=k0; k>0; --k )
+		{
+			real_t* V = &(sens[(j*nN + k-1)*nXU]);
+			BooleanType add = BT_FALSE;
+
+			if ( k > j )
+			{
+				multiplyNN( nX,nU,nX, &(costQ[k*nXX]),nX, &(constraintMatrix[(k-1)*nX*ldA + j*nU]),ldA, V,nU, BT_FALSE );
+				add = BT_TRUE;
+			}
+
+			if ( k < nN )
+				multiplyTN( nX,nU,nX, &(dynA[k*nXX]),nX, &(V[nXU]),nU, V,nU, add );
+		}
+	}
+
+
+	/* 3) Hessian blocks H_{i,j} = [i==j]*R_j + B_i'*V_{i+1,j} (i<=j). All diagonal
+	 *    blocks are rewritten whenever a matrix changes, as a QP might have
+	 *    regularised the diagonal of the previous Hessian. */
+	for( j=0; j<nN; ++j )
+	{
+		for( i=0; i<=j; ++i )
+		{
+			if ( ( i+1 > firstSens[j] ) && ( changedDynamics[i] == BT_FALSE ) &&
+				 ( ( i != j ) || ( matricesChanged == BT_FALSE ) ) )
+				continue;
+
+			real_t* Hij = &(hessian[i*nU*nV + j*nU]);
+
+			multiplyTN( nU,nU,nX, &(dynB[i*nXU]),nU, &(sens[(j*nN + i)*nXU]),nU, Hij,nV, BT_FALSE );
+
+			if ( i == j )
+			{
+				uint_t ii, jj;
+				real_t* Rj = &(costR[j*nU*nU]);
+
+				for( ii=0; ii<nU; ++ii )
+				{
+					Hij[ii*nV+ii] += Rj[ii*nU+ii];
+
+					/* enforce exact symmetry */
+					for( jj=ii+1; jj<nU; ++jj )
+					{
+						Hij[ii*nV+jj] = 0.5 * ( Hij[ii*nV+jj] + Hij[jj*nV+ii] + Rj[ii*nU+jj] + Rj[jj*nU+ii] );
+						Hij[jj*nV+ii] = Hij[ii*nV+jj];
+					}
+				}
+			}
+			else
+			{
+				uint_t ii, jj;
+				real_t* Hji = &(hessian[j*nU*nV + i*nU]);
+
+				for( ii=0; ii<nU; ++ii )
+					for( jj=0; jj<nU; ++jj )
+						Hji[jj*nV+ii] = Hij[ii*nV+jj];
+			}
+		}
+	}
+
+
+	/* 4) Free state trajectory, adjoints, gradient and constraints' bounds. */
+	memcpy( traj,x0,nX*sizeof(real_t) );
+	for( k=0; k<nN; ++k )
+	{
+		memcpy( &(traj[(k+1)*nX]),&(dynC[k*nX]),nX*sizeof(real_t) );
+		multiplyNN( nX,1,nX, &(dynA[k*nXX]),nX, &(traj[k*nX]),1, &(traj[(k+1)*nX]),1, BT_TRUE );
+	}
+
+	memcpy( &(adj[nN*nX]),&(costq[nN*nX]),nX*sizeof(real_t) );
+	multiplyNN( nX,1,nX, &(costQ[nN*nXX]),nX, &(traj[nN*nX]),1, &(adj[nN*nX]),1, BT_TRUE );
+	for( k=nN-1; k>0; --k )
+	{
+		memcpy( &(adj[k*nX]),&(costq[k*nX]),nX*sizeof(real_t) );
+		multiplyNN( nX,1,nX, &(costQ[k*nXX]),nX, &(traj[k*nX]),1, &(adj[k*nX]),1, BT_TRUE );
+		multiplyTN( nX,1,nX, &(dynA[k*nXX]),nX, &(adj[(k+1)*nX]),1, &(adj[k*nX]),1, BT_TRUE );
+	}
+
+	for( j=0; j<nN; ++j )
+	{
+		memcpy( &(g[j*nU]),&(costr[j*nU]),nU*sizeof(real_t) );
+		multiplyTN( nU,1,nX, &(dynB[j*nXU]),nU, &(adj[(j+1)*nX]),1, &(g[j*nU]),1, BT_TRUE );
+	}
+
+	for( i=0; i<getNC( ); ++i )
+	{
+		lbA[i] = ( lbx[i] <= -INFTY ) ? -INFTY : lbx[i] - traj[nX+i];
+		ubA[i] = ( ubx[i] >=  INFTY ) ?  INFTY : ubx[i] - traj[nX+i];
+	}
+
+
+	for( k=0; k<nN; ++k )
+	{
+		changedDynamics[k] = BT_FALSE;
+		changedR[k] = BT_FALSE;
+	}
+	for( k=0; k<=nN; ++k )
+		changedQ[k] = BT_FALSE;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	i n i t
+ */
+returnValue Condenser::init(	SQProblem& qp,
+								int_t& nWSR, real_t* const cputime
+								)
+{
+	if ( nN == 0 )
+		return THROWERROR( RET_QPOBJECT_NOT_SETUP );
+
+	if ( ( qp.getNV( ) != (int_t)getNV( ) ) || ( qp.getNC( ) != (int_t)getNC( ) ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	if ( update( ) != SUCCESSFUL_RETURN )
+		return THROWERROR( RET_QPOBJECT_NOT_SETUP );
+
+	matricesChanged = BT_FALSE;
+
+	return qp.init( H,g,A,lb,ub,lbA,ubA,nWSR,cputime );
+}
+
+
+/*
+ *	h o t s t a r t
+ */
+returnValue Condenser::hotstart(	SQProblem& qp,
+									int_t& nWSR, real_t* const cputime
+									)
+{
+	if ( update( ) != SUCCESSFUL_RETURN )
+		return THROWERROR( RET_QPOBJECT_NOT_SETUP );
+
+	if ( matricesChanged == BT_FALSE )
+		return qp.hotstart( g,lb,ub,lbA,ubA,nWSR,cputime );
+
+	matricesChanged = BT_FALSE;
+
+	return qp.hotstart( H,g,A,lb,ub,lbA,ubA,nWSR,cputime );
+}
+
+
+/*
+ *	e x p a n d S o l u t i o n
+ */
+returnValue Condenser::expandSolution(	const real_t* const uOpt, real_t* const xOpt
+										) const
+{
+	uint_t k;
+
+	if ( ( nN == 0 ) || ( uOpt == 0 ) || ( xOpt == 0 ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	memcpy( xOpt,x0,nX*sizeof(real_t) );
+	for( k=0; k<nN; ++k )
+	{
+		memcpy( &(xOpt[(k+1)*nX]),&(dynC[k*nX]),nX*sizeof(real_t) );
+		multiplyNN( nX,1,nX, &(dynA[k*nX*nX]),nX, &(xOpt[k*nX]),1, &(xOpt[(k+1)*nX]),1, BT_TRUE );
+		multiplyNN( nX,1,nU, &(dynB[k*nX*nU]),nU, &(uOpt[k*nU]),1, &(xOpt[(k+1)*nX]),1, BT_TRUE );
+	}
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+
+/*****************************************************************************
+ *  P R O T E C T E D                                                        *
+ *****************************************************************************/
+
+
+/*
+ *	c l e a r
+ */
+returnValue Condenser::clear( )
+{
+	if ( dynA != 0 )
+	{
+		delete[] dynA;
+		dynA = 0;
+	}
+
+	if ( dynB != 0 )
+	{
+		delete[] dynB;
+		dynB = 0;
+	}
+
+	if ( dynC != 0 )
+	{
+		delete[] dynC;
+		dynC = 0;
+	}
+
+	if ( costQ != 0 )
+	{
+		delete[] costQ;
+		costQ = 0;
+	}
+
+	if ( costR != 0 )
+	{
+		delete[] costR;
+		costR = 0;
+	}
+
+	if ( costq != 0 )
+	{
+		delete[] costq;
+		costq = 0;
+	}
+
+	if ( costr != 0 )
+	{
+		delete[] costr;
+		costr = 0;
+	}
+
+	if ( lbx != 0 )
+	{
+		delete[] lbx;
+		lbx = 0;
+	}
+
+	if ( ubx != 0 )
+	{
+		delete[] ubx;
+		ubx = 0;
+	}
+
+	if ( x0 != 0 )
+	{
+		delete[] x0;
+		x0 = 0;
+	}
+
+	if ( sens != 0 )
+	{
+		delete[] sens;
+		sens = 0;
+	}
+
+	if ( traj != 0 )
+	{
+		delete[] traj;
+		traj = 0;
+	}
+
+	if ( adj != 0 )
+	{
+		delete[] adj;
+		adj = 0;
+	}
+
+	if ( hessian != 0 )
+	{
+		delete[] hessian;
+		hessian = 0;
+	}
+
+	if ( constraintMatrix != 0 )
+	{
+		delete[] constraintMatrix;
+		constraintMatrix = 0;
+	}
+
+	if ( g != 0 )
+	{
+		delete[] g;
+		g = 0;
+	}
+
+	if ( lb != 0 )
+	{
+		delete[] lb;
+		lb = 0;
+	}
+
+	if ( ub != 0 )
+	{
+		delete[] ub;
+		ub = 0;
+	}
+
+	if ( lbA != 0 )
+	{
+		delete[] lbA;
+		lbA = 0;
+	}
+
+	if ( ubA != 0 )
+	{
+		delete[] ubA;
+		ubA = 0;
+	}
+
+	if ( changedDynamics != 0 )
+	{
+		delete[] changedDynamics;
+		changedDynamics = 0;
+	}
+
+	if ( changedQ != 0 )
+	{
+		delete[] changedQ;
+		changedQ = 0;
+	}
+
+	if ( changedR != 0 )
+	{
+		delete[] changedR;
+		changedR = 0;
+	}
+
+	if ( firstGamma != 0 )
+	{
+		delete[] firstGamma;
+		firstGamma = 0;
+	}
+
+	if ( firstSens != 0 )
+	{
+		delete[] firstSens;
+		firstSens = 0;
+	}
+
+	/* matrices do not own their values */
+	if ( H != 0 )
+	{
+		delete H;
+		H = 0;
+	}
+
+	if ( A != 0 )
+	{
+		delete A;
+		A = 0;
+	}
+
+	nX = nU = nN = 0;
+	matricesChanged = BT_FALSE;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	c o p y
+ */
+returnValue Condenser::copy(	const Condenser& rhs
+								)
+{
+	if ( rhs.nN == 0 )
+		return SUCCESSFUL_RETURN;
+
+	init( rhs.nX,rhs.nU,rhs.nN );
+
+	uint_t nV = getNV( );
+	uint_t nC = getNC( );
+
+	memcpy( dynA,rhs.dynA,nN*nX*nX*sizeof(real_t) );
+	memcpy( dynB,rhs.dynB,nN*nX*nU*sizeof(real_t) );
+	memcpy( dynC,rhs.dynC,nN*nX*sizeof(real_t) );
+	memcpy( costQ,rhs.costQ,(nN+1)*nX*nX*sizeof(real_t) );
+	memcpy( costR,rhs.costR,nN*nU*nU*sizeof(real_t) );
+	memcpy( costq,rhs.costq,(nN+1)*nX*sizeof(real_t) );
+	memcpy( costr,rhs.costr,nN*nU*sizeof(real_t) );
+	memcpy( lbx,rhs.lbx,nC*sizeof(real_t) );
+	memcpy( ubx,rhs.ubx,nC*sizeof(real_t) );
+	memcpy( x0,rhs.x0,nX*sizeof(real_t) );
+
+	memcpy( changedDynamics,rhs.changedDynamics,nN*sizeof(BooleanType) );
+	memcpy( changedQ,rhs.changedQ,(nN+1)*sizeof(BooleanType) );
+	memcpy( changedR,rhs.changedR,nN*sizeof(BooleanType) );
+	matricesChanged = rhs.matricesChanged;
+
+	memcpy( sens,rhs.sens,nN*nN*nX*nU*sizeof(real_t) );
+	memcpy( hessian,rhs.hessian,nV*nV*sizeof(real_t) );
+	memcpy( constraintMatrix,rhs.constraintMatrix,nC*nV*sizeof(real_t) );
+
+	memcpy( g,rhs.g,nV*sizeof(real_t) );
+	memcpy( lb,rhs.lb,nV*sizeof(real_t) );
+	memcpy( ub,rhs.ub,nV*sizeof(real_t) );
+	memcpy( lbA,rhs.lbA,nC*sizeof(real_t) );
+	memcpy( ubA,rhs.ubA,nC*sizeof(real_t) );
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	a s s i g n
+ */
+BooleanType Condenser::assign(	real_t* const block, const real_t* const values, uint_t n
+								)
+{
+	uint_t i;
+	BooleanType hasChanged = BT_FALSE;
+
+	for( i=0; i<n; ++i )
+	{
+		real_t value = ( values != 0 ) ? values[i] : 0.0;
+
+		if ( block[i] != value )
+		{
+			block[i] = value;
+			hasChanged = BT_TRUE;
+		}
+	}
+
+	return hasChanged;
+}
+
+
+/*
+ *	m u l t i p l y N N
+ */
+void Condenser::multiplyNN(	uint_t m, uint_t n, uint_t p,
+							const real_t* const A, uint_t ldA,
+							const real_t* const B, uint_t ldB,
+							real_t* const C, uint_t ldC,
+							BooleanType add
+							)
+{
+	uint_t i, j, l;
+
+	/* row-wise loop order, innermost loop runs over contiguous entries */
+	for( i=0; i<m; ++i )
+	{
+		real_t* Ci = &(C[i*ldC]);
+
+		if ( add == BT_FALSE )
+			for( j=0; j<n; ++j )
+				Ci[j] = 0.0;
+
+		for( l=0; l<p; ++l )
+		{
+			real_t a = A[i*ldA+l];
+			const real_t* Bl = &(B[l*ldB]);
+
+			if ( a != 0.0 )
+				for( j=0; j<n; ++j )
+					Ci[j] += a * Bl[j];
+		}
+	}
+}
+
+
+/*
+ *	m u l t i p l y T N
+ */
+void Condenser::multiplyTN(	uint_t m, uint_t n, uint_t p,
+							const real_t* const A, uint_t ldA,
+							const real_t* const B, uint_t ldB,
+							real_t* const C, uint_t ldC,
+							BooleanType add
+							)
+{
+	uint_t i, j, l;
+
+	if ( add == BT_FALSE )
+		for( i=0; i<m; ++i )
+			for( j=0; j<n; ++j )
+				C[i*ldC+j] = 0.0;
+
+	/* rank-one updates with rows of A and B keep all accesses contiguous */
+	for( l=0; l<p; ++l )
+	{
+		const real_t* Al = &(A[l*ldA]);
+		const real_t* Bl = &(B[l*ldB]);
+
+		for( i=0; i<m; ++i )
+		{
+			real_t a = Al[i];
+			real_t* Ci = &(C[i*ldC]);
+
+			if ( a != 0.0 )
+				for( j=0; j<n; ++j )
+					Ci[j] += a * Bl[j];
+		}
+	}
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,401 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file src/EigenReplacement.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	BLAS/LAPACK replacement routines based on Eigen's vectorised and blocked
+ *	kernels (alternative to BLASReplacement.cpp and LAPACKReplacement.cpp).
+ *	The Fortran-style entry points are kept, so callers remain unchanged.
+ */
+
+
+#include <qpOASES/Utils.hpp>
+
+#include <Eigen/Core>
+
+
+/** Block size of the right-looking Cholesky factorisation. */
+static const la_int_t CHOLESKY_BLOCKSIZE = 48;
+
+/** Maximum number of iterations of the 1-norm estimator of TRCON. */
+static const int TRCON_MAXITER = 5;
+
+
+/** Computes C = alpha*op(A)*op(B) + beta*C (column major). */
+template <typename T>
+static void eigenGemm(	const char* TRANSA, const char* TRANSB,
+						la_uint_t M, la_uint_t N, la_uint_t K,
+						T alpha, const T* A, la_uint_t LDA, const T* B, la_uint_t LDB,
+						T beta, T* C, la_uint_t LDC
+						)
+{
+	typedef Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> Mat;
+	typedef Eigen::Map<const Mat,0,Eigen::OuterStride<> > ConstMap;
+	typedef Eigen::Map<Mat,0,Eigen::OuterStride<> > Map;
+
+	bool transA = ( TRANSA[0] != 'N' ) && ( TRANSA[0] != 'n' );
+	bool transB = ( TRANSB[0] != 'N' ) && ( TRANSB[0] != 'n' );
+
+	Map c( C,M,N,Eigen::OuterStride<>( LDC ) );
+
+	/* as in BLAS, C is not read if beta is zero */
+	if ( REFER_NAMESPACE_QPOASES isZero( beta ) == REFER_NAMESPACE_QPOASES BT_TRUE )
+		c.setZero( );
+	else if ( REFER_NAMESPACE_QPOASES isEqual( beta,1.0 ) == REFER_NAMESPACE_QPOASES BT_FALSE )
+		c *= beta;
+
+	if ( ( M == 0 ) || ( N == 0 ) || ( K == 0 ) )
+		return;
+
+	ConstMap a( A,transA ? K : M,transA ? M : K,Eigen::OuterStride<>( LDA ) );
+	ConstMap b( B,transB ? N : K,transB ? K : N,Eigen::OuterStride<>( LDB ) );
+
+	if ( transA == false )
+	{
+		if ( transB == false )
+			c.noalias( ) += alpha * a * b;
+		else
+			c.noalias( ) += alpha * a * b.transpose( );
+	}
+	else
+	{
+		if ( transB == false )
+			c.noalias( ) += alpha * a.transpose( ) * b;
+		else
+			c.noalias( ) += alpha * a.transpose( ) * b.transpose( );
+	}
+}
+
+
+/** Computes the upper Cholesky factor R with R'*R = A in place (as the
+ *  replacement, only the upper triangle is referenced and on failure the
+ *  offending pivot is tunnelled to the caller in a[0]). */
+template <typename T>
+static void eigenPotrf(	la_int_t n, T* a, la_int_t lda, la_int_t* info
+						)
+{
+	typedef Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> Mat;
+	typedef Eigen::Map<Mat,0,Eigen::OuterStride<> > Map;
+
+	la_int_t i, j, k, nb;
+
+	Map A( a,n,n,Eigen::OuterStride<>( lda ) );
+
+	for( k=0; k<n; k+=CHOLESKY_BLOCKSIZE )
+	{
+		nb = ( n-k < CHOLESKY_BLOCKSIZE ) ? n-k : CHOLESKY_BLOCKSIZE;
+
+		/* unblocked factorisation of the diagonal block */
+		for( i=k; i<k+nb; ++i )
+		{
+			T sum = A( i,i ) - A.col( i ).segment( k,i-k ).squaredNorm( );
+
+			if ( sum <= 0.0 )
+			{
+				a[0] = sum; /* tunnel negative diagonal element to caller */
+				if ( info != 0 )
+					*info = i+1;
+				return;
+			}
+
+			A( i,i ) = (T)( REFER_NAMESPACE_QPOASES getSqrt( sum ) );
+
+			for( j=i+1; j<k+nb; ++j )
+				A( i,j ) = ( A( i,j ) - A.col( i ).segment( k,i-k ).dot( A.col( j ).segment( k,i-k ) ) ) / A( i,i );
+		}
+
+		if ( k+nb == n )
+			break;
+
+		/* off-diagonal block row: R11' * R12 = A12 */
+		A.block( k,k,nb,nb ).template triangularView<Eigen::Upper>( ).transpose( )
+			.solveInPlace( A.block( k,k+nb,nb,n-k-nb ) );
+
+		/* trailing submatrix: A22 -= R12' * R12 (upper triangle only) */
+		A.block( k+nb,k+nb,n-k-nb,n-k-nb ).template selfadjointView<Eigen::Upper>( )
+			.rankUpdate( A.block( k,k+nb,nb,n-k-nb ).transpose( ),(T)-1.0 );
+	}
+
+	if ( info != 0 )
+		*info = 0;
+}
+
+
+/** Solves op(A)*X = B in place for triangular A. */
+template <typename T>
+static void eigenTrtrs(	const char* UPLO, const char* TRANS, const char* DIAG,
+						la_uint_t N, la_uint_t NRHS, const T* A, la_uint_t LDA, T* B, la_uint_t LDB,
+						la_int_t* INFO
+						)
+{
+	typedef Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> Mat;
+	typedef Eigen::Map<const Mat,0,Eigen::OuterStride<> > ConstMap;
+	typedef Eigen::Map<Mat,0,Eigen::OuterStride<> > Map;
+
+	la_uint_t i;
+
+	bool upper = ( UPLO[0] == 'U' ) || ( UPLO[0] == 'u' );
+	bool trans = ( TRANS[0] != 'N' ) && ( TRANS[0] != 'n' );
+	bool unit = ( DIAG[0] == 'U' ) || ( DIAG[0] == 'u' );
+
+	ConstMap a( A,N,N,Eigen::OuterStride<>( LDA ) );
+	Map b( B,N,NRHS,Eigen::OuterStride<>( LDB ) );
+
+	/* as in LAPACK, singularity is checked before solving */
+	if ( unit == false )
+		for( i=0; i<N; ++i )
+			if ( a( i,i ) == 0.0 )
+			{
+				INFO[0] = (la_int_t)i+1;
+				return;
+			}
+
+	if ( upper == true )
+	{
+		if ( trans == false )
+		{
+			if ( unit == false )
+				a.template triangularView<Eigen::Upper>( ).solveInPlace( b );
+			else
+				a.template triangularView<Eigen::UnitUpper>( ).solveInPlace( b );
+		}
+		else
+		{
+			if ( unit == false )
+				a.transpose( ).template triangularView<Eigen::Lower>( ).solveInPlace( b );
+			else
+				a.transpose( ).template triangularView<Eigen::UnitLower>( ).solveInPlace( b );
+		}
+	}
+	else
+	{
+		if ( trans == false )
+		{
+			if ( unit == false )
+				a.template triangularView<Eigen::Lower>( ).solveInPlace( b );
+			else
+				a.template triangularView<Eigen::UnitLower>( ).solveInPlace( b );
+		}
+		else
+		{
+			if ( unit == false )
+				a.transpose( ).template triangularView<Eigen::Upper>( ).solveInPlace( b );
+			else
+				a.transpose( ).template triangularView<Eigen::UnitUpper>( ).solveInPlace( b );
+		}
+	}
+
+	INFO[0] = 0;
+}
+
+
+/** Solves op(A)*x = b in place for the triangular A of TRCON. */
+template <typename T>
+static void solveTriangular(	const Eigen::Map<const Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic>,0,Eigen::OuterStride<> >& a,
+								bool upper, bool unit, bool trans, Eigen::Map<Eigen::Matrix<T,Eigen::Dynamic,1> >& x
+								)
+{
+	if ( upper == true )
+	{
+		if ( unit == false )
+		{
+			if ( trans == false ) a.template triangularView<Eigen::Upper>( ).solveInPlace( x );
+			else a.transpose( ).template triangularView<Eigen::Lower>( ).solveInPlace( x );
+		}
+		else
+		{
+			if ( trans == false ) a.template triangularView<Eigen::UnitUpper>( ).solveInPlace( x );
+			else a.transpose( ).template triangularView<Eigen::UnitLower>( ).solveInPlace( x );
+		}
+	}
+	else
+	{
+		if ( unit == false )
+		{
+			if ( trans == false ) a.template triangularView<Eigen::Lower>( ).solveInPlace( x );
+			else a.transpose( ).template triangularView<Eigen::Upper>( ).solveInPlace( x );
+		}
+		else
+		{
+			if ( trans == false ) a.template triangularView<Eigen::UnitLower>( ).solveInPlace( x );
+			else a.transpose( ).template triangularView<Eigen::UnitUpper>( ).solveInPlace( x );
+		}
+	}
+}
+
+
+/** Estimates the reciprocal condition number of a triangular matrix in the
+ *  1-norm ('1' or 'O') or infinity-norm ('I'), using Hager's estimator of
+ *  the norm of the inverse (as LAPACK, without forming the inverse). Only
+ *  the triangle of A is read, the iterates are kept in WORK (2*N). */
+template <typename T>
+static void eigenTrcon(	const char* NORM, const char* UPLO, const char* DIAG,
+						la_uint_t N, const T* A, la_uint_t LDA, T* RCOND, T* WORK, la_int_t* INFO
+						)
+{
+	typedef Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> Mat;
+	typedef Eigen::Matrix<T,Eigen::Dynamic,1> Vec;
+	typedef Eigen::Map<const Mat,0,Eigen::OuterStride<> > ConstMap;
+	typedef Eigen::Map<Vec> VecMap;
+
+	la_uint_t i;
+	int iter;
+	Eigen::Index idx;
+
+	bool upper = ( UPLO[0] == 'U' ) || ( UPLO[0] == 'u' );
+	bool unit = ( DIAG[0] == 'U' ) || ( DIAG[0] == 'u' );
+	bool infNorm = ( NORM[0] == 'I' ) || ( NORM[0] == 'i' );
+
+	INFO[0] = 0;
+
+	if ( N == 0 )
+	{
+		RCOND[0] = 1.0;
+		return;
+	}
+
+	ConstMap a( A,N,N,Eigen::OuterStride<>( LDA ) );
+
+	/* norm of the triangle: maximum column (1-norm) or row (infinity-norm) sum
+	 * of the strict triangle plus the diagonal */
+	T anorm = 0.0;
+	for( i=0; i<N; ++i )
+	{
+		T sum = ( unit == true ) ? (T)1.0 : REFER_NAMESPACE_QPOASES getAbs( a( i,i ) );
+
+		if ( infNorm == false )
+			sum += ( upper == true ) ? a.col( i ).head( i ).cwiseAbs( ).sum( )
+									 : a.col( i ).tail( N-i-1 ).cwiseAbs( ).sum( );
+		else
+			sum += ( upper == true ) ? a.row( i ).tail( N-i-1 ).cwiseAbs( ).sum( )
+									 : a.row( i ).head( i ).cwiseAbs( ).sum( );
+
+		if ( sum > anorm )
+			anorm = sum;
+	}
+
+	RCOND[0] = 0.0;
+	if ( anorm <= 0.0 )
+		return;
+
+	if ( unit == false )
+		for( i=0; i<N; ++i )
+			if ( a( i,i ) == 0.0 )
+				return;
+
+	/* estimate 1-norm of inv(op(A)), where op(A) = A' for the infinity-norm */
+	VecMap x( WORK,N );
+	VecMap xi( WORK+N,N );
+	x.setConstant( (T)1.0 / (T)N );
+	T ainvnorm = 0.0;
+
+	for( iter=0; iter<TRCON_MAXITER; ++iter )
+	{
+		solveTriangular<T>( a,upper,unit,infNorm,x );
+		ainvnorm = x.template lpNorm<1>( );
+
+		for( i=0; i<N; ++i )
+			xi( i ) = ( x( i ) >= 0.0 ) ? (T)1.0 : (T)-1.0;
+
+		solveTriangular<T>( a,upper,unit,!infNorm,xi );
+
+		T zmax = xi.cwiseAbs( ).maxCoeff( &idx );
+		if ( ( iter > 0 ) && ( zmax <= xi.dot( x ) / ainvnorm ) )
+			break;
+
+		x.setZero( );
+		x( idx ) = 1.0;
+	}
+
+	if ( ainvnorm > 0.0 )
+		RCOND[0] = ( (T)1.0 / anorm ) / ainvnorm;
+}
+
+
+extern "C" void dgemm_(	const char* TRANSA, const char* TRANSB,
+						const la_uint_t* M, const la_uint_t* N, const la_uint_t* K,
+						const double* ALPHA, const double* A, const la_uint_t* LDA, const double* B, const la_uint_t* LDB,
+						const double* BETA, double* C, const la_uint_t* LDC
+						)
+{
+	eigenGemm<double>( TRANSA,TRANSB,*M,*N,*K,*ALPHA,A,*LDA,B,*LDB,*BETA,C,*LDC );
+}
+
+extern "C" void sgemm_(	const char* TRANSA, const char* TRANSB,
+						const la_uint_t* M, const la_uint_t* N, const la_uint_t* K,
+						const float* ALPHA, const float* A, const la_uint_t* LDA, const float* B, const la_uint_t* LDB,
+						const float* BETA, float* C, const la_uint_t* LDC
+						)
+{
+	eigenGemm<float>( TRANSA,TRANSB,*M,*N,*K,*ALPHA,A,*LDA,B,*LDB,*BETA,C,*LDC );
+}
+
+extern "C" void dpotrf_(	const char* uplo, const la_uint_t* _n, double* a,
+							const la_uint_t* _lda, la_int_t* info
+							)
+{
+	eigenPotrf<double>( (la_int_t)(*_n),a,(la_int_t)(*_lda),info );
+}
+
+extern "C" void spotrf_(	const char* uplo, const la_uint_t* _n, float* a,
+							const la_uint_t* _lda, la_int_t* info
+							)
+{
+	eigenPotrf<float>( (la_int_t)(*_n),a,(la_int_t)(*_lda),info );
+}
+
+extern "C" void dtrtrs_(	const char* UPLO, const char* TRANS, const char* DIAG,
+							const la_uint_t* N, const la_uint_t* NRHS,
+							double* A, const la_uint_t* LDA, double* B, const la_uint_t* LDB, la_int_t* INFO
+							)
+{
+	eigenTrtrs<double>( UPLO,TRANS,DIAG,*N,*NRHS,A,*LDA,B,*LDB,INFO );
+}
+
+extern "C" void strtrs_(	const char* UPLO, const char* TRANS, const char* DIAG,
+							const la_uint_t* N, const la_uint_t* NRHS,
+							float* A, const la_uint_t* LDA, float* B, const la_uint_t* LDB, la_int_t* INFO
+							)
+{
+	eigenTrtrs<float>( UPLO,TRANS,DIAG,*N,*NRHS,A,*LDA,B,*LDB,INFO );
+}
+
+extern "C" void dtrcon_(	const char* NORM, const char* UPLO, const char* DIAG,
+							const la_uint_t* N, double* A, const la_uint_t*LDA,
+							double* RCOND, double* WORK, const la_uint_t* IWORK, la_int_t* INFO
+							)
+{
+	eigenTrcon<double>( NORM,UPLO,DIAG,*N,A,*LDA,RCOND,WORK,INFO );
+}
+
+extern "C" void strcon_(	const char* NORM, const char* UPLO, const char* DIAG,
+							const la_uint_t* N, float* A, const la_uint_t* LDA,
+							float* RCOND, float* WORK, const la_uint_t* IWORK, la_int_t* INFO
+							)
+{
+	eigenTrcon<float>( NORM,UPLO,DIAG,*N,A,*LDA,RCOND,WORK,INFO );
+}
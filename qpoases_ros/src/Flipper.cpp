@@ -52,6 +52,10 @@ Flipper::Flipper( )
 	R = 0;
 	Q = 0;
 	T = 0;
+
+	lenR = 0;
+	lenQ = 0;
+	lenT = 0;
 	
 	init( );
 }
@@ -67,6 +71,10 @@ Flipper::Flipper(	uint_t _nV,
 	R = 0;
 	Q = 0;
 	T = 0;
+
+	lenR = 0;
+	lenQ = 0;
+	lenT = 0;
 	
 	init( _nV,_nC );
 }
@@ -81,6 +89,10 @@ Flipper::Flipper( const Flipper& rhs )
 	Q = 0;
 	T = 0;
 
+	lenR = 0;
+	lenQ = 0;
+	lenT = 0;
+
 	copy( rhs );
 }
 
@@ -143,14 +155,16 @@ returnValue Flipper::get(	Bounds* const _bounds,
 	if ( _constraints != 0 )
 		*_constraints = constraints;
 
+	/* only the leading parts saved by set() are restored, the remaining
+	 * entries do not belong to the active factorisation */
 	if ( ( _R != 0 ) && ( R != 0 ) )
-		memcpy( _R,R, nV*nV*sizeof(real_t) );
+		memcpy( _R,R, lenR*sizeof(real_t) );
 
 	if ( ( _Q != 0 ) && ( Q != 0 ) )
-		memcpy( _Q,Q, nV*nV*sizeof(real_t) );
+		memcpy( _Q,Q, lenQ*sizeof(real_t) );
 
 	if ( ( _T != 0 ) && ( T != 0 ) )
-		memcpy( _T,T, getDimT()*sizeof(real_t) );
+		memcpy( _T,T, lenT*sizeof(real_t) );
 
 	return SUCCESSFUL_RETURN;
 }
@@ -172,12 +186,21 @@ returnValue Flipper::set(	const Bounds* const _bounds,
 	if ( _constraints != 0 )
 		constraints = *_constraints;
 
+	/* Only the leading columns of R and Q (stored column-wise) belonging to the
+	 * free variables and the leading rows of T (stored row-wise) belonging to
+	 * the active constraints hold the current factorisation; copying just these
+	 * avoids moving the full nV x nV matrices each time the working set changes. */
+	uint_t sizeT = getSizeT( );
+	uint_t nFR = ( _bounds != 0 ) ? (uint_t)_bounds->getNFR( ) : nV;
+	uint_t nAC = ( _constraints != 0 ) ? (uint_t)_constraints->getNAC( ) : sizeT;
+
 	if ( _R != 0 )
 	{
 		if ( R == 0 )
-			R = new real_t[nV*nV];
+			R = new real_t[RR_SIZE(nV,nV)];
 
-		memcpy( R,_R, nV*nV*sizeof(real_t) );
+		lenR = RR_SIZE(nV,nFR);
+		memcpy( R,_R, lenR*sizeof(real_t) );
 	}
 
 	if ( _Q != 0 )
@@ -185,7 +208,8 @@ returnValue Flipper::set(	const Bounds* const _bounds,
 		if ( Q == 0 )
 			Q = new real_t[nV*nV];
 
-		memcpy( Q,_Q, nV*nV*sizeof(real_t) );
+		lenQ = nFR*nV;
+		memcpy( Q,_Q, lenQ*sizeof(real_t) );
 	}
 
 	if ( _T != 0 )
@@ -193,7 +217,8 @@ returnValue Flipper::set(	const Bounds* const _bounds,
 		if ( T == 0 )
 			T = new real_t[getDimT()];
 
-		memcpy( T,_T, getDimT()*sizeof(real_t) );
+		lenT = TT_SIZE(sizeT,nAC);
+		memcpy( T,_T, lenT*sizeof(real_t) );
 	}
 
 	return SUCCESSFUL_RETURN;
@@ -228,6 +253,10 @@ returnValue Flipper::clear( )
 		T = 0;
 	}
 
+	lenR = 0;
+	lenQ = 0;
+	lenT = 0;
+
 	return SUCCESSFUL_RETURN;
 }
 
@@ -242,12 +271,24 @@ returnValue Flipper::copy(	const Flipper& rhs
 }
 
 
-uint_t Flipper::getDimT( ) const
+/*
+ *	g e t S i z e T
+ */
+uint_t Flipper::getSizeT( ) const
 {
 	if ( nV > nC )
-		return nC*nC;
+		return nC;
 	else
-		return nV*nV;
+		return nV;
+}
+
+
+/*
+ *	g e t D i m T
+ */
+uint_t Flipper::getDimT( ) const
+{
+	return TT_SIZE( getSizeT( ),getSizeT( ) );
 }
 
 
@@ -49,8 +49,9 @@ BEGIN_NAMESPACE_QPOASES
  */
 Indexlist::Indexlist( )
 {
-	number = 0;
-	iSort  = 0;
+	number   = 0;
+	iSort    = 0;
+	position = 0;
 
 	init( );
 }
@@ -61,8 +62,9 @@ Indexlist::Indexlist( )
  */
 Indexlist::Indexlist( int_t n )
 {
-	number = 0;
-	iSort  = 0;
+	number   = 0;
+	iSort    = 0;
+	position = 0;
 
 	init( n );
 }
@@ -93,8 +95,16 @@ Indexlist& Indexlist::operator=( const Indexlist& rhs )
 {
 	if ( this != &rhs )
 	{
-		clear( );
-		copy( rhs );
+		/* snapshots (e.g. by the Flipper) reuse the allocated arrays */
+		if ( ( physicallength == rhs.physicallength ) && ( number != 0 ) && ( rhs.number != 0 ) )
+		{
+			copyInPlace( rhs );
+		}
+		else
+		{
+			clear( );
+			copy( rhs );
+		}
 	}
 
 	return *this;
@@ -118,8 +128,12 @@ returnValue Indexlist::init(	int_t n
 
 	if ( n > 0 )
 	{
-		number = new int_t[n];
-		iSort  = new int_t[n];
+		number   = new int_t[n];
+		iSort    = new int_t[n];
+		position = new int_t[n];
+
+		for( int_t i=0; i<n; ++i )
+			position[i] = -1;
 	}
 
 	return SUCCESSFUL_RETURN;
@@ -156,6 +170,9 @@ returnValue Indexlist::getISortArray( int_t** const iSortArray ) const
  */
 int_t Indexlist::getIndex( int_t givennumber ) const
 {
+	if ( ( givennumber >= 0 ) && ( givennumber < physicallength ) )
+		return position[givennumber];
+
 	int_t index = findInsert(givennumber);
 	return number[iSort[index]] == givennumber ? iSort[index] : -1;
 }
@@ -175,6 +192,8 @@ returnValue Indexlist::addNumber( int_t addnumber )
 	for (i = length; i > j+1; i--)
 		iSort[i] = iSort[i-1];
 	iSort[j+1] = length;
+	if ( ( addnumber >= 0 ) && ( addnumber < physicallength ) )
+		position[addnumber] = length;
 	++length;
 
 	return SUCCESSFUL_RETURN;
@@ -202,9 +221,16 @@ returnValue Indexlist::removeNumber( int_t removenumber )
 
 	/* remove from numbers list */
 	for( i=iSidx; i<length-1; ++i )
+	{
 		number[i] = number[i+1];
+		if ( ( number[i] >= 0 ) && ( number[i] < physicallength ) )
+			position[number[i]] = i;
+	}
 	number[length-1] = -1;
 
+	if ( ( removenumber >= 0 ) && ( removenumber < physicallength ) )
+		position[removenumber] = -1;
+
 	--length;
 
 	return SUCCESSFUL_RETURN;
@@ -232,6 +258,11 @@ returnValue Indexlist::swapNumbers( int_t number1, int_t number2 )
 	tmp = iSort[index1];
 	iSort[index1] = iSort[index2];
 	iSort[index2] = tmp;
+	/* update positions */
+	if ( ( number1 >= 0 ) && ( number1 < physicallength ) )
+		position[number1] = iSort[index1];
+	if ( ( number2 >= 0 ) && ( number2 < physicallength ) )
+		position[number2] = iSort[index2];
 
 	return SUCCESSFUL_RETURN;
 }
@@ -247,6 +278,12 @@ returnValue Indexlist::swapNumbers( int_t number1, int_t number2 )
  */
 returnValue Indexlist::clear( )
 {
+	if ( position != 0 )
+	{
+		delete[] position;
+		position = 0;
+	}
+
 	if ( iSort != 0 )
 	{
 		delete[] iSort;
@@ -282,16 +319,37 @@ returnValue Indexlist::copy(	const Indexlist& rhs
 		iSort = new int_t[physicallength];
 		for( i=0; i<physicallength; ++i )
 			iSort[i] = rhs.iSort[i];
+		position = new int_t[physicallength];
+		for( i=0; i<physicallength; ++i )
+			position[i] = rhs.position[i];
 	}
 	else
 	{
 		number = 0;
 		iSort = 0;
+		position = 0;
 	}
 
 	return SUCCESSFUL_RETURN;
 }
 
+
+/*
+ *	c o p y I n P l a c e
+ */
+returnValue Indexlist::copyInPlace(	const Indexlist& rhs
+									)
+{
+	length = rhs.length;
+
+	memcpy( number,rhs.number,((uint_t)physicallength)*sizeof(int_t) );
+	memcpy( iSort,rhs.iSort,((uint_t)physicallength)*sizeof(int_t) );
+	memcpy( position,rhs.position,((uint_t)physicallength)*sizeof(int_t) );
+
+	return SUCCESSFUL_RETURN;
+}
+
+
 int_t Indexlist::findInsert(int_t i) const
 {
 	/* quick check if index can be appended */
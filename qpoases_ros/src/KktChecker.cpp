@@ -0,0 +1,632 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file src/KktChecker.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Implementation of the KktChecker class for cheap checks of the
+ *	KKT optimality conditions after each (hot)start.
+ */
+
+
+#include <qpOASES/extras/KktChecker.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	K k t C h e c k e r
+ */
+KktChecker::KktChecker(	uint_t _nThreads, real_t _tolerance
+						)
+{
+	nThreads = 1;
+	tolerance = 0.0;
+
+	nV = 0;
+	residual = 0;
+	partial = 0;
+	rowBuffer = 0;
+	tasks = 0;
+
+	qp = 0;
+	activeIdx = 0;
+	nActive = 0;
+	rowwiseH = BT_FALSE;
+	rowwiseA = BT_FALSE;
+
+	#ifndef __NO_THREADS__
+	threads = 0;
+	nWorkers = 0;
+	generation = 0;
+	nDone = 0;
+	stopRequested = BT_FALSE;
+
+	pthread_mutex_init( &mutex,0 );
+	pthread_cond_init( &started,0 );
+	pthread_cond_init( &done,0 );
+	#endif
+
+	setNumThreads( _nThreads );
+	setTolerance( _tolerance );
+}
+
+
+/*
+ *	~ K k t C h e c k e r
+ */
+KktChecker::~KktChecker( )
+{
+	clear( );
+
+	#ifndef __NO_THREADS__
+	pthread_cond_destroy( &done );
+	pthread_cond_destroy( &started );
+	pthread_mutex_destroy( &mutex );
+	#endif
+}
+
+
+/*
+ *	s e t N u m T h r e a d s
+ */
+returnValue KktChecker::setNumThreads(	uint_t _nThreads
+										)
+{
+	if ( _nThreads < 1 )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	#ifdef __NO_THREADS__
+	_nThreads = 1;
+	#endif
+
+	if ( _nThreads != nThreads )
+	{
+		clear( );
+		nThreads = _nThreads;
+	}
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s e t T o l e r a n c e
+ */
+returnValue KktChecker::setTolerance(	real_t _tolerance
+										)
+{
+	if ( _tolerance < 0.0 )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	tolerance = _tolerance;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	g e t K k t V i o l a t i o n
+ */
+real_t KktChecker::getKktViolation(	QProblemB* const _qp,
+									real_t* const maxStat, real_t* const maxFeas, real_t* const maxCmpl
+									)
+{
+	if ( _qp == 0 )
+		return INFTY;
+
+	/* the data of an unsolved QP belong to an intermediate QP on the homotopy path */
+	if ( _qp->isSolved( ) == BT_FALSE )
+		return refuse( maxStat,maxFeas,maxCmpl );
+
+	real_t stat=0.0, feas=0.0, cmpl=0.0;
+
+	checkBounds( _qp,feas,cmpl );
+
+	/* stationarity is the only expensive condition, skip it if possible */
+	if ( ( tolerance <= 0.0 ) || ( getMax( feas,cmpl ) <= tolerance ) )
+		stat = checkStationarity( _qp,0 );
+
+	if ( maxStat != 0 )
+		*maxStat = stat;
+
+	if ( maxFeas != 0 )
+		*maxFeas = feas;
+
+	if ( maxCmpl != 0 )
+		*maxCmpl = cmpl;
+
+	return getMax( stat,getMax( feas,cmpl ) );
+}
+
+
+/*
+ *	g e t K k t V i o l a t i o n
+ */
+real_t KktChecker::getKktViolation(	QProblem* const _qp,
+									real_t* const maxStat, real_t* const maxFeas, real_t* const maxCmpl
+									)
+{
+	if ( _qp == 0 )
+		return INFTY;
+
+	/* the data of an unsolved QP belong to an intermediate QP on the homotopy path */
+	if ( _qp->isSolved( ) == BT_FALSE )
+		return refuse( maxStat,maxFeas,maxCmpl );
+
+	real_t stat=0.0, feas=0.0, cmpl=0.0;
+
+	checkBounds( _qp,feas,cmpl );
+
+	if ( ( tolerance <= 0.0 ) || ( getMax( feas,cmpl ) <= tolerance ) )
+		checkConstraints( _qp,feas,cmpl );
+
+	/* stationarity is the only expensive condition, skip it if possible */
+	if ( ( tolerance <= 0.0 ) || ( getMax( feas,cmpl ) <= tolerance ) )
+		stat = checkStationarity( _qp,_qp );
+
+	if ( maxStat != 0 )
+		*maxStat = stat;
+
+	if ( maxFeas != 0 )
+		*maxFeas = feas;
+
+	if ( maxCmpl != 0 )
+		*maxCmpl = cmpl;
+
+	return getMax( stat,getMax( feas,cmpl ) );
+}
+
+
+
+/*****************************************************************************
+ *  P R O T E C T E D                                                        *
+ *****************************************************************************/
+
+
+/*
+ *	c l e a r
+ */
+returnValue KktChecker::clear( )
+{
+	#ifndef __NO_THREADS__
+	uint_t i;
+
+	/* the worker threads use the workspace */
+	if ( nWorkers > 0 )
+	{
+		pthread_mutex_lock( &mutex );
+		stopRequested = BT_TRUE;
+		pthread_cond_broadcast( &started );
+		pthread_mutex_unlock( &mutex );
+
+		for( i=1; i<=nWorkers; ++i )
+			pthread_join( threads[i],0 );
+
+		nWorkers = 0;
+		stopRequested = BT_FALSE;
+	}
+	#endif
+
+	if ( residual != 0 )
+	{
+		delete[] residual;
+		residual = 0;
+	}
+
+	if ( partial != 0 )
+	{
+		delete[] partial;
+		partial = 0;
+	}
+
+	if ( rowBuffer != 0 )
+	{
+		delete[] rowBuffer;
+		rowBuffer = 0;
+	}
+
+	if ( tasks != 0 )
+	{
+		delete[] tasks;
+		tasks = 0;
+	}
+
+	#ifndef __NO_THREADS__
+	if ( threads != 0 )
+	{
+		delete[] threads;
+		threads = 0;
+	}
+	#endif
+
+	nV = 0;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	a l l o c a t e
+ */
+returnValue KktChecker::allocate(	int_t _nV
+									)
+{
+	uint_t i;
+
+	if ( ( _nV <= nV ) && ( residual != 0 ) )
+		return SUCCESSFUL_RETURN;
+
+	clear( );
+
+	nV = _nV;
+	residual = new real_t[nV];
+	partial = new real_t[nThreads*nV];
+	rowBuffer = new real_t[nThreads*nV];
+
+	tasks = new KktCheckerTask[nThreads];
+	for( i=0; i<nThreads; ++i )
+	{
+		tasks[i].checker = this;
+		tasks[i].number = i;
+	}
+
+	#ifndef __NO_THREADS__
+	threads = new pthread_t[nThreads];
+
+	/* chunk 0 is evaluated on the calling thread, chunks without thread as well */
+	generation = 0;
+	for( nWorkers=0; nWorkers+1<nThreads; ++nWorkers )
+		if ( pthread_create( &(threads[nWorkers+1]),0,KktChecker::run,&(tasks[nWorkers+1]) ) != 0 )
+			break;
+	#endif
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	r e f u s e
+ */
+real_t KktChecker::refuse(	real_t* const maxStat, real_t* const maxFeas, real_t* const maxCmpl
+							) const
+{
+	if ( maxStat != 0 )
+		*maxStat = INFTY;
+
+	if ( maxFeas != 0 )
+		*maxFeas = INFTY;
+
+	if ( maxCmpl != 0 )
+		*maxCmpl = INFTY;
+
+	return INFTY;
+}
+
+
+/*
+ *	c h e c k B o u n d s
+ */
+void KktChecker::checkBounds(	const QProblemB* const _qp,
+								real_t& feas, real_t& cmpl
+								) const
+{
+	int_t i;
+	int_t _nV = _qp->getNV( );
+
+	const real_t* x = _qp->x;
+	const real_t* y = _qp->y;
+	const real_t* lb = _qp->lb;
+	const real_t* ub = _qp->ub;
+
+	for( i=0; i<_nV; ++i )
+	{
+		if ( lb[i] - x[i] > feas )
+			feas = lb[i] - x[i];
+
+		if ( x[i] - ub[i] > feas )
+			feas = x[i] - ub[i];
+
+		switch ( _qp->bounds.getStatus( i ) )
+		{
+			case ST_LOWER:
+				if ( getAbs( (x[i]-lb[i])*y[i] ) > cmpl )
+					cmpl = getAbs( (x[i]-lb[i])*y[i] );
+				break;
+
+			case ST_UPPER:
+				if ( getAbs( (x[i]-ub[i])*y[i] ) > cmpl )
+					cmpl = getAbs( (x[i]-ub[i])*y[i] );
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
+
+/*
+ *	c h e c k C o n s t r a i n t s
+ */
+void KktChecker::checkConstraints(	const QProblem* const _qp,
+									real_t& feas, real_t& cmpl
+									) const
+{
+	int_t i;
+	int_t _nV = _qp->getNV( );
+	int_t nC = _qp->getNC( );
+
+	/* Ax_l = A*x - lbA and Ax_u = ubA - A*x are kept up to date by the solver */
+	const real_t* Ax_l = _qp->Ax_l;
+	const real_t* Ax_u = _qp->Ax_u;
+	const real_t* yC = &(_qp->y[_nV]);
+
+	for( i=0; i<nC; ++i )
+	{
+		if ( -Ax_l[i] > feas )
+			feas = -Ax_l[i];
+
+		if ( -Ax_u[i] > feas )
+			feas = -Ax_u[i];
+
+		switch ( _qp->constraints.getStatus( i ) )
+		{
+			case ST_LOWER:
+				if ( getAbs( Ax_l[i]*yC[i] ) > cmpl )
+					cmpl = getAbs( Ax_l[i]*yC[i] );
+				break;
+
+			case ST_UPPER:
+				if ( getAbs( Ax_u[i]*yC[i] ) > cmpl )
+					cmpl = getAbs( Ax_u[i]*yC[i] );
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
+
+/*
+ *	c h e c k S t a t i o n a r i t y
+ */
+real_t KktChecker::checkStationarity(	QProblemB* const _qp, QProblem* const qpC
+										)
+{
+	int_t i;
+	uint_t j, nStarted;
+	int_t _nV = _qp->getNV( );
+
+	const real_t* x = _qp->x;
+	const real_t* y = _qp->y;
+	const real_t* g = _qp->g;
+
+	if ( allocate( _nV ) != SUCCESSFUL_RETURN )
+		return INFTY;
+
+	/* residual = g - y_B, plus the parts of H*x not stored in H */
+	for( i=0; i<_nV; ++i )
+		residual[i] = g[i] - y[i];
+
+	rowwiseH = BT_FALSE;
+
+	switch( _qp->getHessianType( ) )
+	{
+		case HST_ZERO:
+			break;
+
+		case HST_IDENTITY:
+			for( i=0; i<_nV; ++i )
+				residual[i] += x[i];
+			break;
+
+		default:
+			if ( _qp->usingRegularisation( ) == BT_TRUE )
+				for( i=0; i<_nV; ++i )
+					residual[i] -= _qp->regVal * x[i];
+
+			/* sparse matrices cannot cheaply be accessed row by row */
+			if ( dynamic_cast<DenseMatrix*>( _qp->H ) != 0 )
+				rowwiseH = BT_TRUE;
+			else
+				_qp->H->times( 1,1.0,x,_nV,1.0,residual,_nV );
+			break;
+	}
+
+	/* A'*y_C is only summed up over the active constraints */
+	activeIdx = 0;
+	nActive = 0;
+	rowwiseA = BT_FALSE;
+
+	if ( ( qpC != 0 ) && ( qpC->getNC( ) > 0 ) )
+	{
+		if ( dynamic_cast<DenseMatrix*>( qpC->A ) != 0 )
+		{
+			int_t* numbers = 0;
+			qpC->constraints.getActive( )->getNumberArray( &numbers );
+			activeIdx = numbers;
+			nActive = qpC->getNAC( );
+			rowwiseA = BT_TRUE;
+		}
+		else
+			qpC->A->transTimes( 1,-1.0,&(y[_nV]),qpC->getNC( ),1.0,residual,_nV );
+	}
+
+	qp = _qp;
+
+	/* chunk 0 is evaluated on the calling thread */
+	nStarted = 1;
+
+	#ifndef __NO_THREADS__
+	if ( ( ( rowwiseH == BT_TRUE ) || ( nActive > 0 ) ) && ( nWorkers > 0 ) )
+	{
+		pthread_mutex_lock( &mutex );
+		nDone = 0;
+		++generation;
+		pthread_cond_broadcast( &started );
+		pthread_mutex_unlock( &mutex );
+
+		nStarted += nWorkers;
+	}
+	#endif
+
+	evaluate( 0 );
+
+	/* chunks without thread are evaluated on the calling thread */
+	for( j=nStarted; j<nThreads; ++j )
+		evaluate( j );
+
+	#ifndef __NO_THREADS__
+	if ( nStarted > 1 )
+	{
+		pthread_mutex_lock( &mutex );
+		while ( nDone < nWorkers )
+			pthread_cond_wait( &done,&mutex );
+		pthread_mutex_unlock( &mutex );
+	}
+	#endif
+
+	/* reduce partial sums of A'*y_C */
+	if ( rowwiseA == BT_TRUE )
+		for( j=0; j<nThreads; ++j )
+			for( i=0; i<_nV; ++i )
+				residual[i] -= partial[j*_nV+i];
+
+	qp = 0;
+
+	real_t stat = 0.0;
+	for( i=0; i<_nV; ++i )
+		if ( getAbs( residual[i] ) > stat )
+			stat = getAbs( residual[i] );
+
+	return stat;
+}
+
+
+/*
+ *	e v a l u a t e
+ */
+void KktChecker::evaluate(	uint_t number
+							)
+{
+	int_t i, k;
+	int_t _nV = qp->getNV( );
+
+	const real_t* x = qp->x;
+	real_t* row = &(rowBuffer[number*_nV]);
+
+	/* rows of H*x */
+	if ( rowwiseH == BT_TRUE )
+	{
+		int_t first = ( (int_t)number * _nV ) / (int_t)nThreads;
+		int_t last = ( ( (int_t)number+1 ) * _nV ) / (int_t)nThreads;
+
+		for( i=first; i<last; ++i )
+		{
+			real_t sum = 0.0;
+
+			qp->H->getRow( i,0,1.0,row );
+			for( k=0; k<_nV; ++k )
+				sum += row[k] * x[k];
+
+			residual[i] += sum;
+		}
+	}
+
+	/* partial sum of A'*y_C over a chunk of the active constraints */
+	if ( rowwiseA == BT_TRUE )
+	{
+		int_t first = ( (int_t)number * nActive ) / (int_t)nThreads;
+		int_t last = ( ( (int_t)number+1 ) * nActive ) / (int_t)nThreads;
+
+		const Matrix* A = ((QProblem*)qp)->A;
+		const real_t* yC = &(qp->y[_nV]);
+		real_t* sum = &(partial[number*_nV]);
+
+		for( k=0; k<_nV; ++k )
+			sum[k] = 0.0;
+
+		for( i=first; i<last; ++i )
+		{
+			A->getRow( activeIdx[i],0,yC[activeIdx[i]],row );
+			for( k=0; k<_nV; ++k )
+				sum[k] += row[k];
+		}
+	}
+}
+
+
+/*
+ *	r u n
+ */
+void* KktChecker::run(	void* arg
+						)
+{
+	#ifndef __NO_THREADS__
+	KktCheckerTask* task = (KktCheckerTask*)arg;
+	KktChecker* checker = task->checker;
+	uint_t handled = 0;
+
+	pthread_mutex_lock( &checker->mutex );
+	for( ;; )
+	{
+		/* wait for the next check (or for clear()) */
+		while ( ( checker->generation == handled ) && ( checker->stopRequested == BT_FALSE ) )
+			pthread_cond_wait( &checker->started,&checker->mutex );
+
+		if ( checker->stopRequested == BT_TRUE )
+			break;
+
+		handled = checker->generation;
+		pthread_mutex_unlock( &checker->mutex );
+
+		checker->evaluate( task->number );
+
+		pthread_mutex_lock( &checker->mutex );
+		if ( ++checker->nDone == checker->nWorkers )
+			pthread_cond_broadcast( &checker->done );
+	}
+	pthread_mutex_unlock( &checker->mutex );
+	#endif /* __NO_THREADS__ */
+
+	return 0;
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
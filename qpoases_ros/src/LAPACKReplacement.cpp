@@ -33,6 +33,7 @@
 
 
 #include <qpOASES/Utils.hpp>
+#include <qpOASES/SimdKernels.hpp>
 
 
 extern "C" void dpotrf_(	const char* uplo, const la_uint_t* _n, double* a,
@@ -44,6 +45,31 @@ extern "C" void dpotrf_(	const char* uplo, const la_uint_t* _n, double* a,
 	la_int_t n = (la_int_t)(*_n);
 	la_int_t lda = (la_int_t)(*_lda);
 
+	if ( REFER_NAMESPACE_QPOASES getSimdVariant( ) != REFER_NAMESPACE_QPOASES SV_SCALAR )
+	{
+		/* same recurrence, inner products by the vectorised kernel */
+		for( i=0; i<n; ++i )
+		{
+			sum = a[i+lda*i] - REFER_NAMESPACE_QPOASES simdDot( (la_uint_t)i,&(a[lda*i]),&(a[lda*i]) );
+
+			if ( sum > 0.0 )
+				a[i+lda*i] = REFER_NAMESPACE_QPOASES getSqrt( sum );
+			else
+			{
+				a[0] = sum; /* tunnel negative diagonal element to caller */
+				if (info != 0)
+					*info = (la_int_t)i+1;
+				return;
+			}
+
+			for( j=(i+1); j<n; ++j )
+				a[i+lda*j] = ( a[j*lda+i] - REFER_NAMESPACE_QPOASES simdDot( (la_uint_t)i,&(a[lda*i]),&(a[lda*j]) ) ) / a[i+lda*i];
+		}
+		if (info != 0)
+			*info = 0;
+		return;
+	}
+
 	for( i=0; i<n; ++i )
 	{
 		/* j == i */
@@ -219,6 +219,24 @@ MessageHandling::ReturnValueList returnValueList[] =
 { RET_SIMPLE_STATUS_M1, "QP problem could not be solved due to an internal error", VS_VISIBLE },
 { RET_SIMPLE_STATUS_M2, "QP problem is infeasible (and thus could not be solved)", VS_VISIBLE },
 { RET_SIMPLE_STATUS_M3, "QP problem is unbounded (and thus could not be solved)", VS_VISIBLE },
+/* Asynchronous output */
+{ RET_ASYNC_OUTPUT_START_FAILED, "Unable to start output thread", VS_VISIBLE },
+{ RET_ASYNC_OUTPUT_NOT_RUNNING, "Output thread is not running", VS_VISIBLE },
+{ RET_ASYNC_OUTPUT_MESSAGE_DROPPED, "Output buffer full, message dropped", VS_VISIBLE },
+/* Racing solver */
+{ RET_RACE_NOT_INITIALISED, "Racing solver needs to be initialised with at least one candidate", VS_VISIBLE },
+{ RET_RACE_START_FAILED, "Unable to start thread of candidate solver, running it on calling thread", VS_VISIBLE },
+{ RET_RACE_NO_WINNER, "No candidate solver succeeded in solving the QP", VS_VISIBLE },
+/* Solver service */
+{ RET_SERVICE_SETUP_FAILED, "Unable to set up shared memory of solver service", VS_VISIBLE },
+{ RET_SERVICE_ATTACH_FAILED, "Unable to attach to channel of solver service", VS_VISIBLE },
+{ RET_SERVICE_BUSY, "All request slots (or matrix buffers) of solver service channel are in use", VS_VISIBLE },
+{ RET_SERVICE_NO_REQUEST, "No request has been submitted to solver service", VS_VISIBLE },
+{ RET_SERVICE_IN_USE, "Shared memory region of solver service belongs to a running server", VS_VISIBLE },
+{ RET_SERVICE_TIMEOUT, "Solver service did not answer request in time", VS_VISIBLE },
+/* Active set predictor */
+{ RET_PREDICTION_NO_HISTORY, "No working set has been recorded to predict from", VS_VISIBLE },
+{ RET_PREDICTION_INVALID_DIMENSIONS, "Dimensions of QP do not match those of active set predictor", VS_VISIBLE },
 /* IMPORTANT: Terminal list element! */
 { TERMINAL_LIST_ELEMENT, "", VS_HIDDEN }
 };
@@ -246,6 +264,8 @@ MessageHandling::MessageHandling( )
 
 	outputFile = stdFile;
 	errorCount = 0;
+
+	asyncOutput = 0;
 }
 
 /*
@@ -259,6 +279,8 @@ MessageHandling::MessageHandling( FILE* _outputFile )
 
 	outputFile = _outputFile;
 	errorCount = 0;
+
+	asyncOutput = 0;
 }
 
 /*
@@ -275,6 +297,8 @@ MessageHandling::MessageHandling(	VisibilityStatus _errorVisibility,
 
 	outputFile = stdFile;
 	errorCount = 0;
+
+	asyncOutput = 0;
 }
 
 /*
@@ -292,6 +316,8 @@ MessageHandling::MessageHandling( 	FILE* _outputFile,
 
 	outputFile = _outputFile;
 	errorCount = 0;
+
+	asyncOutput = 0;
 }
 
 
@@ -307,6 +333,8 @@ MessageHandling::MessageHandling( const MessageHandling& rhs )
 
 	outputFile = rhs.outputFile;
 	errorCount = rhs.errorCount;
+
+	asyncOutput = rhs.asyncOutput;
 }
 
 
@@ -335,6 +363,8 @@ MessageHandling& MessageHandling::operator=( const MessageHandling& rhs )
 
 		outputFile = rhs.outputFile;
 		errorCount = rhs.errorCount;
+
+		asyncOutput = rhs.asyncOutput;
 	}
 
 	return *this;
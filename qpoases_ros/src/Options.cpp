@@ -160,6 +160,7 @@ returnValue Options::setToDefault( )
 
     enableInertiaCorrection       =  BT_TRUE;
     rcondSMin                     =  1.0e-14;
+    schurResetCostRatio           =  0.0;
 
 	return SUCCESSFUL_RETURN;
 }
@@ -344,6 +345,12 @@ returnValue Options::ensureConsistency( )
 		needToAdjust = BT_TRUE;
 	}
 
+	if ( schurResetCostRatio < 0.0 )
+	{
+		schurResetCostRatio = 0.0;
+		needToAdjust = BT_TRUE;
+	}
+
 	if ( epsIterRef < 0.0 )
 	{
 		epsIterRef = EPS;
@@ -429,6 +436,9 @@ returnValue Options::print( ) const
 	snprintf( myPrintfString,MAX_STRING_LENGTH,"rcondSMin                      =  %e\n",rcondSMin );
 	myPrintf( myPrintfString );
 
+	snprintf( myPrintfString,MAX_STRING_LENGTH,"schurResetCostRatio            =  %e\n",schurResetCostRatio );
+	myPrintf( myPrintfString );
+
 	myPrintf( "\n" );
 
 	snprintf( myPrintfString,MAX_STRING_LENGTH,"terminationTolerance           =  %e\n",terminationTolerance );
@@ -545,6 +555,7 @@ returnValue Options::copy(	const Options& rhs
 
 	enableInertiaCorrection       =  rhs.enableInertiaCorrection;
 	rcondSMin                     =  rhs.rcondSMin;
+	schurResetCostRatio           =  rhs.schurResetCostRatio;
 
 	enableDropInfeasibles         =  rhs.enableDropInfeasibles;
     dropBoundPriority             =  rhs.dropBoundPriority;
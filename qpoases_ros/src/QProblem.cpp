@@ -128,7 +128,7 @@ QProblem::QProblem( int_t _nV, int_t _nC, HessianType _hessianType, BooleanType
 	if (allocDenseMats == BT_TRUE)
 	{
 		sizeT = getMin( _nV,_nC );
-		T = new real_t[sizeT*sizeT];
+		T = new real_t[TT_SIZE(sizeT,sizeT)];
 		Q = new real_t[_nV*_nV];
 	}
 	else
@@ -235,7 +235,7 @@ returnValue QProblem::reset( )
 
 	/* 3) Reset TQ factorisation. */
 	if ( T!=0 )
-		for( i=0; i<sizeT*sizeT; ++i )
+		for( i=0; i<TT_SIZE(sizeT,sizeT); ++i )
 			T[i] = 0.0;
 
 	if ( Q!=0 )
@@ -429,7 +429,14 @@ returnValue QProblem::init(	const char* const H_file, const char* const g_file,
 	else
 	{
 		/* Also read Cholesky factor from file and store it directly into R [thus... */
+		#ifndef __COMPACT_FACTORS__
 		returnValue returnvalue = readFromFile( R, nV,nV, R_file );
+		#else
+		real_t* Rfull = new real_t[nV*nV];
+		returnValue returnvalue = readFromFile( Rfull, nV,nV, R_file );
+		packR( Rfull,nV );
+		delete[] Rfull;
+		#endif
 		if ( returnvalue != SUCCESSFUL_RETURN )
 			return THROWWARNING( returnvalue );
 
@@ -624,6 +631,8 @@ returnValue QProblem::hotstart(	const real_t* const g_new,
 				break;
 			}
 
+			++statistics.nFarBoundGrowths;
+
 			/* advance ramp offset to avoid Ramping cycles */
 			rampOffset++;
 		}
@@ -1228,8 +1237,8 @@ returnValue QProblem::copy(	const QProblem& rhs
 
 	if ( rhs.T != 0 )
 	{
-		T = new real_t[sizeT*sizeT];
-		memcpy( T,rhs.T,((uint_t)(sizeT*sizeT))*sizeof(real_t) );
+		T = new real_t[TT_SIZE(sizeT,sizeT)];
+		memcpy( T,rhs.T,((uint_t)TT_SIZE(sizeT,sizeT))*sizeof(real_t) );
 	}
 	else
 		T = 0;
@@ -1638,6 +1647,9 @@ returnValue QProblem::solveQP(	const real_t* const g_new,
 		nC = getNC( );
 
 		homotopyLength = getRelativeHomotopyLength( g_new,lb_new,ub_new,lbA_new,ubA_new );
+		++statistics.nHomotopyIterations;
+		statistics.homotopyLength = homotopyLength;
+
 		if ( homotopyLength <= options.terminationTolerance )
 		{
 			status = QPS_SOLVED;
@@ -1688,6 +1700,7 @@ returnValue QProblem::solveQP(	const real_t* const g_new,
 		/* 6a) Possibly refactorise projected Hessian from scratch. */
 		if ( ( options.enableCholeskyRefactorisation > 0 ) && ( (iter % options.enableCholeskyRefactorisation) == 0 ) )
 		{
+			++statistics.nRefactorisations;
 			returnvalue = computeProjectedCholesky( );
 			if (returnvalue != SUCCESSFUL_RETURN)
 			{
@@ -1707,17 +1720,26 @@ returnValue QProblem::solveQP(	const real_t* const g_new,
 		if (BC_status != ST_UNDEFINED)
 		{
 			if ( ( tau <= EPS ) && ( options.enableRamping == BT_TRUE ) )
+			{
+				++statistics.nRampings;
 				performRamping( );
+			}
 			else
 			if ( (options.enableDriftCorrection > 0)
 			  && ((iter+1) % options.enableDriftCorrection == 0) )
+			{
+				++statistics.nDriftCorrections;
 				performDriftCorrection( );  /* always returns SUCCESSFUL_RETURN */
+			}
 		}
 		else // AW: Added this.  Otherwise, I observed that the gradient might become incorrect
 		{
 			if ( (options.enableDriftCorrection > 0)
 			  && ((iter+1) % options.enableDriftCorrection == 0) )
+			{
+				++statistics.nDriftCorrections;
 				performDriftCorrection( );  /* always returns SUCCESSFUL_RETURN */
+			}
 		}
 	}
 
@@ -1806,6 +1828,8 @@ returnValue QProblem::solveRegularisedQP(	const real_t* const g_new,
 
 	for( step=0; step<options.numRegularisationSteps; ++step )
 	{
+		++statistics.nRegularisationSteps;
+
 		/* 1) Modify gradient: gMod = g - eps*xOpt
 		 *    (assuming regularisation matrix to be regVal*Id). */
 		for( i=0; i<nV; ++i )
@@ -2046,13 +2070,22 @@ returnValue QProblem::computeProjectedCholesky( )
 		return QProblemB::computeCholesky( );
 
 	/* 1) Initialises R with all zeros. */
-	for( i=0; i<nV*nV; ++i )
+	for( i=0; i<RR_SIZE(nV,nV); ++i )
 		R[i] = 0.0;
 
 	/* Do not do anything for empty null spaces (important for LP case, HST_ZERO !)*/
 	if ( nZ == 0 ) // nZ == nV - getNFX() - getNAC()
 		return SUCCESSFUL_RETURN;
 
+	/* a compactly stored R is factorised within a full workspace */
+	#ifndef __COMPACT_FACTORS__
+	real_t* Rfull = R;
+	#else
+	real_t* Rfull = new real_t[nV*nV];
+	for( i=0; i<nV*nV; ++i )
+		Rfull[i] = 0.0;
+	#endif
+
 	/* 2) Calculate Cholesky decomposition of projected Hessian Z'*H*Z. */
 	int_t* FR_idx;
 	bounds.getFree( )->getNumberArray( &FR_idx );
@@ -2067,20 +2100,25 @@ returnValue QProblem::computeProjectedCholesky( )
 			if ( usingRegularisation() == BT_TRUE )
 			{
 				Id = createDiagSparseMat( nV, regVal );
-				Id->bilinear(bounds.getFree(), nZ, Q, nV, R, nV);
+				Id->bilinear(bounds.getFree(), nZ, Q, nV, Rfull, nV);
 				delete Id;
 			}
 			else
 			{
 				/* Code should not get here, as  nZ == 0  always holds for an LP (without regularisation)! */
 				if ( nZ > 0 )
+				{
+					#ifdef __COMPACT_FACTORS__
+					delete[] Rfull;
+					#endif
 					return THROWERROR( RET_UNKNOWN_BUG );
+				}
 			}
 			break;
 
 		case HST_IDENTITY:
 			Id = createDiagSparseMat( nV, 1.0 );
-			Id->bilinear(bounds.getFree(), nZ, Q, nV, R, nV);
+			Id->bilinear(bounds.getFree(), nZ, Q, nV, Rfull, nV);
 			delete Id;
 			break;
 
@@ -2095,10 +2133,10 @@ returnValue QProblem::computeProjectedCholesky( )
 				/* now Z is trivial, and so is Z'HZ */
 				int_t nFR = getNFR ();
 				for ( j=0; j < nFR; ++j )
-					H->getCol (FR_idx[j], bounds.getFree (), 1.0, &R[j*nV]);
+					H->getCol (FR_idx[j], bounds.getFree (), 1.0, &Rfull[j*nV]);
 			} else {
 				/* this is expensive if Z is large! */
-				H->bilinear(bounds.getFree(), nZ, Q, nV, R, nV);
+				H->bilinear(bounds.getFree(), nZ, Q, nV, Rfull, nV);
 			}
 	}
 
@@ -2106,7 +2144,12 @@ returnValue QProblem::computeProjectedCholesky( )
 	la_int_t info = 0;
 	la_uint_t _nZ = (la_uint_t)nZ, _nV = (la_uint_t)nV;
 
-	POTRF( "U", &_nZ, R, &_nV, &info );
+	POTRF( "U", &_nZ, Rfull, &_nV, &info );
+
+	#ifdef __COMPACT_FACTORS__
+	packR( Rfull,nZ );
+	delete[] Rfull;
+	#endif
 
 	/* <0 = invalid call, =0 ok, >0 not spd */
 	if (info > 0) {
@@ -2186,7 +2229,7 @@ returnValue QProblem::setupTQfactorisation( )
 	}
 
  	/* 2) Set T to zero matrix. */
-	for( i=0; i<sizeT*sizeT; ++i )
+	for( i=0; i<TT_SIZE(sizeT,sizeT); ++i )
 		T[i] = 0.0;
 
 	return SUCCESSFUL_RETURN;
@@ -3945,6 +3988,7 @@ returnValue QProblem::removeConstraint(	int_t number,
 
 				flipper.get( &bounds,R,&constraints,Q,T );
 				constraints.flipFixed(number);
+				++statistics.nFlips;
 				tabularOutput.idxAddC = number;
 				tabularOutput.excAddC = 2;
 
@@ -3991,6 +4035,8 @@ returnValue QProblem::removeConstraint(	int_t number,
 
 	if (exchangeHappened == BT_TRUE)
 	{
+		++statistics.nInertiaCorrections;
+
 		/* add bound or constraint */
 
 		/* hessianType = HST_SEMIDEF; */
@@ -4197,6 +4243,7 @@ returnValue QProblem::removeBound(	int_t number,
 
 				flipper.get( &bounds,R,&constraints,Q,T );
 				bounds.flipFixed(number);
+				++statistics.nFlips;
 				tabularOutput.idxAddB = number;
 				tabularOutput.excAddB = 2;
 
@@ -4230,6 +4277,8 @@ returnValue QProblem::removeBound(	int_t number,
 		}
 		else
 		{
+			++statistics.nInertiaCorrections;
+
 			/* add bound or constraint */
 
 			/* hessianType = HST_SEMIDEF; */
@@ -5082,20 +5131,31 @@ returnValue QProblem::performStep(	const real_t* const delta_g,
 	}
 	else
 	{
+		/* evaluate all bounded inactive constraints in one call,
+		 * den serves as contiguous output buffer */
+		int_t nEval = 0;
+		int_t* evalIdx = new int_t[nIAC];
+
 		for( i=0; i<nIAC; ++i )
 		{
 			ii = IAC_idx[i];
 
 			if ( constraints.getType( ii ) != ST_UNBOUNDED )
-			{
-				if ( (*constraintProduct)( ii,delta_x, &(delta_Ax[ii]) ) != 0 )
-				{
-					delete[] den; delete[] num;
-					delete[] delta_Ax; delete[] delta_Ax_u; delete[] delta_Ax_l; delete[] delta_x;
-					return THROWERROR( RET_ERROR_IN_CONSTRAINTPRODUCT );
-				}
-			}
+				evalIdx[nEval++] = ii;
+		}
+
+		if ( constraintProduct->evaluate( nEval,evalIdx,delta_x,den ) != 0 )
+		{
+			delete[] evalIdx;
+			delete[] den; delete[] num;
+			delete[] delta_Ax; delete[] delta_Ax_u; delete[] delta_Ax_l; delete[] delta_x;
+			return THROWERROR( RET_ERROR_IN_CONSTRAINTPRODUCT );
 		}
+
+		for( i=0; i<nEval; ++i )
+			delta_Ax[evalIdx[i]] = den[i];
+
+		delete[] evalIdx;
 	}
 
 	if ( constraints.hasNoLower( ) == BT_FALSE )
@@ -5245,7 +5305,27 @@ returnValue QProblem::performStep(	const real_t* const delta_g,
 			ubA[i] += tau*delta_ubA[i];
 		}
 
-		A->times( constraints.getActive(),0, 1, 1.0, x, nV, 0.0, Ax, nC, BT_FALSE );
+		if ( constraintProduct == 0 )
+		{
+			A->times( constraints.getActive(),0, 1, 1.0, x, nV, 0.0, Ax, nC, BT_FALSE );
+		}
+		else
+		{
+			real_t* AxAC = new real_t[nAC];
+
+			if ( constraintProduct->evaluate( nAC,AC_idx,x,AxAC ) != 0 )
+			{
+				delete[] AxAC;
+				delete[] delta_Ax; delete[] delta_Ax_u; delete[] delta_Ax_l;
+				return THROWERROR( RET_ERROR_IN_CONSTRAINTPRODUCT );
+			}
+
+			for( i=0; i<nAC; ++i )
+				Ax[AC_idx[i]] = AxAC[i];
+
+			delete[] AxAC;
+		}
+
 		for( i=0; i<nAC; ++i )
 		{
 			ii = AC_idx[i];
@@ -5307,6 +5387,8 @@ returnValue QProblem::changeActiveSet( int_t BC_idx, SubjectToStatus BC_status,
 				if ( removeBound( BC_idx,BT_TRUE,BT_TRUE,options.enableNZCTests ) != SUCCESSFUL_RETURN )
 					return THROWERROR( RET_REMOVE_FROM_ACTIVESET_FAILED );
 
+				++statistics.nRemovedBounds;
+
 				y[BC_idx] = 0.0;
 			}
 			else
@@ -5319,6 +5401,8 @@ returnValue QProblem::changeActiveSet( int_t BC_idx, SubjectToStatus BC_status,
 				if ( removeConstraint( BC_idx,BT_TRUE,BT_TRUE,options.enableNZCTests ) != SUCCESSFUL_RETURN )
 					return THROWERROR( RET_REMOVE_FROM_ACTIVESET_FAILED );
 
+				++statistics.nRemovedConstraints;
+
 				y[nV+BC_idx] = 0.0;
 			}
 			break;
@@ -5342,6 +5426,8 @@ returnValue QProblem::changeActiveSet( int_t BC_idx, SubjectToStatus BC_status,
 					return returnvalue;
 				if ( returnvalue != SUCCESSFUL_RETURN )
 					return THROWERROR( RET_ADD_TO_ACTIVESET_FAILED );
+
+				++statistics.nAddedBounds;
 			}
 			else
 			{
@@ -5358,6 +5444,8 @@ returnValue QProblem::changeActiveSet( int_t BC_idx, SubjectToStatus BC_status,
 					return returnvalue;
 				if ( returnvalue != SUCCESSFUL_RETURN )
 					return THROWERROR( RET_ADD_TO_ACTIVESET_FAILED );
+
+				++statistics.nAddedConstraints;
 			}
 	}
 
@@ -5690,6 +5778,7 @@ returnValue QProblem::setupAuxiliaryQP( const Bounds* const guessedBounds, const
 			return THROWERROR( RET_SETUP_AUXILIARYQP_FAILED );
 
 		/* 2) Setup TQ factorisation. */
+		++statistics.nRefactorisations;
 		if ( setupTQfactorisation( ) != SUCCESSFUL_RETURN )
 			return THROWERROR( RET_SETUP_AUXILIARYQP_FAILED );
 
@@ -6423,7 +6512,16 @@ returnValue QProblem::writeQpWorkspaceIntoMatFile(	const char* const filename
 	int_t nIAC = getNIAC();
 
 
+	#ifndef __COMPACT_FACTORS__
 	writeIntoMatFile( matFile, T, sizeT,sizeT, "T" );
+	#else
+	real_t* Tfull = new real_t[sizeT*sizeT];
+	for( int_t i=0; i<sizeT; ++i )
+		for( int_t j=0; j<sizeT; ++j )
+			Tfull[i*sizeT+j] = ( j >= sizeT-2-i ) ? TT(i,j) : 0.0;
+	writeIntoMatFile( matFile, Tfull, sizeT,sizeT, "T" );
+	delete[] Tfull;
+	#endif
 	writeIntoMatFile( matFile, Q, nV,nV, "Q" );
 
 	writeIntoMatFile( matFile, Ax, nC,1, "Ax" );
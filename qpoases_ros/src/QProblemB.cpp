@@ -81,6 +81,8 @@ QProblemB::QProblemB( )
 	status = QPS_NOTINITIALISED;
 
 	count = 0;
+	resetStatistics( );
+	cancelFlag = 0;
 
 	ramp0 = options.initialRamping;
 	ramp1 = options.finalRamping;
@@ -129,8 +131,8 @@ QProblemB::QProblemB( int_t _nV, HessianType _hessianType, BooleanType allocDens
 
 	if ( allocDenseMats == BT_TRUE )
 	{
-		R = new real_t[_nV*_nV];
-		for( i=0; i<_nV*_nV; ++i ) R[i] = 0.0;
+		R = new real_t[RR_SIZE(_nV,_nV)];
+		for( i=0; i<RR_SIZE(_nV,_nV); ++i ) R[i] = 0.0;
 	}
 	else R = 0;
 	haveCholesky = BT_FALSE;
@@ -152,6 +154,8 @@ QProblemB::QProblemB( int_t _nV, HessianType _hessianType, BooleanType allocDens
 	status = QPS_NOTINITIALISED;
 
 	count = 0;
+	resetStatistics( );
+	cancelFlag = 0;
 
 	ramp0 = options.initialRamping;
 	ramp1 = options.finalRamping;
@@ -220,7 +224,7 @@ returnValue QProblemB::reset( )
 
 	/* 2) Reset Cholesky decomposition. */
 	if ( R!=0 )
-		for( i=0; i<nV*nV; ++i )
+		for( i=0; i<RR_SIZE(nV,nV); ++i )
 			R[i] = 0.0;
 
 	haveCholesky = BT_FALSE;
@@ -397,7 +401,14 @@ returnValue QProblemB::init( 	const char* const H_file, const char* const g_file
 	else
 	{
 		/* Also read Cholesky factor from file and store it directly into R [thus... */
+		#ifndef __COMPACT_FACTORS__
 		returnValue returnvalue = readFromFile( R, nV,nV, R_file );
+		#else
+		real_t* Rfull = new real_t[nV*nV];
+		returnValue returnvalue = readFromFile( Rfull, nV,nV, R_file );
+		packR( Rfull,nV );
+		delete[] Rfull;
+		#endif
 		if ( returnvalue != SUCCESSFUL_RETURN )
 			return THROWWARNING( returnvalue );
 
@@ -563,6 +574,8 @@ returnValue QProblemB::hotstart(	const real_t* const g_new,
 				break;
 			}
 
+			++statistics.nFarBoundGrowths;
+
 			/* advance ramp offset to avoid Ramping cycles */
 			rampOffset++;
 		}
@@ -834,35 +847,44 @@ returnValue QProblemB::setPrintLevel( PrintLevel _printLevel )
 	#endif /* __SUPPRESSANYOUTPUT__ */
 
 	/* update message handler preferences */
+	VisibilityStatus errorVisibility   = VS_VISIBLE;
+	VisibilityStatus warningVisibility = VS_VISIBLE;
+	VisibilityStatus infoVisibility    = VS_VISIBLE;
+
  	switch ( options.printLevel )
  	{
  		case PL_NONE:
- 			getGlobalMessageHandler( )->setErrorVisibilityStatus( VS_HIDDEN );
-			getGlobalMessageHandler( )->setWarningVisibilityStatus( VS_HIDDEN );
-			getGlobalMessageHandler( )->setInfoVisibilityStatus( VS_HIDDEN );
+ 			errorVisibility   = VS_HIDDEN;
+			warningVisibility = VS_HIDDEN;
+			infoVisibility    = VS_HIDDEN;
 			break;
 
 		case PL_TABULAR:
 		case PL_LOW:
-			getGlobalMessageHandler( )->setErrorVisibilityStatus( VS_VISIBLE );
-			getGlobalMessageHandler( )->setWarningVisibilityStatus( VS_HIDDEN );
-			getGlobalMessageHandler( )->setInfoVisibilityStatus( VS_HIDDEN );
+			warningVisibility = VS_HIDDEN;
+			infoVisibility    = VS_HIDDEN;
 			break;
 
 		case PL_DEBUG_ITER:
 		case PL_MEDIUM:
-			getGlobalMessageHandler( )->setErrorVisibilityStatus( VS_VISIBLE );
-			getGlobalMessageHandler( )->setWarningVisibilityStatus( VS_VISIBLE );
-			getGlobalMessageHandler( )->setInfoVisibilityStatus( VS_HIDDEN );
+			infoVisibility    = VS_HIDDEN;
 			break;
 
 		default: /* PL_HIGH */
-			getGlobalMessageHandler( )->setErrorVisibilityStatus( VS_VISIBLE );
-			getGlobalMessageHandler( )->setWarningVisibilityStatus( VS_VISIBLE );
-			getGlobalMessageHandler( )->setInfoVisibilityStatus( VS_VISIBLE );
 			break;
  	}
 
+	/* only write changed preferences, so that QPs sharing one print level
+	 * can be copied while others are being solved (see RacingSolver) */
+	if ( getGlobalMessageHandler( )->getErrorVisibilityStatus( ) != errorVisibility )
+		getGlobalMessageHandler( )->setErrorVisibilityStatus( errorVisibility );
+
+	if ( getGlobalMessageHandler( )->getWarningVisibilityStatus( ) != warningVisibility )
+		getGlobalMessageHandler( )->setWarningVisibilityStatus( warningVisibility );
+
+	if ( getGlobalMessageHandler( )->getInfoVisibilityStatus( ) != infoVisibility )
+		getGlobalMessageHandler( )->setInfoVisibilityStatus( infoVisibility );
+
 	return SUCCESSFUL_RETURN;
 }
 
@@ -1118,8 +1140,8 @@ returnValue QProblemB::copy(	const QProblemB& rhs
 
 	if ( rhs.R != 0 )
 	{
-		R = new real_t[_nV*_nV];
-		memcpy( R,rhs.R,_nV*_nV*sizeof(real_t) );
+		R = new real_t[RR_SIZE(_nV,_nV)];
+		memcpy( R,rhs.R,RR_SIZE(_nV,_nV)*sizeof(real_t) );
 	}
 	else
 		R = 0;
@@ -1153,6 +1175,9 @@ returnValue QProblemB::copy(	const QProblemB& rhs
 	status = rhs.status;
 
 	count = rhs.count;
+	statistics = rhs.statistics;
+	/* the cancel flag belongs to whoever set it (e.g. a RacingSolver), a copy may outlive it */
+	cancelFlag = 0;
 
 	ramp0 = rhs.ramp0;
 	ramp1 = rhs.ramp1;
@@ -1370,7 +1395,7 @@ returnValue QProblemB::computeCholesky( )
 	int_t nFR = getNFR( );
 
 	/* 1) Initialises R with all zeros. */
-	for( i=0; i<nV*nV; ++i )
+	for( i=0; i<RR_SIZE(nV,nV); ++i )
 		R[i] = 0.0;
 
 	/* 2) Calculate Cholesky decomposition of H (projected to free variables). */
@@ -1407,15 +1432,27 @@ returnValue QProblemB::computeCholesky( )
 				int_t* FR_idx;
 				bounds.getFree( )->getNumberArray( &FR_idx );
 
+				/* a compactly stored R is factorised within a full workspace */
+				#ifndef __COMPACT_FACTORS__
+				real_t* Rfull = R;
+				#else
+				real_t* Rfull = new real_t[nV*nV];
+				#endif
+
 				/* get H */
 				for ( j=0; j < nFR; ++j )
-					H->getCol (FR_idx[j], bounds.getFree (), 1.0, &(R[j*nV]) );
+					H->getCol (FR_idx[j], bounds.getFree (), 1.0, &(Rfull[j*nV]) );
 
 				/* R'*R = H */
 				la_int_t info = 0;
 				la_uint_t _nFR = (la_uint_t)nFR, _nV = (la_uint_t)nV;
 
-				POTRF( "U", &_nFR, R, &_nV, &info );
+				POTRF( "U", &_nFR, Rfull, &_nV, &info );
+
+				#ifdef __COMPACT_FACTORS__
+				packR( Rfull,nFR );
+				delete[] Rfull;
+				#endif
 
 				/* <0 = invalid call, =0 ok, >0 not spd */
 				if (info > 0) {
@@ -1441,6 +1478,30 @@ returnValue QProblemB::computeCholesky( )
 }
 
 
+/*
+ *	p a c k R
+ */
+returnValue QProblemB::packR(	const real_t* const Rfull,
+								int_t nR
+								)
+{
+	int_t i, j;
+	int_t nV = getNV( );
+
+	if ( Rfull == R )
+		return SUCCESSFUL_RETURN;
+
+	for( i=0; i<RR_SIZE(nV,nV); ++i )
+		R[i] = 0.0;
+
+	for( j=0; j<nR; ++j )
+		for( i=0; i<=j; ++i )
+			RR(i,j) = Rfull[i+nV*j];
+
+	return SUCCESSFUL_RETURN;
+}
+
+
 /*
  *	s e t u p I n i t i a l C h o l e s k y
  */
@@ -1973,6 +2034,10 @@ BooleanType QProblemB::isCPUtimeLimitExceeded(	const real_t* const cputime,
 												int_t nWSR
 												) const
 {
+	/* Stop immediately if solution process has been cancelled. */
+	if ( isCancelled( ) == BT_TRUE )
+		return BT_TRUE;
+
 	/* Always perform next QP iteration if no CPU time limit is given. */
 	if ( cputime == 0 )
 		return BT_FALSE;
@@ -2547,6 +2612,9 @@ returnValue QProblemB::solveQP(	const real_t* const g_new,
 
 		/* 5) Termination criterion. */
 		homotopyLength = getRelativeHomotopyLength(g_new, lb_new, ub_new);
+		++statistics.nHomotopyIterations;
+		statistics.homotopyLength = homotopyLength;
+
 		if ( homotopyLength <= options.terminationTolerance )
 		{
 			status = QPS_SOLVED;
@@ -2598,6 +2666,7 @@ returnValue QProblemB::solveQP(	const real_t* const g_new,
 		/* 6a) Possibly refactorise projected Hessian from scratch. */
 		if ( ( options.enableCholeskyRefactorisation > 0 ) && ( (iter % options.enableCholeskyRefactorisation) == 0 ) )
 		{
+			++statistics.nRefactorisations;
 			returnvalue = computeCholesky( );
 			if (returnvalue != SUCCESSFUL_RETURN)
 			{
@@ -2610,10 +2679,16 @@ returnValue QProblemB::solveQP(	const real_t* const g_new,
 
 		/* 7) Perform Ramping Strategy on zero homotopy step or drift correction (if desired). */
 		 if ( ( tau <= EPS ) && ( options.enableRamping == BT_TRUE ) )
+		{
+			++statistics.nRampings;
 			performRamping( );
+		}
 		else
 		if ( (options.enableDriftCorrection > 0) && ((iter+1) % options.enableDriftCorrection == 0) )
+		{
+			++statistics.nDriftCorrections;
 			performDriftCorrection( );  /* always returns SUCCESSFUL_RETURN */
+		}
 
 		/* 8) Output information of successful QP iteration. */
 		status = QPS_HOMOTOPYQPSOLVED;
@@ -2707,6 +2782,8 @@ returnValue QProblemB::solveRegularisedQP(	const real_t* const g_new,
 
 	for( step=0; step<options.numRegularisationSteps; ++step )
 	{
+		++statistics.nRegularisationSteps;
+
 		/* 1) Modify gradient: gMod = g - eps*xOpt
 		 *    (assuming regularisation matrix to be regVal*Id). */
 		for( i=0; i<nV; ++i )
@@ -3008,6 +3085,7 @@ returnValue QProblemB::setupAuxiliaryQP( const Bounds* const guessedBounds )
 			THROWERROR( RET_SETUP_AUXILIARYQP_FAILED );
 
 		/* 3) Calculate Cholesky decomposition. */
+		++statistics.nRefactorisations;
 		if ( computeCholesky( ) != SUCCESSFUL_RETURN )
 			return THROWERROR( RET_SETUP_AUXILIARYQP_FAILED );
 	}
@@ -3375,6 +3453,8 @@ returnValue QProblemB::changeActiveSet( int_t BC_idx, SubjectToStatus BC_status
 			if ( removeBound( BC_idx,BT_TRUE ) != SUCCESSFUL_RETURN )
 				return THROWERROR( RET_REMOVE_FROM_ACTIVESET_FAILED );
 
+			++statistics.nRemovedBounds;
+
 			y[BC_idx] = 0.0;
 			break;
 
@@ -3391,6 +3471,8 @@ returnValue QProblemB::changeActiveSet( int_t BC_idx, SubjectToStatus BC_status
 
 			if ( addBound( BC_idx,BC_status,BT_TRUE ) != SUCCESSFUL_RETURN )
 				return THROWERROR( RET_ADD_TO_ACTIVESET_FAILED );
+
+			++statistics.nAddedBounds;
 			break;
 	}
 
@@ -3530,8 +3612,8 @@ returnValue QProblemB::addBound(	int_t number, SubjectToStatus B_status,
 		}
 
 		/* 3) Delete <number_idx>th column and ... */
-		for( i=0; i<nFR-1; ++i )
-			for( j=number_idx+1; j<nFR; ++j )
+		for( j=number_idx+1; j<nFR; ++j )
+			for( i=0; i<=getMin( j,nFR-2 ); ++i ) /* entries below the subdiagonal are not used */
 				RR(i,j-1) = RR(i,j);
 		/* ... last column of R. */
 		for( i=0; i<nFR; ++i )
@@ -3641,6 +3723,7 @@ returnValue QProblemB::removeBound(	int_t number,
 
 				flipper.get( &bounds,R );
 				bounds.flipFixed(number);
+				++statistics.nFlips;
 
 				switch (bounds.getStatus(number))
 				{
@@ -3671,6 +3754,7 @@ returnValue QProblemB::removeBound(	int_t number,
 	{
 		flipper.get( &bounds,R );
 		bounds.flipFixed(number);
+		++statistics.nFlips;
 
 		switch (bounds.getStatus(number))
 		{
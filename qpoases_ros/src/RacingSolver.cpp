@@ -0,0 +1,686 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file src/RacingSolver.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Implementation of the RacingSolver class which performs the same hotstart
+ *	concurrently on several clones of a QP with different options.
+ */
+
+
+#include <qpOASES/extras/RacingSolver.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	R a c i n g S o l v e r
+ */
+RacingSolver::RacingSolver( )
+{
+	nCandidates = 0;
+	candidates = 0;
+	candidateOptions = 0;
+	guessedBounds = 0;
+	guessedConstraints = 0;
+
+	candidateStatus = 0;
+	candidateNWSR = 0;
+	candidateTime = 0;
+	tasks = 0;
+
+	winner = -1;
+	cancelFlag = 0;
+
+	g = 0;
+	lb = 0;
+	ub = 0;
+	lbA = 0;
+	ubA = 0;
+	useTime = BT_FALSE;
+	resyncPending = BT_FALSE;
+
+	#ifndef __NO_THREADS__
+	threads = 0;
+	nThreads = 0;
+	generation = 0;
+	nFinished = 0;
+	nIdle = 0;
+	stopRequested = BT_FALSE;
+	pthread_mutex_init( &mutex,0 );
+	pthread_cond_init( &started,0 );
+	pthread_cond_init( &finished,0 );
+	pthread_cond_init( &idle,0 );
+	#endif
+}
+
+
+/*
+ *	R a c i n g S o l v e r
+ */
+RacingSolver::RacingSolver(	const QProblem& _qp,
+							uint_t _nCandidates,
+							const Options* const _candidateOptions
+							)
+{
+	nCandidates = 0;
+	candidates = 0;
+	candidateOptions = 0;
+	guessedBounds = 0;
+	guessedConstraints = 0;
+
+	candidateStatus = 0;
+	candidateNWSR = 0;
+	candidateTime = 0;
+	tasks = 0;
+
+	winner = -1;
+	cancelFlag = 0;
+
+	g = 0;
+	lb = 0;
+	ub = 0;
+	lbA = 0;
+	ubA = 0;
+	useTime = BT_FALSE;
+	resyncPending = BT_FALSE;
+
+	#ifndef __NO_THREADS__
+	threads = 0;
+	nThreads = 0;
+	generation = 0;
+	nFinished = 0;
+	nIdle = 0;
+	stopRequested = BT_FALSE;
+	pthread_mutex_init( &mutex,0 );
+	pthread_cond_init( &started,0 );
+	pthread_cond_init( &finished,0 );
+	pthread_cond_init( &idle,0 );
+	#endif
+
+	init( _qp,_nCandidates,_candidateOptions );
+}
+
+
+/*
+ *	~ R a c i n g S o l v e r
+ */
+RacingSolver::~RacingSolver( )
+{
+	clear( );
+
+	#ifndef __NO_THREADS__
+	pthread_cond_destroy( &idle );
+	pthread_cond_destroy( &finished );
+	pthread_cond_destroy( &started );
+	pthread_mutex_destroy( &mutex );
+	#endif
+}
+
+
+/*
+ *	i n i t
+ */
+returnValue RacingSolver::init(	const QProblem& _qp,
+								uint_t _nCandidates,
+								const Options* const _candidateOptions
+								)
+{
+	uint_t i;
+
+	if ( ( _nCandidates == 0 ) || ( _candidateOptions == 0 ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	clear( );
+
+	nCandidates = _nCandidates;
+
+	candidates = new QProblem*[nCandidates];
+	candidateOptions = new Options[nCandidates];
+	guessedBounds = new Bounds*[nCandidates];
+	guessedConstraints = new Constraints*[nCandidates];
+
+	candidateStatus = new returnValue[nCandidates];
+	candidateNWSR = new int_t[nCandidates];
+	candidateTime = new real_t[nCandidates];
+	tasks = new RacingSolverTask[nCandidates];
+
+	#ifndef __NO_THREADS__
+	threads = new pthread_t[nCandidates];
+	#endif
+
+	for( i=0; i<nCandidates; ++i )
+	{
+		candidates[i] = new QProblem( _qp );
+
+		/* candidates run concurrently, so none of them may print; this also
+		 * hides all messages of the global message handler, which makes
+		 * resynchronising candidates (in parallel) leave it untouched */
+		candidateOptions[i] = _candidateOptions[i];
+		candidateOptions[i].printLevel = PL_NONE;
+		candidateOptions[i].ensureConsistency( );
+		candidates[i]->setPrintLevel( PL_NONE );
+		applyOptions( i );
+
+		candidates[i]->setCancelFlag( &cancelFlag );
+
+		guessedBounds[i] = 0;
+		guessedConstraints[i] = 0;
+
+		candidateStatus[i] = RET_RACE_NO_WINNER;
+		candidateNWSR[i] = 0;
+		candidateTime[i] = 0.0;
+
+		tasks[i].solver = this;
+		tasks[i].number = i;
+	}
+
+	winner = -1;
+
+	#ifndef __NO_THREADS__
+	/* start one worker per candidate; they wait for hotstarts until clear() */
+	generation = 0;
+	nFinished = 0;
+	stopRequested = BT_FALSE;
+
+	for( nThreads=0; nThreads<nCandidates; ++nThreads )
+		if ( pthread_create( &(threads[nThreads]),0,RacingSolver::run,&(tasks[nThreads]) ) != 0 )
+			break;
+
+	nIdle = nThreads;
+
+	if ( nThreads < nCandidates )
+		THROWWARNING( RET_RACE_START_FAILED );
+	#endif /* __NO_THREADS__ */
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s e t G u e s s e d W o r k i n g S e t
+ */
+returnValue RacingSolver::setGuessedWorkingSet(	uint_t number,
+												const Bounds* const _guessedBounds,
+												const Constraints* const _guessedConstraints
+												)
+{
+	if ( number >= nCandidates )
+		return THROWERROR( RET_INDEX_OUT_OF_BOUNDS );
+
+	/* candidate must not be working while its guesses change */
+	synchronise( );
+
+	if ( guessedBounds[number] != 0 )
+	{
+		delete guessedBounds[number];
+		guessedBounds[number] = 0;
+	}
+
+	if ( guessedConstraints[number] != 0 )
+	{
+		delete guessedConstraints[number];
+		guessedConstraints[number] = 0;
+	}
+
+	if ( _guessedBounds != 0 )
+		guessedBounds[number] = new Bounds( *_guessedBounds );
+
+	if ( _guessedConstraints != 0 )
+		guessedConstraints[number] = new Constraints( *_guessedConstraints );
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	h o t s t a r t
+ */
+returnValue RacingSolver::hotstart(	const real_t* const g_new,
+									const real_t* const lb_new, const real_t* const ub_new,
+									const real_t* const lbA_new, const real_t* const ubA_new,
+									int_t& nWSR, real_t* const cputime
+									)
+{
+	uint_t i;
+
+	if ( nCandidates == 0 )
+		return THROWERROR( RET_RACE_NOT_INITIALISED );
+
+	/* losers of the last hotstart have to be up to date */
+	synchronise( );
+
+	g = g_new;
+	lb = lb_new;
+	ub = ub_new;
+	lbA = lbA_new;
+	ubA = ubA_new;
+	useTime = ( cputime != 0 ) ? BT_TRUE : BT_FALSE;
+
+	for( i=0; i<nCandidates; ++i )
+	{
+		candidateStatus[i] = RET_RACE_NO_WINNER;
+		candidateNWSR[i] = nWSR;
+		candidateTime[i] = ( cputime != 0 ) ? *cputime : 0.0;
+	}
+
+	winner = -1;
+	cancelFlag = 0;
+
+	#ifndef __NO_THREADS__
+	/* hand the hotstart to the candidate threads */
+	pthread_mutex_lock( &mutex );
+	nFinished = 0;
+	nIdle = 0;
+	++generation;
+	pthread_cond_broadcast( &started );
+	pthread_mutex_unlock( &mutex );
+
+	/* candidates without thread are run on the calling thread */
+	for( i=nThreads; i<nCandidates; ++i )
+	{
+		race( i );
+		signalFinished( );
+	}
+
+	/* wait until all candidates are done with the (caller-owned) QP data */
+	pthread_mutex_lock( &mutex );
+	while ( nFinished < nCandidates )
+		pthread_cond_wait( &finished,&mutex );
+	pthread_mutex_unlock( &mutex );
+	#else
+	for( i=0; i<nCandidates; ++i )
+	{
+		race( i );
+		if ( winner >= 0 )
+			break;
+	}
+	#endif /* __NO_THREADS__ */
+
+	g = 0;
+	lb = 0;
+	ub = 0;
+	lbA = 0;
+	ubA = 0;
+
+	if ( winner < 0 )
+	{
+		nWSR = candidateNWSR[0];
+		if ( cputime != 0 )
+			*cputime = candidateTime[0];
+
+		return candidateStatus[0];
+	}
+
+	/* threads resynchronise their candidates themselves,
+	 * all others are resynchronised lazily by synchronise() */
+	#ifndef __NO_THREADS__
+	if ( nThreads < nCandidates )
+		resyncPending = BT_TRUE;
+	#else
+	resyncPending = BT_TRUE;
+	#endif
+
+	nWSR = candidateNWSR[winner];
+	if ( cputime != 0 )
+		*cputime = candidateTime[winner];
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s y n c h r o n i s e
+ */
+returnValue RacingSolver::synchronise( )
+{
+	uint_t i;
+	uint_t first = 0;
+
+	#ifndef __NO_THREADS__
+	pthread_mutex_lock( &mutex );
+	while ( nIdle < nThreads )
+		pthread_cond_wait( &idle,&mutex );
+	pthread_mutex_unlock( &mutex );
+
+	first = nThreads;
+	#endif
+
+	if ( resyncPending == BT_TRUE )
+	{
+		for( i=first; i<nCandidates; ++i )
+			if ( (int_t)i != winner )
+				resync( i );
+
+		resyncPending = BT_FALSE;
+	}
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	g e t C a n d i d a t e
+ */
+QProblem* RacingSolver::getCandidate(	uint_t number
+										)
+{
+	if ( number >= nCandidates )
+		return 0;
+
+	synchronise( );
+
+	return candidates[number];
+}
+
+
+/*
+ *	g e t P r i m a l S o l u t i o n
+ */
+returnValue RacingSolver::getPrimalSolution(	real_t* const xOpt
+												) const
+{
+	if ( winner < 0 )
+		return RET_RACE_NO_WINNER;
+
+	/* winner is only read while losers are resynchronised */
+	return candidates[winner]->getPrimalSolution( xOpt );
+}
+
+
+/*
+ *	g e t D u a l S o l u t i o n
+ */
+returnValue RacingSolver::getDualSolution(	real_t* const yOpt
+											) const
+{
+	if ( winner < 0 )
+		return RET_RACE_NO_WINNER;
+
+	return candidates[winner]->getDualSolution( yOpt );
+}
+
+
+/*
+ *	g e t O b j V a l
+ */
+real_t RacingSolver::getObjVal( ) const
+{
+	if ( winner < 0 )
+		return INFTY;
+
+	return candidates[winner]->getObjVal( );
+}
+
+
+
+/*****************************************************************************
+ *  P R O T E C T E D                                                        *
+ *****************************************************************************/
+
+
+/*
+ *	c l e a r
+ */
+returnValue RacingSolver::clear( )
+{
+	uint_t i;
+
+	synchronise( );
+
+	#ifndef __NO_THREADS__
+	if ( nThreads > 0 )
+	{
+		pthread_mutex_lock( &mutex );
+		stopRequested = BT_TRUE;
+		pthread_cond_broadcast( &started );
+		pthread_mutex_unlock( &mutex );
+
+		for( i=0; i<nThreads; ++i )
+			pthread_join( threads[i],0 );
+
+		nThreads = 0;
+		stopRequested = BT_FALSE;
+	}
+	#endif
+
+	for( i=0; i<nCandidates; ++i )
+	{
+		delete candidates[i];
+
+		if ( guessedBounds[i] != 0 )
+			delete guessedBounds[i];
+
+		if ( guessedConstraints[i] != 0 )
+			delete guessedConstraints[i];
+	}
+
+	if ( candidates != 0 )
+	{
+		delete[] candidates;
+		candidates = 0;
+	}
+
+	if ( candidateOptions != 0 )
+	{
+		delete[] candidateOptions;
+		candidateOptions = 0;
+	}
+
+	if ( guessedBounds != 0 )
+	{
+		delete[] guessedBounds;
+		guessedBounds = 0;
+	}
+
+	if ( guessedConstraints != 0 )
+	{
+		delete[] guessedConstraints;
+		guessedConstraints = 0;
+	}
+
+	if ( candidateStatus != 0 )
+	{
+		delete[] candidateStatus;
+		candidateStatus = 0;
+	}
+
+	if ( candidateNWSR != 0 )
+	{
+		delete[] candidateNWSR;
+		candidateNWSR = 0;
+	}
+
+	if ( candidateTime != 0 )
+	{
+		delete[] candidateTime;
+		candidateTime = 0;
+	}
+
+	if ( tasks != 0 )
+	{
+		delete[] tasks;
+		tasks = 0;
+	}
+
+	#ifndef __NO_THREADS__
+	if ( threads != 0 )
+	{
+		delete[] threads;
+		threads = 0;
+	}
+	#endif
+
+	nCandidates = 0;
+	winner = -1;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	r a c e
+ */
+void RacingSolver::race(	uint_t number
+							)
+{
+	int_t expected = -1;
+
+	candidateStatus[number] = candidates[number]->hotstart(	g,lb,ub,lbA,ubA,
+															candidateNWSR[number],
+															( useTime == BT_TRUE ) ? &(candidateTime[number]) : 0,
+															guessedBounds[number],guessedConstraints[number]
+															);
+
+	if ( candidateStatus[number] != SUCCESSFUL_RETURN )
+		return;
+
+	/* first successful candidate claims the win and cancels all others */
+	#ifndef __NO_THREADS__
+	if ( __atomic_compare_exchange_n( &winner,&expected,(int_t)number,false,__ATOMIC_ACQ_REL,__ATOMIC_ACQUIRE ) )
+		__atomic_store_n( &cancelFlag,1,__ATOMIC_RELAXED );
+	#else
+	if ( winner == expected )
+	{
+		winner = (int_t)number;
+		cancelFlag = 1;
+	}
+	#endif
+}
+
+
+/*
+ *	r e s y n c
+ */
+void RacingSolver::resync(	uint_t number
+							)
+{
+	/* deep copy of winner's working set, factorisations and solution;
+	 * the options preset of the candidate is restored afterwards */
+	*(candidates[number]) = *(candidates[winner]);
+	candidates[number]->setCancelFlag( &cancelFlag );
+	applyOptions( number );
+}
+
+
+/*
+ *	a p p l y O p t i o n s
+ */
+void RacingSolver::applyOptions(	uint_t number
+									)
+{
+	QProblem* candidate = candidates[number];
+
+	/* regularisation may have been switched on for a semi-definite Hessian,
+	 * which the (copied) factorisations rely on */
+	BooleanType enableRegularisation = candidate->options.enableRegularisation;
+
+	candidate->options = candidateOptions[number];
+	if ( enableRegularisation == BT_TRUE )
+		candidate->options.enableRegularisation = BT_TRUE;
+
+	/* the ramping values are only derived from the options when a QP is reset,
+	 * a copy takes them over from the original */
+	candidate->ramp0 = candidateOptions[number].initialRamping;
+	candidate->ramp1 = candidateOptions[number].finalRamping;
+}
+
+
+/*
+ *	s i g n a l F i n i s h e d
+ */
+void RacingSolver::signalFinished( )
+{
+	#ifndef __NO_THREADS__
+	pthread_mutex_lock( &mutex );
+	if ( ++nFinished == nCandidates )
+		pthread_cond_broadcast( &finished );
+	pthread_mutex_unlock( &mutex );
+	#endif
+}
+
+
+/*
+ *	r u n
+ */
+void* RacingSolver::run(	void* arg
+							)
+{
+	#ifndef __NO_THREADS__
+	RacingSolverTask* task = (RacingSolverTask*)arg;
+	RacingSolver* solver = task->solver;
+	uint_t handled = 0;
+
+	pthread_mutex_lock( &solver->mutex );
+	for( ;; )
+	{
+		/* wait for the next hotstart (or for clear()) */
+		while ( ( solver->generation == handled ) && ( solver->stopRequested == BT_FALSE ) )
+			pthread_cond_wait( &solver->started,&solver->mutex );
+
+		if ( solver->stopRequested == BT_TRUE )
+			break;
+
+		handled = solver->generation;
+		pthread_mutex_unlock( &solver->mutex );
+
+		solver->race( task->number );
+		solver->signalFinished( );
+
+		/* a winner may still emerge until all candidates have finished */
+		pthread_mutex_lock( &solver->mutex );
+		while ( solver->nFinished < solver->nCandidates )
+			pthread_cond_wait( &solver->finished,&solver->mutex );
+		pthread_mutex_unlock( &solver->mutex );
+
+		if ( ( solver->winner >= 0 ) && ( solver->winner != (int_t)task->number ) )
+			solver->resync( task->number );
+
+		pthread_mutex_lock( &solver->mutex );
+		if ( ++solver->nIdle == solver->nThreads )
+			pthread_cond_broadcast( &solver->idle );
+	}
+	pthread_mutex_unlock( &solver->mutex );
+	#endif /* __NO_THREADS__ */
+
+	return 0;
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
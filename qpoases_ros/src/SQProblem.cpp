@@ -457,6 +457,7 @@ returnValue SQProblem::setupNewAuxiliaryQP(	SymmetricMatrix *H_new, Matrix *A_ne
             return THROWERROR( RET_SETUP_AUXILIARYQP_FAILED );
 
         /* 2) Setup TQ factorisation. */
+        ++statistics.nRefactorisations;
         if ( setupTQfactorisation( ) != SUCCESSFUL_RETURN )
             return THROWERROR( RET_SETUP_AUXILIARYQP_FAILED );
 
@@ -35,6 +35,7 @@
  */
 
 #include <qpOASES/SQProblemSchur.hpp>
+#include <qpOASES/AsyncOutput.hpp>
 
 
 #ifndef __MATLAB__
@@ -44,7 +45,16 @@ void MyPrintf(const char* pformat, ... )
   va_list ap;
   va_start(ap, pformat);
 
-  vfprintf(stdout, pformat, ap);
+  /* keep the solver thread free of stream I/O if an output thread is attached */
+  qpOASES::AsyncOutput* asyncOutput = qpOASES::getGlobalMessageHandler( )->getAsyncOutput( );
+  if ( asyncOutput != 0 )
+  {
+    char myPrintfString[qpOASES::MAX_STRING_LENGTH];
+    vsnprintf(myPrintfString, qpOASES::MAX_STRING_LENGTH, pformat, ap);
+    asyncOutput->write(myPrintfString);
+  }
+  else
+    vfprintf(stdout, pformat, ap);
 
   va_end(ap);
 }
@@ -57,6 +67,10 @@ void MyPrintf(const char* pformat, ... )
 BEGIN_NAMESPACE_QPOASES
 
 
+/** Number of columns of R transformed simultaneously by a sequence of Givens rotations. */
+const int_t SCHUR_COLUMNBLOCK = 4;
+
+
 /*****************************************************************************
  *  P U B L I C                                                              *
  *****************************************************************************/
@@ -85,6 +99,9 @@ SQProblemSchur::SQProblemSchur( ) : SQProblem( )
 	schurUpdateIndex = 0;
 	schurUpdate = 0;
 	numFactorizations = 0;
+	nnzKKT = 0;
+	resetCost = 0.0;
+	schurCost = 0.0;
 
 	M_physicallength = 0;
 	M_vals = 0;
@@ -140,6 +157,9 @@ SQProblemSchur::SQProblemSchur( int_t _nV, int_t _nC, HessianType _hessianType,
 		M_jc = 0;
 	}
 	numFactorizations = 0;
+	nnzKKT = 0;
+	resetCost = 0.0;
+	schurCost = 0.0;
 }
 
 
@@ -215,6 +235,9 @@ returnValue SQProblemSchur::clear( )
 	detS = 0.0;
 	rcondS = 0.0;
 	numFactorizations = 0;
+	nnzKKT = 0;
+	resetCost = 0.0;
+	schurCost = 0.0;
 	delete [] S; S=0;
 	delete [] Q_; Q_=0;
 	delete [] R_; R_=0;
@@ -298,6 +321,9 @@ returnValue SQProblemSchur::copy(	const SQProblemSchur& rhs
 		M_jc = 0;
 	}
 	numFactorizations = rhs.numFactorizations;
+	nnzKKT = rhs.nnzKKT;
+	resetCost = rhs.resetCost;
+	schurCost = rhs.schurCost;
 
 	boundsFreeStart = rhs.boundsFreeStart;
 	constraintsActiveStart = rhs.constraintsActiveStart;
@@ -720,9 +746,9 @@ returnValue SQProblemSchur::addConstraint(	int_t number,
 	}
 	if ( !found )
 	{
-		if ( nS < 0 || nS==nSmax )
+		if ( nS < 0 || nS==nSmax || isSchurResetDue( ) == BT_TRUE )
 		{
-			/* The schur complement has become too large, reset. */
+			/* The schur complement has become too large (or too expensive), reset. */
 			/* Correct inertia if necessary. */
 			returnValue retval = resetSchurComplement( BT_TRUE );
 			if ( retval != SUCCESSFUL_RETURN )
@@ -1187,9 +1213,9 @@ returnValue SQProblemSchur::addBound(	int_t number,
 	}
 	if ( !found )
 	{
-		if ( nS < 0 || nS==nSmax )
+		if ( nS < 0 || nS==nSmax || isSchurResetDue( ) == BT_TRUE )
 		{
-			/* The schur complement has become too large, reset. */
+			/* The schur complement has become too large (or too expensive), reset. */
 			/* Correct inertia if necessary. */
 			returnValue retval = resetSchurComplement( BT_TRUE );
 			if ( retval != SUCCESSFUL_RETURN )
@@ -1596,9 +1622,9 @@ returnValue SQProblemSchur::removeConstraint(	int_t number,
 	}
 	if ( !found )
 	{
-		if ( nS < 0 || nS==nSmax )
+		if ( nS < 0 || nS==nSmax || isSchurResetDue( ) == BT_TRUE )
 		{
-			/* The schur complement has become too large, reset. */
+			/* The schur complement has become too large (or too expensive), reset. */
 			/* Don't check inertia here, may be corrected later! */
 			returnValue retval = resetSchurComplement( BT_FALSE );
 			if ( retval != SUCCESSFUL_RETURN )
@@ -1657,6 +1683,7 @@ returnValue SQProblemSchur::removeConstraint(	int_t number,
 				nS--;
 
 				/* Flip bounds */
+				++statistics.nFlips;
 				tabularOutput.idxAddC = number;
 				tabularOutput.excAddC = 2;
 				switch ( oldStatus )
@@ -1694,6 +1721,7 @@ returnValue SQProblemSchur::removeConstraint(	int_t number,
 				undoDeleteFromSchurComplement( idxDeleted );
 
 				/* Flip bounds */
+				++statistics.nFlips;
 				tabularOutput.idxAddC = number;
 				tabularOutput.excAddC = 2;
 				switch ( oldStatus )
@@ -1725,6 +1753,7 @@ returnValue SQProblemSchur::removeConstraint(	int_t number,
 			if( neig > getNAC( ) ) // Wrong inertia!
 			{
 				/* Flip bounds and update Schur complement */
+				++statistics.nFlips;
 				tabularOutput.idxAddC = number;
 				tabularOutput.excAddC = 2;
 				switch ( oldStatus )
@@ -1861,9 +1890,9 @@ returnValue SQProblemSchur::removeBound(	int_t number,
 	}
 	if ( !found )
 	{
-		if ( nS < 0 || nS==nSmax )
+		if ( nS < 0 || nS==nSmax || isSchurResetDue( ) == BT_TRUE )
 		{
-			/* The schur complement has become too large, reset. */
+			/* The schur complement has become too large (or too expensive), reset. */
 			/* Don't correct inertia here, may be corrected by flipping bounds! */
 			returnValue retval = resetSchurComplement( BT_FALSE );
 			if ( retval != SUCCESSFUL_RETURN )
@@ -2029,6 +2058,7 @@ returnValue SQProblemSchur::removeBound(	int_t number,
 				nS--;
 
 				/* Flip bounds */
+				++statistics.nFlips;
 				tabularOutput.idxAddB = number;
 				tabularOutput.excAddB = 2;
 				switch ( oldStatus )
@@ -2064,6 +2094,7 @@ returnValue SQProblemSchur::removeBound(	int_t number,
 				undoDeleteFromSchurComplement( idxDeleted );
 
 				/* Flip bounds */
+				++statistics.nFlips;
 				tabularOutput.idxAddB = number;
 				tabularOutput.excAddB = 2;
 				switch ( oldStatus )
@@ -2093,6 +2124,7 @@ returnValue SQProblemSchur::removeBound(	int_t number,
 			if( neig > getNAC( ) ) // Wrong inertia, flip bounds!
 			{
 				/* Flip bounds and update Schur complement */
+				++statistics.nFlips;
 				tabularOutput.idxAddB = number;
 				tabularOutput.excAddB = 2;
 				switch ( oldStatus )
@@ -2218,33 +2250,45 @@ real_t SQProblemSchur::calcDetSchur( int_t idxDel )
 	else
 	{
 		const int_t dim = nS+1;
-		real_t *tempR = new real_t[dim*(dim-1)];
+		real_t *tempColR = new real_t[dim];
+		real_t *tempDiagR = new real_t[nS];
+		real_t *tempRowR = new real_t[nS];
 		real_t *tempColQ = new real_t[dim];
+		real_t *rotations = new real_t[3*dim];
 
-		/* Copy current R without column idxDel*/
+		/* Only the diagonal and the last row of R are needed: columns left of idxDel are unchanged */
 		for( j=0; j<idxDel; j++ )
-			for( i=0; i<dim; i++ )
-				tempR[i+j*dim] = R_[i+j*nSmax];
-		for( j=idxDel; j<dim-1; j++ )
-			for( i=0; i<dim; i++ )
-				tempR[i+j*dim] = R_[i+(j+1)*nSmax];
-		/* Copy row idxDel of Q */
-		for( j=0; j<dim; j++ )
-			tempColQ[j] = Q_[idxDel+j*nSmax];
+		{
+			tempDiagR[j] = R_[j+j*nSmax];
+			tempRowR[j] = R_[nS+j*nSmax];
+		}
 
-		/* Bring tempR to triangular form with nS-idxDel Givens rotations */
-		for ( i=idxDel; i<nS; i++ )
+		/* Bring current R without column idxDel to triangular form with nS-idxDel Givens rotations,
+		 * sweeping one column at a time (rows above idxDel are not affected) */
+		for( j=idxDel; j<nS; j++ )
 		{
-			computeGivens( tempR[i+i*dim], tempR[(i+1)+i*dim], tempR[i+i*dim], tempR[(i+1)+i*dim], c, s );
-			nu = s/(1.0+c);
-			/// \todo I think we do not need to transform all columns of R, i+3 or so should be sufficient
-			for ( j=i+1; j<nS; j++ )
-				applyGivens( c, s, nu, tempR[i+j*dim], tempR[(i+1)+j*dim], tempR[i+j*dim], tempR[(i+1)+j*dim] );
+			for( i=idxDel; i<dim; i++ )
+				tempColR[i] = R_[i+(j+1)*nSmax];
+
+			for( i=idxDel; i<j; i++ )
+				applyGivens( rotations[3*i], rotations[3*i+1], rotations[3*i+2], tempColR[i], tempColR[i+1], tempColR[i], tempColR[i+1] );
+
+			computeGivens( tempColR[j], tempColR[j+1], tempColR[j], tempColR[j+1], c, s );
+			rotations[3*j] = c;
+			rotations[3*j+1] = s;
+			rotations[3*j+2] = s/(1.0+c);
 
-			/* Simultaneously transform relevant column of Q**T */
-			applyGivens( c, s, nu, tempColQ[i], tempColQ[i+1], tempColQ[i], tempColQ[i+1] );
+			tempDiagR[j] = tempColR[j];
+			tempRowR[j] = tempColR[nS];
 		}
 
+		/* Copy row idxDel of Q and transform it accordingly */
+		for( j=0; j<dim; j++ )
+			tempColQ[j] = Q_[idxDel+j*nSmax];
+
+		for ( i=idxDel; i<nS; i++ )
+			applyGivens( rotations[3*i], rotations[3*i+1], rotations[3*i+2], tempColQ[i], tempColQ[i+1], tempColQ[i], tempColQ[i+1] );
+
 		/* Delete row: nS Givens rotations to transform last column (and row!) of (old) Q**T to getAbs((nS+1)-th unity vector) */
 		for ( i=nS; i>0; i-- )
 		{
@@ -2252,7 +2296,7 @@ real_t SQProblemSchur::calcDetSchur( int_t idxDel )
 			nu = s/(1.0+c);
 
 			/* Simultaneously transform diagonal elements of R (coldim is already one less than Q) */
-			applyGivens( c, s, nu, tempR[nS+(i-1)*dim], tempR[(i-1)+(i-1)*dim], tempR[nS+(i-1)*dim], tempR[(i-1)+(i-1)*dim] );
+			applyGivens( c, s, nu, tempRowR[i-1], tempDiagR[i-1], tempRowR[i-1], tempDiagR[i-1] );
 		}
 
 		/* Note that we implicitly did a row permutation of Q.
@@ -2262,16 +2306,17 @@ real_t SQProblemSchur::calcDetSchur( int_t idxDel )
 		if ( (( (nS - idxDel) % 2 == 1 ) && ( tempColQ[nS] > 0.0 )) ||
 			(( (nS - idxDel) % 2 == 0 ) && ( tempColQ[nS] < 0.0 )) )
 		{
-			tempR[0] = -tempR[0];
+			tempDiagR[0] = -tempDiagR[0];
 		}
 
 		newDet = 1.0;
-		//for( i=0; i<nS; i++ )
-			//newDet *= tempR[i+i*dim];
 		for( i=0; i<nS; i++ )
-			if( tempR[i+i*dim] < 0.0 ) newDet = -newDet;
-		delete [] tempR;
+			if( tempDiagR[i] < 0.0 ) newDet = -newDet;
+		delete [] rotations;
 		delete [] tempColQ;
+		delete [] tempRowR;
+		delete [] tempDiagR;
+		delete [] tempColR;
 	}
 
 	return newDet;
@@ -2283,8 +2328,9 @@ real_t SQProblemSchur::calcDetSchur( int_t idxDel )
  */
 returnValue SQProblemSchur::updateSchurQR( int_t idxDel )
 {
-	int_t i, j;
-	real_t c, s, nu;
+	int_t i, j, k, j0, jEnd;
+	real_t c, s;
+	real_t last[SCHUR_COLUMNBLOCK];
 
 	if ( nS <= 0 )
 	{
@@ -2293,6 +2339,11 @@ returnValue SQProblemSchur::updateSchurQR( int_t idxDel )
 		return SUCCESSFUL_RETURN;
 	}
 
+	/* The rotations of one update are determined while sweeping R and
+	 * applied to Q**T afterwards (see applySchurRotations). */
+	real_t* rotations = new real_t[3*(nS+1)];
+	int_t* rotationCols = new int_t[2*(nS+1)];
+
 	/* Case 1: S has been bordered by one row and column */
 	if ( idxDel < 0 )
 	{
@@ -2316,18 +2367,42 @@ returnValue SQProblemSchur::updateSchurQR( int_t idxDel )
 				R_[i+(nS-1)*nSmax] += Q_[j+i*nSmax] * S[j+(nS-1)*nSmax];
 		}
 
-		/* III: Restore triangular form of R by nS-1 Givens rotations */
-		for ( i=0; i<nS-1; i++ )
+		/* III: Restore triangular form of R by nS-1 Givens rotations.
+		 * R is swept by blocks of columns: each column receives the rotations
+		 * determined by the columns before in their original order, the columns of
+		 * a block are transformed simultaneously to keep their (last) entries in registers. */
+		for ( j0=0; j0<nS; j0+=SCHUR_COLUMNBLOCK )
 		{
-			computeGivens( R_[i+i*nSmax], R_[(nS-1)+i*nSmax], R_[i+i*nSmax], R_[(nS-1)+i*nSmax], c, s );
-			nu = s/(1.0+c);
-			for ( j=i+1; j<nS; j++ )
-				applyGivens( c, s, nu, R_[i+j*nSmax], R_[(nS-1)+j*nSmax], R_[i+j*nSmax], R_[(nS-1)+j*nSmax] );
+			jEnd = getMin( j0+SCHUR_COLUMNBLOCK,nS );
 
-			/* Simultaneously transform Q**T */
-			for ( j=0; j<nS; j++ )
-				applyGivens( c, s, nu, Q_[j+i*nSmax], Q_[j+(nS-1)*nSmax], Q_[j+i*nSmax], Q_[j+(nS-1)*nSmax] );
+			for ( j=j0; j<jEnd; j++ )
+				last[j-j0] = R_[(nS-1)+j*nSmax];
+
+			for ( i=0; i<j0; i++ )
+				for ( j=j0; j<jEnd; j++ )
+					applyGivens( rotations[3*i], rotations[3*i+1], rotations[3*i+2], R_[i+j*nSmax], last[j-j0], R_[i+j*nSmax], last[j-j0] );
+
+			for ( j=j0; j<jEnd; j++ )
+			{
+				for ( i=j0; i<j; i++ )
+					applyGivens( rotations[3*i], rotations[3*i+1], rotations[3*i+2], R_[i+j*nSmax], last[j-j0], R_[i+j*nSmax], last[j-j0] );
+
+				R_[(nS-1)+j*nSmax] = last[j-j0];
+
+				if ( j < nS-1 )
+				{
+					computeGivens( R_[j+j*nSmax], R_[(nS-1)+j*nSmax], R_[j+j*nSmax], R_[(nS-1)+j*nSmax], c, s );
+					rotations[3*j] = c;
+					rotations[3*j+1] = s;
+					rotations[3*j+2] = s/(1.0+c);
+					rotationCols[2*j] = j;
+					rotationCols[2*j+1] = nS-1;
+				}
+			}
 		}
+
+		/* Simultaneously transform Q**T */
+		applySchurRotations( nS, nS-1, rotations, rotationCols );
 	}
 	/* Case 2: row and column idxDel have been deleted from S */
 	else
@@ -2337,19 +2412,39 @@ returnValue SQProblemSchur::updateSchurQR( int_t idxDel )
 			for ( i=0; i<nS+1; i++ )
 				R_[i+j*nSmax] = R_[i+(j+1)*nSmax];
 
-		/* II: Bring R back to triangular form with nS-idxDel Givens rotations */
-		for ( i=idxDel; i<nS; i++ )
+		/* II: Bring R back to triangular form with nS-idxDel Givens rotations (swept by blocks of columns as above) */
+		for ( j0=idxDel; j0<nS; j0+=SCHUR_COLUMNBLOCK )
 		{
-			computeGivens( R_[i+i*nSmax], R_[(i+1)+i*nSmax], R_[i+i*nSmax], R_[(i+1)+i*nSmax], c, s );
-			nu = s/(1.0+c);
-			for ( j=i+1; j<nS; j++ )
-				applyGivens( c, s, nu, R_[i+j*nSmax], R_[(i+1)+j*nSmax], R_[i+j*nSmax], R_[(i+1)+j*nSmax] );
+			jEnd = getMin( j0+SCHUR_COLUMNBLOCK,nS );
 
-			/* Simultaneously transform (old) Q**T (coldim is one larger)*/
-			for ( j=0; j<nS+1; j++ )
-				applyGivens( c, s, nu, Q_[j+i*nSmax], Q_[j+(i+1)*nSmax], Q_[j+i*nSmax], Q_[j+(i+1)*nSmax] );
+			for ( i=idxDel; i<j0; i++ )
+			{
+				k = i-idxDel;
+				for ( j=j0; j<jEnd; j++ )
+					applyGivens( rotations[3*k], rotations[3*k+1], rotations[3*k+2], R_[i+j*nSmax], R_[(i+1)+j*nSmax], R_[i+j*nSmax], R_[(i+1)+j*nSmax] );
+			}
+
+			for ( j=j0; j<jEnd; j++ )
+			{
+				for ( i=j0; i<j; i++ )
+				{
+					k = i-idxDel;
+					applyGivens( rotations[3*k], rotations[3*k+1], rotations[3*k+2], R_[i+j*nSmax], R_[(i+1)+j*nSmax], R_[i+j*nSmax], R_[(i+1)+j*nSmax] );
+				}
+
+				k = j-idxDel;
+				computeGivens( R_[j+j*nSmax], R_[(j+1)+j*nSmax], R_[j+j*nSmax], R_[(j+1)+j*nSmax], c, s );
+				rotations[3*k] = c;
+				rotations[3*k+1] = s;
+				rotations[3*k+2] = s/(1.0+c);
+				rotationCols[2*k] = j;
+				rotationCols[2*k+1] = j+1;
+			}
 		}
 
+		/* Simultaneously transform (old) Q**T (coldim is one larger)*/
+		applySchurRotations( nS+1, nS-idxDel, rotations, rotationCols );
+
 		/* III: Permute rows of Q: move row idxDel to position nS */
 		real_t temp;
 		for ( j=0; j<nS+1; j++ )
@@ -2360,17 +2455,47 @@ returnValue SQProblemSchur::updateSchurQR( int_t idxDel )
 			Q_[nS+j*nSmax] = temp;
 		}
 
-		/* IV: Delete row: nS Givens rotations to transform last column (and row!) of (old) Q**T to getAbs((nS+1)-th unity vector) */
+		/* IV: Delete row: nS Givens rotations to transform last column (and row!) of (old) Q**T to getAbs((nS+1)-th unity vector).
+		 * The rotations only depend on row nS of Q**T, which the remaining rows do not influence. */
 		for ( i=nS; i>0; i-- )
 		{
+			k = nS-i;
 			computeGivens( Q_[nS+nS*nSmax], Q_[nS+(i-1)*nSmax], Q_[nS+nS*nSmax], Q_[nS+(i-1)*nSmax], c, s );
-			nu = s/(1.0+c);
-			for ( j=0; j<nS; j++ )
-				applyGivens( c, s, nu, Q_[j+nS*nSmax], Q_[j+(i-1)*nSmax], Q_[j+nS*nSmax], Q_[j+(i-1)*nSmax] );
+			rotations[3*k] = c;
+			rotations[3*k+1] = s;
+			rotations[3*k+2] = s/(1.0+c);
+			rotationCols[2*k] = nS;
+			rotationCols[2*k+1] = i-1;
+		}
+
+		applySchurRotations( nS, nS, rotations, rotationCols );
+
+		/* Simultaneously transform R (coldim is already one less than Q), column j
+		 * receives the rotations involving rows j+1,...,0 (in this order) */
+		for ( j0=0; j0<nS; j0+=SCHUR_COLUMNBLOCK )
+		{
+			jEnd = getMin( j0+SCHUR_COLUMNBLOCK,nS );
+
+			for ( j=j0; j<jEnd; j++ )
+			{
+				last[j-j0] = R_[nS+j*nSmax];
+
+				for ( i=getMin( j+1,nS ); i>j0+1; i-- )
+				{
+					k = nS-i;
+					applyGivens( rotations[3*k], rotations[3*k+1], rotations[3*k+2], last[j-j0], R_[(i-1)+j*nSmax], last[j-j0], R_[(i-1)+j*nSmax] );
+				}
+			}
+
+			for ( i=getMin( j0+1,nS ); i>0; i-- )
+			{
+				k = nS-i;
+				for ( j=j0; j<jEnd; j++ )
+					applyGivens( rotations[3*k], rotations[3*k+1], rotations[3*k+2], last[j-j0], R_[(i-1)+j*nSmax], last[j-j0], R_[(i-1)+j*nSmax] );
+			}
 
-			/* Simultaneously transform R (coldim is already one less than Q) */
-			for ( j=i-1; j<nS; j++ )
-				applyGivens( c, s, nu, R_[nS+j*nSmax], R_[(i-1)+j*nSmax], R_[nS+j*nSmax], R_[(i-1)+j*nSmax] );
+			for ( j=j0; j<jEnd; j++ )
+				R_[nS+j*nSmax] = last[j-j0];
 		}
 
 		/* If we did an  odd permutation AND deleted a positive unity vector or
@@ -2386,6 +2511,9 @@ returnValue SQProblemSchur::updateSchurQR( int_t idxDel )
 		}
 	}
 
+	delete[] rotationCols;
+	delete[] rotations;
+
 	/* Compute determinant */
 	detS = 1.0;
 	//for ( i=0; i<nS; i++ )
@@ -2413,10 +2541,34 @@ returnValue SQProblemSchur::updateSchurQR( int_t idxDel )
 	delete[] IWORK;
 	delete[] WORK;
 
+	/* Sweeping R and rotating Q**T, plus the condition estimate */
+	schurCost += 12.0 * (real_t)nS * (real_t)nS;
+
 	return SUCCESSFUL_RETURN;
 }
 
 
+/*
+ *	a p p l y S c h u r R o t a t i o n s
+ */
+void SQProblemSchur::applySchurRotations( int_t nRows, int_t nRotations, const real_t* const rotations, const int_t* const rotationCols )
+{
+	int_t j, k;
+
+	for ( k=0; k<nRotations; k++ )
+	{
+		const real_t c  = rotations[3*k];
+		const real_t s  = rotations[3*k+1];
+		const real_t nu = rotations[3*k+2];
+		real_t* x = &( Q_[rotationCols[2*k]*nSmax] );
+		real_t* y = &( Q_[rotationCols[2*k+1]*nSmax] );
+
+		for ( j=0; j<nRows; j++ )
+			applyGivens( c, s, nu, x[j], y[j], x[j], y[j] );
+	}
+}
+
+
 /*
  *	b a c k s o l v e S c h u r Q R
  */
@@ -2452,7 +2604,7 @@ returnValue SQProblemSchur::backsolveSchurQR( int_t dimS, const real_t* const rh
 	{
 		MyPrintf("TRTRS returns INFO = %d\n", INFO);
 		if ( INFO == ((long)0xDEADBEEF) )
-			MyPrintf( "If SQProblemSchur is to be used, system LAPACK must be used instead of the qpOASES LAPACK replacement" );
+			MyPrintf( "If SQProblemSchur is to be used, system LAPACK (or the Eigen backend) must be used instead of the qpOASES LAPACK replacement" );
 		return RET_QR_FACTORISATION_FAILED;
 	}
 
@@ -2674,6 +2826,10 @@ returnValue SQProblemSchur::stepCalcBacksolveSchur( int_t nFR, int_t nFX, int_t
 
 	delete [] p;
 	delete [] q;
+
+	/* Two sparse backsolves, products with M and M**T, and the QR backsolve */
+	schurCost += 4.0 * (real_t)nnzKKT + 4.0 * (real_t)M_jc[nS] + 3.0 * (real_t)nS * (real_t)nS;
+
 	return SUCCESSFUL_RETURN;
 }
 
@@ -2990,6 +3146,8 @@ returnValue SQProblemSchur::resetSchurComplement( BooleanType allowInertiaCorrec
 	if ( options.printLevel == PL_HIGH )
 		MyPrintf( "Resetting Schur complement.\n");
 
+	++statistics.nRefactorisations;
+
 	nS = 0;
 	detS = 1.0;
 	rcondS = 1.0;
@@ -3110,6 +3268,12 @@ returnValue SQProblemSchur::resetSchurComplement( BooleanType allowInertiaCorrec
 
 	nS = 0;
 
+	/* Estimated cost of this factorization (fill-in neglected) serves as reference for the
+	 * Schur complement updates to come */
+	nnzKKT = numNonzeros;
+	resetCost = ( dim > 0 ) ? (real_t)numNonzeros * (real_t)numNonzeros / (real_t)dim : 0.0;
+	schurCost = 0.0;
+
 	return SUCCESSFUL_RETURN;
 }
 
@@ -3234,6 +3398,9 @@ returnValue SQProblemSchur::addToSchurComplement( int_t number, SchurUpdateType
 	delete [] rhs;
 	delete [] new_Scol;
 
+	/* One sparse backsolve and the product of the new column with the previous ones */
+	schurCost += 4.0 * (real_t)nnzKKT + 2.0 * (real_t)M_jc[nS] + 2.0 * (real_t)nS;
+
 	if ( options.printLevel == PL_HIGH )
 		MyPrintf( "added index %d with update type %d to Schur complement.  nS = %d\n", number, update, nS);
 
@@ -3438,6 +3605,8 @@ returnValue SQProblemSchur::correctInertia( )
 	 * has been added, i.e. when a bound has flipped after refactorization */
 	if( nS != 0 && nS != 1 )
 		return THROWERROR( RET_INERTIA_CORRECTION_FAILED );
+
+	++statistics.nInertiaCorrections;
 	neig = sparseSolver->getNegativeEigenvalues( );
 
 	/* if a bound flipped, check if it did in fact remove a negative eigenvalue */
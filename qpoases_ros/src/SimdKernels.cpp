@@ -0,0 +1,366 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file src/SimdKernels.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Implementation of the vectorised kernels used by the BLAS/LAPACK
+ *	replacement. Every instruction set variant is compiled into the library
+ *	via function-level target attributes; the variant is selected at runtime
+ *	from the features reported by CPUID, so that the library itself does not
+ *	need to be compiled with -march flags.
+ */
+
+
+#include <qpOASES/SimdKernels.hpp>
+
+#if ( defined(__x86_64__) || defined(__i386__) ) && defined(__GNUC__) && !defined(__NO_SIMD_DISPATCH__)
+  #define __SIMD_DISPATCH__
+  #include <immintrin.h>
+#endif
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/** Active instruction set variant (negative if not yet determined). */
+static int activeSimdVariant = -1;
+
+
+/*
+ *	s c a l a r D o t
+ */
+static double scalarDot( la_uint_t n, const double* const x, const double* const y )
+{
+	la_uint_t i;
+	double sum = 0.0;
+
+	for( i=0; i<n; ++i )
+		sum += x[i] * y[i];
+
+	return sum;
+}
+
+
+/*
+ *	s c a l a r A x p y
+ */
+static void scalarAxpy( la_uint_t n, double alpha, const double* const x, double* const y )
+{
+	la_uint_t i;
+
+	for( i=0; i<n; ++i )
+		y[i] += alpha * x[i];
+}
+
+
+#ifdef __SIMD_DISPATCH__
+
+/*
+ *	s s e 2 D o t
+ */
+__attribute__((target("sse2")))
+static double sse2Dot( la_uint_t n, const double* const x, const double* const y )
+{
+	la_uint_t i = 0;
+	__m128d s0 = _mm_setzero_pd( );
+	__m128d s1 = _mm_setzero_pd( );
+	double sum[2];
+
+	for( ; i+4<=n; i+=4 )
+	{
+		s0 = _mm_add_pd( s0,_mm_mul_pd( _mm_loadu_pd( &(x[i]) ),_mm_loadu_pd( &(y[i]) ) ) );
+		s1 = _mm_add_pd( s1,_mm_mul_pd( _mm_loadu_pd( &(x[i+2]) ),_mm_loadu_pd( &(y[i+2]) ) ) );
+	}
+	_mm_storeu_pd( sum,_mm_add_pd( s0,s1 ) );
+
+	for( ; i<n; ++i )
+		sum[0] += x[i] * y[i];
+
+	return sum[0] + sum[1];
+}
+
+
+/*
+ *	s s e 2 A x p y
+ */
+__attribute__((target("sse2")))
+static void sse2Axpy( la_uint_t n, double alpha, const double* const x, double* const y )
+{
+	la_uint_t i = 0;
+	__m128d a = _mm_set1_pd( alpha );
+
+	for( ; i+2<=n; i+=2 )
+		_mm_storeu_pd( &(y[i]),_mm_add_pd( _mm_loadu_pd( &(y[i]) ),_mm_mul_pd( a,_mm_loadu_pd( &(x[i]) ) ) ) );
+
+	for( ; i<n; ++i )
+		y[i] += alpha * x[i];
+}
+
+
+/*
+ *	a v x 2 D o t
+ */
+__attribute__((target("avx2,fma")))
+static double avx2Dot( la_uint_t n, const double* const x, const double* const y )
+{
+	la_uint_t i = 0;
+	__m256d s0 = _mm256_setzero_pd( );
+	__m256d s1 = _mm256_setzero_pd( );
+	double sum[4];
+
+	for( ; i+8<=n; i+=8 )
+	{
+		s0 = _mm256_fmadd_pd( _mm256_loadu_pd( &(x[i]) ),_mm256_loadu_pd( &(y[i]) ),s0 );
+		s1 = _mm256_fmadd_pd( _mm256_loadu_pd( &(x[i+4]) ),_mm256_loadu_pd( &(y[i+4]) ),s1 );
+	}
+	if ( i+4 <= n )
+	{
+		s0 = _mm256_fmadd_pd( _mm256_loadu_pd( &(x[i]) ),_mm256_loadu_pd( &(y[i]) ),s0 );
+		i += 4;
+	}
+	_mm256_storeu_pd( sum,_mm256_add_pd( s0,s1 ) );
+
+	for( ; i<n; ++i )
+		sum[0] += x[i] * y[i];
+
+	return ( sum[0] + sum[2] ) + ( sum[1] + sum[3] );
+}
+
+
+/*
+ *	a v x 2 A x p y
+ */
+__attribute__((target("avx2,fma")))
+static void avx2Axpy( la_uint_t n, double alpha, const double* const x, double* const y )
+{
+	la_uint_t i = 0;
+	__m256d a = _mm256_set1_pd( alpha );
+
+	for( ; i+4<=n; i+=4 )
+		_mm256_storeu_pd( &(y[i]),_mm256_fmadd_pd( a,_mm256_loadu_pd( &(x[i]) ),_mm256_loadu_pd( &(y[i]) ) ) );
+
+	for( ; i<n; ++i )
+		y[i] += alpha * x[i];
+}
+
+
+/*
+ *	a v x 5 1 2 D o t
+ */
+__attribute__((target("avx512f")))
+static double avx512Dot( la_uint_t n, const double* const x, const double* const y )
+{
+	la_uint_t i = 0;
+	__m512d s0 = _mm512_setzero_pd( );
+	__m512d s1 = _mm512_setzero_pd( );
+	double sum[8];
+
+	for( ; i+16<=n; i+=16 )
+	{
+		s0 = _mm512_fmadd_pd( _mm512_loadu_pd( &(x[i]) ),_mm512_loadu_pd( &(y[i]) ),s0 );
+		s1 = _mm512_fmadd_pd( _mm512_loadu_pd( &(x[i+8]) ),_mm512_loadu_pd( &(y[i+8]) ),s1 );
+	}
+	if ( i+8 <= n )
+	{
+		s0 = _mm512_fmadd_pd( _mm512_loadu_pd( &(x[i]) ),_mm512_loadu_pd( &(y[i]) ),s0 );
+		i += 8;
+	}
+	if ( i < n )
+	{
+		/* masked loads of the remainder never touch memory beyond the vectors */
+		__mmask8 mask = (__mmask8)( ( 1u << ( n-i ) ) - 1u );
+		s1 = _mm512_fmadd_pd( _mm512_maskz_loadu_pd( mask,&(x[i]) ),_mm512_maskz_loadu_pd( mask,&(y[i]) ),s1 );
+	}
+
+	/* reduced through memory in the order of _mm512_reduce_add_pd, whose
+	 * lane extraction from undefined vectors GCC reports as uninitialised */
+	_mm512_storeu_pd( sum,_mm512_add_pd( s0,s1 ) );
+
+	return ( ( sum[0] + sum[4] ) + ( sum[2] + sum[6] ) ) + ( ( sum[1] + sum[5] ) + ( sum[3] + sum[7] ) );
+}
+
+
+/*
+ *	a v x 5 1 2 A x p y
+ */
+__attribute__((target("avx512f")))
+static void avx512Axpy( la_uint_t n, double alpha, const double* const x, double* const y )
+{
+	la_uint_t i = 0;
+	__m512d a = _mm512_set1_pd( alpha );
+
+	for( ; i+8<=n; i+=8 )
+		_mm512_storeu_pd( &(y[i]),_mm512_fmadd_pd( a,_mm512_loadu_pd( &(x[i]) ),_mm512_loadu_pd( &(y[i]) ) ) );
+
+	if ( i < n )
+	{
+		__mmask8 mask = (__mmask8)( ( 1u << ( n-i ) ) - 1u );
+		_mm512_mask_storeu_pd( &(y[i]),mask,_mm512_fmadd_pd( a,_mm512_maskz_loadu_pd( mask,&(x[i]) ),_mm512_maskz_loadu_pd( mask,&(y[i]) ) ) );
+	}
+}
+
+#endif	/* __SIMD_DISPATCH__ */
+
+
+/*
+ *	g e t S u p p o r t e d S i m d V a r i a n t
+ */
+SimdVariant getSupportedSimdVariant( )
+{
+	#ifdef __SIMD_DISPATCH__
+	/* __builtin_cpu_supports also checks that the OS saves the wide registers */
+	__builtin_cpu_init( );
+
+	if ( __builtin_cpu_supports( "avx512f" ) )
+		return SV_AVX512;
+
+	if ( ( __builtin_cpu_supports( "avx2" ) ) && ( __builtin_cpu_supports( "fma" ) ) )
+		return SV_AVX2;
+
+	if ( __builtin_cpu_supports( "sse2" ) )
+		return SV_SSE2;
+	#endif
+
+	return SV_SCALAR;
+}
+
+
+/*
+ *	g e t S i m d V a r i a n t
+ */
+SimdVariant getSimdVariant( )
+{
+	int variant = __atomic_load_n( &activeSimdVariant,__ATOMIC_RELAXED );
+
+	if ( variant < 0 )
+	{
+		/* detection is idempotent, so racing first calls are harmless */
+		variant = (int)getSupportedSimdVariant( );
+		__atomic_store_n( &activeSimdVariant,variant,__ATOMIC_RELAXED );
+	}
+
+	return (SimdVariant)variant;
+}
+
+
+/*
+ *	s e t S i m d V a r i a n t
+ */
+returnValue setSimdVariant( SimdVariant variant )
+{
+	if ( ( variant < SV_SCALAR ) || ( variant > getSupportedSimdVariant( ) ) )
+		return RET_INVALID_ARGUMENTS;
+
+	__atomic_store_n( &activeSimdVariant,(int)variant,__ATOMIC_RELAXED );
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	g e t S i m d V a r i a n t N a m e
+ */
+const char* getSimdVariantName( SimdVariant variant )
+{
+	switch ( variant )
+	{
+		case SV_SSE2:
+			return "sse2";
+
+		case SV_AVX2:
+			return "avx2";
+
+		case SV_AVX512:
+			return "avx512";
+
+		default:
+			return "scalar";
+	}
+}
+
+
+/*
+ *	s i m d D o t
+ */
+double simdDot( la_uint_t n, const double* const x, const double* const y )
+{
+	#ifdef __SIMD_DISPATCH__
+	switch ( getSimdVariant( ) )
+	{
+		case SV_AVX512:
+			return avx512Dot( n,x,y );
+
+		case SV_AVX2:
+			return avx2Dot( n,x,y );
+
+		case SV_SSE2:
+			return sse2Dot( n,x,y );
+
+		default:
+			break;
+	}
+	#endif
+
+	return scalarDot( n,x,y );
+}
+
+
+/*
+ *	s i m d A x p y
+ */
+void simdAxpy( la_uint_t n, double alpha, const double* const x, double* const y )
+{
+	#ifdef __SIMD_DISPATCH__
+	switch ( getSimdVariant( ) )
+	{
+		case SV_AVX512:
+			avx512Axpy( n,alpha,x,y );
+			return;
+
+		case SV_AVX2:
+			avx2Axpy( n,alpha,x,y );
+			return;
+
+		case SV_SSE2:
+			sse2Axpy( n,alpha,x,y );
+			return;
+
+		default:
+			break;
+	}
+	#endif
+
+	scalarAxpy( n,alpha,x,y );
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
@@ -35,11 +35,91 @@
 
 
 #include <qpOASES/extras/SolutionAnalysis.hpp>
+#include <qpOASES/LapackBlasReplacement.hpp>
 
 
 BEGIN_NAMESPACE_QPOASES
 
 
+/** Minimum work of a thread applying the inverse KKT matrix, in units of
+ *  (nV+nC)^2 (roughly the cost of one column); smaller shares are not worth
+ *  creating a thread for. */
+static const real_t COVARIANCE_MIN_WORK = 1.0e4;
+
+
+/** Returns the block of the variance-covariance matrices a row or column belongs to. */
+static inline int_t getCovarianceBlock( int_t i, int_t nV )
+{
+	if ( i < nV )
+		return CB_VARIABLES;
+
+	if ( i < 2*nV )
+		return CB_BOUNDS;
+
+	return CB_CONSTRAINTS;
+}
+
+
+/** Loads one column with given stride, setting entries outside of the given blocks to zero. */
+static void loadColumn( const real_t* const in, int_t stride, int_t nV, int_t nC, int_t blocks, real_t* const x )
+{
+	int_t i;
+
+	for( i=0; i<nV; ++i )
+		x[i] = ( ( blocks & CB_VARIABLES ) != 0 ) ? in[i*stride] : 0.0;
+
+	for( i=nV; i<2*nV; ++i )
+		x[i] = ( ( blocks & CB_BOUNDS ) != 0 ) ? in[i*stride] : 0.0;
+
+	for( i=2*nV; i<2*nV+nC; ++i )
+		x[i] = ( ( blocks & CB_CONSTRAINTS ) != 0 ) ? in[i*stride] : 0.0;
+}
+
+
+/** Computes C = alpha*op(A)*B + beta*C for column-major matrices, where op(A) is m x k. */
+static void multiply(	BooleanType transposed, int_t m, int_t n, int_t k,
+						real_t alpha, const real_t* const A, int_t lda, const real_t* const B, int_t ldb,
+						real_t beta, real_t* const C, int_t ldc
+						)
+{
+	int_t i, j;
+
+	if ( ( m <= 0 ) || ( n <= 0 ) )
+		return;
+
+	if ( k <= 0 )
+	{
+		for( j=0; j<n; ++j )
+			for( i=0; i<m; ++i )
+				C[j*ldc+i] = ( isZero( beta ) == BT_TRUE ) ? 0.0 : beta*C[j*ldc+i];
+		return;
+	}
+
+	la_uint_t _m = (la_uint_t)m, _n = (la_uint_t)n, _k = (la_uint_t)k;
+	la_uint_t _lda = (la_uint_t)lda, _ldb = (la_uint_t)ldb, _ldc = (la_uint_t)ldc;
+
+	GEMM( ( transposed == BT_TRUE ) ? "TRANS" : "NOTRANS","NOTRANS",&_m,&_n,&_k,&alpha,A,&_lda,B,&_ldb,&beta,C,&_ldc );
+}
+
+
+/** Gathers the submatrix of given rows and columns of a matrix column by column (scaled by alpha). */
+static void gatherSubmatrix(	const Matrix* const M, const Indexlist* const irows, const Indexlist* const icols,
+								real_t alpha, real_t* const sub
+								)
+{
+	int_t j;
+	int_t* numbers;
+
+	if ( ( M == 0 ) || ( irows->getLength( ) <= 0 ) )
+		return;
+
+	icols->getNumberArray( &numbers );
+
+	for( j=0; j<icols->getLength( ); ++j )
+		M->getCol( numbers[j],irows,alpha,&(sub[j*irows->getLength( )]) );
+}
+
+
 /*****************************************************************************
  *  P U B L I C                                                              *
  *****************************************************************************/
@@ -50,7 +130,21 @@ BEGIN_NAMESPACE_QPOASES
  */
 SolutionAnalysis::SolutionAnalysis( )
 {
+	nThreads = 1;
+	blockSize = 16;
+}
+
+
+/*
+ *	S o l u t i o n A n a l y s i s
+ */
+SolutionAnalysis::SolutionAnalysis( uint_t _nThreads, int_t _blockSize )
+{
+	nThreads = 1;
+	blockSize = 16;
 
+	setNumThreads( _nThreads );
+	setBlockSize( _blockSize );
 }
 
 
@@ -59,7 +153,8 @@ SolutionAnalysis::SolutionAnalysis( )
  */
 SolutionAnalysis::SolutionAnalysis( const SolutionAnalysis& rhs )
 {
-
+	nThreads = rhs.nThreads;
+	blockSize = rhs.blockSize;
 }
 
 
@@ -79,7 +174,8 @@ SolutionAnalysis& SolutionAnalysis::operator=( const SolutionAnalysis& rhs )
 {
 	if ( this != &rhs )
 	{
-
+		nThreads = rhs.nThreads;
+		blockSize = rhs.blockSize;
 	}
 
 	return *this;
@@ -87,6 +183,40 @@ SolutionAnalysis& SolutionAnalysis::operator=( const SolutionAnalysis& rhs )
 
 
 
+/*
+ *	s e t N u m T h r e a d s
+ */
+returnValue SolutionAnalysis::setNumThreads(	uint_t _nThreads
+												)
+{
+	if ( _nThreads < 1 )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	#ifdef __NO_THREADS__
+	_nThreads = 1;
+	#endif
+
+	nThreads = _nThreads;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s e t B l o c k S i z e
+ */
+returnValue SolutionAnalysis::setBlockSize(	int_t _blockSize
+											)
+{
+	if ( _blockSize < 1 )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	blockSize = _blockSize;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
 /*
  *	g e t K k t V i o l a t i o n
  */
@@ -518,6 +648,213 @@ returnValue SolutionAnalysis::getVarianceCovariance(	SQProblem* const qp,
 }
 
 
+/*
+ *	g e t V a r i a n c e C o v a r i a n c e
+ */
+returnValue SolutionAnalysis::getVarianceCovariance(	QProblem* const qp,
+														const real_t* const g_b_bA_VAR, real_t* const Primal_Dual_VAR,
+														int_t inputBlocks, int_t outputBlocks
+														) const
+{
+	int_t i, j, nColumns;
+	int_t nV  = qp->getNV( );
+	int_t nC  = qp->getNC( );
+	int_t nFR = qp->getNFR( );
+	int_t dim = 2*nV+nC;
+
+	returnValue returnvalue;
+
+	if ( ( g_b_bA_VAR == 0 ) || ( Primal_Dual_VAR == 0 ) ||
+		 ( ( inputBlocks & ~CB_ALL ) != 0 ) || ( ( outputBlocks & ~CB_ALL ) != 0 ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	for( i=0; i<dim*dim; ++i )
+		Primal_Dual_VAR[i] = 0.0;
+
+	if ( ( inputBlocks == CB_NONE ) || ( outputBlocks == CB_NONE ) )
+		return SUCCESSFUL_RETURN;
+
+
+	/* The Schur complement variant keeps no dense factorisation to solve
+	 * against, so it applies its own step determination column by column. */
+	if ( dynamic_cast<SQProblemSchur*>( qp ) != 0 )
+	{
+		real_t* masked = new real_t[dim*dim];
+
+		for( j=0; j<dim; ++j )
+			loadColumn( &(g_b_bA_VAR[j*dim]),1,nV,nC,
+						( ( getCovarianceBlock( j,nV ) & inputBlocks ) != 0 ) ? inputBlocks : CB_NONE,
+						&(masked[j*dim]) );
+
+		returnvalue = getVarianceCovariance( qp,masked,Primal_Dual_VAR );
+		delete[] masked;
+
+		if ( returnvalue != SUCCESSFUL_RETURN )
+			return returnvalue;
+
+		for( j=0; j<dim; ++j )
+			for( i=0; i<dim; ++i )
+				if ( ( ( getCovarianceBlock( i,nV ) & outputBlocks ) == 0 ) || ( ( getCovarianceBlock( j,nV ) & outputBlocks ) == 0 ) )
+					Primal_Dual_VAR[j*dim+i] = 0.0;
+
+		return SUCCESSFUL_RETURN;
+	}
+
+
+	/* GATHER THE ROWS OF Q BELONGING TO FREE VARIABLES, [Z Y]:
+	 * -------------------------------------------------------- */
+	int_t* FR_idx;
+
+	if ( qp->bounds.getFree( )->getNumberArray( &FR_idx ) != SUCCESSFUL_RETURN )
+		return THROWERROR( RET_HOTSTART_FAILED );
+
+	const real_t* Q = qp->Q;
+	real_t* QFR = new real_t[nFR*nFR];
+
+	for( j=0; j<nFR; ++j )
+		for( i=0; i<nFR; ++i )
+			QFR[j*nFR+i] = QQ(FR_idx[i],j);
+
+	/* GATHER THE SUBMATRICES OF H AND A OF THE CURRENT WORKING SET
+	 * (zero and identity Hessians are not stored, but scaled identities):
+	 * ------------------------------------------------------------------- */
+	int_t nFX = qp->getNFX( );
+	int_t nAC = qp->getNAC( );
+
+	const Indexlist* FR_list = qp->bounds.getFree( );
+	const Indexlist* FX_list = qp->bounds.getFixed( );
+	const Indexlist* AC_list = qp->constraints.getActive( );
+
+	real_t* HFR = new real_t[nFR*nFR];
+	real_t* HFX = new real_t[nFR*nFX];
+	real_t* HXX = new real_t[nFX*nFX];
+	real_t* AFR = new real_t[nAC*nFR];
+	real_t* AFX = new real_t[nAC*nFX];
+
+	switch ( qp->getHessianType( ) )
+	{
+		case HST_ZERO:
+		case HST_IDENTITY:
+			{
+				real_t hessianScaling = 1.0;
+				if ( qp->getHessianType( ) == HST_ZERO )
+					hessianScaling = ( qp->usingRegularisation( ) == BT_TRUE ) ? qp->regVal : 0.0;
+
+				for( i=0; i<nFR*nFR; ++i )
+					HFR[i] = 0.0;
+				for( i=0; i<nFR*nFX; ++i )
+					HFX[i] = 0.0;
+				for( i=0; i<nFX*nFX; ++i )
+					HXX[i] = 0.0;
+
+				for( i=0; i<nFR; ++i )
+					HFR[i*nFR+i] = hessianScaling;
+				for( i=0; i<nFX; ++i )
+					HXX[i*nFX+i] = hessianScaling;
+			}
+			break;
+
+		default:
+			gatherSubmatrix( qp->H,FR_list,FR_list,1.0,HFR );
+			gatherSubmatrix( qp->H,FR_list,FX_list,1.0,HFX );
+			gatherSubmatrix( qp->H,FX_list,FX_list,1.0,HXX );
+			break;
+	}
+
+	gatherSubmatrix( qp->A,AC_list,FR_list,1.0,AFR );
+	gatherSubmatrix( qp->A,AC_list,FX_list,1.0,AFX );
+
+	real_t* K = new real_t[dim*dim];
+	for( i=0; i<dim*dim; ++i )
+		K[i] = 0.0;
+
+	int_t* columns = new int_t[dim];
+
+	CovarianceStage stage;
+	stage.qp = qp;
+	stage.QFR = QFR;
+	stage.HFR = HFR;
+	stage.HFX = HFX;
+	stage.HXX = HXX;
+	stage.AFR = AFR;
+	stage.AFX = AFX;
+	stage.columns = columns;
+
+
+	/* FIRST MATRIX MULTIPLICATION, ROW BY ROW:
+	 *  K := [ ("ACTIVE" KKT-MATRIX OF THE QP)^(-1) * g_b_bA_VAR ]^T
+	 * (ROWS BELONGING TO DETERMINISTIC INPUTS REMAIN ZERO) */
+	nColumns = 0;
+	for( j=0; j<dim; ++j )
+		if ( ( getCovarianceBlock( j,nV ) & inputBlocks ) != 0 )
+			columns[nColumns++] = j;
+
+	stage.in = g_b_bA_VAR;
+	stage.inRowStride = 1;
+	stage.inColStride = dim;
+	stage.inputBlocks = inputBlocks;
+	stage.out = K;
+	stage.outRowStride = 1;
+	stage.outColStride = dim;
+	stage.outputBlocks = CB_ALL;
+
+	returnvalue = applyKktInverse( stage,nColumns );
+
+
+	/* SECOND MATRIX MULTIPLICATION, COLUMN BY COLUMN:
+	 *  Primal_Dual_VAR := ("ACTIVE" KKT-MATRIX OF THE QP)^(-1) * K
+	 * (ONLY COLUMNS AND ROWS OF REQUESTED OUTPUTS) */
+	if ( returnvalue == SUCCESSFUL_RETURN )
+	{
+		nColumns = 0;
+		for( j=0; j<dim; ++j )
+			if ( ( getCovarianceBlock( j,nV ) & outputBlocks ) != 0 )
+				columns[nColumns++] = j;
+
+		stage.in = K;
+		stage.inRowStride = dim;
+		stage.inColStride = 1;
+		stage.inputBlocks = CB_ALL;
+		stage.out = Primal_Dual_VAR;
+		stage.outRowStride = dim;
+		stage.outColStride = 1;
+		stage.outputBlocks = outputBlocks;
+
+		returnvalue = applyKktInverse( stage,nColumns );
+	}
+
+	delete[] columns;
+	delete[] K;
+	delete[] AFX;
+	delete[] AFR;
+	delete[] HXX;
+	delete[] HFX;
+	delete[] HFR;
+	delete[] QFR;
+
+	if ( returnvalue != SUCCESSFUL_RETURN )
+	{
+		THROWERROR( RET_STEPDIRECTION_DETERMINATION_FAILED );
+		return returnvalue;
+	}
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	g e t V a r i a n c e C o v a r i a n c e
+ */
+returnValue SolutionAnalysis::getVarianceCovariance(	SQProblem* const qp,
+														const real_t* const g_b_bA_VAR, real_t* const Primal_Dual_VAR,
+														int_t inputBlocks, int_t outputBlocks
+														) const
+{
+	/* Call QProblem variant. */
+	return getVarianceCovariance( (QProblem*)qp,g_b_bA_VAR,Primal_Dual_VAR,inputBlocks,outputBlocks );
+}
+
+
 /*
  *	c h e c k C u r v a t u r e O n S e t S
  */
@@ -673,6 +1010,347 @@ returnValue SolutionAnalysis::checkCurvatureOnStronglyActiveConstraints( SQProbl
 //}
 
 
+/*****************************************************************************
+ *  P R O T E C T E D                                                        *
+ *****************************************************************************/
+
+
+/*
+ *	a p p l y K k t I n v e r s e
+ */
+returnValue SolutionAnalysis::applyKktInverse(	const CovarianceStage& stage,
+												int_t nColumns
+												) const
+{
+	uint_t j, nTasks, nStarted;
+	int_t nBlocks = ( nColumns + blockSize-1 ) / blockSize;
+	int_t nVC = stage.qp->getNV( ) + stage.qp->getNC( );
+
+	returnValue returnvalue = SUCCESSFUL_RETURN;
+
+	if ( nColumns <= 0 )
+		return SUCCESSFUL_RETURN;
+
+	/* whole blocks of columns are assigned to the tasks, small problems are
+	 * solved serially as creating the threads would cost more than it saves */
+	nTasks = nThreads;
+	if ( (int_t)nTasks > nBlocks )
+		nTasks = (uint_t)nBlocks;
+
+	real_t work = (real_t)nColumns * (real_t)nVC * (real_t)nVC;
+	while ( ( nTasks > 1 ) && ( work < (real_t)nTasks * COVARIANCE_MIN_WORK ) )
+		--nTasks;
+
+	CovarianceTask* tasks = new CovarianceTask[nTasks];
+	for( j=0; j<nTasks; ++j )
+	{
+		tasks[j].analysis = this;
+		tasks[j].stage = &stage;
+		tasks[j].begin = getMin( ( (int_t)j * nBlocks ) / (int_t)nTasks * blockSize,nColumns );
+		tasks[j].end = getMin( ( (int_t)(j+1) * nBlocks ) / (int_t)nTasks * blockSize,nColumns );
+		tasks[j].status = SUCCESSFUL_RETURN;
+	}
+
+	/* task 0 is processed on the calling thread */
+	nStarted = 1;
+
+	#ifndef __NO_THREADS__
+	pthread_t* threads = ( nTasks > 1 ) ? new pthread_t[nTasks] : 0;
+
+	for( ; nStarted<nTasks; ++nStarted )
+		if ( pthread_create( &(threads[nStarted]),0,SolutionAnalysis::run,&(tasks[nStarted]) ) != 0 )
+			break;
+	#endif
+
+	tasks[0].status = solveColumns( stage,tasks[0].begin,tasks[0].end );
+
+	/* tasks without thread are processed on the calling thread */
+	for( j=nStarted; j<nTasks; ++j )
+		tasks[j].status = solveColumns( stage,tasks[j].begin,tasks[j].end );
+
+	#ifndef __NO_THREADS__
+	for( j=1; j<nStarted; ++j )
+		pthread_join( threads[j],0 );
+
+	if ( threads != 0 )
+		delete[] threads;
+	#endif
+
+	for( j=0; j<nTasks; ++j )
+	{
+		if ( tasks[j].status != SUCCESSFUL_RETURN )
+		{
+			returnvalue = tasks[j].status;
+			break;
+		}
+	}
+
+	delete[] tasks;
+
+	return returnvalue;
+}
+
+
+/*
+ *	s o l v e C o l u m n s
+ */
+returnValue SolutionAnalysis::solveColumns(	const CovarianceStage& stage,
+											int_t begin, int_t end
+											) const
+{
+	int_t i, k, r, first, nRhs;
+
+	QProblem* qp = stage.qp;
+	int_t nV  = qp->getNV( );
+	int_t nC  = qp->getNC( );
+	int_t nFR = qp->getNFR( );
+	int_t nFX = qp->getNFX( );
+	int_t nAC = qp->getNAC( );
+	int_t nZ  = qp->getNZ( );
+	int_t dim = 2*nV+nC;
+
+	int_t *FR_idx, *FX_idx, *AC_idx;
+	qp->bounds.getFree( )->getNumberArray( &FR_idx );
+	qp->bounds.getFixed( )->getNumberArray( &FX_idx );
+	qp->constraints.getActive( )->getNumberArray( &AC_idx );
+
+	returnValue returnvalue = SUCCESSFUL_RETURN;
+
+	/* workspace for one block of right-hand sides */
+	real_t* buffer = new real_t[blockSize*( dim + 2*nFX + 4*nFR + 5*nAC + nZ ) + 1];
+	real_t* X    = buffer;
+	real_t* xFX  = &(X[blockSize*dim]);
+	real_t* yFX  = &(xFX[blockSize*nFX]);
+	real_t* gFR  = &(yFX[blockSize*nFX]);
+	real_t* xFR  = &(gFR[blockSize*nFR]);
+	real_t* dxFR = &(xFR[blockSize*nFR]);
+	real_t* bAC  = &(dxFR[blockSize*nFR]);
+	real_t* yAC  = &(bAC[blockSize*nAC]);
+	real_t* dyAC = &(yAC[blockSize*nAC]);
+	real_t* work = &(dyAC[blockSize*nAC]);
+
+	for( first=begin; first<end; first+=blockSize )
+	{
+		nRhs = getMin( blockSize,end-first );
+
+		for( k=0; k<nRhs; ++k )
+			loadColumn( &(stage.in[stage.columns[first+k]*stage.inColStride]),stage.inRowStride,
+						nV,nC,stage.inputBlocks,&(X[k*dim]) );
+
+
+		/* I) DETERMINE xFX (exact) AND MOVE IT TO THE RIGHT-HAND SIDES */
+		for( k=0; k<nRhs; ++k )
+		{
+			for( i=0; i<nFX; ++i )
+				xFX[k*nFX+i] = X[k*dim+nV+FX_idx[i]];
+			for( i=0; i<nFR; ++i )
+				gFR[k*nFR+i] = X[k*dim+FR_idx[i]];
+			for( i=0; i<nAC; ++i )
+				bAC[k*nAC+i] = X[k*dim+2*nV+AC_idx[i]];
+		}
+
+		multiply( BT_FALSE,nFR,nRhs,nFX, 1.0,stage.HFX,nFR,xFX,nFX,1.0,gFR,nFR );
+		multiply( BT_FALSE,nAC,nRhs,nFX,-1.0,stage.AFX,nAC,xFX,nFX,1.0,bAC,nAC );
+
+		for( i=0; i<nRhs*nFR; ++i )
+			xFR[i] = 0.0;
+		for( i=0; i<nRhs*nAC; ++i )
+			yAC[i] = 0.0;
+
+
+		/* II) DETERMINE xFR AND yAC, REFINING ALL COLUMNS OF THE BLOCK TOGETHER */
+		for( r=0; r<=qp->options.numRefinementSteps; ++r )
+		{
+			returnvalue = solveReducedKkt( stage,nRhs,gFR,bAC,dxFR,dyAC,work );
+			if ( returnvalue != SUCCESSFUL_RETURN )
+				break;
+
+			for( i=0; i<nRhs*nFR; ++i )
+				xFR[i] += dxFR[i];
+			for( i=0; i<nRhs*nAC; ++i )
+				yAC[i] += dyAC[i];
+
+			if ( qp->options.numRefinementSteps > 0 )
+			{
+				/* residuals gFR + HFR*xFR + HMX*xFX - AFR'*yAC and bAC - AFR*xFR - AFX*xFX */
+				for( k=0; k<nRhs; ++k )
+				{
+					for( i=0; i<nFR; ++i )
+						gFR[k*nFR+i] = X[k*dim+FR_idx[i]];
+					for( i=0; i<nAC; ++i )
+						bAC[k*nAC+i] = X[k*dim+2*nV+AC_idx[i]];
+				}
+
+				multiply( BT_FALSE,nFR,nRhs,nFR, 1.0,stage.HFR,nFR,xFR,nFR,1.0,gFR,nFR );
+				multiply( BT_FALSE,nFR,nRhs,nFX, 1.0,stage.HFX,nFR,xFX,nFX,1.0,gFR,nFR );
+				multiply( BT_TRUE, nFR,nRhs,nAC,-1.0,stage.AFR,nAC,yAC,nAC,1.0,gFR,nFR );
+				multiply( BT_FALSE,nAC,nRhs,nFR,-1.0,stage.AFR,nAC,xFR,nFR,1.0,bAC,nAC );
+				multiply( BT_FALSE,nAC,nRhs,nFX,-1.0,stage.AFX,nAC,xFX,nFX,1.0,bAC,nAC );
+
+				real_t rnrm = 0.0;
+				for( i=0; i<nRhs*nFR; ++i )
+					if ( rnrm < getAbs( gFR[i] ) )
+						rnrm = getAbs( gFR[i] );
+				for( i=0; i<nRhs*nAC; ++i )
+					if ( rnrm < getAbs( bAC[i] ) )
+						rnrm = getAbs( bAC[i] );
+
+				/* early termination if residual norm small enough */
+				if ( rnrm < qp->options.epsIterRef )
+					break;
+			}
+		}
+
+		if ( returnvalue != SUCCESSFUL_RETURN )
+			break;
+
+
+		/* III) DETERMINE yFX = gFX - AFX'*yAC + HMX'*xFR + HFX*xFX */
+		for( k=0; k<nRhs; ++k )
+			for( i=0; i<nFX; ++i )
+				yFX[k*nFX+i] = X[k*dim+FX_idx[i]];
+
+		multiply( BT_TRUE, nFX,nRhs,nAC,-1.0,stage.AFX,nAC,yAC,nAC,1.0,yFX,nFX );
+		multiply( BT_TRUE, nFX,nRhs,nFR, 1.0,stage.HFX,nFR,xFR,nFR,1.0,yFX,nFX );
+		multiply( BT_FALSE,nFX,nRhs,nFX, 1.0,stage.HXX,nFX,xFX,nFX,1.0,yFX,nFX );
+
+
+		/* IV) STORE THE QP-REACTION (ONLY ROWS OF REQUESTED OUTPUTS) */
+		for( k=0; k<nRhs; ++k )
+		{
+			real_t* out = &(stage.out[stage.columns[first+k]*stage.outColStride]);
+			int_t stride = stage.outRowStride;
+
+			if ( ( stage.outputBlocks & CB_VARIABLES ) != 0 )
+			{
+				for( i=0; i<nFR; ++i )
+					out[FR_idx[i]*stride] = xFR[k*nFR+i];
+				for( i=0; i<nFX; ++i )
+					out[FX_idx[i]*stride] = xFX[k*nFX+i];
+			}
+
+			if ( ( stage.outputBlocks & CB_BOUNDS ) != 0 )
+				for( i=0; i<nFX; ++i )
+					out[(nV+FX_idx[i])*stride] = yFX[k*nFX+i];
+
+			if ( ( stage.outputBlocks & CB_CONSTRAINTS ) != 0 )
+				for( i=0; i<nAC; ++i )
+					out[(2*nV+AC_idx[i])*stride] = yAC[k*nAC+i];
+		}
+	}
+
+	delete[] buffer;
+
+	return returnvalue;
+}
+
+
+/*
+ *	s o l v e R e d u c e d K k t
+ */
+returnValue SolutionAnalysis::solveReducedKkt(	const CovarianceStage& stage, int_t nRhs,
+												real_t* const gFR, const real_t* const bAC,
+												real_t* const xFR, real_t* const yAC,
+												real_t* const work
+												) const
+{
+	int_t i, k;
+
+	QProblem* qp = stage.qp;
+	int_t nFR = qp->getNFR( );
+	int_t nAC = qp->getNAC( );
+	int_t nZ  = qp->getNZ( );
+
+	real_t* xFRy  = work;
+	real_t* xFRz  = &(work[nRhs*nAC]);
+	real_t* ZxFRz = &(work[nRhs*(nAC+nZ)]);
+	real_t* YgFR  = &(work[nRhs*(nAC+nZ+nFR)]);
+
+	/* Z and Y are the first nZ and the last nAC columns of QFR */
+	const real_t* Z = stage.QFR;
+	const real_t* Y = &(stage.QFR[nZ*nFR]);
+
+
+	/* 1) Determine xFRy = T \ bAC and xFR = Y*xFRy. */
+	for( k=0; k<nRhs; ++k )
+		if ( qp->backsolveT( &(bAC[k*nAC]),BT_FALSE,&(xFRy[k*nAC]) ) != SUCCESSFUL_RETURN )
+			return THROWERROR( RET_STEPDIRECTION_FAILED_TQ );
+
+	multiply( BT_FALSE,nFR,nRhs,nAC,1.0,Y,nFR,xFRy,nAC,0.0,xFR,nFR );
+	multiply( BT_FALSE,nFR,nRhs,nFR,1.0,stage.HFR,nFR,xFR,nFR,1.0,gFR,nFR );
+
+
+	/* 2) Determine xFRz = (Z'*HFR*Z) \ -Z'*(gFR + HFR*xFR) and add Z*xFRz. */
+	if ( nZ > 0 )
+	{
+		multiply( BT_TRUE,nZ,nRhs,nFR,-1.0,Z,nFR,gFR,nFR,0.0,xFRz,nZ );
+
+		switch ( qp->getHessianType( ) )
+		{
+			case HST_ZERO:
+				/* When solving LPs without regularisation, iterates must always be at a vertex. */
+				if ( qp->usingRegularisation( ) == BT_FALSE )
+					return THROWERROR( RET_UNKNOWN_BUG );
+
+				for( i=0; i<nRhs*nZ; ++i )
+					xFRz[i] /= qp->regVal;
+				break;
+
+			case HST_IDENTITY:
+				break;
+
+			default:
+				for( k=0; k<nRhs; ++k )
+				{
+					if ( qp->backsolveR( &(xFRz[k*nZ]),BT_TRUE,&(xFRz[k*nZ]) ) != SUCCESSFUL_RETURN )
+						return THROWERROR( RET_STEPDIRECTION_FAILED_CHOLESKY );
+
+					if ( qp->backsolveR( &(xFRz[k*nZ]),BT_FALSE,&(xFRz[k*nZ]) ) != SUCCESSFUL_RETURN )
+						return THROWERROR( RET_STEPDIRECTION_FAILED_CHOLESKY );
+				}
+				break;
+		}
+
+		multiply( BT_FALSE,nFR,nRhs,nZ,1.0,Z,nFR,xFRz,nZ,0.0,ZxFRz,nFR );
+
+		for( i=0; i<nRhs*nFR; ++i )
+			xFR[i] += ZxFRz[i];
+
+		if ( nAC > 0 )
+			multiply( BT_FALSE,nFR,nRhs,nFR,1.0,stage.HFR,nFR,ZxFRz,nFR,1.0,gFR,nFR );
+	}
+
+
+	/* 3) Determine yAC = T' \ Y'*(gFR + HFR*xFR). */
+	if ( nAC > 0 )
+	{
+		multiply( BT_TRUE,nAC,nRhs,nFR,1.0,Y,nFR,gFR,nFR,0.0,YgFR,nAC );
+
+		for( k=0; k<nRhs; ++k )
+			if ( qp->backsolveT( &(YgFR[k*nAC]),BT_TRUE,&(yAC[k*nAC]) ) != SUCCESSFUL_RETURN )
+				return THROWERROR( RET_STEPDIRECTION_FAILED_TQ );
+	}
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	r u n
+ */
+void* SolutionAnalysis::run(	void* arg
+								)
+{
+	#ifndef __NO_THREADS__
+	CovarianceTask* task = (CovarianceTask*)arg;
+
+	task->status = task->analysis->solveColumns( *(task->stage),task->begin,task->end );
+	#endif /* __NO_THREADS__ */
+
+	return 0;
+}
+
+
 END_NAMESPACE_QPOASES
 
 
@@ -0,0 +1,916 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file src/SolverService.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Implementation of the SolverService, SolverServer and SolverClient classes
+ *	which allow several processes to share QP solvers via POSIX shared memory.
+ */
+
+
+#include <qpOASES/extras/SolverService.hpp>
+
+#ifndef __NO_THREADS__
+  #include <errno.h>
+  #include <fcntl.h>
+  #include <pthread.h>
+  #include <sched.h>
+  #include <signal.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <time.h>
+  #include <unistd.h>
+#endif
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/** Marks an initialised solver service region. */
+const uint_t SERVICE_MAGIC = 0x71704f53;
+
+/** Default timeout of a client waiting for the server [s]. */
+const real_t SERVICE_TIMEOUT = 1.0;
+
+
+#ifndef __NO_THREADS__
+/** Returns monotonic time in seconds. */
+static real_t getMonotonicTime( )
+{
+	struct timespec t;
+	clock_gettime( CLOCK_MONOTONIC,&t );
+	return (real_t)t.tv_sec + (real_t)t.tv_nsec * 1.0e-9;
+}
+#endif /* __NO_THREADS__ */
+
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	S o l v e r S e r v i c e
+ */
+SolverService::SolverService( )
+{
+	name[0] = '\0';
+	base = 0;
+	size = 0;
+	owner = BT_FALSE;
+	header = 0;
+}
+
+
+/*
+ *	~ S o l v e r S e r v i c e
+ */
+SolverService::~SolverService( )
+{
+	unmap( );
+}
+
+
+
+/*
+ *	S o l v e r S e r v e r
+ */
+SolverServer::SolverServer( ) : SolverService( )
+{
+	problems = 0;
+	hessians = 0;
+}
+
+
+/*
+ *	~ S o l v e r S e r v e r
+ */
+SolverServer::~SolverServer( )
+{
+	clear( );
+}
+
+
+/*
+ *	i n i t
+ */
+returnValue SolverServer::init(	const char* const _name,
+								uint_t _nChannels, const uint_t* const _nV, const uint_t* const _nC,
+								uint_t _nSlots, const Options* const _options
+								)
+{
+	uint_t i;
+
+	if ( ( _name == 0 ) || ( _nChannels == 0 ) || ( _nV == 0 ) || ( _nC == 0 ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	for( i=0; i<_nChannels; ++i )
+		if ( _nV[i] == 0 )
+			return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	clear( );
+
+	/* round number of slots up to a power of two (allows cheap wrap-around) */
+	uint_t nSlots = 1;
+	while ( nSlots < _nSlots )
+		nSlots *= 2;
+
+	#ifndef __NO_THREADS__
+	size = computeLayout( _nChannels,_nV,_nC,nSlots,0 );
+
+	int fd = shm_open( _name,O_CREAT | O_EXCL | O_RDWR,0660 );
+
+	/* a region of the same name may only be replaced if its server has crashed */
+	if ( ( fd < 0 ) && ( errno == EEXIST ) )
+	{
+		if ( isStale( _name ) == BT_FALSE )
+			return THROWERROR( RET_SERVICE_IN_USE );
+
+		shm_unlink( _name );
+		fd = shm_open( _name,O_CREAT | O_EXCL | O_RDWR,0660 );
+	}
+
+	if ( fd < 0 )
+		return THROWERROR( RET_SERVICE_SETUP_FAILED );
+
+	if ( ftruncate( fd,(off_t)size ) != 0 )
+	{
+		close( fd );
+		shm_unlink( _name );
+		return THROWERROR( RET_SERVICE_SETUP_FAILED );
+	}
+
+	base = mmap( 0,size,PROT_READ | PROT_WRITE,MAP_SHARED,fd,0 );
+	close( fd );
+
+	if ( base == MAP_FAILED )
+	{
+		base = 0;
+		shm_unlink( _name );
+		return THROWERROR( RET_SERVICE_SETUP_FAILED );
+	}
+
+	strncpy( name,_name,MAX_STRING_LENGTH-1 );
+	name[MAX_STRING_LENGTH-1] = '\0';
+	owner = BT_TRUE;
+
+	/* avoid page faults while serving requests (if permitted) */
+	mlock( base,size );
+
+	header = (Header*)base;
+	header->pid = (int_t)getpid( );
+	header->sizeofReal = sizeof(real_t);
+	header->sizeofInt = sizeof(int_t);
+	header->nChannels = _nChannels;
+	header->nSlots = nSlots;
+	header->shutdown = 0;
+
+	computeLayout( _nChannels,_nV,_nC,nSlots,base );
+
+	problems = new SQProblem*[_nChannels];
+	hessians = new real_t*[_nChannels];
+	for( i=0; i<_nChannels; ++i )
+	{
+		problems[i] = new SQProblem( (int_t)_nV[i],(int_t)_nC[i] );
+		hessians[i] = new real_t[2*_nV[i]*_nV[i]];
+
+		if ( _options != 0 )
+		{
+			problems[i]->setOptions( *_options );
+		}
+		else
+		{
+			Options defaultOptions;
+			defaultOptions.printLevel = PL_NONE;
+			problems[i]->setOptions( defaultOptions );
+		}
+	}
+
+	/* clients may attach from now on */
+	__atomic_store_n( &(header->magic),SERVICE_MAGIC,__ATOMIC_RELEASE );
+
+	return SUCCESSFUL_RETURN;
+	#else
+	return THROWERROR( RET_SERVICE_SETUP_FAILED );
+	#endif /* __NO_THREADS__ */
+}
+
+
+/*
+ *	p i n T o C o r e
+ */
+returnValue SolverServer::pinToCore( int_t core )
+{
+	#if defined(__linux__) && !defined(__NO_THREADS__)
+	if ( ( core < 0 ) || ( core >= CPU_SETSIZE ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	cpu_set_t cpus;
+	CPU_ZERO( &cpus );
+	CPU_SET( core,&cpus );
+
+	if ( pthread_setaffinity_np( pthread_self( ),sizeof(cpus),&cpus ) != 0 )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	return SUCCESSFUL_RETURN;
+	#else
+	return THROWERROR( RET_NOT_YET_IMPLEMENTED );
+	#endif
+}
+
+
+/*
+ *	p o l l
+ */
+uint_t SolverServer::poll( )
+{
+	uint_t i;
+	uint_t nProcessed = 0;
+
+	for( i=0; i<getNumChannels( ); ++i )
+	{
+		Channel* _channel = getChannel( i );
+		uint_t head = __atomic_load_n( &(_channel->head),__ATOMIC_ACQUIRE );
+
+		while ( _channel->tail != head )
+		{
+			Slot* slot = getSlot( _channel,_channel->tail );
+
+			process( i,slot );
+
+			__atomic_store_n( &(slot->done),_channel->tail+1,__ATOMIC_RELEASE );
+			__atomic_store_n( &(_channel->tail),_channel->tail+1,__ATOMIC_RELEASE );
+			++nProcessed;
+		}
+	}
+
+	return nProcessed;
+}
+
+
+/*
+ *	r u n
+ */
+returnValue SolverServer::run( uint_t idlePeriod )
+{
+	if ( header == 0 )
+		return THROWERROR( RET_SERVICE_SETUP_FAILED );
+
+	#ifndef __NO_THREADS__
+	while ( __atomic_load_n( &(header->shutdown),__ATOMIC_ACQUIRE ) == 0 )
+	{
+		if ( ( poll( ) == 0 ) && ( idlePeriod > 0 ) )
+			usleep( idlePeriod );
+	}
+	#endif /* __NO_THREADS__ */
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	r e q u e s t S h u t d o w n
+ */
+void SolverServer::requestShutdown( )
+{
+	if ( header != 0 )
+		__atomic_store_n( &(header->shutdown),1,__ATOMIC_RELEASE );
+}
+
+
+
+/*
+ *	S o l v e r C l i e n t
+ */
+SolverClient::SolverClient( ) : SolverService( )
+{
+	channel = 0;
+	submitted = 0;
+	completed = 0;
+	nextBuffer = 0;
+	matrixRequest = 0;
+	matricesWritten = BT_FALSE;
+	lastSlot = 0;
+	timeout = SERVICE_TIMEOUT;
+}
+
+
+/*
+ *	~ S o l v e r C l i e n t
+ */
+SolverClient::~SolverClient( )
+{
+	detach( );
+}
+
+
+/*
+ *	a t t a c h
+ */
+returnValue SolverClient::attach(	const char* const _name, uint_t _channel
+									)
+{
+	if ( _name == 0 )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	detach( );
+
+	#ifndef __NO_THREADS__
+	int fd = shm_open( _name,O_RDWR,0 );
+	if ( fd < 0 )
+		return THROWERROR( RET_SERVICE_ATTACH_FAILED );
+
+	struct stat info;
+	if ( ( fstat( fd,&info ) != 0 ) || ( (size_t)info.st_size < sizeof(Header) ) )
+	{
+		close( fd );
+		return THROWERROR( RET_SERVICE_ATTACH_FAILED );
+	}
+
+	size = (size_t)info.st_size;
+	base = mmap( 0,size,PROT_READ | PROT_WRITE,MAP_SHARED,fd,0 );
+	close( fd );
+
+	if ( base == MAP_FAILED )
+	{
+		base = 0;
+		size = 0;
+		return THROWERROR( RET_SERVICE_ATTACH_FAILED );
+	}
+
+	strncpy( name,_name,MAX_STRING_LENGTH-1 );
+	name[MAX_STRING_LENGTH-1] = '\0';
+	owner = BT_FALSE;
+	header = (Header*)base;
+
+	/* server has to be compatible and channel must not be in use */
+	uint_t unused = 0;
+
+	if ( ( __atomic_load_n( &(header->magic),__ATOMIC_ACQUIRE ) != SERVICE_MAGIC ) ||
+		 ( header->sizeofReal != sizeof(real_t) ) || ( header->sizeofInt != sizeof(int_t) ) ||
+		 ( _channel >= header->nChannels ) ||
+		 ( __atomic_compare_exchange_n( &(getChannel( _channel )->attached),&unused,1,false,__ATOMIC_ACQ_REL,__ATOMIC_ACQUIRE ) == false ) )
+	{
+		unmap( );
+		return THROWERROR( RET_SERVICE_ATTACH_FAILED );
+	}
+
+	channel = getChannel( _channel );
+
+	/* requests of a previous client have to be processed first */
+	submitted = channel->head;
+	real_t deadline = getMonotonicTime( ) + timeout;
+	while ( __atomic_load_n( &(channel->tail),__ATOMIC_ACQUIRE ) != submitted )
+	{
+		if ( ( timeout > 0.0 ) && ( getMonotonicTime( ) > deadline ) )
+		{
+			__atomic_store_n( &(channel->attached),0,__ATOMIC_RELEASE );
+			channel = 0;
+			unmap( );
+			return THROWERROR( RET_SERVICE_TIMEOUT );
+		}
+		sched_yield( );
+	}
+
+	completed = submitted;
+	nextBuffer = 1 - channel->matrixBuffer;
+	matrixRequest = 0;
+	matricesWritten = BT_FALSE;
+	lastSlot = 0;
+
+	return SUCCESSFUL_RETURN;
+	#else
+	return THROWERROR( RET_SERVICE_ATTACH_FAILED );
+	#endif /* __NO_THREADS__ */
+}
+
+
+/*
+ *	d e t a c h
+ */
+returnValue SolverClient::detach( )
+{
+	int_t nWSR;
+
+	if ( channel == 0 )
+		return SUCCESSFUL_RETURN;
+
+	/* requests the server does not answer any more are abandoned */
+	while ( completed != submitted )
+		if ( wait( nWSR ) == RET_SERVICE_TIMEOUT )
+			break;
+
+	__atomic_store_n( &(channel->attached),0,__ATOMIC_RELEASE );
+
+	channel = 0;
+	lastSlot = 0;
+
+	return unmap( );
+}
+
+
+/*
+ *	g e t V e c t o r s
+ */
+returnValue SolverClient::getVectors(	real_t*& g, real_t*& lb, real_t*& ub, real_t*& lbA, real_t*& ubA
+										)
+{
+	if ( channel == 0 )
+		return THROWERROR( RET_SERVICE_ATTACH_FAILED );
+
+	if ( submitted-completed >= getNumSlots( ) )
+		return THROWERROR( RET_SERVICE_BUSY );
+
+	Slot* slot = getSlot( channel,submitted );
+
+	g   = getVector( channel,slot,0 );
+	lb  = getVector( channel,slot,1 );
+	ub  = getVector( channel,slot,2 );
+	lbA = getVector( channel,slot,3 );
+	ubA = getVector( channel,slot,4 );
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	g e t M a t r i c e s
+ */
+returnValue SolverClient::getMatrices(	real_t*& H, real_t*& A
+										)
+{
+	if ( channel == 0 )
+		return THROWERROR( RET_SERVICE_ATTACH_FAILED );
+
+	/* other buffer is in use by the server until the last matrix request has been processed */
+	if ( matrixRequest > completed )
+		return THROWERROR( RET_SERVICE_BUSY );
+
+	H = getMatrix( channel,nextBuffer,0 );
+	A = getMatrix( channel,nextBuffer,1 );
+	matricesWritten = BT_TRUE;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s u b m i t
+ */
+returnValue SolverClient::submit(	ServiceRequestType type, int_t nWSR, real_t cputime
+									)
+{
+	if ( channel == 0 )
+		return THROWERROR( RET_SERVICE_ATTACH_FAILED );
+
+	if ( submitted-completed >= getNumSlots( ) )
+		return THROWERROR( RET_SERVICE_BUSY );
+
+	if ( ( type != SRT_HOTSTART ) && ( matricesWritten == BT_FALSE ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	Slot* slot = getSlot( channel,submitted );
+
+	slot->type = (int_t)type;
+	slot->nWSR = nWSR;
+	slot->cputime = cputime;
+	slot->matrixBuffer = nextBuffer;
+
+	if ( type != SRT_HOTSTART )
+	{
+		channel->matrixBuffer = nextBuffer;
+		nextBuffer = 1 - nextBuffer;
+		matrixRequest = submitted+1;
+		matricesWritten = BT_FALSE;
+	}
+
+	++submitted;
+	__atomic_store_n( &(channel->head),submitted,__ATOMIC_RELEASE );
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s e t T i m e o u t
+ */
+returnValue SolverClient::setTimeout(	real_t _timeout
+										)
+{
+	timeout = _timeout;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	w a i t
+ */
+returnValue SolverClient::wait(	int_t& nWSR, real_t* const cputime
+								)
+{
+	if ( ( channel == 0 ) || ( completed == submitted ) )
+		return THROWERROR( RET_SERVICE_NO_REQUEST );
+
+	Slot* slot = getSlot( channel,completed );
+	uint_t spins = 0;
+	real_t deadline = 0.0;
+
+	/* spin briefly, then leave the core to others (e.g. the server)
+	 * and give up once the server has not answered in time */
+	while ( __atomic_load_n( &(slot->done),__ATOMIC_ACQUIRE ) != completed+1 )
+	{
+		#ifndef __NO_THREADS__
+		if ( ++spins > 1000 )
+		{
+			if ( timeout > 0.0 )
+			{
+				if ( deadline == 0.0 )
+					deadline = getMonotonicTime( ) + timeout;
+				else if ( getMonotonicTime( ) > deadline )
+					return THROWERROR( RET_SERVICE_TIMEOUT );
+			}
+
+			sched_yield( );
+		}
+		#endif
+	}
+
+	++completed;
+	lastSlot = slot;
+
+	nWSR = slot->nWSR;
+	if ( cputime != 0 )
+		*cputime = slot->cputime;
+
+	return (returnValue)slot->status;
+}
+
+
+/*
+ *	i n i t
+ */
+returnValue SolverClient::init(	const real_t* const _H, const real_t* const _g, const real_t* const _A,
+								const real_t* const _lb, const real_t* const _ub,
+								const real_t* const _lbA, const real_t* const _ubA,
+								int_t& nWSR, real_t* const cputime
+								)
+{
+	return request( SRT_INIT,_H,_g,_A,_lb,_ub,_lbA,_ubA,nWSR,cputime );
+}
+
+
+/*
+ *	h o t s t a r t
+ */
+returnValue SolverClient::hotstart(	const real_t* const H_new, const real_t* const g_new, const real_t* const A_new,
+									const real_t* const lb_new, const real_t* const ub_new,
+									const real_t* const lbA_new, const real_t* const ubA_new,
+									int_t& nWSR, real_t* const cputime
+									)
+{
+	if ( ( H_new == 0 ) && ( A_new == 0 ) )
+		return request( SRT_HOTSTART,0,g_new,0,lb_new,ub_new,lbA_new,ubA_new,nWSR,cputime );
+	else
+		return request( SRT_HOTSTART_MATRICES,H_new,g_new,A_new,lb_new,ub_new,lbA_new,ubA_new,nWSR,cputime );
+}
+
+
+/*
+ *	h o t s t a r t
+ */
+returnValue SolverClient::hotstart(	const real_t* const g_new,
+									const real_t* const lb_new, const real_t* const ub_new,
+									const real_t* const lbA_new, const real_t* const ubA_new,
+									int_t& nWSR, real_t* const cputime
+									)
+{
+	return request( SRT_HOTSTART,0,g_new,0,lb_new,ub_new,lbA_new,ubA_new,nWSR,cputime );
+}
+
+
+/*
+ *	r e q u e s t S h u t d o w n
+ */
+returnValue SolverClient::requestShutdown( )
+{
+	if ( header == 0 )
+		return THROWERROR( RET_SERVICE_ATTACH_FAILED );
+
+	__atomic_store_n( &(header->shutdown),1,__ATOMIC_RELEASE );
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+
+/*****************************************************************************
+ *  P R O T E C T E D                                                        *
+ *****************************************************************************/
+
+
+/*
+ *	u n m a p
+ */
+returnValue SolverService::unmap( )
+{
+	#ifndef __NO_THREADS__
+	if ( base != 0 )
+		munmap( base,size );
+
+	if ( owner == BT_TRUE )
+		shm_unlink( name );
+	#endif /* __NO_THREADS__ */
+
+	name[0] = '\0';
+	base = 0;
+	size = 0;
+	owner = BT_FALSE;
+	header = 0;
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	c o m p u t e L a y o u t
+ */
+size_t SolverService::computeLayout(	uint_t _nChannels, const uint_t* const _nV, const uint_t* const _nC,
+										uint_t _nSlots, void* const base
+										)
+{
+	uint_t i, j;
+	size_t offset = align( sizeof(Header) ) + _nChannels*align( sizeof(Channel) );
+
+	for( i=0; i<_nChannels; ++i )
+	{
+		size_t slotSize = align( sizeof(Slot) ) + align( ( 5*_nV[i] + 3*_nC[i] )*sizeof(real_t) );
+		size_t matrixSize = align( ( _nV[i] + _nC[i] )*_nV[i]*sizeof(real_t) );
+
+		if ( base != 0 )
+		{
+			Channel* _channel = (Channel*)( (char*)base + align( sizeof(Header) ) + i*align( sizeof(Channel) ) );
+
+			_channel->nV = _nV[i];
+			_channel->nC = _nC[i];
+			_channel->slotOffset = offset;
+			_channel->slotSize = slotSize;
+			_channel->matrixOffset = offset + _nSlots*slotSize;
+			_channel->matrixSize = matrixSize;
+			_channel->attached = 0;
+			_channel->matrixBuffer = 1;
+			_channel->head = 0;
+			_channel->tail = 0;
+
+			for( j=0; j<_nSlots; ++j )
+				( (Slot*)( (char*)base + offset + j*slotSize ) )->done = 0;
+		}
+
+		offset += _nSlots*slotSize + 2*matrixSize;
+	}
+
+	return offset;
+}
+
+
+
+/*
+ *	c l e a r
+ */
+returnValue SolverServer::clear( )
+{
+	uint_t i;
+
+	if ( problems != 0 )
+	{
+		for( i=0; i<getNumChannels( ); ++i )
+			delete problems[i];
+
+		delete[] problems;
+		problems = 0;
+	}
+
+	if ( hessians != 0 )
+	{
+		for( i=0; i<getNumChannels( ); ++i )
+			delete[] hessians[i];
+
+		delete[] hessians;
+		hessians = 0;
+	}
+
+	return unmap( );
+}
+
+
+/*
+ *	i s S t a l e
+ */
+BooleanType SolverServer::isStale(	const char* const _name
+									)
+{
+	BooleanType stale = BT_FALSE;
+
+	#ifndef __NO_THREADS__
+	int fd = shm_open( _name,O_RDONLY,0 );
+	if ( fd < 0 )
+		return BT_FALSE;
+
+	struct stat info;
+	if ( ( fstat( fd,&info ) != 0 ) || ( (size_t)info.st_size < sizeof(Header) ) )
+	{
+		close( fd );
+		return BT_FALSE;
+	}
+
+	void* region = mmap( 0,sizeof(Header),PROT_READ,MAP_SHARED,fd,0 );
+	close( fd );
+
+	if ( region == MAP_FAILED )
+		return BT_FALSE;
+
+	/* the process id is written as soon as the server has mapped the region */
+	int_t pid = ((const Header*)region)->pid;
+	if ( ( pid > 0 ) && ( kill( (pid_t)pid,0 ) != 0 ) && ( errno == ESRCH ) )
+		stale = BT_TRUE;
+
+	munmap( region,sizeof(Header) );
+	#endif /* __NO_THREADS__ */
+
+	return stale;
+}
+
+
+/*
+ *	p r o c e s s
+ */
+void SolverServer::process(	uint_t number, Slot* const slot
+							)
+{
+	Channel* _channel = getChannel( number );
+	SQProblem* qp = problems[number];
+
+	real_t* g   = getVector( _channel,slot,0 );
+	real_t* lb  = getVector( _channel,slot,1 );
+	real_t* ub  = getVector( _channel,slot,2 );
+	real_t* lbA = getVector( _channel,slot,3 );
+	real_t* ubA = getVector( _channel,slot,4 );
+
+	/* the constraint matrix is passed in place (shallow copy), the client does
+	 * not touch this buffer until a later request with new matrices is processed;
+	 * the Hessian is copied first as the SQProblem may regularise it in place,
+	 * which would otherwise leak into requests keeping the previous Hessian */
+	real_t* H = 0;
+	real_t* A = getMatrix( _channel,slot->matrixBuffer,1 );
+
+	if ( ( slot->type == SRT_INIT ) || ( slot->type == SRT_HOTSTART_MATRICES ) )
+	{
+		H = &(hessians[number][ slot->matrixBuffer*_channel->nV*_channel->nV ]);
+		memcpy( H,getMatrix( _channel,slot->matrixBuffer,0 ),_channel->nV*_channel->nV*sizeof(real_t) );
+	}
+
+	int_t nWSR = slot->nWSR;
+	real_t cputime = slot->cputime;
+	real_t* cputimePtr = ( cputime > 0.0 ) ? &cputime : 0;
+	returnValue returnvalue;
+
+	switch ( (ServiceRequestType)slot->type )
+	{
+		case SRT_INIT:
+			returnvalue = qp->init( H,g,A,lb,ub,lbA,ubA,nWSR,cputimePtr );
+			break;
+
+		case SRT_HOTSTART_MATRICES:
+			returnvalue = qp->hotstart( H,g,A,lb,ub,lbA,ubA,nWSR,cputimePtr );
+			break;
+
+		case SRT_HOTSTART:
+			returnvalue = qp->hotstart( g,lb,ub,lbA,ubA,nWSR,cputimePtr );
+			break;
+
+		default:
+			returnvalue = RET_INVALID_ARGUMENTS;
+			break;
+	}
+
+	slot->status = (int_t)returnvalue;
+	slot->nWSR = nWSR;
+	slot->cputime = ( cputimePtr != 0 ) ? cputime : 0.0;
+
+	qp->getPrimalSolution( getVector( _channel,slot,5 ) );
+	qp->getDualSolution( getVector( _channel,slot,6 ) );
+	slot->objVal = qp->getObjVal( );
+}
+
+
+
+/*
+ *	r e q u e s t
+ */
+returnValue SolverClient::request(	ServiceRequestType type,
+									const real_t* const _H, const real_t* const _g, const real_t* const _A,
+									const real_t* const _lb, const real_t* const _ub,
+									const real_t* const _lbA, const real_t* const _ubA,
+									int_t& nWSR, real_t* const cputime
+									)
+{
+	real_t *H, *A, *g, *lb, *ub, *lbA, *ubA;
+	returnValue returnvalue;
+
+	if ( channel == 0 )
+		return THROWERROR( RET_SERVICE_ATTACH_FAILED );
+
+	if ( completed != submitted )
+		return THROWERROR( RET_SERVICE_BUSY );
+
+	uint_t nV = getNV( );
+	uint_t nC = getNC( );
+
+	if ( type != SRT_HOTSTART )
+	{
+		returnvalue = getMatrices( H,A );
+		if ( returnvalue != SUCCESSFUL_RETURN )
+			return returnvalue;
+
+		/* matrices not given are kept from the previous request */
+		if ( ( _H == 0 ) && ( type != SRT_INIT ) )
+			copyVector( H,getMatrix( channel,1-nextBuffer,0 ),nV*nV,0.0 );
+		else
+			copyVector( H,_H,nV*nV,0.0 );
+
+		if ( ( _A == 0 ) && ( type != SRT_INIT ) )
+			copyVector( A,getMatrix( channel,1-nextBuffer,1 ),nC*nV,0.0 );
+		else
+			copyVector( A,_A,nC*nV,0.0 );
+	}
+
+	returnvalue = getVectors( g,lb,ub,lbA,ubA );
+	if ( returnvalue != SUCCESSFUL_RETURN )
+		return returnvalue;
+
+	copyVector( g,_g,nV,0.0 );
+	copyVector( lb,_lb,nV,-INFTY );
+	copyVector( ub,_ub,nV,INFTY );
+	copyVector( lbA,_lbA,nC,-INFTY );
+	copyVector( ubA,_ubA,nC,INFTY );
+
+	returnvalue = submit( type,nWSR,( cputime != 0 ) ? *cputime : 0.0 );
+	if ( returnvalue != SUCCESSFUL_RETURN )
+		return returnvalue;
+
+	return wait( nWSR,cputime );
+}
+
+
+/*
+ *	c o p y V e c t o r
+ */
+void SolverClient::copyVector(	real_t* const dest, const real_t* const src, uint_t n, real_t value
+								)
+{
+	uint_t i;
+
+	if ( src != 0 )
+	{
+		memcpy( dest,src,n*sizeof(real_t) );
+	}
+	else
+	{
+		for( i=0; i<n; ++i )
+			dest[i] = value;
+	}
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
@@ -93,8 +93,19 @@ SubjectTo& SubjectTo::operator=( const SubjectTo& rhs )
 {
 	if ( this != &rhs )
 	{
-		clear( );
-		copy( rhs );
+		/* snapshots (e.g. by the Flipper) reuse the allocated arrays */
+		if ( ( n == rhs.n ) && ( n > 0 ) && ( type != 0 ) && ( status != 0 ) )
+		{
+			noLower = rhs.noLower;
+			noUpper = rhs.noUpper;
+			memcpy( type,rhs.type,((uint_t)n)*sizeof(SubjectToType) );
+			memcpy( status,rhs.status,((uint_t)n)*sizeof(SubjectToStatus) );
+		}
+		else
+		{
+			clear( );
+			copy( rhs );
+		}
 	}
 
 	return *this;
@@ -51,6 +51,7 @@
 
 
 #include <qpOASES/Utils.hpp>
+#include <qpOASES/AsyncOutput.hpp>
 
 
 #ifdef __NO_SNPRINTF__
@@ -236,6 +237,14 @@ returnValue myPrintf( const char* s )
 			#ifdef __SCILAB__
 				sciprint( s );
 			#else
+				AsyncOutput* asyncOutput = getGlobalMessageHandler( )->getAsyncOutput( );
+				if ( asyncOutput != 0 )
+				{
+					/* hand message over to output thread (never blocks) */
+					asyncOutput->write( s );
+					return SUCCESSFUL_RETURN;
+				}
+
 				FILE* outputfile = getGlobalMessageHandler( )->getOutputFile( );
 				if ( outputfile == 0 )
 					return THROWERROR( RET_NO_GLOBAL_MESSAGE_OUTPUTFILE );
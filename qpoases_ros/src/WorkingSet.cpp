@@ -0,0 +1,410 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/**
+ *	\file src/WorkingSet.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Implementation of the WorkingSet class, a compact bitset representation
+ *	of the status of all bounds and constraints.
+ */
+
+
+#include <qpOASES/WorkingSet.hpp>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/** Returns the number of set bits of a word. */
+static inline int_t countBits( uint_t word )
+{
+	#ifdef __GNUC__
+	return (int_t)__builtin_popcountll( (unsigned long long)word );
+	#else
+	int_t count = 0;
+	for( ; word != 0; word &= word-1 )
+		++count;
+	return count;
+	#endif
+}
+
+
+/** Packs the status of the entries [begin,end) of a SubjectTo object into the
+ *  bits of one word, starting with entry offset at its least significant bit. */
+static inline void packStatus(	const SubjectTo* const subjectTo, int_t begin, int_t end, int_t offset,
+								uint_t& activeWord, uint_t& upperWord
+								)
+{
+	int_t i;
+	SubjectToStatus _status;
+
+	for( i=begin; i<end; ++i )
+	{
+		_status = subjectTo->getStatus( i );
+
+		/* branch-free, as statuses are in no particular order */
+		uint_t isUpper = (uint_t)( ( _status == ST_UPPER ) | ( _status == ST_INFEASIBLE_UPPER ) );
+		uint_t isLower = (uint_t)( ( _status == ST_LOWER ) | ( _status == ST_INFEASIBLE_LOWER ) );
+		activeWord |= ( isLower | isUpper ) << ( i-offset );
+		upperWord  |= isUpper << ( i-offset );
+	}
+}
+
+
+/*****************************************************************************
+ *  P U B L I C                                                              *
+ *****************************************************************************/
+
+
+/*
+ *	W o r k i n g S e t
+ */
+WorkingSet::WorkingSet( )
+{
+	active = 0;
+	upper  = 0;
+
+	init( );
+}
+
+
+/*
+ *	W o r k i n g S e t
+ */
+WorkingSet::WorkingSet( int_t _nV, int_t _nC )
+{
+	active = 0;
+	upper  = 0;
+
+	init( _nV,_nC );
+}
+
+
+/*
+ *	W o r k i n g S e t
+ */
+WorkingSet::WorkingSet( const WorkingSet& rhs )
+{
+	copy( rhs );
+}
+
+
+/*
+ *	~ W o r k i n g S e t
+ */
+WorkingSet::~WorkingSet( )
+{
+	clear( );
+}
+
+
+/*
+ *	o p e r a t o r =
+ */
+WorkingSet& WorkingSet::operator=( const WorkingSet& rhs )
+{
+	if ( this != &rhs )
+	{
+		if ( ( nWords == rhs.nWords ) && ( nWords > 0 ) )
+		{
+			nV = rhs.nV;
+			nC = rhs.nC;
+			memcpy( active,rhs.active,((uint_t)nWords)*sizeof(uint_t) );
+			memcpy( upper,rhs.upper,((uint_t)nWords)*sizeof(uint_t) );
+		}
+		else
+		{
+			clear( );
+			copy( rhs );
+		}
+	}
+
+	return *this;
+}
+
+
+/*
+ *	i n i t
+ */
+returnValue WorkingSet::init(	int_t _nV,
+								int_t _nC
+								)
+{
+	if ( ( _nV < 0 ) || ( _nC < 0 ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	clear( );
+
+	nV = _nV;
+	nC = _nC;
+	nWords = ( nV+nC + (int_t)QPOASES_WORKINGSET_BITS-1 ) / (int_t)QPOASES_WORKINGSET_BITS;
+
+	if ( nWords > 0 )
+	{
+		active = new uint_t[nWords];
+		upper  = new uint_t[nWords];
+	}
+
+	return reset( );
+}
+
+
+/*
+ *	r e s e t
+ */
+returnValue WorkingSet::reset( )
+{
+	int_t i;
+
+	for( i=0; i<nWords; ++i )
+	{
+		active[i] = 0;
+		upper[i]  = 0;
+	}
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s e t
+ */
+returnValue WorkingSet::set(	const Bounds* const bounds,
+								const Constraints* const constraints
+								)
+{
+	int_t i;
+
+	if ( ( bounds == 0 ) || ( bounds->getNV( ) != nV ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	if ( ( nC > 0 ) && ( ( constraints == 0 ) || ( constraints->getNC( ) != nC ) ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	/* assemble the bitsets word by word */
+	for( i=0; i<nWords; ++i )
+	{
+		int_t first = i * (int_t)QPOASES_WORKINGSET_BITS;
+		int_t last = getMin( first + (int_t)QPOASES_WORKINGSET_BITS,nV+nC );
+		int_t split = getMax( getMin( nV,last ),first );
+
+		uint_t activeWord = 0, upperWord = 0;
+		packStatus( bounds,first,split,first,activeWord,upperWord );
+		packStatus( constraints,split-nV,last-nV,first-nV,activeWord,upperWord );
+
+		active[i] = activeWord;
+		upper[i]  = upperWord;
+	}
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	s e t
+ */
+returnValue WorkingSet::set(	const real_t* const workingSet
+								)
+{
+	int_t i;
+
+	if ( ( workingSet == 0 ) && ( nV+nC > 0 ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	for( i=0; i<nV+nC; ++i )
+	{
+		if ( workingSet[i] < -0.5 )
+			setStatus( i,ST_LOWER );
+		else if ( workingSet[i] > 0.5 )
+			setStatus( i,ST_UPPER );
+		else
+			setStatus( i,ST_INACTIVE );
+	}
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	g e t
+ */
+returnValue WorkingSet::get(	Bounds* const bounds,
+								Constraints* const constraints
+								) const
+{
+	int_t i;
+
+	if ( ( bounds == 0 ) || ( ( nC > 0 ) && ( constraints == 0 ) ) )
+		return THROWERROR( RET_INVALID_ARGUMENTS );
+
+	bounds->init( nV );
+	for( i=0; i<nV; ++i )
+		bounds->setupBound( i,getStatus( i ) );
+
+	if ( nC > 0 )
+	{
+		constraints->init( nC );
+		for( i=0; i<nC; ++i )
+			constraints->setupConstraint( i,getStatus( nV+i ) );
+	}
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	g e t N u m A c t i v e
+ */
+int_t WorkingSet::getNumActive( ) const
+{
+	int_t i, count = 0;
+
+	for( i=0; i<nWords; ++i )
+		count += countBits( active[i] );
+
+	return count;
+}
+
+
+/*
+ *	g e t N u m D i f f e r e n c e s
+ */
+int_t WorkingSet::getNumDifferences( const WorkingSet& rhs ) const
+{
+	int_t i, count = 0;
+
+	if ( ( nV != rhs.nV ) || ( nC != rhs.nC ) )
+		return -1;
+
+	/* an entry differs if its activity or (when active) its side differs */
+	for( i=0; i<nWords; ++i )
+		count += countBits( ( active[i] ^ rhs.active[i] ) | ( upper[i] ^ rhs.upper[i] ) );
+
+	return count;
+}
+
+
+/*
+ *	i s E q u a l
+ */
+BooleanType WorkingSet::isEqual( const WorkingSet& rhs ) const
+{
+	int_t i;
+
+	if ( ( nV != rhs.nV ) || ( nC != rhs.nC ) )
+		return BT_FALSE;
+
+	for( i=0; i<nWords; ++i )
+		if ( ( active[i] != rhs.active[i] ) || ( upper[i] != rhs.upper[i] ) )
+			return BT_FALSE;
+
+	return BT_TRUE;
+}
+
+
+/*
+ *	g e t H a s h
+ */
+uint_t WorkingSet::getHash( ) const
+{
+	int_t i;
+	uint_t shift;
+
+	/* FNV-1a over both bitsets, 32 bits at a time (words may have 64 bits
+	 * under __USE_LONG_INTEGERS__) */
+	unsigned int hash = 2166136261u;
+	for( i=0; i<nWords; ++i )
+		for( shift=0; shift<QPOASES_WORKINGSET_BITS; shift+=32 )
+		{
+			hash ^= (unsigned int)( active[i] >> shift );
+			hash *= 16777619u;
+			hash ^= (unsigned int)( upper[i] >> shift );
+			hash *= 16777619u;
+		}
+
+	return (uint_t)hash;
+}
+
+
+
+/*****************************************************************************
+ *  P R O T E C T E D                                                        *
+ *****************************************************************************/
+
+
+/*
+ *	c l e a r
+ */
+returnValue WorkingSet::clear( )
+{
+	if ( active != 0 )
+	{
+		delete[] active;
+		active = 0;
+	}
+
+	if ( upper != 0 )
+	{
+		delete[] upper;
+		upper = 0;
+	}
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+/*
+ *	c o p y
+ */
+returnValue WorkingSet::copy(	const WorkingSet& rhs
+								)
+{
+	nV = rhs.nV;
+	nC = rhs.nC;
+	nWords = rhs.nWords;
+
+	if ( nWords > 0 )
+	{
+		active = new uint_t[nWords];
+		upper  = new uint_t[nWords];
+		memcpy( active,rhs.active,((uint_t)nWords)*sizeof(uint_t) );
+		memcpy( upper,rhs.upper,((uint_t)nWords)*sizeof(uint_t) );
+	}
+	else
+	{
+		active = 0;
+		upper  = 0;
+	}
+
+	return SUCCESSFUL_RETURN;
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+/*
+ *	end of file
+ */
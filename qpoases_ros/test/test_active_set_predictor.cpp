@@ -0,0 +1,202 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/**
+ *	\file test/test_active_set_predictor.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Checks the working sets predicted by the ActiveSetPredictor on a
+ *	periodic QP sequence (the synthetic gait of the active set benchmark
+ *	without noise) against those of QPs solved from scratch.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <math.h>
+
+#include <qpOASES.hpp>
+
+USING_NAMESPACE_QPOASES
+
+
+namespace
+{
+	const int_t nV = 12;
+	const int_t nC = 8;
+	const int_t nLegs = 4;
+	const int_t period = 10;
+
+	/* Constraints of each leg are tight during its stance phase and the
+	 * gradient follows the phase, as in tools/active_set_benchmark.cpp. */
+	class Gait
+	{
+		public:
+			Gait( )
+			{
+				for( int_t i=0; i<nV; ++i )
+					for( int_t j=0; j<nV; ++j )
+						H[i*nV+j] = ( i == j ) ? 2.0 + 0.1*i : 0.1 * cos( (real_t)(i+j) );
+
+				for( int_t i=0; i<nC; ++i )
+					for( int_t j=0; j<nV; ++j )
+						A[i*nV+j] = cos( 0.5*(real_t)(i+1)*(real_t)j );
+			}
+
+			void setTick( int_t tick )
+			{
+				real_t phase = 2.0 * M_PI * (real_t)( tick % period ) / (real_t)period;
+
+				for( int_t i=0; i<nV; ++i )
+				{
+					g[i] = 2.0 * sin( phase + 0.1*(real_t)i );
+					lb[i] = -1.0;
+					ub[i] = 1.0;
+				}
+
+				for( int_t i=0; i<nC; ++i )
+				{
+					int_t leg = ( i * nLegs ) / nC;
+					real_t legPhase = fmod( phase + 2.0 * M_PI * (real_t)leg / (real_t)nLegs,2.0 * M_PI );
+
+					lbA[i] = ( legPhase < M_PI ) ? 0.2 : -2.0;
+					ubA[i] = ( legPhase < M_PI ) ? 0.5 : 2.0;
+				}
+
+				p[0] = cos( phase );
+				p[1] = sin( phase );
+			}
+
+			real_t H[nV*nV], A[nC*nV];
+			real_t g[nV], lb[nV], ub[nV], lbA[nC], ubA[nC], p[2];
+	};
+
+	void setupOptions( QProblemB& qp )
+	{
+		Options options;
+		options.setToDefault( );
+		options.printLevel = PL_NONE;
+		qp.setOptions( options );
+	}
+
+	/* Runs the gait for some periods with plain hotstarts (no predictor) or
+	 * with those of the predictor and compares each solution against a QP
+	 * solved from scratch; returns the number of working set recalculations
+	 * in the last period. */
+	int_t runGait( int_t nPeriods, ActiveSetPredictor* const predictor = 0, BooleanType passParameters = BT_FALSE )
+	{
+		Gait gait;
+		QProblem qp( nV,nC );
+		setupOptions( qp );
+
+		int_t nWSR = 1000;
+		gait.setTick( 0 );
+		EXPECT_EQ( SUCCESSFUL_RETURN, qp.init( gait.H,gait.g,gait.A,gait.lb,gait.ub,gait.lbA,gait.ubA,nWSR ) );
+		if ( predictor != 0 )
+			EXPECT_EQ( SUCCESSFUL_RETURN, predictor->record( &qp,gait.p ) );
+
+		int_t nWSRLast = 0;
+		for( int_t tick=1; tick<nPeriods*period; ++tick )
+		{
+			gait.setTick( tick );
+			const real_t* p = ( passParameters == BT_TRUE ) ? gait.p : 0;
+
+			nWSR = 1000;
+			if ( predictor != 0 )
+				EXPECT_EQ( SUCCESSFUL_RETURN, predictor->hotstart( &qp,gait.g,gait.lb,gait.ub,gait.lbA,gait.ubA,nWSR,0,p ) );
+			else
+				EXPECT_EQ( SUCCESSFUL_RETURN, qp.hotstart( gait.g,gait.lb,gait.ub,gait.lbA,gait.ubA,nWSR ) );
+
+			if ( tick >= (nPeriods-1)*period )
+				nWSRLast += nWSR;
+
+			QProblem reference( nV,nC );
+			setupOptions( reference );
+			int_t nWSRReference = 1000;
+			EXPECT_EQ( SUCCESSFUL_RETURN, reference.init( gait.H,gait.g,gait.A,gait.lb,gait.ub,gait.lbA,gait.ubA,nWSRReference ) );
+
+			real_t x[nV], xReference[nV];
+			qp.getPrimalSolution( x );
+			reference.getPrimalSolution( xReference );
+			for( int_t i=0; i<nV; ++i )
+				EXPECT_NEAR( xReference[i], x[i], 1e-10 );
+		}
+
+		return nWSRLast;
+	}
+}
+
+
+TEST(active_set_predictor, no_history)
+{
+	Gait gait;
+	Bounds guessedBounds;
+	Constraints guessedConstraints;
+	ActiveSetPredictor predictor( nV,nC,2,4*period,PM_NEARESTNEIGHBOUR );
+
+	gait.setTick( 0 );
+	EXPECT_EQ( RET_PREDICTION_NO_HISTORY, predictor.predict( &guessedBounds,&guessedConstraints,gait.p ) );
+	EXPECT_EQ( RET_INVALID_ARGUMENTS, predictor.predict( &guessedBounds,&guessedConstraints ) );
+
+	/* QPs of other dimensions are rejected */
+	QProblem qp( nV,nC-1 );
+	EXPECT_EQ( RET_PREDICTION_INVALID_DIMENSIONS, predictor.record( &qp,gait.p ) );
+	EXPECT_EQ( 0u, predictor.getNumRecorded( ) );
+}
+
+
+TEST(active_set_predictor, markov)
+{
+	int_t nWSRPlain = runGait( 3 );
+
+	ActiveSetPredictor predictor( nV,nC,0,4*period,PM_MARKOV );
+	int_t nWSRPredicted = runGait( 3,&predictor );
+
+	/* after the first period, the successors of the working sets are known */
+	EXPECT_LT( nWSRPredicted, nWSRPlain );
+	EXPECT_GT( predictor.getNumGuided( ), 0u );
+	EXPECT_EQ( (uint_t)(3*period), predictor.getNumRecorded( ) );
+	EXPECT_LE( predictor.getNumWorkingSets( ), (uint_t)period );
+}
+
+
+TEST(active_set_predictor, nearest_neighbour)
+{
+	ActiveSetPredictor predictor( nV,nC,2,4*period,PM_NEARESTNEIGHBOUR );
+
+	/* each phase recurs with exactly the same QP, whose working set is predicted */
+	EXPECT_EQ( 0, runGait( 3,&predictor,BT_TRUE ) );
+	EXPECT_GT( predictor.getNumGuided( ), 0u );
+}
+
+
+TEST(active_set_predictor, capacity)
+{
+	ActiveSetPredictor predictor( nV,nC,0,4,PM_MARKOV );
+
+	/* only the last ticks are remembered, which still gives correct solutions */
+	runGait( 3,&predictor );
+	EXPECT_EQ( 4u, predictor.getNumRecorded( ) );
+	EXPECT_LE( predictor.getNumWorkingSets( ), 4u );
+}
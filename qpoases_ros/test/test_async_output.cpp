@@ -0,0 +1,89 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file test/test_async_output.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Checks that AsyncOutput enqueues or drops multi-chunk messages as a whole.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <qpOASES/AsyncOutput.hpp>
+
+USING_NAMESPACE_QPOASES
+
+
+namespace
+{
+	std::string readAll( FILE* file )
+	{
+		std::string contents;
+		char chunk[256];
+		size_t n;
+
+		rewind( file );
+		while ( ( n = fread( chunk,1,sizeof(chunk),file ) ) > 0 )
+			contents.append( chunk,n );
+		return contents;
+	}
+}
+
+
+TEST(async_output, multi_chunk_messages)
+{
+	FILE* file = tmpfile( );
+	ASSERT_TRUE( file != 0 );
+
+	/* two slots hold messages of up to 2*(MAX_STRING_LENGTH-1) characters */
+	std::string tooLong( 2*(MAX_STRING_LENGTH-1)+1,'x' );
+	std::string fits( 2*(MAX_STRING_LENGTH-1),'y' );
+	fits[fits.size()-1] = '\n';
+
+	{
+		AsyncOutput output( 2,file );
+		ASSERT_EQ( 2u, output.getNumSlots( ) );
+		ASSERT_EQ( SUCCESSFUL_RETURN, output.start( ) );
+
+		EXPECT_EQ( RET_ASYNC_OUTPUT_MESSAGE_DROPPED, output.write( tooLong.c_str( ) ) );
+		EXPECT_EQ( 1u, output.getNumDropped( ) );
+
+		ASSERT_EQ( SUCCESSFUL_RETURN, output.flush( ) );
+		EXPECT_EQ( SUCCESSFUL_RETURN, output.write( fits.c_str( ) ) );
+		ASSERT_EQ( SUCCESSFUL_RETURN, output.flush( ) );
+		EXPECT_EQ( SUCCESSFUL_RETURN, output.write( "" ) );
+		EXPECT_EQ( SUCCESSFUL_RETURN, output.stop( ) );
+		EXPECT_EQ( 1u, output.getNumDropped( ) );
+	}
+
+	/* nothing of the dropped message may have reached the file */
+	EXPECT_EQ( fits, readAll( file ) );
+	fclose( file );
+}
+
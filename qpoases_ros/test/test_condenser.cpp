@@ -0,0 +1,342 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file test/test_condenser.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Checks the incrementally condensed QP of the Condenser class against a
+ *	dense condensing from scratch by simulating the dynamics.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <qpOASES.hpp>
+
+#include <vector>
+
+USING_NAMESPACE_QPOASES
+
+
+namespace
+{
+	const uint_t nX = 3;
+	const uint_t nU = 2;
+	const uint_t nN = 6;
+	const uint_t nV = nN*nU;
+	const uint_t nC = nN*nX;
+
+	/* Stage-wise data of a linear MPC problem (all matrices row-wise). */
+	struct MpcData
+	{
+		std::vector<real_t> A, B, c, Q, R, q, r, lbu, ubu, lbx, ubx, x0;
+
+		MpcData( ) :
+			A( nN*nX*nX ), B( nN*nX*nU ), c( nN*nX ), Q( (nN+1)*nX*nX ), R( nN*nU*nU ),
+			q( (nN+1)*nX ), r( nN*nU ), lbu( nV ), ubu( nV ), lbx( nC ), ubx( nC ), x0( nX )
+		{
+		}
+	};
+
+	real_t getRandom( )
+	{
+		return 2.0 * (real_t)rand( ) / (real_t)RAND_MAX - 1.0;
+	}
+
+	/* Random symmetric positive definite n x n matrix. */
+	void setupSpd( uint_t n, real_t* M )
+	{
+		std::vector<real_t> L( n*n );
+		for( uint_t i=0; i<n*n; ++i )
+			L[i] = getRandom( );
+
+		for( uint_t i=0; i<n; ++i )
+			for( uint_t j=0; j<n; ++j )
+			{
+				M[i*n+j] = ( i == j ) ? 1.0 : 0.0;
+				for( uint_t k=0; k<n; ++k )
+					M[i*n+j] += L[k*n+i] * L[k*n+j];
+			}
+	}
+
+	void setupData( MpcData& data )
+	{
+		for( uint_t k=0; k<nN; ++k )
+		{
+			for( uint_t i=0; i<nX*nX; ++i )
+				data.A[k*nX*nX+i] = ( ( i % (nX+1) ) == 0 ? 1.0 : 0.0 ) + 0.1 * getRandom( );
+			for( uint_t i=0; i<nX*nU; ++i )
+				data.B[k*nX*nU+i] = getRandom( );
+			for( uint_t i=0; i<nX; ++i )
+				data.c[k*nX+i] = 0.1 * getRandom( );
+			setupSpd( nU,&(data.R[k*nU*nU]) );
+			for( uint_t i=0; i<nU; ++i )
+				data.r[k*nU+i] = getRandom( );
+		}
+
+		for( uint_t k=0; k<=nN; ++k )
+		{
+			setupSpd( nX,&(data.Q[k*nX*nX]) );
+			for( uint_t i=0; i<nX; ++i )
+				data.q[k*nX+i] = getRandom( );
+		}
+
+		for( uint_t i=0; i<nV; ++i )
+		{
+			data.lbu[i] = -1.0;
+			data.ubu[i] = 1.0;
+		}
+
+		for( uint_t i=0; i<nC; ++i )
+		{
+			data.lbx[i] = -2.0;
+			data.ubx[i] = 2.0;
+		}
+
+		for( uint_t i=0; i<nX; ++i )
+			data.x0[i] = getRandom( );
+	}
+
+	void passData( const MpcData& data, Condenser& condenser )
+	{
+		for( uint_t k=0; k<nN; ++k )
+		{
+			condenser.setDynamics( k,&(data.A[k*nX*nX]),&(data.B[k*nX*nU]),&(data.c[k*nX]) );
+			condenser.setStageCost( k,&(data.Q[k*nX*nX]),&(data.R[k*nU*nU]),&(data.q[k*nX]),&(data.r[k*nU]) );
+			condenser.setInputBounds( k,&(data.lbu[k*nU]),&(data.ubu[k*nU]) );
+			condenser.setStateBounds( k+1,&(data.lbx[k*nX]),&(data.ubx[k*nX]) );
+		}
+		condenser.setTerminalCost( &(data.Q[nN*nX*nX]),&(data.q[nN*nX]) );
+		condenser.setInitialState( &(data.x0[0]) );
+	}
+
+	/* Simulates x_1,...,x_N from x_0 (optionally zero) and inputs u, optionally without affine terms. */
+	void simulate( const MpcData& data, const real_t* const x0, const real_t* const u, BooleanType affine, real_t* x )
+	{
+		std::vector<real_t> xk( nX,0.0 );
+		if ( x0 != 0 )
+			for( uint_t i=0; i<nX; ++i )
+				xk[i] = x0[i];
+
+		for( uint_t k=0; k<nN; ++k )
+		{
+			for( uint_t i=0; i<nX; ++i )
+			{
+				x[k*nX+i] = ( affine == BT_TRUE ) ? data.c[k*nX+i] : 0.0;
+				for( uint_t j=0; j<nX; ++j )
+					x[k*nX+i] += data.A[(k*nX+i)*nX+j] * xk[j];
+				for( uint_t j=0; j<nU; ++j )
+					x[k*nX+i] += data.B[(k*nX+i)*nU+j] * u[k*nU+j];
+			}
+			for( uint_t i=0; i<nX; ++i )
+				xk[i] = x[k*nX+i];
+		}
+	}
+
+	/* Dense condensing from scratch: x_{1..N} = Su*u + xfree. */
+	void condense( const MpcData& data, real_t* H, real_t* g, real_t* Acon, real_t* lbA, real_t* ubA )
+	{
+		std::vector<real_t> Su( nC*nV ), xfree( nC ), u( nV,0.0 ), column( nC );
+
+		simulate( data,&(data.x0[0]),&(u[0]),BT_TRUE,&(xfree[0]) );
+		for( uint_t j=0; j<nV; ++j )
+		{
+			u[j] = 1.0;
+			simulate( data,0,&(u[0]),BT_FALSE,&(column[0]) );
+			u[j] = 0.0;
+			for( uint_t i=0; i<nC; ++i )
+				Su[i*nV+j] = column[i];
+		}
+
+		/* QSu = blockdiag(Q_1,...,Q_N)*Su, Qx = blockdiag(Q_1,...,Q_N)*xfree + q_{1..N} */
+		std::vector<real_t> QSu( nC*nV,0.0 ), Qx( nC,0.0 );
+		for( uint_t k=0; k<nN; ++k )
+			for( uint_t i=0; i<nX; ++i )
+			{
+				const real_t* Qrow = &(data.Q[((k+1)*nX+i)*nX]);
+				Qx[k*nX+i] = data.q[(k+1)*nX+i];
+				for( uint_t l=0; l<nX; ++l )
+				{
+					Qx[k*nX+i] += Qrow[l] * xfree[k*nX+l];
+					for( uint_t j=0; j<nV; ++j )
+						QSu[(k*nX+i)*nV+j] += Qrow[l] * Su[(k*nX+l)*nV+j];
+				}
+			}
+
+		for( uint_t i=0; i<nV; ++i )
+		{
+			g[i] = data.r[i];
+			for( uint_t l=0; l<nC; ++l )
+				g[i] += Su[l*nV+i] * Qx[l];
+
+			for( uint_t j=0; j<nV; ++j )
+			{
+				H[i*nV+j] = ( i/nU == j/nU ) ? data.R[(i/nU)*nU*nU+(i%nU)*nU+(j%nU)] : 0.0;
+				for( uint_t l=0; l<nC; ++l )
+					H[i*nV+j] += Su[l*nV+i] * QSu[l*nV+j];
+			}
+		}
+
+		for( uint_t i=0; i<nC*nV; ++i )
+			Acon[i] = Su[i];
+
+		for( uint_t i=0; i<nC; ++i )
+		{
+			lbA[i] = data.lbx[i] - xfree[i];
+			ubA[i] = data.ubx[i] - xfree[i];
+		}
+	}
+
+	void expectCondensed( Condenser& condenser, const MpcData& data )
+	{
+		real_t H[nV*nV], g[nV], Acon[nC*nV], lbA[nC], ubA[nC];
+		condense( data,H,g,Acon,lbA,ubA );
+
+		real_t* Hcondensed = condenser.getH( )->full( );
+		real_t* Acondensed = condenser.getA( )->full( );
+
+		for( uint_t i=0; i<nV*nV; ++i )
+			EXPECT_NEAR( H[i], Hcondensed[i], 1e-10 ) << "H entry " << i;
+		for( uint_t i=0; i<nC*nV; ++i )
+			EXPECT_NEAR( Acon[i], Acondensed[i], 1e-10 ) << "A entry " << i;
+		for( uint_t i=0; i<nV; ++i )
+		{
+			EXPECT_NEAR( g[i], condenser.getG( )[i], 1e-10 ) << "g entry " << i;
+			EXPECT_EQ( data.lbu[i], condenser.getLB( )[i] );
+			EXPECT_EQ( data.ubu[i], condenser.getUB( )[i] );
+		}
+		for( uint_t i=0; i<nC; ++i )
+		{
+			EXPECT_NEAR( lbA[i], condenser.getLBA( )[i], 1e-10 ) << "lbA entry " << i;
+			EXPECT_NEAR( ubA[i], condenser.getUBA( )[i], 1e-10 ) << "ubA entry " << i;
+		}
+
+		delete[] Acondensed;
+		delete[] Hcondensed;
+	}
+}
+
+
+TEST(condenser, full_condensing)
+{
+	srand( 7 );
+
+	MpcData data;
+	setupData( data );
+
+	Condenser condenser( nX,nU,nN );
+	passData( data,condenser );
+	ASSERT_EQ( SUCCESSFUL_RETURN, condenser.update( ) );
+	expectCondensed( condenser,data );
+}
+
+
+TEST(condenser, incremental_updates)
+{
+	srand( 11 );
+
+	MpcData data;
+	setupData( data );
+
+	Condenser condenser( nX,nU,nN );
+	passData( data,condenser );
+	ASSERT_EQ( SUCCESSFUL_RETURN, condenser.update( ) );
+
+	/* new linearisation of the first stage only */
+	for( uint_t i=0; i<nX*nX; ++i )
+		data.A[i] += 0.05 * getRandom( );
+	for( uint_t i=0; i<nX*nU; ++i )
+		data.B[i] += 0.05 * getRandom( );
+	passData( data,condenser );
+	ASSERT_EQ( SUCCESSFUL_RETURN, condenser.update( ) );
+	expectCondensed( condenser,data );
+
+	/* changed dynamics in the middle, weights at the end and a new initial state */
+	uint_t k = nN/2;
+	for( uint_t i=0; i<nX*nU; ++i )
+		data.B[k*nX*nU+i] += 0.05 * getRandom( );
+	setupSpd( nX,&(data.Q[nN*nX*nX]) );
+	setupSpd( nU,&(data.R[(nN-1)*nU*nU]) );
+	for( uint_t i=0; i<nX; ++i )
+		data.x0[i] = getRandom( );
+	passData( data,condenser );
+	ASSERT_EQ( SUCCESSFUL_RETURN, condenser.update( ) );
+	expectCondensed( condenser,data );
+
+	/* re-sending unchanged data keeps the result */
+	passData( data,condenser );
+	ASSERT_EQ( SUCCESSFUL_RETURN, condenser.update( ) );
+	expectCondensed( condenser,data );
+}
+
+
+TEST(condenser, hotstart_matches_dense_qp)
+{
+	srand( 13 );
+
+	MpcData data;
+	setupData( data );
+
+	Options options;
+	options.setToDefault( );
+	options.printLevel = PL_NONE;
+
+	Condenser condenser( nX,nU,nN );
+	passData( data,condenser );
+
+	SQProblem qp( nV,nC );
+	qp.setOptions( options );
+	int_t nWSR = 1000;
+	ASSERT_EQ( SUCCESSFUL_RETURN, condenser.init( qp,nWSR ) );
+
+	for( int_t tick=0; tick<5; ++tick )
+	{
+		/* new linearisation of the first stage and a new initial state */
+		for( uint_t i=0; i<nX*nU; ++i )
+			data.B[i] += 0.05 * getRandom( );
+		for( uint_t i=0; i<nX; ++i )
+			data.x0[i] = 2.0 * getRandom( );
+		passData( data,condenser );
+
+		nWSR = 1000;
+		ASSERT_EQ( SUCCESSFUL_RETURN, condenser.hotstart( qp,nWSR ) );
+
+		real_t H[nV*nV], g[nV], Acon[nC*nV], lbA[nC], ubA[nC];
+		condense( data,H,g,Acon,lbA,ubA );
+
+		QProblem reference( nV,nC );
+		reference.setOptions( options );
+		nWSR = 1000;
+		ASSERT_EQ( SUCCESSFUL_RETURN, reference.init( H,g,Acon,&(data.lbu[0]),&(data.ubu[0]),lbA,ubA,nWSR ) );
+
+		real_t xOpt[nV], xReference[nV];
+		qp.getPrimalSolution( xOpt );
+		reference.getPrimalSolution( xReference );
+		for( uint_t i=0; i<nV; ++i )
+			EXPECT_NEAR( xReference[i], xOpt[i], 1e-8 ) << "tick " << tick;
+	}
+}
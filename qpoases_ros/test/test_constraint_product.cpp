@@ -0,0 +1,230 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/**
+ *	\file test/test_constraint_product.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Checks that QPs solved with user-defined constraint products (evaluated
+ *	one by one or in one batched call) take the same steps as with the
+ *	dense constraint matrix.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <math.h>
+
+#include <qpOASES.hpp>
+
+USING_NAMESPACE_QPOASES
+
+
+namespace
+{
+	const int_t nV = 10;
+	const int_t nC = 6;
+
+	/* Strictly convex QP with box and general constraints; the gradient and
+	 * the constraints' bounds are shifted by 'phase' so that hotstarts change
+	 * the active set. */
+	void setupQP( real_t phase, real_t* H, real_t* g, real_t* A, real_t* lb, real_t* ub, real_t* lbA, real_t* ubA )
+	{
+		for( int_t i=0; i<nV*nV; ++i )
+			H[i] = 0.0;
+
+		for( int_t i=0; i<nV; ++i )
+		{
+			H[i*nV+i] = 1.0 + 0.1*i;
+			g[i] = 2.0*sin( 0.7*i + phase );
+			lb[i] = -1.0;
+			ub[i] = 1.0;
+		}
+
+		for( int_t j=0; j<nC; ++j )
+		{
+			for( int_t i=0; i<nV; ++i )
+				A[j*nV+i] = cos( 0.3*i*(j+1) );
+			lbA[j] = -0.5 + 0.3*sin( phase + j );
+			ubA[j] = 0.5 + 0.3*sin( phase + j );
+		}
+	}
+
+	/* Constraint product evaluated one constraint at a time (the default
+	 * evaluate() calls operator() for each index). */
+	class RowProduct : public ConstraintProduct
+	{
+		public:
+			RowProduct( const real_t* const _A ) : A( _A ), nCalls( 0 ) { }
+
+			virtual int_t operator() ( int_t constrIndex, const real_t* const x, real_t* const constrValue ) const
+			{
+				++nCalls;
+
+				*constrValue = 0.0;
+				for( int_t i=0; i<nV; ++i )
+					*constrValue += A[constrIndex*nV+i] * x[i];
+
+				return 0;
+			}
+
+			const real_t* A;
+			mutable int_t nCalls;
+	};
+
+	/* Constraint product evaluating the whole set of constraints in one call. */
+	class BatchProduct : public RowProduct
+	{
+		public:
+			BatchProduct( const real_t* const _A ) : RowProduct( _A ), nBatches( 0 ) { }
+
+			virtual int_t evaluate( int_t nConstr, const int_t* const constrIndices, const real_t* const x, real_t* const constrValues ) const
+			{
+				++nBatches;
+
+				for( int_t k=0; k<nConstr; ++k )
+				{
+					constrValues[k] = 0.0;
+					for( int_t i=0; i<nV; ++i )
+						constrValues[k] += A[constrIndices[k]*nV+i] * x[i];
+				}
+
+				return 0;
+			}
+
+			mutable int_t nBatches;
+	};
+
+	/* Constraint product that always fails. */
+	class FailingProduct : public ConstraintProduct
+	{
+		public:
+			virtual int_t operator() ( int_t, const real_t* const, real_t* const ) const
+			{
+				return 1;
+			}
+	};
+
+	void setupOptions( QProblem& qp )
+	{
+		Options options;
+		options.setToDefault( );
+		options.printLevel = PL_NONE;
+		qp.setOptions( options );
+	}
+
+	/* Solves the same QP sequence with and without constraint product and
+	 * compares the iterates after each (hot)start. */
+	void compareSequence( ConstraintProduct* const product )
+	{
+		real_t H[nV*nV], g[nV], A[nC*nV], lb[nV], ub[nV], lbA[nC], ubA[nC];
+		real_t x[nV], xDense[nV], y[nV+nC], yDense[nV+nC];
+
+		QProblem qp( nV,nC );
+		QProblem dense( nV,nC );
+		setupOptions( qp );
+		setupOptions( dense );
+		ASSERT_EQ( SUCCESSFUL_RETURN, qp.setConstraintProduct( product ) );
+
+		int_t nWSRTotal = 0;
+		for( int_t k=0; k<8; ++k )
+		{
+			setupQP( 0.4*k,H,g,A,lb,ub,lbA,ubA );
+
+			int_t nWSR = 100, nWSRDense = 100;
+			if ( k == 0 )
+			{
+				ASSERT_EQ( SUCCESSFUL_RETURN, qp.init( H,g,A,lb,ub,lbA,ubA,nWSR ) );
+				ASSERT_EQ( SUCCESSFUL_RETURN, dense.init( H,g,A,lb,ub,lbA,ubA,nWSRDense ) );
+			}
+			else
+			{
+				ASSERT_EQ( SUCCESSFUL_RETURN, qp.hotstart( g,lb,ub,lbA,ubA,nWSR ) );
+				ASSERT_EQ( SUCCESSFUL_RETURN, dense.hotstart( g,lb,ub,lbA,ubA,nWSRDense ) );
+			}
+
+			EXPECT_EQ( nWSRDense, nWSR );
+			nWSRTotal += nWSR;
+			EXPECT_EQ( dense.getNAC( ), qp.getNAC( ) );
+
+			qp.getPrimalSolution( x );
+			dense.getPrimalSolution( xDense );
+			for( int_t i=0; i<nV; ++i )
+				EXPECT_NEAR( xDense[i], x[i], 1e-12 );
+
+			qp.getDualSolution( y );
+			dense.getDualSolution( yDense );
+			for( int_t i=0; i<nV+nC; ++i )
+				EXPECT_NEAR( yDense[i], y[i], 1e-12 );
+
+			EXPECT_NEAR( dense.getObjVal( ), qp.getObjVal( ), 1e-12 );
+		}
+
+		/* the hotstarts shall change the active set */
+		EXPECT_GT( nWSRTotal, 8 );
+	}
+}
+
+
+TEST(constraint_product, row_product)
+{
+	real_t H[nV*nV], g[nV], A[nC*nV], lb[nV], ub[nV], lbA[nC], ubA[nC];
+	setupQP( 0.0,H,g,A,lb,ub,lbA,ubA );
+
+	RowProduct product( A );
+	compareSequence( &product );
+	EXPECT_GT( product.nCalls, 0 );
+}
+
+
+TEST(constraint_product, batch_product)
+{
+	real_t H[nV*nV], g[nV], A[nC*nV], lb[nV], ub[nV], lbA[nC], ubA[nC];
+	setupQP( 0.0,H,g,A,lb,ub,lbA,ubA );
+
+	/* all products of performStep() are evaluated in batches */
+	BatchProduct product( A );
+	compareSequence( &product );
+	EXPECT_GT( product.nBatches, 0 );
+	EXPECT_EQ( 0, product.nCalls );
+}
+
+
+TEST(constraint_product, failing_product)
+{
+	real_t H[nV*nV], g[nV], A[nC*nV], lb[nV], ub[nV], lbA[nC], ubA[nC];
+	FailingProduct product;
+
+	QProblem qp( nV,nC );
+	setupOptions( qp );
+
+	setupQP( 0.0,H,g,A,lb,ub,lbA,ubA );
+	int_t nWSR = 100;
+	ASSERT_EQ( SUCCESSFUL_RETURN, qp.init( H,g,A,lb,ub,lbA,ubA,nWSR ) );
+	ASSERT_EQ( SUCCESSFUL_RETURN, qp.setConstraintProduct( &product ) );
+
+	setupQP( 1.2,H,g,A,lb,ub,lbA,ubA );
+	nWSR = 100;
+	EXPECT_EQ( RET_ERROR_IN_CONSTRAINTPRODUCT, qp.hotstart( g,lb,ub,lbA,ubA,nWSR ) );
+}
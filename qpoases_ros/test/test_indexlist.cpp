@@ -0,0 +1,116 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file test/test_indexlist.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Checks the position lookup of the Indexlist class against a linear scan.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <qpOASES.hpp>
+
+USING_NAMESPACE_QPOASES
+
+
+namespace
+{
+	const int_t n = 20;
+
+	/* Returns physical index of given number found by a linear scan (-1 if not contained). */
+	int_t findLinear( const Indexlist& list, int_t givennumber )
+	{
+		for( int_t i=0; i<list.getLength( ); ++i )
+			if ( list.getNumber( i ) == givennumber )
+				return i;
+
+		return -1;
+	}
+
+	/* Compares getIndex() and isMember() with a linear scan for all numbers
+	 * and checks that iSort still sorts the numbers. */
+	void checkConsistency( const Indexlist& list )
+	{
+		int_t* iSort;
+		list.getISortArray( &iSort );
+
+		for( int_t k=0; k<n; ++k )
+		{
+			int_t index = findLinear( list,k );
+			ASSERT_EQ( index, list.getIndex( k ) ) << "number " << k;
+			ASSERT_EQ( ( index >= 0 ) ? BT_TRUE : BT_FALSE, list.isMember( k ) ) << "number " << k;
+		}
+
+		for( int_t i=1; i<list.getLength( ); ++i )
+			ASSERT_LT( list.getNumber( iSort[i-1] ), list.getNumber( iSort[i] ) );
+	}
+}
+
+
+TEST(indexlist, random_add_swap_remove)
+{
+	srand( 42 );
+
+	for( int_t sequence=0; sequence<20; ++sequence )
+	{
+		Indexlist list( n );
+
+		for( int_t step=0; step<500; ++step )
+		{
+			int_t length = list.getLength( );
+			int_t operation = rand( ) % 3;
+
+			if ( ( operation == 0 ) && ( length < n ) )
+			{
+				int_t k = rand( ) % n;
+				if ( list.isMember( k ) == BT_FALSE )
+				{
+					ASSERT_EQ( SUCCESSFUL_RETURN, list.addNumber( k ) );
+				}
+			}
+			else if ( ( operation == 1 ) && ( length > 1 ) )
+			{
+				int_t number1 = list.getNumber( rand( ) % length );
+				int_t number2 = list.getNumber( rand( ) % length );
+				if ( number1 != number2 )
+				{
+					ASSERT_EQ( SUCCESSFUL_RETURN, list.swapNumbers( number1,number2 ) );
+				}
+			}
+			else if ( ( operation == 2 ) && ( length > 0 ) )
+			{
+				ASSERT_EQ( SUCCESSFUL_RETURN, list.removeNumber( list.getNumber( rand( ) % length ) ) );
+			}
+
+			checkConsistency( list );
+			if ( HasFatalFailure( ) )
+				return;
+		}
+	}
+}
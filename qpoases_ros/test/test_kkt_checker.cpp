@@ -0,0 +1,223 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file test/test_kkt_checker.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Checks that the KktChecker only accepts solved QPs and detects violations
+ *	of the KKT conditions, with and without additional threads.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <qpOASES.hpp>
+
+USING_NAMESPACE_QPOASES
+
+
+namespace
+{
+	const int_t nV = 10;
+	const int_t nC = 4;
+
+	/* Strictly convex QP with box and general constraints; the gradient is
+	 * shifted by 'phase' so that hotstarts change the active set. */
+	void setupQP( real_t phase, real_t* H, real_t* g, real_t* A, real_t* lb, real_t* ub, real_t* lbA, real_t* ubA )
+	{
+		for( int_t i=0; i<nV*nV; ++i )
+			H[i] = 0.0;
+
+		for( int_t i=0; i<nV; ++i )
+		{
+			H[i*nV+i] = 1.0 + 0.1*i;
+			g[i] = 2.0*sin( 0.7*i + phase );
+			lb[i] = -1.0;
+			ub[i] = 1.0;
+		}
+
+		for( int_t j=0; j<nC; ++j )
+		{
+			for( int_t i=0; i<nV; ++i )
+				A[j*nV+i] = cos( 0.3*i*(j+1) );
+			lbA[j] = -0.5;
+			ubA[j] = 0.5;
+		}
+	}
+
+	void setupOptions( QProblemB& qp )
+	{
+		Options options;
+		options.setToDefault( );
+		options.printLevel = PL_NONE;
+		qp.setOptions( options );
+	}
+
+	/* QP whose solution can be moved away from the optimum. */
+	class PerturbedQProblem : public QProblem
+	{
+		public:
+			PerturbedQProblem( ) : QProblem( nV,nC ) { }
+
+			void perturb( int_t i, real_t delta ) { x[i] += delta; }
+	};
+}
+
+
+TEST(kkt_checker, nwsr_limit_bounds)
+{
+	real_t H[nV*nV], g[nV], A[nC*nV], lb[nV], ub[nV], lbA[nC], ubA[nC];
+	real_t stat, feas, cmpl;
+	KktChecker checker;
+	QProblemB qp( nV );
+	setupOptions( qp );
+
+	setupQP( 0.0,H,g,A,lb,ub,lbA,ubA );
+	int_t nWSR = 100;
+	ASSERT_EQ( SUCCESSFUL_RETURN, qp.init( H,g,lb,ub,nWSR ) );
+	EXPECT_LT( checker.getKktViolation( &qp ), 1e-10 );
+
+	/* interrupted hotstart: the iterate solves an intermediate QP only */
+	setupQP( 1.5,H,g,A,lb,ub,lbA,ubA );
+	nWSR = 1;
+	ASSERT_EQ( RET_MAX_NWSR_REACHED, qp.hotstart( g,lb,ub,nWSR ) );
+	EXPECT_EQ( INFTY, checker.getKktViolation( &qp,&stat,&feas,&cmpl ) );
+	EXPECT_EQ( INFTY, stat );
+	EXPECT_EQ( INFTY, feas );
+	EXPECT_EQ( INFTY, cmpl );
+
+	nWSR = 100;
+	ASSERT_EQ( SUCCESSFUL_RETURN, qp.hotstart( g,lb,ub,nWSR ) );
+	EXPECT_LT( checker.getKktViolation( &qp ), 1e-10 );
+}
+
+
+TEST(kkt_checker, nwsr_limit_constraints)
+{
+	real_t H[nV*nV], g[nV], A[nC*nV], lb[nV], ub[nV], lbA[nC], ubA[nC];
+	real_t stat, feas, cmpl;
+	KktChecker checker;
+	QProblem qp( nV,nC );
+	setupOptions( qp );
+
+	setupQP( 0.0,H,g,A,lb,ub,lbA,ubA );
+	int_t nWSR = 100;
+	ASSERT_EQ( SUCCESSFUL_RETURN, qp.init( H,g,A,lb,ub,lbA,ubA,nWSR ) );
+	EXPECT_LT( checker.getKktViolation( &qp ), 1e-10 );
+
+	/* interrupted hotstart: the iterate solves an intermediate QP only */
+	setupQP( 1.5,H,g,A,lb,ub,lbA,ubA );
+	nWSR = 1;
+	ASSERT_EQ( RET_MAX_NWSR_REACHED, qp.hotstart( g,lb,ub,lbA,ubA,nWSR ) );
+	EXPECT_EQ( INFTY, checker.getKktViolation( &qp,&stat,&feas,&cmpl ) );
+	EXPECT_EQ( INFTY, stat );
+	EXPECT_EQ( INFTY, feas );
+	EXPECT_EQ( INFTY, cmpl );
+
+	nWSR = 100;
+	ASSERT_EQ( SUCCESSFUL_RETURN, qp.hotstart( g,lb,ub,lbA,ubA,nWSR ) );
+	EXPECT_LT( checker.getKktViolation( &qp ), 1e-10 );
+}
+
+
+TEST(kkt_checker, detects_violation)
+{
+	real_t H[nV*nV], g[nV], A[nC*nV], lb[nV], ub[nV], lbA[nC], ubA[nC];
+	real_t stat, feas, cmpl;
+	KktChecker serial( 1 );
+	KktChecker parallel( 3 );
+	PerturbedQProblem qp;
+	setupOptions( qp );
+
+	setupQP( 0.0,H,g,A,lb,ub,lbA,ubA );
+	int_t nWSR = 100;
+	ASSERT_EQ( SUCCESSFUL_RETURN, qp.init( H,g,A,lb,ub,lbA,ubA,nWSR ) );
+	ASSERT_GT( qp.getNAC( ), 0 );
+	EXPECT_LT( serial.getKktViolation( &qp ), 1e-10 );
+	EXPECT_LT( parallel.getKktViolation( &qp ), 1e-10 );
+
+	/* the stationarity residual of the last variable grows by H[last]*delta,
+	 * the constraints' products A*x are not updated by the perturbation */
+	real_t x[nV];
+	qp.getPrimalSolution( x );
+	const int_t last = nV-1;
+	const real_t delta = 1e-3 * ( x[last] > 0.0 ? -1.0 : 1.0 );
+	qp.perturb( last,delta );
+
+	real_t expected = H[last*nV+last] * getAbs( delta );
+	EXPECT_NEAR( expected, serial.getKktViolation( &qp,&stat,&feas,&cmpl ), 1e-10 );
+	EXPECT_NEAR( expected, stat, 1e-10 );
+
+	real_t statParallel, feasParallel, cmplParallel;
+	EXPECT_NEAR( expected, parallel.getKktViolation( &qp,&statParallel,&feasParallel,&cmplParallel ), 1e-10 );
+	EXPECT_NEAR( stat, statParallel, 1e-14 );
+	EXPECT_EQ( feas, feasParallel );
+	EXPECT_EQ( cmpl, cmplParallel );
+
+	/* repeated checks reuse the worker threads */
+	for( int_t k=0; k<100; ++k )
+		EXPECT_NEAR( stat, parallel.getKktViolation( &qp ), 1e-14 );
+}
+
+
+TEST(kkt_checker, early_exit)
+{
+	real_t H[nV*nV], g[nV], A[nC*nV], lb[nV], ub[nV], lbA[nC], ubA[nC];
+	real_t stat, feas, cmpl;
+	KktChecker checker( 3,1e-6 );
+	PerturbedQProblem qp;
+	setupOptions( qp );
+
+	setupQP( 0.0,H,g,A,lb,ub,lbA,ubA );
+	int_t nWSR = 100;
+	ASSERT_EQ( SUCCESSFUL_RETURN, qp.init( H,g,A,lb,ub,lbA,ubA,nWSR ) );
+	EXPECT_LT( checker.getKktViolation( &qp ), 1e-6 );
+
+	/* push a variable beyond its bound: stationarity is not evaluated any more */
+	real_t x[nV];
+	qp.getPrimalSolution( x );
+	qp.perturb( 0,ub[0] - x[0] + 0.5 );
+
+	EXPECT_GT( checker.getKktViolation( &qp,&stat,&feas,&cmpl ), 1e-6 );
+	EXPECT_NEAR( 0.5, feas, 1e-10 );
+	EXPECT_EQ( 0.0, stat );
+
+	/* without tolerance all conditions are evaluated */
+	ASSERT_EQ( SUCCESSFUL_RETURN, checker.setTolerance( 0.0 ) );
+	checker.getKktViolation( &qp,&stat,&feas,&cmpl );
+	EXPECT_GT( stat, 0.1 );
+
+	/* an unsolved QP is refused before any condition is checked */
+	ASSERT_EQ( SUCCESSFUL_RETURN, checker.setTolerance( 1e-6 ) );
+	setupQP( 1.5,H,g,A,lb,ub,lbA,ubA );
+	nWSR = 1;
+	ASSERT_EQ( RET_MAX_NWSR_REACHED, qp.hotstart( g,lb,ub,lbA,ubA,nWSR ) );
+	EXPECT_EQ( INFTY, checker.getKktViolation( &qp,&stat,&feas,&cmpl ) );
+	EXPECT_EQ( INFTY, stat );
+	EXPECT_EQ( INFTY, feas );
+	EXPECT_EQ( INFTY, cmpl );
+}
@@ -0,0 +1,134 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+
+/**
+ *	\file test/test_racing_solver.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Checks that copies of RacingSolver candidates solve on their own.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <qpOASES.hpp>
+
+USING_NAMESPACE_QPOASES
+
+
+namespace
+{
+	const int_t nV = 10;
+	const int_t nC = 4;
+	const uint_t nCandidates = 3;
+
+	/* Strictly convex QP with box and general constraints; the gradient is
+	 * shifted by 'phase' so that hotstarts change the active set. */
+	void setupQP( real_t phase, real_t* H, real_t* g, real_t* A, real_t* lb, real_t* ub, real_t* lbA, real_t* ubA )
+	{
+		for( int_t i=0; i<nV*nV; ++i )
+			H[i] = 0.0;
+
+		for( int_t i=0; i<nV; ++i )
+		{
+			H[i*nV+i] = 1.0 + 0.1*i;
+			g[i] = 2.0*sin( 0.7*i + phase );
+			lb[i] = -1.0;
+			ub[i] = 1.0;
+		}
+
+		for( int_t j=0; j<nC; ++j )
+		{
+			for( int_t i=0; i<nV; ++i )
+				A[j*nV+i] = cos( 0.3*i*(j+1) );
+			lbA[j] = -0.5;
+			ubA[j] = 0.5;
+		}
+	}
+}
+
+
+TEST(racing_solver, hotstart_copy_of_winner)
+{
+	real_t H[nV*nV], g[nV], A[nC*nV], lb[nV], ub[nV], lbA[nC], ubA[nC];
+	real_t xOpt[nV], xReference[nV];
+
+	Options options;
+	options.setToDefault( );
+	options.printLevel = PL_NONE;
+
+	Options presets[nCandidates];
+	presets[0].setToDefault( );
+	presets[1].setToReliable( );
+	presets[2].setToMPC( );
+
+	QProblem qp( nV,nC );
+	qp.setOptions( options );
+
+	setupQP( 0.0,H,g,A,lb,ub,lbA,ubA );
+	int_t nWSR = 100;
+	ASSERT_EQ( SUCCESSFUL_RETURN, qp.init( H,g,A,lb,ub,lbA,ubA,nWSR ) );
+
+	QProblem* constructed = 0;
+	QProblem assigned( nV,nC );
+
+	{
+		RacingSolver racer( qp,nCandidates,presets );
+
+		setupQP( 1.5,H,g,A,lb,ub,lbA,ubA );
+		nWSR = 100;
+		ASSERT_EQ( SUCCESSFUL_RETURN, racer.hotstart( g,lb,ub,lbA,ubA,nWSR ) );
+		ASSERT_GE( racer.getWinner( ), 0 );
+
+		/* the losers have been cancelled, but copies must not be */
+		QProblem* winner = racer.getCandidate( (uint_t)racer.getWinner( ) );
+		constructed = new QProblem( *winner );
+		assigned = *winner;
+	}
+
+	/* the racer (and with it any cancel flag) is gone now */
+	setupQP( 3.0,H,g,A,lb,ub,lbA,ubA );
+
+	QProblem reference( nV,nC );
+	reference.setOptions( options );
+	nWSR = 100;
+	ASSERT_EQ( SUCCESSFUL_RETURN, reference.init( H,g,A,lb,ub,lbA,ubA,nWSR ) );
+	reference.getPrimalSolution( xReference );
+
+	QProblem* copies[2] = { constructed,&assigned };
+	for( int_t k=0; k<2; ++k )
+	{
+		nWSR = 100;
+		ASSERT_EQ( SUCCESSFUL_RETURN, copies[k]->hotstart( g,lb,ub,lbA,ubA,nWSR ) );
+		EXPECT_GT( nWSR, 0 );
+
+		copies[k]->getPrimalSolution( xOpt );
+		for( int_t i=0; i<nV; ++i )
+			EXPECT_NEAR( xReference[i], xOpt[i], 1e-10 );
+	}
+
+	delete constructed;
+}
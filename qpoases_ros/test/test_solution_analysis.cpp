@@ -0,0 +1,154 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/**
+ *	\file test/test_solution_analysis.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Checks the blocked evaluation of selected blocks of variance-covariance
+ *	matrices against the serial evaluation of the whole matrix.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <math.h>
+
+#include <qpOASES.hpp>
+
+USING_NAMESPACE_QPOASES
+
+
+namespace
+{
+	/* Returns the block of the variance-covariance matrices a row or column belongs to. */
+	int_t getBlock( int_t i, int_t nV )
+	{
+		if ( i < nV )
+			return CB_VARIABLES;
+
+		return ( i < 2*nV ) ? CB_BOUNDS : CB_CONSTRAINTS;
+	}
+
+	/* Solves a strictly convex QP with some active bounds and constraints and
+	 * compares the blocked variance-covariance against the serial one. */
+	void compareVarianceCovariance( int_t nV, int_t nC, uint_t nThreads, int_t blockSize, int_t inputBlocks, int_t outputBlocks )
+	{
+		int_t i, j;
+		int_t nVar = 2*nV+nC;
+
+		real_t* H = new real_t[nV*nV];
+		real_t* A = new real_t[nC*nV];
+		real_t* g = new real_t[nV];
+		real_t* lb = new real_t[nV];
+		real_t* ub = new real_t[nV];
+		real_t* lbA = new real_t[nC];
+		real_t* ubA = new real_t[nC];
+
+		for( i=0; i<nV; ++i )
+		{
+			for( j=0; j<nV; ++j )
+				H[i*nV+j] = ( i == j ) ? 2.0 + 0.1*i : 0.5 * cos( (real_t)(i+2*j) ) / (real_t)nV;
+			g[i] = 3.0 * sin( 0.9*i );
+			lb[i] = -1.0;
+			ub[i] = 1.0;
+		}
+
+		for( j=0; j<nC; ++j )
+		{
+			for( i=0; i<nV; ++i )
+				A[j*nV+i] = cos( 0.3*(real_t)(i*(j+1)) );
+			lbA[j] = -0.5;
+			ubA[j] = 0.5;
+		}
+
+		QProblem qp( nV,nC );
+		Options options;
+		options.printLevel = PL_NONE;
+		qp.setOptions( options );
+
+		int_t nWSR = 1000;
+		ASSERT_EQ( SUCCESSFUL_RETURN, qp.init( H,g,A,lb,ub,lbA,ubA,nWSR ) );
+		EXPECT_GT( qp.getNAC( ), 0 );
+
+		/* symmetric positive definite input variance-covariance */
+		real_t* inputVar = new real_t[nVar*nVar];
+		real_t* maskedVar = new real_t[nVar*nVar];
+		for( i=0; i<nVar; ++i )
+			for( j=0; j<nVar; ++j )
+			{
+				inputVar[i*nVar+j] = ( i == j ) ? 1.0 + 0.01*i : 0.1 * cos( (real_t)(i*j) ) / (real_t)nVar;
+				maskedVar[i*nVar+j] = ( ( ( getBlock( i,nV ) & inputBlocks ) != 0 ) && ( ( getBlock( j,nV ) & inputBlocks ) != 0 ) ) ? inputVar[i*nVar+j] : 0.0;
+			}
+
+		real_t* reference = new real_t[nVar*nVar];
+		real_t* blocked = new real_t[nVar*nVar];
+
+		SolutionAnalysis serial;
+		ASSERT_EQ( SUCCESSFUL_RETURN, serial.getVarianceCovariance( &qp,maskedVar,reference ) );
+
+		SolutionAnalysis analysis( nThreads,blockSize );
+		ASSERT_EQ( SUCCESSFUL_RETURN, analysis.getVarianceCovariance( &qp,inputVar,blocked,inputBlocks,outputBlocks ) );
+
+		real_t maxRef = 0.0;
+		for( i=0; i<nVar*nVar; ++i )
+			maxRef = getMax( maxRef,getAbs( reference[i] ) );
+
+		for( i=0; i<nVar; ++i )
+			for( j=0; j<nVar; ++j )
+			{
+				if ( ( ( getBlock( i,nV ) & outputBlocks ) != 0 ) && ( ( getBlock( j,nV ) & outputBlocks ) != 0 ) )
+					EXPECT_NEAR( reference[i*nVar+j], blocked[i*nVar+j], 1e-12 * maxRef ) << "row " << i << ", column " << j;
+				else
+					EXPECT_EQ( 0.0, blocked[i*nVar+j] ) << "row " << i << ", column " << j;
+			}
+
+		delete[] blocked; delete[] reference; delete[] maskedVar; delete[] inputVar;
+		delete[] ubA; delete[] lbA; delete[] ub; delete[] lb; delete[] g; delete[] A; delete[] H;
+	}
+}
+
+
+TEST(solution_analysis, small_serial)
+{
+	/* too small to be split between threads */
+	compareVarianceCovariance( 6,3,4,4,CB_ALL,CB_ALL );
+}
+
+
+TEST(solution_analysis, threads)
+{
+	compareVarianceCovariance( 30,20,1,8,CB_ALL,CB_ALL );
+	compareVarianceCovariance( 30,20,3,8,CB_ALL,CB_ALL );
+	compareVarianceCovariance( 30,20,4,5,CB_ALL,CB_ALL );
+}
+
+
+TEST(solution_analysis, selected_blocks)
+{
+	compareVarianceCovariance( 30,20,3,8,CB_VARIABLES,CB_VARIABLES );
+	compareVarianceCovariance( 30,20,3,8,CB_BOUNDS | CB_CONSTRAINTS,CB_VARIABLES );
+	compareVarianceCovariance( 30,20,3,8,CB_VARIABLES,CB_BOUNDS | CB_CONSTRAINTS );
+	compareVarianceCovariance( 6,3,2,2,CB_CONSTRAINTS,CB_ALL );
+}
@@ -0,0 +1,232 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file test/test_solver_service.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Checks that a solver service keeping the previous Hessian solves the same
+ *	QPs as an in-process SQProblem, also if the Hessian gets regularised.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <qpOASES.hpp>
+
+USING_NAMESPACE_QPOASES
+
+
+#ifndef __NO_THREADS__
+
+namespace
+{
+	void* serve( void* arg )
+	{
+		static_cast<SolverServer*>( arg )->run( );
+		return 0;
+	}
+}
+
+
+TEST(solver_service, keep_previous_hessian)
+{
+	const uint_t nV = 4;
+	const uint_t nC = 1;
+
+	/* semi-definite Hessian, so the solver regularises it */
+	real_t H[nV*nV] = {	1.0, 0.0, 0.0, 0.0,
+						0.0, 2.0, 0.0, 0.0,
+						0.0, 0.0, 3.0, 0.0,
+						0.0, 0.0, 0.0, 0.0 };
+	real_t A[nC*nV] = { 1.0, 1.0, 1.0, 1.0 };
+	real_t g[nV], lb[nV], ub[nV];
+	real_t lbA[nC] = { -2.0 };
+	real_t ubA[nC] = { 2.0 };
+
+	for( uint_t i=0; i<nV; ++i )
+	{
+		g[i] = 0.5 - 0.3*i;
+		lb[i] = -1.0;
+		ub[i] = 1.0;
+	}
+
+	char name[MAX_STRING_LENGTH];
+	snprintf( name,MAX_STRING_LENGTH,"/qpoases_test_%d",(int)getpid( ) );
+
+	Options options;
+	options.printLevel = PL_NONE;
+	options.enableRegularisation = BT_TRUE;
+
+	SolverServer server;
+	ASSERT_EQ( SUCCESSFUL_RETURN, server.init( name,1,&nV,&nC,4,&options ) );
+
+	pthread_t thread;
+	ASSERT_EQ( 0, pthread_create( &thread,0,serve,&server ) );
+
+	SolverClient client;
+	ASSERT_EQ( SUCCESSFUL_RETURN, client.attach( name,0 ) );
+
+	SQProblem reference( nV,nC );
+	reference.setOptions( options );
+
+	int_t nWSR = 100;
+	int_t nWSRreference = 100;
+	ASSERT_EQ( SUCCESSFUL_RETURN, client.init( H,g,A,lb,ub,lbA,ubA,nWSR ) );
+	real_t Hinit[nV*nV];
+	memcpy( Hinit,H,nV*nV*sizeof(real_t) );
+	ASSERT_EQ( SUCCESSFUL_RETURN, reference.init( Hinit,g,A,lb,ub,lbA,ubA,nWSRreference ) );
+
+	/* the reference regularises the Hessian it is given in place as well,
+	 * so it gets a fresh copy (that lives until the next hotstart) each time */
+	real_t Hreference[2][nV*nV];
+	real_t xReference[nV];
+	for( uint_t k=0; k<20; ++k )
+	{
+		for( uint_t i=0; i<nV; ++i )
+			g[i] = ( k % 2 == 0 ) ? 0.5 - 0.3*i : 0.3*i - 0.5;
+
+		/* the service keeps its previous Hessian, the reference gets the original one */
+		nWSR = 100;
+		nWSRreference = 100;
+		ASSERT_EQ( SUCCESSFUL_RETURN, client.hotstart( 0,g,A,lb,ub,lbA,ubA,nWSR ) );
+		memcpy( Hreference[k%2],H,nV*nV*sizeof(real_t) );
+		ASSERT_EQ( SUCCESSFUL_RETURN, reference.hotstart( Hreference[k%2],g,A,lb,ub,lbA,ubA,nWSRreference ) );
+
+		/* both solve the very same QPs, so results have to agree exactly */
+		reference.getPrimalSolution( xReference );
+		for( uint_t i=0; i<nV; ++i )
+			ASSERT_EQ( xReference[i], client.getPrimalSolution( )[i] );
+		ASSERT_EQ( reference.getObjVal( ), client.getObjVal( ) );
+	}
+
+	client.requestShutdown( );
+	pthread_join( thread,0 );
+}
+
+
+TEST(solver_service, region_in_use)
+{
+	const uint_t nV = 2;
+	const uint_t nC = 0;
+	real_t H[nV*nV] = { 1.0, 0.0, 0.0, 1.0 };
+	real_t g[nV] = { 1.0, -1.0 };
+
+	char name[MAX_STRING_LENGTH];
+	snprintf( name,MAX_STRING_LENGTH,"/qpoases_test_%d",(int)getpid( ) );
+
+	Options options;
+	options.printLevel = PL_NONE;
+
+	SolverServer server;
+	ASSERT_EQ( SUCCESSFUL_RETURN, server.init( name,1,&nV,&nC,4,&options ) );
+
+	/* a second server must leave the region of the running one alone */
+	SolverServer intruder;
+	EXPECT_EQ( RET_SERVICE_IN_USE, intruder.init( name,1,&nV,&nC,4,&options ) );
+
+	pthread_t thread;
+	ASSERT_EQ( 0, pthread_create( &thread,0,serve,&server ) );
+
+	SolverClient client;
+	ASSERT_EQ( SUCCESSFUL_RETURN, client.attach( name,0 ) );
+
+	int_t nWSR = 100;
+	ASSERT_EQ( SUCCESSFUL_RETURN, client.init( H,g,0,0,0,0,0,nWSR ) );
+	EXPECT_EQ( -1.0, client.getPrimalSolution( )[0] );
+	EXPECT_EQ( 1.0, client.getPrimalSolution( )[1] );
+
+	client.requestShutdown( );
+	pthread_join( thread,0 );
+}
+
+
+TEST(solver_service, stale_region_is_replaced)
+{
+	const uint_t nV = 2;
+	const uint_t nC = 0;
+
+	char name[MAX_STRING_LENGTH];
+	snprintf( name,MAX_STRING_LENGTH,"/qpoases_test_%d",(int)getpid( ) );
+
+	Options options;
+	options.printLevel = PL_NONE;
+
+	/* a server that exits without removing its region, as if it had crashed */
+	pid_t pid = fork( );
+	ASSERT_GE( pid, 0 );
+	if ( pid == 0 )
+	{
+		SolverServer* crashing = new SolverServer;
+		_exit( ( crashing->init( name,1,&nV,&nC,4,&options ) == SUCCESSFUL_RETURN ) ? 0 : 1 );
+	}
+
+	int status = 0;
+	ASSERT_EQ( pid, waitpid( pid,&status,0 ) );
+	ASSERT_TRUE( WIFEXITED( status ) );
+	ASSERT_EQ( 0, WEXITSTATUS( status ) );
+
+	SolverServer server;
+	EXPECT_EQ( SUCCESSFUL_RETURN, server.init( name,1,&nV,&nC,4,&options ) );
+}
+
+
+TEST(solver_service, wait_times_out)
+{
+	const uint_t nV = 2;
+	const uint_t nC = 0;
+	real_t H[nV*nV] = { 1.0, 0.0, 0.0, 1.0 };
+	real_t g[nV] = { 1.0, -1.0 };
+
+	char name[MAX_STRING_LENGTH];
+	snprintf( name,MAX_STRING_LENGTH,"/qpoases_test_%d",(int)getpid( ) );
+
+	Options options;
+	options.printLevel = PL_NONE;
+
+	/* the server is not running, as if it had died */
+	SolverServer server;
+	ASSERT_EQ( SUCCESSFUL_RETURN, server.init( name,1,&nV,&nC,4,&options ) );
+
+	SolverClient client;
+	ASSERT_EQ( SUCCESSFUL_RETURN, client.attach( name,0 ) );
+	ASSERT_EQ( SUCCESSFUL_RETURN, client.setTimeout( 0.05 ) );
+
+	int_t nWSR = 100;
+	EXPECT_EQ( RET_SERVICE_TIMEOUT, client.init( H,g,0,0,0,0,0,nWSR ) );
+
+	/* the request stays outstanding and is answered once the server polls */
+	EXPECT_EQ( 1u, server.poll( ) );
+	EXPECT_EQ( SUCCESSFUL_RETURN, client.wait( nWSR ) );
+	EXPECT_EQ( -1.0, client.getPrimalSolution( )[0] );
+	EXPECT_EQ( 1.0, client.getPrimalSolution( )[1] );
+}
+
+#endif /* __NO_THREADS__ */
@@ -0,0 +1,144 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file test/test_solver_statistics.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Checks the refactorisation counter of the SolverStatistics struct.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <qpOASES.hpp>
+
+USING_NAMESPACE_QPOASES
+
+
+namespace
+{
+	const int_t nV = 10;
+
+	/* Box-constrained QP with a diagonal Hessian; the gradient is shifted
+	 * by 'phase' so that hotstarts change the active bounds. */
+	void setupBoxQP( real_t phase, real_t* H, real_t* g, real_t* lb, real_t* ub )
+	{
+		for( int_t i=0; i<nV*nV; ++i )
+			H[i] = 0.0;
+
+		for( int_t i=0; i<nV; ++i )
+		{
+			H[i*nV+i] = 1.0 + 0.1*i;
+			g[i] = 2.0*sin( 0.7*i + phase );
+			lb[i] = -1.0;
+			ub[i] = 1.0;
+		}
+	}
+
+	void setupOptions( QProblemB& qp, int_t enableCholeskyRefactorisation )
+	{
+		Options options;
+		options.setToDefault( );
+		options.printLevel = PL_NONE;
+		options.enableCholeskyRefactorisation = enableCholeskyRefactorisation;
+		qp.setOptions( options );
+	}
+}
+
+
+TEST(solver_statistics, no_refactorisations_by_default)
+{
+	real_t H[nV*nV], g[nV], lb[nV], ub[nV];
+	QProblemB qp( nV );
+	setupOptions( qp,0 );
+
+	setupBoxQP( 0.0,H,g,lb,ub );
+	int_t nWSR = 100;
+	ASSERT_EQ( SUCCESSFUL_RETURN, qp.init( H,g,lb,ub,nWSR ) );
+
+	qp.resetStatistics( );
+	setupBoxQP( 1.5,H,g,lb,ub );
+	nWSR = 100;
+	ASSERT_EQ( SUCCESSFUL_RETURN, qp.hotstart( g,lb,ub,nWSR ) );
+
+	SolverStatistics statistics = qp.getStatistics( );
+	EXPECT_GT( statistics.nHomotopyIterations, 1u );
+	EXPECT_EQ( 0u, statistics.nRefactorisations );
+}
+
+
+TEST(solver_statistics, periodic_refactorisations)
+{
+	real_t H[nV*nV], g[nV], lb[nV], ub[nV];
+	QProblemB qp( nV );
+	setupOptions( qp,1 );
+
+	/* init() solves a homotopy as well, so it counts refactorisations */
+	setupBoxQP( 0.0,H,g,lb,ub );
+	int_t nWSR = 100;
+	ASSERT_EQ( SUCCESSFUL_RETURN, qp.init( H,g,lb,ub,nWSR ) );
+	EXPECT_GT( qp.getStatistics( ).nRefactorisations, 0u );
+
+	/* every working set change of the hotstart is followed by one,
+	 * only the final (terminating) iteration is not */
+	qp.resetStatistics( );
+	setupBoxQP( 1.5,H,g,lb,ub );
+	nWSR = 100;
+	ASSERT_EQ( SUCCESSFUL_RETURN, qp.hotstart( g,lb,ub,nWSR ) );
+
+	SolverStatistics statistics = qp.getStatistics( );
+	EXPECT_GT( statistics.nRefactorisations, 0u );
+	EXPECT_EQ( statistics.nHomotopyIterations - 1, statistics.nRefactorisations );
+}
+
+
+TEST(solver_statistics, guessed_working_set)
+{
+	real_t H[nV*nV], g[nV], lb[nV], ub[nV];
+	QProblemB qp( nV );
+	setupOptions( qp,0 );
+
+	setupBoxQP( 0.0,H,g,lb,ub );
+	int_t nWSR = 100;
+	ASSERT_EQ( SUCCESSFUL_RETURN, qp.init( H,g,lb,ub,nWSR ) );
+
+	/* hotstarting from a different working set sets it up afresh */
+	Bounds guessedBounds( nV );
+	guessedBounds.setupAllFree( );
+
+	qp.resetStatistics( );
+	setupBoxQP( 1.5,H,g,lb,ub );
+	nWSR = 100;
+	ASSERT_EQ( SUCCESSFUL_RETURN, qp.hotstart( g,lb,ub,nWSR,0,&guessedBounds ) );
+	EXPECT_EQ( 1u, qp.getStatistics( ).nRefactorisations );
+}
+
+
+int main(int argc, char **argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
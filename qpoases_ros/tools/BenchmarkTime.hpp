@@ -0,0 +1,59 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tools/BenchmarkTime.hpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Monotonic clock shared by the benchmark tools (getCPUtime() returns -1
+ *	unless qpOASES is built with LINUX defined).
+ */
+
+
+#ifndef QPOASES_BENCHMARKTIME_HPP
+#define QPOASES_BENCHMARKTIME_HPP
+
+
+#include <qpOASES/Types.hpp>
+
+#include <time.h>
+
+
+BEGIN_NAMESPACE_QPOASES
+
+
+/** Returns monotonic time in seconds. */
+inline real_t getTime( )
+{
+	struct timespec t;
+	clock_gettime( CLOCK_MONOTONIC,&t );
+	return (real_t)t.tv_sec + (real_t)t.tv_nsec * 1.0e-9;
+}
+
+
+END_NAMESPACE_QPOASES
+
+
+#endif	/* QPOASES_BENCHMARKTIME_HPP */
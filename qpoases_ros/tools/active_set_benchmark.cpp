@@ -0,0 +1,225 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tools/active_set_benchmark.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Compares plain hotstarts to hotstarts from working sets predicted by the
+ *	ActiveSetPredictor on a periodic QP sequence mimicking a gait: each leg
+ *	contributes a group of force constraints that are tight while the leg is
+ *	in stance and loose while it swings, and the gradient follows the phase.
+ *
+ *	Usage: active_set_benchmark [NV] [NC] [PERIOD] [NTICKS]
+ */
+
+
+#include <qpOASES.hpp>
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "BenchmarkTime.hpp"
+
+
+USING_NAMESPACE_QPOASES
+
+
+/** Number of legs of the synthetic gait. */
+const int_t NLEGS = 4;
+
+
+/** Returns uniformly distributed random number in [-1,1]. */
+static real_t getRandom( )
+{
+	return 2.0 * (real_t)rand( ) / (real_t)RAND_MAX - 1.0;
+}
+
+
+/** Sets up QP data of a given tick of the synthetic gait. */
+static void setupTick(	int_t tick, int_t period, int_t nV, int_t nC,
+						const real_t* g0, real_t* g, real_t* lb, real_t* ub,
+						real_t* lbA, real_t* ubA, real_t* p
+						)
+{
+	int_t i;
+	real_t phase = 2.0 * M_PI * (real_t)( tick % period ) / (real_t)period;
+
+	for( i=0; i<nV; ++i )
+	{
+		g[i] = g0[i] + 2.0 * sin( phase + 0.1*(real_t)i ) + 0.05 * getRandom( );
+		lb[i] = -1.0;
+		ub[i] = 1.0;
+	}
+
+	/* constraints of leg k are tight while it is in stance (half of the period, shifted per leg) */
+	for( i=0; i<nC; ++i )
+	{
+		int_t leg = ( i * NLEGS ) / nC;
+		real_t legPhase = fmod( phase + 2.0 * M_PI * (real_t)leg / (real_t)NLEGS,2.0 * M_PI );
+
+		if ( legPhase < M_PI )
+		{
+			lbA[i] = 0.2;
+			ubA[i] = 0.5;
+		}
+		else
+		{
+			lbA[i] = -2.0;
+			ubA[i] = 2.0;
+		}
+	}
+
+	p[0] = cos( phase );
+	p[1] = sin( phase );
+}
+
+
+/** Runs the QP sequence and reports iteration counts and CPU times. */
+static void runSequence(	const char* label, int_t mode,
+							int_t nV, int_t nC, int_t period, int_t nTicks,
+							const real_t* H, const real_t* A, const real_t* g0
+							)
+{
+	int_t tick;
+
+	real_t* g = new real_t[nV];
+	real_t* lb = new real_t[nV];
+	real_t* ub = new real_t[nV];
+	real_t* lbA = new real_t[nC];
+	real_t* ubA = new real_t[nC];
+	real_t p[2];
+
+	Options options;
+	options.setToMPC( );
+	options.printLevel = PL_NONE;
+
+	QProblem qp( nV,nC );
+	qp.setOptions( options );
+
+	ActiveSetPredictor predictor( nV,nC,2,4*period,( mode == 2 ) ? PM_NEARESTNEIGHBOUR : PM_MARKOV );
+
+	/* same random sequence for all runs */
+	srand( 42 );
+
+	int_t nWSR = 1000;
+	setupTick( 0,period,nV,nC,g0,g,lb,ub,lbA,ubA,p );
+	qp.init( H,g,A,lb,ub,lbA,ubA,nWSR );
+	predictor.record( &qp,p );
+
+	int_t nWSRTotal = 0, nFailed = 0;
+	real_t cputimeTotal = 0.0;
+
+	for( tick=1; tick<nTicks; ++tick )
+	{
+		setupTick( tick,period,nV,nC,g0,g,lb,ub,lbA,ubA,p );
+
+		returnValue returnvalue;
+		nWSR = 1000;
+
+		/* timed from outside to include setting up the guessed working set */
+		real_t starttime = getTime( );
+
+		if ( mode == 0 )
+			returnvalue = qp.hotstart( g,lb,ub,lbA,ubA,nWSR );
+		else
+			returnvalue = predictor.hotstart( &qp,g,lb,ub,lbA,ubA,nWSR,0,p );
+
+		real_t cputime = getTime( ) - starttime;
+
+		/* skip the first period in which the predictor is still learning */
+		if ( tick < period )
+			continue;
+
+		if ( returnvalue != SUCCESSFUL_RETURN )
+			++nFailed;
+
+		nWSRTotal += nWSR;
+		cputimeTotal += cputime;
+	}
+
+	int_t nMeasured = nTicks - period;
+	printf( "%-18s nWSR/tick %7.2f  cputime/tick %9.2f [us]  guided %5d  failed %d\n",label,
+			(real_t)nWSRTotal / (real_t)nMeasured,1.0e6 * cputimeTotal / (real_t)nMeasured,
+			(int)predictor.getNumGuided( ),(int)nFailed );
+
+	delete[] ubA; delete[] lbA; delete[] ub; delete[] lb; delete[] g;
+}
+
+
+/** Main program. */
+int main( int argc, char* argv[] )
+{
+	int_t i, j, k;
+
+	int_t nV = ( argc > 1 ) ? atoi( argv[1] ) : 40;
+	int_t nC = ( argc > 2 ) ? atoi( argv[2] ) : 32;
+	int_t period = ( argc > 3 ) ? atoi( argv[3] ) : 20;
+	int_t nTicks = ( argc > 4 ) ? atoi( argv[4] ) : 2000;
+
+	if ( ( nV < 1 ) || ( nC < NLEGS ) || ( period < 2 ) || ( nTicks <= period ) )
+	{
+		fprintf( stderr,"Usage: %s [NV] [NC>=%d] [PERIOD>=2] [NTICKS>PERIOD]\n",argv[0],(int)NLEGS );
+		return 1;
+	}
+
+	/* random positive definite Hessian and constraint matrix */
+	real_t* M = new real_t[nV*nV];
+	real_t* H = new real_t[nV*nV];
+	real_t* A = new real_t[nC*nV];
+	real_t* g0 = new real_t[nV];
+
+	srand( 1 );
+	for( i=0; i<nV*nV; ++i )
+		M[i] = getRandom( );
+
+	for( i=0; i<nV; ++i )
+		for( j=0; j<nV; ++j )
+		{
+			H[i*nV+j] = ( i == j ) ? 1.0 : 0.0;
+			for( k=0; k<nV; ++k )
+				H[i*nV+j] += M[k*nV+i] * M[k*nV+j] / (real_t)nV;
+		}
+
+	for( i=0; i<nC*nV; ++i )
+		A[i] = getRandom( );
+
+	for( i=0; i<nV; ++i )
+		g0[i] = getRandom( );
+
+	printf( "nV %d  nC %d  period %d  ticks %d\n",(int)nV,(int)nC,(int)period,(int)nTicks );
+	runSequence( "hotstart",0,nV,nC,period,nTicks,H,A,g0 );
+	runSequence( "markov",1,nV,nC,period,nTicks,H,A,g0 );
+	runSequence( "nearest neighbour",2,nV,nC,period,nTicks,H,A,g0 );
+
+	delete[] g0; delete[] A; delete[] H; delete[] M;
+
+	return 0;
+}
+
+
+/*
+ *	end of file
+ */
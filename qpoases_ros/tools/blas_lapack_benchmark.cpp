@@ -0,0 +1,265 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tools/blas_lapack_benchmark.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Times the BLAS/LAPACK entry points used by qpOASES (GEMM, POTRF, TRTRS,
+ *	TRCON) for a range of dimensions and reports the residual of each result.
+ *	The executable is built once per backend (replacement loops, Eigen and,
+ *	where available, system BLAS/LAPACK), so that running all of them yields
+ *	the benchmark matrix. The replacement loops are run once per SIMD
+ *	variant supported by the CPU.
+ *
+ *	Usage: blas_lapack_benchmark [MAXN]
+ */
+
+
+#include <qpOASES.hpp>
+
+#include <stdlib.h>
+
+#include "BenchmarkTime.hpp"
+
+
+USING_NAMESPACE_QPOASES
+
+
+#if defined(BENCHMARK_BACKEND_EIGEN)
+static const char* BACKEND = "eigen";
+#elif defined(BENCHMARK_BACKEND_SYSTEM)
+static const char* BACKEND = "system";
+#else
+static const char* BACKEND = "replacement";
+#endif
+
+/** Backend name including the SIMD variant (replacement only). */
+static char backendName[32];
+
+/** Minimum measurement time per operation [s]. */
+static const real_t MIN_DURATION = 0.05;
+
+
+/** Returns uniformly distributed random number in [-1,1]. */
+static real_t getRandom( )
+{
+	return 2.0 * (real_t)rand( ) / (real_t)RAND_MAX - 1.0;
+}
+
+
+/** Prints one entry of the benchmark matrix. */
+static void printEntry( const char* op, int_t n, real_t time, real_t residual, BooleanType available )
+{
+	if ( available == BT_TRUE )
+		printf( "%-20s %-10s %5d %12.3f %12.3e\n",backendName,op,(int)n,1.0e6 * time,residual );
+	else
+		printf( "%-20s %-10s %5d %12s %12s\n",backendName,op,(int)n,"n/a","n/a" );
+}
+
+
+/** Benchmarks all operations for one dimension. */
+static void runDimension( int_t n )
+{
+	int_t i, j, k, nRuns;
+	real_t starttime, time, residual;
+
+	la_uint_t N = (la_uint_t)n, ONE = 1;
+	la_int_t info = 0;
+	real_t alpha = 1.0, beta = 0.0;
+
+	real_t* M = new real_t[n*n];
+	real_t* A = new real_t[n*n];
+	real_t* R = new real_t[n*n];
+	real_t* B = new real_t[n*n];
+	real_t* C = new real_t[n*n];
+	real_t* x = new real_t[n];
+	real_t* b = new real_t[n];
+	real_t* work = new real_t[3*n];
+	la_uint_t* iwork = new la_uint_t[n];
+
+	/* well-conditioned symmetric positive definite matrix */
+	for( i=0; i<n*n; ++i )
+	{
+		M[i] = getRandom( );
+		B[i] = getRandom( );
+	}
+
+	for( i=0; i<n; ++i )
+		for( j=0; j<n; ++j )
+		{
+			A[i+j*n] = ( i == j ) ? (real_t)n : 0.0;
+			for( k=0; k<n; ++k )
+				A[i+j*n] += M[k+i*n] * M[k+j*n] / (real_t)n;
+		}
+
+	/* GEMM as matrix-vector product (as in DenseMatrix::times) */
+	nRuns = 0;
+	starttime = getTime( );
+	do
+	{
+		GEMM( "TRANS","NOTRANS",&N,&ONE,&N,&alpha,A,&N,B,&N,&beta,C,&N );
+		++nRuns;
+	}
+	while ( getTime( ) - starttime < MIN_DURATION );
+	time = ( getTime( ) - starttime ) / (real_t)nRuns;
+
+	residual = 0.0;
+	for( i=0; i<n; ++i )
+	{
+		real_t sum = 0.0;
+		for( k=0; k<n; ++k )
+			sum += A[k+i*n] * B[k];
+		residual = getMax( residual,getAbs( sum - C[i] ) );
+	}
+	printEntry( "GEMV",n,time,residual,BT_TRUE );
+
+	/* GEMM as matrix-matrix product */
+	nRuns = 0;
+	starttime = getTime( );
+	do
+	{
+		GEMM( "NOTRANS","NOTRANS",&N,&N,&N,&alpha,A,&N,B,&N,&beta,C,&N );
+		++nRuns;
+	}
+	while ( getTime( ) - starttime < MIN_DURATION );
+	time = ( getTime( ) - starttime ) / (real_t)nRuns;
+
+	residual = 0.0;
+	for( i=0; i<n; ++i )
+	{
+		real_t sum = 0.0;
+		for( k=0; k<n; ++k )
+			sum += A[i+k*n] * B[k+(n-1)*n];
+		residual = getMax( residual,getAbs( sum - C[i+(n-1)*n] ) );
+	}
+	printEntry( "GEMM",n,time,residual,BT_TRUE );
+
+	/* POTRF (upper Cholesky factor, as in QProblemB::computeCholesky) */
+	nRuns = 0;
+	time = 0.0;
+	do
+	{
+		for( i=0; i<n*n; ++i )
+			R[i] = A[i];
+
+		starttime = getTime( );
+		POTRF( "U",&N,R,&N,&info );
+		time += getTime( ) - starttime;
+		++nRuns;
+	}
+	while ( time < MIN_DURATION );
+	time /= (real_t)nRuns;
+
+	residual = 0.0;
+	for( i=0; i<n; ++i )
+		for( j=i; j<n; ++j )
+		{
+			real_t sum = 0.0;
+			for( k=0; k<=i; ++k )
+				sum += R[k+i*n] * R[k+j*n];
+			residual = getMax( residual,getAbs( sum - A[i+j*n] ) );
+		}
+	printEntry( "POTRF",n,time,( info == 0 ) ? residual : INFTY,BT_TRUE );
+
+	/* TRTRS with the Cholesky factor (as in SQProblemSchur) */
+	nRuns = 0;
+	time = 0.0;
+	do
+	{
+		for( i=0; i<n; ++i )
+			x[i] = B[i];
+
+		starttime = getTime( );
+		TRTRS( "U","N","N",&N,&ONE,R,&N,x,&N,&info );
+		time += getTime( ) - starttime;
+		++nRuns;
+	}
+	while ( time < MIN_DURATION );
+	time /= (real_t)nRuns;
+
+	residual = 0.0;
+	for( i=0; i<n; ++i )
+	{
+		real_t sum = 0.0;
+		for( k=i; k<n; ++k )
+			sum += R[i+k*n] * x[k];
+		residual = getMax( residual,getAbs( sum - B[i] ) );
+	}
+	printEntry( "TRTRS",n,time,residual,( info == 0 ) ? BT_TRUE : BT_FALSE );
+
+	/* TRCON of the Cholesky factor (as in SQProblemSchur), reported
+	 * residual is the reciprocal condition number itself */
+	real_t rcond = 0.0;
+	nRuns = 0;
+	starttime = getTime( );
+	do
+	{
+		TRCON( "1","U","N",&N,R,&N,&rcond,work,iwork,&info );
+		++nRuns;
+	}
+	while ( getTime( ) - starttime < MIN_DURATION );
+	time = ( getTime( ) - starttime ) / (real_t)nRuns;
+
+	printEntry( "TRCON",n,time,rcond,( info == 0 ) ? BT_TRUE : BT_FALSE );
+
+	delete[] iwork; delete[] work; delete[] b; delete[] x;
+	delete[] C; delete[] B; delete[] R; delete[] A; delete[] M;
+}
+
+
+/** Main program. */
+int main( int argc, char* argv[] )
+{
+	int_t n;
+	int_t maxN = ( argc > 1 ) ? atoi( argv[1] ) : 256;
+
+	srand( 1 );
+
+	printf( "%-20s %-10s %5s %12s %12s\n","backend","operation","n","time [us]","residual" );
+
+	#if defined(BENCHMARK_BACKEND_REPLACEMENT)
+	int_t variant;
+	for( variant=SV_SCALAR; variant<=getSupportedSimdVariant( ); ++variant )
+	{
+		setSimdVariant( (SimdVariant)variant );
+		snprintf( backendName,32,"%s/%s",BACKEND,getSimdVariantName( (SimdVariant)variant ) );
+		srand( 1 );
+		for( n=8; n<=maxN; n*=2 )
+			runDimension( n );
+	}
+	#else
+	snprintf( backendName,32,"%s",BACKEND );
+	for( n=8; n<=maxN; n*=2 )
+		runDimension( n );
+	#endif
+
+	return 0;
+}
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,247 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/**
+ *	\file tools/flipper_benchmark.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Benchmarks the flipping bounds strategy: hotstarts on a semidefinite QP
+ *	sequence in which many bounds flip, followed by timings of saving and
+ *	restoring the factorisations in the Flipper with only the active leading
+ *	blocks compared to copying the full matrices R, Q and T.
+ *
+ *	Usage: flipper_benchmark [NV] [NC] [NTICKS]
+ */
+
+
+#include <qpOASES.hpp>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "BenchmarkTime.hpp"
+
+
+USING_NAMESPACE_QPOASES
+
+
+/** Minimum measurement time per operation [s]. */
+static const real_t MIN_DURATION = 0.1;
+
+
+/** Returns uniformly distributed random number in [-1,1]. */
+static real_t getRandom( )
+{
+	return 2.0 * (real_t)rand( ) / (real_t)RAND_MAX - 1.0;
+}
+
+
+/** Runs hotstarts with flipping bounds on a semidefinite QP sequence. */
+static void runHotstarts( int_t nV, int_t nC, int_t nTicks, const real_t* H, const real_t* A )
+{
+	int_t i, tick;
+
+	real_t* g = new real_t[nV];
+	real_t* lb = new real_t[nV];
+	real_t* ub = new real_t[nV];
+	real_t* lbA = new real_t[nC];
+	real_t* ubA = new real_t[nC];
+
+	for( i=0; i<nV; ++i )
+	{
+		g[i] = getRandom( );
+		lb[i] = -0.5;
+		ub[i] = 0.5;
+	}
+	for( i=0; i<nC; ++i )
+	{
+		lbA[i] = -1.0;
+		ubA[i] = 1.0;
+	}
+
+	/* without regularisation, zero curvature directions are resolved by flips */
+	Options options;
+	options.setToDefault( );
+	options.printLevel = PL_NONE;
+	options.enableFlippingBounds = BT_TRUE;
+	options.enableRegularisation = BT_FALSE;
+
+	QProblem qp( nV,nC );
+	qp.setOptions( options );
+
+	int_t nWSR = 10000;
+	qp.init( H,g,A,lb,ub,lbA,ubA,nWSR );
+	qp.resetStatistics( );
+
+	int_t nWSRTotal = 0, nFailed = 0;
+	real_t cputimeTotal = 0.0;
+
+	for( tick=0; tick<nTicks; ++tick )
+	{
+		/* small gradient changes move the solution along zero curvature
+		 * directions, so that bounds flip instead of being removed */
+		for( i=0; i<nV; ++i )
+			g[i] = 0.3 * getRandom( );
+
+		nWSR = 10000;
+		real_t starttime = getTime( );
+		if ( qp.hotstart( g,lb,ub,lbA,ubA,nWSR ) != SUCCESSFUL_RETURN )
+			++nFailed;
+
+		nWSRTotal += nWSR;
+		cputimeTotal += getTime( ) - starttime;
+	}
+
+	printf( "hotstart: nWSR/tick %7.2f  flips/tick %7.2f  cputime/tick %9.2f [us]  failed %d\n",
+			(real_t)nWSRTotal / (real_t)nTicks,(real_t)qp.getStatistics( ).nFlips / (real_t)nTicks,
+			1.0e6 * cputimeTotal / (real_t)nTicks,(int)nFailed );
+
+	delete[] ubA; delete[] lbA; delete[] ub; delete[] lb; delete[] g;
+}
+
+
+/** Times one save and restore of the factorisations with nFR free
+ *  variables and nAC active constraints. */
+static void runFlipper( int_t nV, int_t nC, int_t nFR, int_t nAC )
+{
+	int_t i, nRuns;
+	real_t starttime, time, timeFull;
+
+	int_t sizeT = ( nV < nC ) ? nV : nC;
+	real_t* R = new real_t[nV*nV];
+	real_t* Q = new real_t[nV*nV];
+	real_t* T = new real_t[sizeT*sizeT];
+	real_t* Rsaved = new real_t[nV*nV];
+	real_t* Qsaved = new real_t[nV*nV];
+	real_t* Tsaved = new real_t[sizeT*sizeT];
+
+	for( i=0; i<nV*nV; ++i )
+	{
+		R[i] = getRandom( );
+		Q[i] = getRandom( );
+	}
+	for( i=0; i<sizeT*sizeT; ++i )
+		T[i] = getRandom( );
+
+	Bounds bounds( nV );
+	bounds.setupAllFree( );
+	for( i=nFR; i<nV; ++i )
+		bounds.moveFreeToFixed( i,ST_LOWER );
+
+	Constraints constraints( nC );
+	constraints.setupAllInactive( );
+	for( i=0; i<nAC; ++i )
+		constraints.moveInactiveToActive( i,ST_LOWER );
+
+	Flipper flipper( nV,nC );
+
+	/* active leading blocks, as saved and restored by the Flipper */
+	nRuns = 0;
+	starttime = getTime( );
+	do
+	{
+		flipper.set( &bounds,R,&constraints,Q,T );
+		flipper.get( &bounds,R,&constraints,Q,T );
+		++nRuns;
+	}
+	while ( getTime( ) - starttime < MIN_DURATION );
+	time = ( getTime( ) - starttime ) / (real_t)nRuns;
+
+	/* full matrices, as saved and restored before */
+	nRuns = 0;
+	starttime = getTime( );
+	do
+	{
+		flipper.set( &bounds,0,&constraints );
+		memcpy( Rsaved,R,nV*nV*sizeof(real_t) );
+		memcpy( Qsaved,Q,nV*nV*sizeof(real_t) );
+		memcpy( Tsaved,T,sizeT*sizeT*sizeof(real_t) );
+		flipper.get( &bounds,0,&constraints );
+		memcpy( R,Rsaved,nV*nV*sizeof(real_t) );
+		memcpy( Q,Qsaved,nV*nV*sizeof(real_t) );
+		memcpy( T,Tsaved,sizeT*sizeT*sizeof(real_t) );
+		++nRuns;
+	}
+	while ( getTime( ) - starttime < MIN_DURATION );
+	timeFull = ( getTime( ) - starttime ) / (real_t)nRuns;
+
+	printf( "set+get nFR %4d nAC %4d: active blocks %9.2f [us]  full matrices %9.2f [us]  speedup %5.2f\n",
+			(int)nFR,(int)nAC,1.0e6 * time,1.0e6 * timeFull,timeFull / time );
+
+	delete[] Tsaved; delete[] Qsaved; delete[] Rsaved;
+	delete[] T; delete[] Q; delete[] R;
+}
+
+
+/** Main program. */
+int main( int argc, char* argv[] )
+{
+	int_t i, j, k;
+
+	int_t nV = ( argc > 1 ) ? atoi( argv[1] ) : 60;
+	int_t nC = ( argc > 2 ) ? atoi( argv[2] ) : 30;
+	int_t nTicks = ( argc > 3 ) ? atoi( argv[3] ) : 50;
+
+	if ( ( nV < 1 ) || ( nC < 1 ) || ( nTicks < 1 ) )
+	{
+		fprintf( stderr,"Usage: %s [NV] [NC] [NTICKS]\n",argv[0] );
+		return 1;
+	}
+
+	/* random semidefinite Hessian of rank nV/6 and constraint matrix */
+	int_t rank = ( nV >= 6 ) ? nV/6 : 1;
+	real_t* M = new real_t[rank*nV];
+	real_t* H = new real_t[nV*nV];
+	real_t* A = new real_t[nC*nV];
+
+	srand( 1 );
+	for( i=0; i<rank*nV; ++i )
+		M[i] = getRandom( );
+
+	for( i=0; i<nV; ++i )
+		for( j=0; j<nV; ++j )
+		{
+			H[i*nV+j] = 0.0;
+			for( k=0; k<rank; ++k )
+				H[i*nV+j] += M[k*nV+i] * M[k*nV+j];
+		}
+
+	for( i=0; i<nC*nV; ++i )
+		A[i] = getRandom( );
+
+	printf( "nV %d  nC %d  ticks %d\n",(int)nV,(int)nC,(int)nTicks );
+	runHotstarts( nV,nC,nTicks,H,A );
+
+	for( i=1; i<=4; ++i )
+		runFlipper( nV,nC,( i*nV )/4,( ( 4-i )*( ( nV < nC ) ? nV : nC ) )/4 );
+
+	delete[] A; delete[] H; delete[] M;
+
+	return 0;
+}
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,167 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tools/solver_benchmark.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Measures the round-trip latency of a solver server (see solver_server.cpp)
+ *	and compares it to solving the same sequence of QPs in-process.
+ *
+ *	Usage: solver_benchmark NAME CHANNEL [NRUNS]
+ *	(the server channel determines the problem dimensions).
+ */
+
+
+#include <qpOASES.hpp>
+
+#include <algorithm>
+#include <stdlib.h>
+#include <vector>
+
+#include "BenchmarkTime.hpp"
+
+
+USING_NAMESPACE_QPOASES
+
+
+/** Prints latency statistics of given samples. */
+static void printStatistics( const char* label, std::vector<real_t>& samples )
+{
+	std::sort( samples.begin( ),samples.end( ) );
+
+	uint_t n = (uint_t)samples.size( );
+	printf( "%-10s min %9.2f  median %9.2f  p99 %9.2f  max %9.2f [us]\n",label,
+			samples[0],samples[n/2],samples[(99*n)/100],samples[n-1] );
+}
+
+
+/** Main program. */
+int main( int argc, char* argv[] )
+{
+	uint_t i, j, k;
+
+	if ( argc < 3 )
+	{
+		fprintf( stderr,"Usage: %s NAME CHANNEL [NRUNS]\n",argv[0] );
+		return 1;
+	}
+
+	uint_t nRuns = ( argc > 3 ) ? (uint_t)atoi( argv[3] ) : 1000;
+	if ( nRuns == 0 )
+		nRuns = 1;
+
+	SolverClient client;
+	if ( client.attach( argv[1],(uint_t)atoi( argv[2] ) ) != SUCCESSFUL_RETURN )
+		return 1;
+
+	uint_t nV = client.getNV( );
+	uint_t nC = client.getNC( );
+
+	/* random strictly convex QP with box and general constraints */
+	std::vector<real_t> M( nV*nV ), H( nV*nV ), A( nC*nV+1 ), g( nV );
+	std::vector<real_t> lb( nV,-1.0 ), ub( nV,1.0 ), lbA( nC+1,-1.0 ), ubA( nC+1,1.0 );
+
+	srand( 42 );
+	for( i=0; i<nV*nV; ++i )
+		M[i] = (real_t)rand( ) / (real_t)RAND_MAX - 0.5;
+	for( i=0; i<nC*nV; ++i )
+		A[i] = (real_t)rand( ) / (real_t)RAND_MAX - 0.5;
+
+	for( i=0; i<nV; ++i )
+		for( j=0; j<nV; ++j )
+		{
+			H[i*nV+j] = ( i == j ) ? 1.0 : 0.0;
+			for( k=0; k<nV; ++k )
+				H[i*nV+j] += M[k*nV+i] * M[k*nV+j];
+		}
+
+	Options options;
+	options.printLevel = PL_NONE;
+
+	SQProblem local( (int_t)nV,(int_t)nC );
+	local.setOptions( options );
+
+	std::vector<real_t> xLocal( nV );
+	std::vector<real_t> remoteTimes, localTimes;
+	real_t maxDeviation = 0.0;
+	real_t t;
+
+	for( k=0; k<=nRuns; ++k )
+	{
+		for( i=0; i<nV; ++i )
+			g[i] = (real_t)rand( ) / (real_t)RAND_MAX * 10.0 - 5.0;
+
+		int_t nWSR = 1000;
+		int_t nWSRlocal = 1000;
+		returnValue returnvalue;
+
+		t = getTime( );
+		if ( k == 0 )
+			returnvalue = client.init( &H[0],&g[0],&A[0],&lb[0],&ub[0],&lbA[0],&ubA[0],nWSR );
+		else
+			returnvalue = client.hotstart( &g[0],&lb[0],&ub[0],&lbA[0],&ubA[0],nWSR );
+		remoteTimes.push_back( 1.0e6 * ( getTime( ) - t ) );
+
+		t = getTime( );
+		if ( k == 0 )
+			local.init( &H[0],&g[0],&A[0],&lb[0],&ub[0],&lbA[0],&ubA[0],nWSRlocal );
+		else
+			local.hotstart( &g[0],&lb[0],&ub[0],&lbA[0],&ubA[0],nWSRlocal );
+		localTimes.push_back( 1.0e6 * ( getTime( ) - t ) );
+
+		if ( returnvalue != SUCCESSFUL_RETURN )
+		{
+			fprintf( stderr,"Request %d failed\n",(int)k );
+			return 1;
+		}
+
+		local.getPrimalSolution( &xLocal[0] );
+		for( i=0; i<nV; ++i )
+			maxDeviation = getMax( maxDeviation,getAbs( client.getPrimalSolution( )[i] - xLocal[i] ) );
+	}
+
+	/* exclude cold start */
+	remoteTimes.erase( remoteTimes.begin( ) );
+	localTimes.erase( localTimes.begin( ) );
+
+	/* round-trip overhead of each request (same QP solved on both sides) */
+	std::vector<real_t> overhead( nRuns );
+	for( k=0; k<nRuns; ++k )
+		overhead[k] = remoteTimes[k] - localTimes[k];
+
+	printf( "%d hotstarts, nV = %d, nC = %d\n",(int)nRuns,(int)nV,(int)nC );
+	printStatistics( "server",remoteTimes );
+	printStatistics( "local",localTimes );
+	printStatistics( "overhead",overhead );
+	printf( "max. deviation of solutions: %e\n",maxDeviation );
+
+	return 0;
+}
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,108 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/**
+ *	\file tools/solver_server.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Solver server which owns a set of SQProblem instances and serves
+ *	requests of other processes via POSIX shared memory.
+ *
+ *	Usage: solver_server NAME CORE NSLOTS nV1 nC1 [nV2 nC2 ...]
+ *	(pass a negative CORE to skip pinning).
+ */
+
+
+#include <qpOASES.hpp>
+
+#include <signal.h>
+#include <stdlib.h>
+
+
+USING_NAMESPACE_QPOASES
+
+
+/** Server instance, stopped by signal handler. */
+static SolverServer server;
+
+
+/** Requests the server to shut down. */
+static void handleSignal( int )
+{
+	server.requestShutdown( );
+}
+
+
+/** Main program. */
+int main( int argc, char* argv[] )
+{
+	uint_t i;
+
+	if ( ( argc < 6 ) || ( ( argc-4 ) % 2 != 0 ) )
+	{
+		fprintf( stderr,"Usage: %s NAME CORE NSLOTS nV1 nC1 [nV2 nC2 ...]\n",argv[0] );
+		return 1;
+	}
+
+	const char* name = argv[1];
+	int_t core = atoi( argv[2] );
+	uint_t nSlots = (uint_t)atoi( argv[3] );
+	uint_t nChannels = (uint_t)( argc-4 ) / 2;
+
+	uint_t* nV = new uint_t[nChannels];
+	uint_t* nC = new uint_t[nChannels];
+
+	for( i=0; i<nChannels; ++i )
+	{
+		nV[i] = (uint_t)atoi( argv[4+2*i] );
+		nC[i] = (uint_t)atoi( argv[5+2*i] );
+	}
+
+	returnValue returnvalue = server.init( name,nChannels,nV,nC,nSlots );
+
+	delete[] nC;
+	delete[] nV;
+
+	if ( returnvalue != SUCCESSFUL_RETURN )
+		return 1;
+
+	if ( ( core >= 0 ) && ( server.pinToCore( core ) != SUCCESSFUL_RETURN ) )
+		fprintf( stderr,"Warning: could not pin server to core %d\n",(int)core );
+
+	signal( SIGINT,handleSignal );
+	signal( SIGTERM,handleSignal );
+
+	printf( "Serving %d channel(s) on %s\n",(int)nChannels,name );
+	fflush( stdout );
+
+	server.run( );
+
+	return 0;
+}
+
+
+/*
+ *	end of file
+ */
@@ -0,0 +1,262 @@
+/*
+ *	This file is part of qpOASES.
+ *
+ *	qpOASES -- An Implementation of the Online Active Set Strategy.
+ *	Copyright (C) 2007-2017 by Hans Joachim Ferreau, Andreas Potschka,
+ *	Christian Kirches et al. All rights reserved.
+ *
+ *	qpOASES is free software; you can redistribute it and/or
+ *	modify it under the terms of the GNU Lesser General Public
+ *	License as published by the Free Software Foundation; either
+ *	version 2.1 of the License, or (at your option) any later version.
+ *
+ *	qpOASES is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *	See the GNU Lesser General Public License for more details.
+ *
+ *	You should have received a copy of the GNU Lesser General Public
+ *	License along with qpOASES; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/**
+ *	\file tools/working_set_benchmark.cpp
+ *	\version 3.2
+ *	\date 2018
+ *
+ *	Benchmarks the working set bookkeeping: hotstarts on a QP sequence whose
+ *	gradient jumps each tick (many bounds and constraints enter and leave the
+ *	working set), followed by timings of the individual operations, i.e.
+ *	adding/removing constraints, index lookups, snapshots as taken by the
+ *	Flipper and the compact WorkingSet used by working set caches.
+ *
+ *	Usage: working_set_benchmark [NV] [NC] [NTICKS]
+ */
+
+
+#include <qpOASES.hpp>
+
+#include <stdlib.h>
+
+#include "BenchmarkTime.hpp"
+
+
+USING_NAMESPACE_QPOASES
+
+
+/** Minimum measurement time per operation [s]. */
+static const real_t MIN_DURATION = 0.1;
+
+
+/** Returns uniformly distributed random number in [-1,1]. */
+static real_t getRandom( )
+{
+	return 2.0 * (real_t)rand( ) / (real_t)RAND_MAX - 1.0;
+}
+
+
+/** Prints timing of one operation. */
+static void printTiming( const char* op, int_t nRuns, int_t nOps, real_t time )
+{
+	printf( "%-28s %10.1f [ns/op]\n",op,1.0e9 * time / ( (real_t)nRuns * (real_t)nOps ) );
+}
+
+
+/** Runs hotstarts on a QP sequence with large gradient jumps. */
+static void runHotstarts( int_t nV, int_t nC, int_t nTicks, const real_t* H, const real_t* A )
+{
+	int_t i, tick;
+
+	real_t* g = new real_t[nV];
+	real_t* lb = new real_t[nV];
+	real_t* ub = new real_t[nV];
+	real_t* lbA = new real_t[nC];
+	real_t* ubA = new real_t[nC];
+
+	for( i=0; i<nV; ++i )
+	{
+		g[i] = getRandom( );
+		lb[i] = -0.5;
+		ub[i] = 0.5;
+	}
+	for( i=0; i<nC; ++i )
+	{
+		lbA[i] = -1.0;
+		ubA[i] = 1.0;
+	}
+
+	Options options;
+	options.setToMPC( );
+	options.printLevel = PL_NONE;
+
+	QProblem qp( nV,nC );
+	qp.setOptions( options );
+
+	int_t nWSR = 10000;
+	qp.init( H,g,A,lb,ub,lbA,ubA,nWSR );
+
+	int_t nWSRTotal = 0, nFailed = 0;
+	real_t cputimeTotal = 0.0;
+
+	for( tick=0; tick<nTicks; ++tick )
+	{
+		/* gradient jumps by its own magnitude, so that the working set changes a lot */
+		for( i=0; i<nV; ++i )
+			g[i] = 10.0 * getRandom( );
+
+		nWSR = 10000;
+		real_t starttime = getTime( );
+		if ( qp.hotstart( g,lb,ub,lbA,ubA,nWSR ) != SUCCESSFUL_RETURN )
+			++nFailed;
+
+		nWSRTotal += nWSR;
+		cputimeTotal += getTime( ) - starttime;
+	}
+
+	printf( "hotstart: nWSR/tick %7.2f  cputime/tick %9.2f [us]  cputime/nWSR %7.2f [us]  failed %d\n",
+			(real_t)nWSRTotal / (real_t)nTicks,1.0e6 * cputimeTotal / (real_t)nTicks,
+			1.0e6 * cputimeTotal / (real_t)( nWSRTotal > 0 ? nWSRTotal : 1 ),(int)nFailed );
+
+	delete[] ubA; delete[] lbA; delete[] ub; delete[] lb; delete[] g;
+}
+
+
+/** Times the individual working set operations on nC constraints. */
+static void runOperations( int_t nC )
+{
+	int_t i, nRuns;
+	real_t starttime, time;
+
+	int_t* order = new int_t[nC];
+	for( i=0; i<nC; ++i )
+		order[i] = i;
+	for( i=nC-1; i>0; --i )
+	{
+		int_t j = rand( ) % ( i+1 );
+		int_t tmp = order[i]; order[i] = order[j]; order[j] = tmp;
+	}
+
+	Constraints constraints( nC );
+	for( i=0; i<nC; ++i )
+		constraints.setType( i,ST_BOUNDED );
+	constraints.setupAllInactive( );
+
+	/* activate all constraints and deactivate them again, both in random order */
+	nRuns = 0;
+	starttime = getTime( );
+	do
+	{
+		for( i=0; i<nC; ++i )
+			constraints.moveInactiveToActive( order[i],( i%2 == 0 ) ? ST_LOWER : ST_UPPER );
+		for( i=nC-1; i>=0; --i )
+			constraints.moveActiveToInactive( order[(i*7)%nC] );
+		++nRuns;
+	}
+	while ( getTime( ) - starttime < MIN_DURATION );
+	time = getTime( ) - starttime;
+	printTiming( "add + remove constraint",nRuns,nC,time );
+
+	/* index lookups in a half-full list of active constraints */
+	for( i=0; i<nC/2; ++i )
+		constraints.moveInactiveToActive( order[i],ST_LOWER );
+
+	int_t checksum = 0;
+	nRuns = 0;
+	starttime = getTime( );
+	do
+	{
+		for( i=0; i<nC; ++i )
+			checksum += constraints.getActive( )->getIndex( i );
+		++nRuns;
+	}
+	while ( getTime( ) - starttime < MIN_DURATION );
+	time = getTime( ) - starttime;
+	printTiming( "getIndex",nRuns,nC,time );
+
+	/* snapshots as taken by the Flipper before each working set change */
+	Constraints snapshot( constraints );
+	nRuns = 0;
+	starttime = getTime( );
+	do
+	{
+		snapshot = constraints;
+		++nRuns;
+	}
+	while ( getTime( ) - starttime < MIN_DURATION );
+	time = getTime( ) - starttime;
+	printTiming( "snapshot (full copy)",nRuns,1,time );
+
+	/* compact snapshot, hash and comparison as done by working set caches */
+	Bounds bounds( 0 );
+	WorkingSet workingSet( 0,nC ), cached( 0,nC );
+	cached.set( &bounds,&constraints );
+
+	nRuns = 0;
+	starttime = getTime( );
+	do
+	{
+		workingSet.set( &bounds,&constraints );
+		checksum += (int_t)( workingSet.getHash( ) & 1 );
+		checksum += ( workingSet.isEqual( cached ) == BT_TRUE ) ? 1 : 0;
+		++nRuns;
+	}
+	while ( getTime( ) - starttime < MIN_DURATION );
+	time = getTime( ) - starttime;
+	printTiming( "WorkingSet set+hash+compare",nRuns,1,time );
+
+	printf( "(checksum %d)\n",(int)checksum );
+
+	delete[] order;
+}
+
+
+/** Main program. */
+int main( int argc, char* argv[] )
+{
+	int_t i, j, k;
+
+	int_t nV = ( argc > 1 ) ? atoi( argv[1] ) : 60;
+	int_t nC = ( argc > 2 ) ? atoi( argv[2] ) : 120;
+	int_t nTicks = ( argc > 3 ) ? atoi( argv[3] ) : 200;
+
+	if ( ( nV < 1 ) || ( nC < 1 ) || ( nTicks < 1 ) )
+	{
+		fprintf( stderr,"Usage: %s [NV] [NC] [NTICKS]\n",argv[0] );
+		return 1;
+	}
+
+	/* random positive definite Hessian and constraint matrix */
+	real_t* M = new real_t[nV*nV];
+	real_t* H = new real_t[nV*nV];
+	real_t* A = new real_t[nC*nV];
+
+	srand( 1 );
+	for( i=0; i<nV*nV; ++i )
+		M[i] = getRandom( );
+
+	for( i=0; i<nV; ++i )
+		for( j=0; j<nV; ++j )
+		{
+			H[i*nV+j] = ( i == j ) ? 0.1 : 0.0;
+			for( k=0; k<nV; ++k )
+				H[i*nV+j] += M[k*nV+i] * M[k*nV+j] / (real_t)nV;
+		}
+
+	for( i=0; i<nC*nV; ++i )
+		A[i] = getRandom( );
+
+	printf( "nV %d  nC %d  ticks %d\n",(int)nV,(int)nC,(int)nTicks );
+	runHotstarts( nV,nC,nTicks,H,A );
+	runOperations( nC );
+
+	delete[] A; delete[] H; delete[] M;
+
+	return 0;
+}
+
+
+/*
+ *	end of file
+ */
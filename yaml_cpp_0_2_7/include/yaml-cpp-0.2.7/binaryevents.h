@@ -0,0 +1,93 @@
+# ifndef BINARYEVENTS_H_62B23520_7C8E_11DE_8A39_0800200C9A66_0_2_7 
+# define BINARYEVENTS_H_62B23520_7C8E_11DE_8A39_0800200C9A66_0_2_7 
+
+#if defined(_MSC_VER) || (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || (__GNUC__ >= 4)) // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+#include "yaml-cpp-0.2.7/dll.h"
+#include "yaml-cpp-0.2.7/eventhandler.h"
+#include "yaml-cpp-0.2.7/mark.h"
+#include "yaml-cpp-0.2.7/noncopyable.h"
+#include "yaml-cpp-0.2.7/nodestorage.h"
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace YAML_0_2_7
+{
+	class Node;
+	
+	// BinaryEventWriter
+	// . Records the events of one or more documents in a compact binary form, which a
+	//   BinaryEventReader replays much faster than the original text can be parsed.
+	// . The recording is appended to 'out'; it's not portable across versions of this format.
+	class YAML_CPP_API BinaryEventWriter: public EventHandler
+	{
+	public:
+		explicit BinaryEventWriter(std::string& out);
+		
+		virtual void OnDocumentStart(const Mark& mark);
+		virtual void OnDocumentEnd();
+		
+		virtual void OnNull(const Mark& mark, anchor_t anchor);
+		virtual void OnAlias(const Mark& mark, anchor_t anchor);
+		virtual void OnScalar(const Mark& mark, const std::string& tag, anchor_t anchor, const std::string& value);
+		
+		virtual void OnSequenceStart(const Mark& mark, const std::string& tag, anchor_t anchor);
+		virtual void OnSequenceEnd();
+		
+		virtual void OnMapStart(const Mark& mark, const std::string& tag, anchor_t anchor);
+		virtual void OnMapEnd();
+		
+	private:
+		void WriteNumber(std::size_t n);
+		void WriteOffset(int delta);
+		void WriteMark(const Mark& mark);
+		void WriteString(const std::string& str);
+		void WriteTag(const std::string& tag);
+		
+	private:
+		std::string& m_out;
+		Mark m_lastMark;
+		std::map<std::string, std::size_t> m_tags;
+	};
+	
+	// BinaryEventReader
+	// . Replays a recording of a BinaryEventWriter, one document at a time, just like a Parser.
+	// . The buffer must stay valid as long as the reader is used.
+	// . Throws a ParserException if the recording is malformed (e.g., truncated).
+	class YAML_CPP_API BinaryEventReader: private noncopyable
+	{
+	public:
+		BinaryEventReader(const char *data, std::size_t size);
+		
+		operator bool() const;
+		
+		bool HandleNextDocument(EventHandler& eventHandler);
+		bool GetNextDocument(Node& document);
+		bool GetNextDocument(Node& document, NodeStorage::value storage);
+		
+	private:
+		unsigned char ReadByte();
+		std::size_t ReadNumber();
+		int ReadOffset();
+		const Mark& ReadMark();
+		const std::string& ReadString();
+		const std::string& ReadTag();
+		anchor_t ReadAnchor(bool isAlias);
+		void ThrowInvalid() const;
+		
+	private:
+		const char *m_pCurrent;
+		const char *m_pEnd;
+		
+		Mark m_mark;
+		std::vector<std::string> m_tags;
+		std::string m_value;
+		anchor_t m_anchorCount;
+	};
+}
+
+# endif // BINARYEVENTS_H_62B23520_7C8E_11DE_8A39_0800200C9A66_0_2_7 
@@ -6,6 +6,7 @@
 #endif
 
 
+#include "yaml-cpp-0.2.7/dll.h"
 #include "yaml-cpp-0.2.7/null.h"
 #include "yaml-cpp-0.2.7/traits.h"
 #include <limits>
@@ -35,8 +36,66 @@ namespace YAML_0_2_7
 	}
 
 
+	// ConvertDecimal
+	// . Allocation-free fast path for plain decimal numbers (no whitespace, no trailing characters,
+	//   no octal or hex integers); gives the same result as the std::stringstream conversion below.
+	// . Returns false for anything else (or for other types), in which case the stream is used.
+	template <typename T>
+	inline bool ConvertDecimal(const std::string& /*input*/, T& /*output*/) {
+		return false;
+	}
+	
+	template <typename T>
+	inline bool ConvertInteger(const std::string& input, T& output) {
+		const char *p = input.c_str(), *end = p + input.size();
+		bool negative = false;
+		if(p != end && (*p == '+' || *p == '-'))
+			negative = (*p++ == '-');
+		
+		// a leading zero makes the stream read an octal number
+		if(p == end || (*p == '0' && p + 1 != end))
+			return false;
+		if(negative && !std::numeric_limits<T>::is_signed)
+			return false;
+		
+		T value = 0;
+		for(;p!=end;++p) {
+			if(*p < '0' || *p > '9')
+				return false;
+			const T digit = static_cast<T>(*p - '0');
+			if(negative) {
+				if(value < (std::numeric_limits<T>::min() + digit) / 10)
+					return false;
+				value = static_cast<T>(value * 10 - digit);
+			} else {
+				if(value > (std::numeric_limits<T>::max() - digit) / 10)
+					return false;
+				value = static_cast<T>(value * 10 + digit);
+			}
+		}
+		
+		output = value;
+		return true;
+	}
+	
+	inline bool ConvertDecimal(const std::string& input, short& output) { return ConvertInteger(input, output); }
+	inline bool ConvertDecimal(const std::string& input, unsigned short& output) { return ConvertInteger(input, output); }
+	inline bool ConvertDecimal(const std::string& input, int& output) { return ConvertInteger(input, output); }
+	inline bool ConvertDecimal(const std::string& input, unsigned int& output) { return ConvertInteger(input, output); }
+	inline bool ConvertDecimal(const std::string& input, long& output) { return ConvertInteger(input, output); }
+	inline bool ConvertDecimal(const std::string& input, unsigned long& output) { return ConvertInteger(input, output); }
+#if !defined(_MSC_VER) || (_MSC_VER >= 1310)
+	inline bool ConvertDecimal(const std::string& input, long long& output) { return ConvertInteger(input, output); }
+	inline bool ConvertDecimal(const std::string& input, unsigned long long& output) { return ConvertInteger(input, output); }
+#endif
+	YAML_CPP_API bool ConvertDecimal(const std::string& input, float& output);
+	YAML_CPP_API bool ConvertDecimal(const std::string& input, double& output);
+
 	template <typename T> 
 	inline bool Convert(const std::string& input, T& output, typename enable_if<is_numeric<T> >::type * = 0) {
+		if(ConvertDecimal(input, output))
+			return true;
+		
 		std::stringstream stream(input);
 		stream.unsetf(std::ios::dec);
 		stream >> output;
@@ -11,6 +11,7 @@
 #include "yaml-cpp-0.2.7/ostream.h"
 #include "yaml-cpp-0.2.7/noncopyable.h"
 #include "yaml-cpp-0.2.7/null.h"
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <sstream>
@@ -63,12 +64,21 @@ namespace YAML_0_2_7
 		
 		template <typename T>
 		Emitter& WriteStreamable(T value);
+		
+		// bulk flow sequences of numbers (every 'stride'th value), as Flow << BeginSeq << ... << EndSeq
+		// would write them, except that floating point values get the fewest digits that read back exactly
+		Emitter& WriteFlowSeq(const double *values, std::size_t size, std::size_t stride = 1);
+		Emitter& WriteFlowSeq(const float *values, std::size_t size, std::size_t stride = 1);
+		Emitter& WriteFlowSeq(const int *values, std::size_t size, std::size_t stride = 1);
 
 	private:
 		void PreWriteIntegralType(std::stringstream& str);
 		void PreWriteStreamable(std::stringstream& str);
 		void PostWriteIntegralType(const std::stringstream& str);
 		void PostWriteStreamable(const std::stringstream& str);
+		
+		template <typename T>
+		Emitter& WriteNumbers(const T *values, std::size_t size, std::size_t stride);
 	
 	private:
 		void PreAtomicWrite();
@@ -70,6 +70,7 @@ namespace YAML_0_2_7
 		const char * const EXPECTED_VALUE_TOKEN   = "expected value token";
 		const char * const UNEXPECTED_KEY_TOKEN   = "unexpected key token";
 		const char * const UNEXPECTED_VALUE_TOKEN = "unexpected value token";
+		const char * const INVALID_BINARY_EVENTS  = "invalid binary event recording";
 
 		template <typename T>
 		inline const std::string KEY_NOT_FOUND_WITH_KEY(const T&, typename disable_if<is_numeric<T> >::type * = 0) {
@@ -23,6 +23,7 @@ namespace YAML_0_2_7
 {
 	class AliasManager;
 	class Content;
+	class KeyIndex;
 	class NodeOwnership;
 	class Scanner;
 	class Emitter;
@@ -82,7 +83,7 @@ namespace YAML_0_2_7
 		const Node& operator [] (char *key) const;
 
 		// for tags
-		const std::string& Tag() const { return m_tag; }
+		const std::string& Tag() const { return m_pTag ? *m_pTag : m_tag; }
 
 		// emitting
 		friend YAML_CPP_API Emitter& operator << (Emitter& out, const Node& node);
@@ -92,7 +93,7 @@ namespace YAML_0_2_7
 		friend bool operator < (const Node& n1, const Node& n2);
 
 	private:
-		explicit Node(NodeOwnership& owner);
+		explicit Node(NodeOwnership& document);
 		Node& CreateNode();
 		
 		void Init(NodeType::value type, const Mark& mark, const std::string& tag);
@@ -101,6 +102,15 @@ namespace YAML_0_2_7
 		void SetScalarData(const std::string& data);
 		void Append(Node& node);
 		void Insert(Node& key, Node& value);
+		void IndexKeys();
+		
+		// for documents built in an arena (see NodeStorage)
+		void UseArena();
+		bool IsCompact() const { return m_pDocument != 0; }
+		void SetChildren(Node * const *pChildren, std::size_t count);
+		
+		const char *ScalarData() const { return m_pDocument ? m_pScalar : m_scalarData.data(); }
+		std::size_t ScalarSize() const { return m_pDocument ? m_scalarSize : m_scalarData.size(); }
 
 		// helper for sequences
 		template <typename, bool> friend struct _FindFromNodeAtIndex;
@@ -112,6 +122,10 @@ namespace YAML_0_2_7
 
 		template <typename T>
 		const Node *FindValueForKey(const T& key) const;
+		
+		// string keys are matched against the scalar data directly (through m_pKeyIndex for large maps)
+		const Node *FindValueForKey(const std::string& key) const;
+		const Node *FindCompactValueForKey(const std::string& key) const;
 
 	private:
 		std::auto_ptr<NodeOwnership> m_pOwnership;
@@ -126,6 +140,21 @@ namespace YAML_0_2_7
 		std::string m_scalarData;
 		node_seq m_seqData;
 		node_map m_mapData;
+		
+		// built by IndexKeys() once a large map is complete, reset whenever m_mapData changes;
+		// lookups only read it, so they may run concurrently
+		std::auto_ptr<KeyIndex> m_pKeyIndex;
+		
+		// Compact nodes (those of an arena document) leave all of the above empty and keep
+		// their data in the arena of m_pDocument instead; except for the root, they live in
+		// that arena too, and are never destroyed.
+		// Maps store their key/value pairs in map order, i.e., m_pChildren[2*i] and m_pChildren[2*i+1].
+		NodeOwnership *m_pDocument;
+		const std::string *m_pTag;
+		const char *m_pScalar;
+		std::size_t m_scalarSize;
+		Node **m_pChildren;
+		std::size_t m_childCount;
 	};
 }
 
@@ -0,0 +1,20 @@
+# ifndef NODESTORAGE_H_62B23520_7C8E_11DE_8A39_0800200C9A66_0_2_7 
+# define NODESTORAGE_H_62B23520_7C8E_11DE_8A39_0800200C9A66_0_2_7 
+
+#if defined(_MSC_VER) || (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || (__GNUC__ >= 4)) // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+
+namespace YAML_0_2_7
+{
+	// How a parsed document keeps its nodes:
+	// . Heap - each node (and its scalar and children) is allocated separately
+	// . Arena - all nodes, scalars and child arrays of the document live in one arena,
+	//   with the children of each sequence and map stored contiguously; the document
+	//   is freed all at once
+	// Either way, the document is read through the same Node interface.
+	struct NodeStorage { enum value { Heap, Arena }; };
+}
+
+# endif // NODESTORAGE_H_62B23520_7C8E_11DE_8A39_0800200C9A66_0_2_7 
@@ -6,6 +6,7 @@
 #endif
 
 
+#include <cstddef>
 #include <string>
 
 namespace YAML_0_2_7
@@ -18,6 +19,7 @@ namespace YAML_0_2_7
 		
 		void reserve(unsigned size);
 		void put(char ch);
+		void write(const char *str, std::size_t size);
 		const char *str() const { return m_buffer; }
 		
 		unsigned row() const { return m_row; }
@@ -8,6 +8,8 @@
 
 #include "yaml-cpp-0.2.7/dll.h"
 #include "yaml-cpp-0.2.7/noncopyable.h"
+#include "yaml-cpp-0.2.7/nodestorage.h"
+#include <cstddef>
 #include <ios>
 #include <memory>
 
@@ -25,14 +27,22 @@ namespace YAML_0_2_7
 	public:
 		Parser();
 		Parser(std::istream& in);
+		Parser(const char *data, std::size_t size);
 		~Parser();
 
 		operator bool() const;
 
 		void Load(std::istream& in);
+		
+		// parses directly from a contiguous buffer (e.g., a memory-mapped file),
+		// which must stay valid as long as the parser is used
+		void Load(const char *data, std::size_t size);
 		bool HandleNextDocument(EventHandler& eventHandler);
 		
 		bool GetNextDocument(Node& document);
+		
+		// NodeStorage::Arena builds the whole document in one arena (see nodestorage.h)
+		bool GetNextDocument(Node& document, NodeStorage::value storage);
 		void PrintTokens(std::ostream& out);
 
 	private:
@@ -7,7 +7,9 @@
 
 
 #include "yaml-cpp-0.2.7/parser.h"
+#include "yaml-cpp-0.2.7/binaryevents.h"
 #include "yaml-cpp-0.2.7/node.h"
+#include "yaml-cpp-0.2.7/nodestorage.h"
 #include "yaml-cpp-0.2.7/stlnode.h"
 #include "yaml-cpp-0.2.7/iterator.h"
 #include "yaml-cpp-0.2.7/emitter.h"
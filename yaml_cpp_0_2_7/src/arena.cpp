@@ -0,0 +1,90 @@
+#include "arena.h"
+#include <cstring>
+
+namespace YAML_0_2_7
+{
+	namespace
+	{
+		union MaxAlign {
+			long l;
+			double d;
+			long double ld;
+			void *p;
+		};
+		
+		const std::size_t alignment = sizeof(MaxAlign);
+		const std::size_t minBlockSize = 4096;
+		const std::size_t maxBlockSize = 1 << 20;
+	}
+
+	Arena::Arena(): m_pCurrent(0), m_available(0), m_blockSize(minBlockSize)
+	{
+	}
+
+	Arena::~Arena()
+	{
+		for(std::size_t i=0;i<m_blocks.size();i++)
+			delete [] m_blocks[i];
+	}
+
+	// Allocate
+	// . Blocks are aligned and their sizes are multiples of the alignment, so the current
+	//   position is aligned whenever m_available is a multiple of it.
+	void *Arena::Allocate(std::size_t size)
+	{
+		const std::size_t padding = m_available % alignment;
+		if(padding + size > m_available)
+			return AllocateBlock(size);
+		
+		m_pCurrent += padding;
+		m_available -= padding;
+		return AllocateBytes(size);
+	}
+
+	const char *Arena::Copy(const std::string& str)
+	{
+		if(str.empty())
+			return "";
+		
+		char *pCopy = AllocateBytes(str.size());
+		std::memcpy(pCopy, str.data(), str.size());
+		return pCopy;
+	}
+
+	const std::string *Arena::Intern(const std::string& tag)
+	{
+		return &*m_tags.insert(tag).first;
+	}
+
+	char *Arena::AllocateBytes(std::size_t size)
+	{
+		if(size > m_available)
+			return AllocateBlock(size);
+		
+		char *pBytes = m_pCurrent;
+		m_pCurrent += size;
+		m_available -= size;
+		return pBytes;
+	}
+
+	// AllocateBlock
+	// . Blocks double in size (up to a limit), so a document needs only a handful of them;
+	//   oversized requests get a block of their own.
+	char *Arena::AllocateBlock(std::size_t size)
+	{
+		const std::size_t blockSize = m_blockSize;
+		if(m_blockSize < maxBlockSize)
+			m_blockSize *= 2;
+		
+		if(size > blockSize / 4) {
+			char *pBlock = new char[size];
+			m_blocks.push_back(pBlock);
+			return pBlock;
+		}
+		
+		m_pCurrent = new char[blockSize];
+		m_blocks.push_back(m_pCurrent);
+		m_available = blockSize;
+		return AllocateBytes(size);
+	}
+}
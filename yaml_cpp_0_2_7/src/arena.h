@@ -0,0 +1,47 @@
+#ifndef ARENA_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define ARENA_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) || (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || (__GNUC__ >= 4)) // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+
+#include "yaml-cpp-0.2.7/noncopyable.h"
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace YAML_0_2_7
+{
+	// Bump allocator for the nodes, scalars and child arrays of one document.
+	// Nothing is freed (or destroyed) individually; the blocks are released all at once
+	// when the arena is destroyed.
+	class Arena: private noncopyable
+	{
+	public:
+		Arena();
+		~Arena();
+		
+		// suitably aligned for any object
+		void *Allocate(std::size_t size);
+		const char *Copy(const std::string& str);
+		
+		// tags repeat a lot, so they're shared rather than copied
+		const std::string *Intern(const std::string& tag);
+		
+	private:
+		char *AllocateBytes(std::size_t size);
+		char *AllocateBlock(std::size_t size);
+		
+	private:
+		std::vector<char *> m_blocks;
+		char *m_pCurrent;
+		std::size_t m_available;
+		std::size_t m_blockSize;
+		
+		std::set<std::string> m_tags;
+	};
+}
+
+#endif // ARENA_H_62B23520_7C8E_11DE_8A39_0800200C9A66
@@ -0,0 +1,313 @@
+#include "yaml-cpp-0.2.7/binaryevents.h"
+#include "yaml-cpp-0.2.7/exceptions.h"
+#include "nodebuilder.h"
+#include <cstring>
+
+namespace YAML_0_2_7
+{
+	namespace
+	{
+		// the recording starts with this, and then has one record per event:
+		//   DocumentStart mark, DocumentEnd,
+		//   Null mark anchor, Alias mark anchor, Scalar mark tag anchor value,
+		//   SequenceStart mark tag anchor, SequenceEnd, MapStart mark tag anchor, MapEnd
+		// where numbers are varints, marks are (zigzag) deltas from the previous mark,
+		// strings are a length and their bytes, and tags are indices into the tags seen so far
+		// (followed by the string, the first time).
+		const char header[] = "\x7fYEV\x01";
+		const std::size_t headerSize = sizeof(header) - 1;
+		
+		enum EventType { DocumentStart = 1, DocumentEnd, Null, Alias, Scalar, SequenceStart, SequenceEnd, MapStart, MapEnd };
+		
+		// while replaying, for each open collection
+		enum Expecting { SequenceEntry, MapKey, MapValue };
+	}
+
+	BinaryEventWriter::BinaryEventWriter(std::string& out): m_out(out)
+	{
+		m_out.append(header, headerSize);
+	}
+
+	void BinaryEventWriter::OnDocumentStart(const Mark& mark)
+	{
+		m_out += static_cast<char>(DocumentStart);
+		WriteMark(mark);
+	}
+
+	void BinaryEventWriter::OnDocumentEnd()
+	{
+		m_out += static_cast<char>(DocumentEnd);
+	}
+
+	void BinaryEventWriter::OnNull(const Mark& mark, anchor_t anchor)
+	{
+		m_out += static_cast<char>(Null);
+		WriteMark(mark);
+		WriteNumber(anchor);
+	}
+
+	void BinaryEventWriter::OnAlias(const Mark& mark, anchor_t anchor)
+	{
+		m_out += static_cast<char>(Alias);
+		WriteMark(mark);
+		WriteNumber(anchor);
+	}
+
+	void BinaryEventWriter::OnScalar(const Mark& mark, const std::string& tag, anchor_t anchor, const std::string& value)
+	{
+		m_out += static_cast<char>(Scalar);
+		WriteMark(mark);
+		WriteTag(tag);
+		WriteNumber(anchor);
+		WriteString(value);
+	}
+
+	void BinaryEventWriter::OnSequenceStart(const Mark& mark, const std::string& tag, anchor_t anchor)
+	{
+		m_out += static_cast<char>(SequenceStart);
+		WriteMark(mark);
+		WriteTag(tag);
+		WriteNumber(anchor);
+	}
+
+	void BinaryEventWriter::OnSequenceEnd()
+	{
+		m_out += static_cast<char>(SequenceEnd);
+	}
+
+	void BinaryEventWriter::OnMapStart(const Mark& mark, const std::string& tag, anchor_t anchor)
+	{
+		m_out += static_cast<char>(MapStart);
+		WriteMark(mark);
+		WriteTag(tag);
+		WriteNumber(anchor);
+	}
+
+	void BinaryEventWriter::OnMapEnd()
+	{
+		m_out += static_cast<char>(MapEnd);
+	}
+
+	void BinaryEventWriter::WriteNumber(std::size_t n)
+	{
+		while(n >= 0x80) {
+			m_out += static_cast<char>((n & 0x7f) | 0x80);
+			n >>= 7;
+		}
+		m_out += static_cast<char>(n);
+	}
+
+	void BinaryEventWriter::WriteOffset(int delta)
+	{
+		WriteNumber(delta < 0 ? 2 * (-static_cast<std::size_t>(delta)) - 1 : 2 * static_cast<std::size_t>(delta));
+	}
+
+	void BinaryEventWriter::WriteMark(const Mark& mark)
+	{
+		WriteOffset(mark.pos - m_lastMark.pos);
+		WriteOffset(mark.line - m_lastMark.line);
+		WriteOffset(mark.column - m_lastMark.column);
+		m_lastMark = mark;
+	}
+
+	void BinaryEventWriter::WriteString(const std::string& str)
+	{
+		WriteNumber(str.size());
+		m_out += str;
+	}
+
+	void BinaryEventWriter::WriteTag(const std::string& tag)
+	{
+		std::map<std::string, std::size_t>::const_iterator it = m_tags.find(tag);
+		if(it != m_tags.end()) {
+			WriteNumber(it->second);
+			return;
+		}
+		
+		const std::size_t index = m_tags.size();
+		m_tags[tag] = index;
+		WriteNumber(index);
+		WriteString(tag);
+	}
+
+	BinaryEventReader::BinaryEventReader(const char *data, std::size_t size): m_pCurrent(data), m_pEnd(data + size), m_anchorCount(0)
+	{
+		if(size < headerSize || std::memcmp(data, header, headerSize) != 0)
+			ThrowInvalid();
+		m_pCurrent += headerSize;
+	}
+
+	BinaryEventReader::operator bool() const
+	{
+		return m_pCurrent != m_pEnd;
+	}
+
+	// HandleNextDocument
+	// . Replays the events of the next document, checking that they're well-formed on the way
+	//   (so a damaged recording can't get an event handler into an inconsistent state).
+	// . Returns false if there are no more documents.
+	bool BinaryEventReader::HandleNextDocument(EventHandler& eventHandler)
+	{
+		if(m_pCurrent == m_pEnd)
+			return false;
+		if(ReadByte() != DocumentStart)
+			ThrowInvalid();
+		
+		eventHandler.OnDocumentStart(ReadMark());
+		m_anchorCount = 0;
+		
+		std::vector<Expecting> open;
+		bool haveRoot = false;
+		while(true) {
+			const unsigned char type = ReadByte();
+			
+			if(type == DocumentEnd) {
+				if(!open.empty() || !haveRoot)
+					ThrowInvalid();
+				eventHandler.OnDocumentEnd();
+				return true;
+			}
+			
+			if(type == SequenceEnd || type == MapEnd) {
+				if(open.empty() || open.back() != (type == SequenceEnd ? SequenceEntry : MapKey))
+					ThrowInvalid();
+				open.pop_back();
+				if(type == SequenceEnd)
+					eventHandler.OnSequenceEnd();
+				else
+					eventHandler.OnMapEnd();
+			} else {
+				if(open.empty() && haveRoot)
+					ThrowInvalid();
+				
+				const Mark& mark = ReadMark();
+				switch(type) {
+					case Null: {
+						const anchor_t anchor = ReadAnchor(false);
+						eventHandler.OnNull(mark, anchor);
+						break;
+					}
+					case Alias: {
+						const anchor_t anchor = ReadAnchor(true);
+						eventHandler.OnAlias(mark, anchor);
+						break;
+					}
+					case Scalar: {
+						const std::string& tag = ReadTag();
+						const anchor_t anchor = ReadAnchor(false);
+						const std::string& value = ReadString();
+						eventHandler.OnScalar(mark, tag, anchor, value);
+						break;
+					}
+					case SequenceStart:
+					case MapStart: {
+						const std::string& tag = ReadTag();
+						const anchor_t anchor = ReadAnchor(false);
+						if(type == SequenceStart)
+							eventHandler.OnSequenceStart(mark, tag, anchor);
+						else
+							eventHandler.OnMapStart(mark, tag, anchor);
+						open.push_back(type == SequenceStart ? SequenceEntry : MapKey);
+						continue;
+					}
+					default:
+						ThrowInvalid();
+				}
+			}
+			
+			// a node is complete
+			if(open.empty())
+				haveRoot = true;
+			else if(open.back() != SequenceEntry)
+				open.back() = (open.back() == MapKey ? MapValue : MapKey);
+		}
+	}
+
+	bool BinaryEventReader::GetNextDocument(Node& document)
+	{
+		return GetNextDocument(document, NodeStorage::Heap);
+	}
+
+	bool BinaryEventReader::GetNextDocument(Node& document, NodeStorage::value storage)
+	{
+		NodeBuilder builder(document, storage);
+		return HandleNextDocument(builder);
+	}
+
+	unsigned char BinaryEventReader::ReadByte()
+	{
+		if(m_pCurrent == m_pEnd)
+			ThrowInvalid();
+		return static_cast<unsigned char>(*m_pCurrent++);
+	}
+
+	std::size_t BinaryEventReader::ReadNumber()
+	{
+		std::size_t n = 0;
+		for(std::size_t shift=0;shift<8 * sizeof(std::size_t);shift+=7) {
+			const unsigned char byte = ReadByte();
+			n |= static_cast<std::size_t>(byte & 0x7f) << shift;
+			if(!(byte & 0x80))
+				return n;
+		}
+		
+		ThrowInvalid();
+		return 0;
+	}
+
+	int BinaryEventReader::ReadOffset()
+	{
+		const std::size_t n = ReadNumber();
+		return n & 1 ? -static_cast<int>((n + 1) / 2) : static_cast<int>(n / 2);
+	}
+
+	const Mark& BinaryEventReader::ReadMark()
+	{
+		m_mark.pos += ReadOffset();
+		m_mark.line += ReadOffset();
+		m_mark.column += ReadOffset();
+		return m_mark;
+	}
+
+	const std::string& BinaryEventReader::ReadString()
+	{
+		const std::size_t size = ReadNumber();
+		if(size > static_cast<std::size_t>(m_pEnd - m_pCurrent))
+			ThrowInvalid();
+		
+		m_value.assign(m_pCurrent, size);
+		m_pCurrent += size;
+		return m_value;
+	}
+
+	const std::string& BinaryEventReader::ReadTag()
+	{
+		const std::size_t index = ReadNumber();
+		if(index == m_tags.size())
+			m_tags.push_back(ReadString());
+		else if(index > m_tags.size())
+			ThrowInvalid();
+		return m_tags[index];
+	}
+
+	// ReadAnchor
+	// . As the parser does, anchors are numbered from one in each document, and aliases refer to earlier ones.
+	anchor_t BinaryEventReader::ReadAnchor(bool isAlias)
+	{
+		const anchor_t anchor = ReadNumber();
+		if(isAlias) {
+			if(anchor == NullAnchor || anchor > m_anchorCount)
+				ThrowInvalid();
+		} else if(anchor != NullAnchor) {
+			if(anchor != m_anchorCount + 1)
+				ThrowInvalid();
+			m_anchorCount = anchor;
+		}
+		return anchor;
+	}
+
+	void BinaryEventReader::ThrowInvalid() const
+	{
+		throw ParserException(Mark::null(), ErrorMsg::INVALID_BINARY_EVENTS);
+	}
+}
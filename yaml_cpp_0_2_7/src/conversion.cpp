@@ -1,5 +1,7 @@
 #include "yaml-cpp-0.2.7/conversion.h"
 #include <algorithm>
+#include <clocale>
+#include <cstdlib>
 
 ////////////////////////////////////////////////////////////////
 // Specializations for converting a string to specific types
@@ -45,6 +47,111 @@ namespace
 		std::string rest = str.substr(1);
 		return firstcaps && (IsEntirely(rest, IsLower) || IsEntirely(rest, IsUpper));
 	}
+
+	// Decimal
+	// . A number of the form [+-]?([0-9]+\.?[0-9]*|\.[0-9]+)([eE][+-]?[0-9]+)?,
+	//   i.e., (-1)^negative * mantissa * 10^exponent
+	struct Decimal {
+		bool negative;
+		unsigned long long mantissa;
+		int exponent;
+		bool exact; // false if significant digits were dropped from the mantissa
+	};
+
+	bool IsDigit(char ch) { return '0' <= ch && ch <= '9'; }
+
+	bool ParseDecimal(const std::string& str, Decimal& decimal)
+	{
+		const char *p = str.c_str(), *end = p + str.size();
+		decimal.negative = false;
+		decimal.mantissa = 0;
+		decimal.exponent = 0;
+		decimal.exact = true;
+
+		if(p != end && (*p == '+' || *p == '-'))
+			decimal.negative = (*p++ == '-');
+
+		int nDigits = 0, nSignificant = 0;
+		bool point = false;
+		for(;p!=end;++p) {
+			if(*p == '.' && !point) {
+				point = true;
+				continue;
+			}
+			if(!IsDigit(*p))
+				break;
+
+			nDigits++;
+			if(nSignificant == 0 && *p == '0') {
+				if(point)
+					decimal.exponent--;
+				continue;
+			}
+			if(nSignificant < 19) {
+				decimal.mantissa = decimal.mantissa * 10 + (*p - '0');
+				nSignificant++;
+				if(point)
+					decimal.exponent--;
+			} else {
+				if(*p != '0')
+					decimal.exact = false;
+				if(!point)
+					decimal.exponent++;
+			}
+		}
+		if(nDigits == 0)
+			return false;
+
+		if(p != end && (*p == 'e' || *p == 'E')) {
+			++p;
+			bool negativeExponent = false;
+			if(p != end && (*p == '+' || *p == '-'))
+				negativeExponent = (*p++ == '-');
+			if(p == end)
+				return false;
+
+			int exponent = 0;
+			for(;p!=end && IsDigit(*p);++p) {
+				if(exponent < 100000)
+					exponent = exponent * 10 + (*p - '0');
+			}
+			decimal.exponent += negativeExponent ? -exponent : exponent;
+		}
+
+		return p == end;
+	}
+
+	// the conversion of the stream (std::num_get) is done by strtod() in the "C" locale
+	bool HasDecimalPoint()
+	{
+		return *std::localeconv()->decimal_point == '.';
+	}
+
+	// ConvertExactly
+	// . If both the mantissa and the power of ten are exactly representable, one
+	//   (correctly rounded) multiplication or division gives the correctly rounded result.
+	template <typename T>
+	bool ConvertExactly(const Decimal& decimal, unsigned long long maxMantissa, int maxExponent, T& output)
+	{
+		static const T powers[] = {
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+
+		if(!decimal.exact || decimal.mantissa > maxMantissa)
+			return false;
+		if(decimal.mantissa == 0) {
+			output = decimal.negative ? -T(0) : T(0);
+			return true;
+		}
+		if(decimal.exponent < -maxExponent || decimal.exponent > maxExponent)
+			return false;
+
+		T value = static_cast<T>(decimal.mantissa);
+		value = decimal.exponent < 0 ? value / powers[-decimal.exponent] : value * powers[decimal.exponent];
+		output = decimal.negative ? -value : value;
+		return true;
+	}
 }
 
 namespace YAML_0_2_7
@@ -85,5 +192,40 @@ namespace YAML_0_2_7
 	{
 		return input.empty() || input == "~" || input == "null" || input == "Null" || input == "NULL";
 	}
-}
 
+	bool ConvertDecimal(const std::string& input, float& output)
+	{
+		Decimal decimal;
+		if(!ParseDecimal(input, decimal))
+			return false;
+		if(ConvertExactly(decimal, 1ULL << 24, 10, output))
+			return true;
+		if(!HasDecimalPoint())
+			return false;
+
+		// std::num_get fails on overflow
+		const float value = std::strtof(input.c_str(), 0);
+		if(value == std::numeric_limits<float>::infinity() || value == -std::numeric_limits<float>::infinity())
+			return false;
+		output = value;
+		return true;
+	}
+
+	bool ConvertDecimal(const std::string& input, double& output)
+	{
+		Decimal decimal;
+		if(!ParseDecimal(input, decimal))
+			return false;
+		if(ConvertExactly(decimal, 1ULL << 53, 22, output))
+			return true;
+		if(!HasDecimalPoint())
+			return false;
+
+		// std::num_get fails on overflow
+		const double value = std::strtod(input.c_str(), 0);
+		if(value == std::numeric_limits<double>::infinity() || value == -std::numeric_limits<double>::infinity())
+			return false;
+		output = value;
+		return true;
+	}
+}
@@ -680,6 +680,61 @@ namespace YAML_0_2_7
 		PostAtomicWrite();
 	}
 
+	Emitter& Emitter::WriteFlowSeq(const double *values, std::size_t size, std::size_t stride)
+	{
+		return WriteNumbers(values, size, stride);
+	}
+
+	Emitter& Emitter::WriteFlowSeq(const float *values, std::size_t size, std::size_t stride)
+	{
+		return WriteNumbers(values, size, stride);
+	}
+
+	Emitter& Emitter::WriteFlowSeq(const int *values, std::size_t size, std::size_t stride)
+	{
+		if(!good())
+			return *this;
+		
+		// only decimal integers have a fast path
+		if(m_pState->GetIntFormat() == Dec)
+			return WriteNumbers(values, size, stride);
+		
+		*this << Flow << BeginSeq;
+		for(std::size_t i=0;i<size;i++, values += stride)
+			*this << *values;
+		return *this << EndSeq;
+	}
+
+	// WriteNumbers
+	// . The entries are plain scalars on one line, so rather than going through the state
+	//   machine for each one, we write them all and then move to the state after the last one.
+	template <typename T>
+	Emitter& Emitter::WriteNumbers(const T *values, std::size_t size, std::size_t stride)
+	{
+		if(!good())
+			return *this;
+		
+		SetLocalValue(Flow);
+		EmitBeginSeq();
+		if(!good())
+			return *this;
+		
+		char buffer[Utils::NUMBER_BUFFER_SIZE];
+		for(std::size_t i=0;i<size;i++, values += stride) {
+			if(i > 0)
+				m_stream.write(", ", 2);
+			m_stream.write(buffer, Utils::FormatNumber(buffer, *values));
+		}
+		
+		if(size > 0) {
+			m_pState->SwitchState(ES_DONE_WITH_FLOW_SEQ_ENTRY);
+			m_pState->ClearModifiedSettings();
+		}
+		
+		EmitEndSeq();
+		return *this;
+	}
+
 	const char *Emitter::ComputeFullBoolName(bool b) const
 	{
 		const EMITTER_MANIP mainFmt = (m_pState->GetBoolLengthFormat() == ShortBool ? YesNoBool : m_pState->GetBoolFormat());
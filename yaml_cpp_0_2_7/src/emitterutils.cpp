@@ -5,6 +5,18 @@
 #include "stringsource.h"
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#if defined(__has_include)
+#if __has_include(<charconv>) && __cplusplus >= 201703L
+#include <charconv>
+#endif
+#endif
 
 namespace YAML_0_2_7
 {
@@ -13,6 +25,54 @@ namespace YAML_0_2_7
 		namespace {
 			enum {REPLACEMENT_CHARACTER = 0xFFFD};
 
+			std::size_t FormatSpecial(char *buffer, const char *text)
+			{
+				const std::size_t size = std::strlen(text);
+				std::memcpy(buffer, text, size);
+				return size;
+			}
+			
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+			template <typename T>
+			std::size_t FormatFloat(char *buffer, T value, int /*minPrecision*/, int /*maxPrecision*/)
+			{
+				return std::to_chars(buffer, buffer + NUMBER_BUFFER_SIZE, value).ptr - buffer;
+			}
+#else
+			bool ReadsBackAs(const char *buffer, double value) { return std::strtod(buffer, 0) == value; }
+			bool ReadsBackAs(const char *buffer, float value) { return std::strtof(buffer, 0) == value; }
+			
+			// without std::to_chars, the fewest significant digits (from those that are always
+			// enough for some values to those that are enough for all) that read back the same
+			template <typename T>
+			std::size_t FormatFloat(char *buffer, T value, int minPrecision, int maxPrecision)
+			{
+				int size = 0;
+				for(int precision=minPrecision;precision<=maxPrecision;precision++) {
+					size = std::snprintf(buffer, NUMBER_BUFFER_SIZE, "%.*g", precision, static_cast<double>(value));
+					if(ReadsBackAs(buffer, value))
+						break;
+				}
+				
+				const char point = *std::localeconv()->decimal_point;
+				if(point != '.')
+					std::replace(buffer, buffer + size, point, '.');
+				return size;
+			}
+#endif
+			
+			template <typename T>
+			std::size_t FormatNumber(char *buffer, T value, int minPrecision, int maxPrecision)
+			{
+				if(value != value)
+					return FormatSpecial(buffer, ".nan");
+				if(value > std::numeric_limits<T>::max())
+					return FormatSpecial(buffer, ".inf");
+				if(value < -std::numeric_limits<T>::max())
+					return FormatSpecial(buffer, "-.inf");
+				return FormatFloat(buffer, value, minPrecision, maxPrecision);
+			}
+			
 			bool IsAnchorChar(int ch) { // test for ns-anchor-char
 				switch (ch) {
 					case ',': case '[': case ']': case '{': case '}': // c-flow-indicator
@@ -347,6 +407,34 @@ namespace YAML_0_2_7
 			return true;
 		}
 
+		std::size_t FormatNumber(char *buffer, double value)
+		{
+			return FormatNumber(buffer, value, 15, 17);
+		}
+		
+		std::size_t FormatNumber(char *buffer, float value)
+		{
+			return FormatNumber(buffer, value, 6, 9);
+		}
+		
+		std::size_t FormatNumber(char *buffer, int value)
+		{
+			unsigned magnitude = (value < 0 ? 0u - static_cast<unsigned>(value) : static_cast<unsigned>(value));
+			char digits[16];
+			std::size_t nDigits = 0;
+			do {
+				digits[nDigits++] = static_cast<char>('0' + magnitude % 10);
+				magnitude /= 10;
+			} while(magnitude > 0);
+			
+			std::size_t size = 0;
+			if(value < 0)
+				buffer[size++] = '-';
+			while(nDigits > 0)
+				buffer[size++] = digits[--nDigits];
+			return size;
+		}
+		
 		bool WriteBinary(ostream& out, const unsigned char *data, std::size_t size)
 		{
 			static const char encoding[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
@@ -7,6 +7,7 @@
 
 
 #include "yaml-cpp-0.2.7/ostream.h"
+#include <cstddef>
 #include <string>
 
 namespace YAML_0_2_7
@@ -23,6 +24,14 @@ namespace YAML_0_2_7
 		bool WriteTag(ostream& out, const std::string& str, bool verbatim);
 		bool WriteTagWithPrefix(ostream& out, const std::string& prefix, const std::string& tag);
 		bool WriteBinary(ostream& out, const unsigned char *data, std::size_t size);
+		
+		// FormatNumber
+		// . Writes the shortest text that reads back as 'value' (with infinities and NaN spelled as
+		//   in YAML) to 'buffer', which must hold NUMBER_BUFFER_SIZE characters, and returns its length.
+		enum { NUMBER_BUFFER_SIZE = 32 };
+		std::size_t FormatNumber(char *buffer, double value);
+		std::size_t FormatNumber(char *buffer, float value);
+		std::size_t FormatNumber(char *buffer, int value);
 	}
 }
 
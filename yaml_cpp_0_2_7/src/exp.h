@@ -162,6 +162,28 @@ namespace YAML_0_2_7
 			return e;
 		}
 
+		// what ends each kind of scalar (see ScanScalarParams::end)
+		inline const RegEx& EndPlainScalar() {
+			static const RegEx e = EndScalar() || (BlankOrBreak() + Comment());
+			return e;
+		}
+		inline const RegEx& EndPlainScalarInFlow() {
+			static const RegEx e = EndScalarInFlow() || (BlankOrBreak() + Comment());
+			return e;
+		}
+		inline const RegEx& EndSingleQuotedScalar() {
+			static const RegEx e = RegEx('\'') && !EscSingleQuote();
+			return e;
+		}
+		inline const RegEx& EndDoubleQuotedScalar() {
+			static const RegEx e = RegEx('\"');
+			return e;
+		}
+		inline const RegEx& EndBlockScalar() {
+			static const RegEx e = RegEx(); // only at the end of the input
+			return e;
+		}
+
 		inline const RegEx& ChompIndicator() {
 			static const RegEx e = RegEx("+-", REGEX_OR);
 			return e;
@@ -171,6 +193,71 @@ namespace YAML_0_2_7
 			return e;
 		}
 
+		// Table-driven fast paths for the tests the scanner runs at (almost) every character.
+		// . Each gives the same result as the RegEx of the same name, but classifies a
+		//   character with a single table lookup instead of evaluating the composed expression.
+		enum CharClass {
+			CC_BLANK = 0x001,                   // ' ' '\t'
+			CC_BREAK = 0x002,                   // '\n' '\r' (a break is "\n" or "\r\n")
+			CC_EOF = 0x004,                     // Stream::eof()
+			CC_END_SCALAR = 0x008,              // may start EndScalar()
+			CC_END_SCALAR_IN_FLOW = 0x010,      // may start EndScalarInFlow()
+			CC_INDICATOR = 0x020,               // cannot start a PlainScalar()
+			CC_INDICATOR_IN_FLOW = 0x040,       // cannot start a PlainScalarInFlow()
+			CC_PLAIN_INDICATOR = 0x080,         // cannot start a PlainScalar() if followed by a blank
+			CC_PLAIN_INDICATOR_IN_FLOW = 0x100, // cannot start a PlainScalarInFlow() if followed by a blank
+			CC_QUOTE = 0x200                    // '\'' '"'
+		};
+
+		extern const unsigned short charClasses[256];
+
+		inline unsigned short ClassOf(char ch) {
+			return charClasses[static_cast<unsigned char>(ch)];
+		}
+		inline bool IsBlank(char ch) {
+			return (ClassOf(ch) & CC_BLANK) != 0;
+		}
+		inline int MatchBreak(const Stream& in, std::size_t i = 0) {
+			const char ch = in.peek(i);
+			if(ch == '\n')
+				return 1;
+			if(ch == '\r' && in.peek(i + 1) == '\n')
+				return 2;
+			return -1;
+		}
+		inline bool IsBreak(const Stream& in, std::size_t i = 0) {
+			return MatchBreak(in, i) >= 0;
+		}
+		inline bool IsBlankOrBreak(const Stream& in, std::size_t i = 0) {
+			return IsBlank(in.peek(i)) || IsBreak(in, i);
+		}
+		inline bool IsBlankOrBreakOrEnd(const Stream& in, std::size_t i) {
+			return in.peek(i) == Stream::eof() || IsBlankOrBreak(in, i);
+		}
+		inline bool IsDocStart(const Stream& in) {
+			return in.peek(0) == '-' && in.peek(1) == '-' && in.peek(2) == '-' && IsBlankOrBreakOrEnd(in, 3);
+		}
+		inline bool IsDocEnd(const Stream& in) {
+			return in.peek(0) == '.' && in.peek(1) == '.' && in.peek(2) == '.' && IsBlankOrBreakOrEnd(in, 3);
+		}
+		inline bool IsDocIndicator(const Stream& in) {
+			return IsDocStart(in) || IsDocEnd(in);
+		}
+		inline bool IsBlockEntry(const Stream& in) {
+			return in.peek(0) == '-' && IsBlankOrBreakOrEnd(in, 1);
+		}
+		inline bool IsKey(const Stream& in, bool inFlow) {
+			return in.peek(0) == '?' && (!inFlow || IsBlankOrBreak(in, 1));
+		}
+		inline bool IsPlainScalar(const Stream& in, bool inFlow) {
+			const unsigned short cls = ClassOf(in.peek(0));
+			if(cls & (inFlow ? CC_INDICATOR_IN_FLOW : CC_INDICATOR))
+				return false;
+			if((cls & (inFlow ? CC_PLAIN_INDICATOR_IN_FLOW : CC_PLAIN_INDICATOR)) && IsBlank(in.peek(1)))
+				return false;
+			return !IsBlankOrBreak(in);
+		}
+
 		// and some functions
 		std::string Escape(Stream& in);
 	}
@@ -35,6 +35,10 @@ namespace YAML_0_2_7
 			++m_pData->seqIter;
 		else if(m_pData->type == IterPriv::IT_MAP)
 			++m_pData->mapIter;
+		else if(m_pData->type == IterPriv::IT_COMPACT_SEQ)
+			m_pData->pChild += 1;
+		else if(m_pData->type == IterPriv::IT_COMPACT_MAP)
+			m_pData->pChild += 2;
 
 		return *this;
 	}
@@ -47,6 +51,10 @@ namespace YAML_0_2_7
 			++m_pData->seqIter;
 		else if(m_pData->type == IterPriv::IT_MAP)
 			++m_pData->mapIter;
+		else if(m_pData->type == IterPriv::IT_COMPACT_SEQ)
+			m_pData->pChild += 1;
+		else if(m_pData->type == IterPriv::IT_COMPACT_MAP)
+			m_pData->pChild += 2;
 
 		return temp;
 	}
@@ -55,6 +63,8 @@ namespace YAML_0_2_7
 	{
 		if(m_pData->type == IterPriv::IT_SEQ)
 			return **m_pData->seqIter;
+		if(m_pData->type == IterPriv::IT_COMPACT_SEQ)
+			return **m_pData->pChild;
 
 		throw BadDereference();
 	}
@@ -63,6 +73,8 @@ namespace YAML_0_2_7
 	{
 		if(m_pData->type == IterPriv::IT_SEQ)
 			return *m_pData->seqIter;
+		if(m_pData->type == IterPriv::IT_COMPACT_SEQ)
+			return *m_pData->pChild;
 
 		throw BadDereference();
 	}
@@ -71,6 +83,8 @@ namespace YAML_0_2_7
 	{
 		if(m_pData->type == IterPriv::IT_MAP)
 			return *m_pData->mapIter->first;
+		if(m_pData->type == IterPriv::IT_COMPACT_MAP)
+			return *m_pData->pChild[0];
 
 		throw BadDereference();
 	}
@@ -79,6 +93,8 @@ namespace YAML_0_2_7
 	{
 		if(m_pData->type == IterPriv::IT_MAP)
 			return *m_pData->mapIter->second;
+		if(m_pData->type == IterPriv::IT_COMPACT_MAP)
+			return *m_pData->pChild[1];
 
 		throw BadDereference();
 	}
@@ -92,6 +108,8 @@ namespace YAML_0_2_7
 			return it.m_pData->seqIter == jt.m_pData->seqIter;
 		else if(it.m_pData->type == IterPriv::IT_MAP)
 			return it.m_pData->mapIter == jt.m_pData->mapIter;
+		else if(it.m_pData->type == IterPriv::IT_COMPACT_SEQ || it.m_pData->type == IterPriv::IT_COMPACT_MAP)
+			return it.m_pData->pChild == jt.m_pData->pChild;
 
 		return true;
 	}
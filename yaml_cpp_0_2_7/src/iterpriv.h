@@ -16,17 +16,22 @@ namespace YAML_0_2_7
 
 	// IterPriv
 	// . The implementation for iterators - essentially a union of sequence and map iterators.
+	// . Compact nodes (see Node::m_pChildren) are walked with a plain pointer, one entry
+	//   at a time for sequences and one key/value pair at a time for maps.
 	struct IterPriv
 	{
-		IterPriv(): type(IT_NONE) {}
-		IterPriv(std::vector <Node *>::const_iterator it): type(IT_SEQ), seqIter(it) {}
-		IterPriv(std::map <Node *, Node *, ltnode>::const_iterator it): type(IT_MAP), mapIter(it) {}
+		enum ITER_TYPE { IT_NONE, IT_SEQ, IT_MAP, IT_COMPACT_SEQ, IT_COMPACT_MAP };
+
+		IterPriv(): type(IT_NONE), pChild(0) {}
+		IterPriv(std::vector <Node *>::const_iterator it): type(IT_SEQ), seqIter(it), pChild(0) {}
+		IterPriv(std::map <Node *, Node *, ltnode>::const_iterator it): type(IT_MAP), mapIter(it), pChild(0) {}
+		IterPriv(ITER_TYPE type_, Node * const *pChild_): type(type_), pChild(pChild_) {}
 
-		enum ITER_TYPE { IT_NONE, IT_SEQ, IT_MAP };
 		ITER_TYPE type;
 
 		std::vector <Node *>::const_iterator seqIter;
 		std::map <Node *, Node *, ltnode>::const_iterator mapIter;
+		Node * const *pChild;
 	};
 }
 
@@ -0,0 +1,54 @@
+#include "keyindex.h"
+
+namespace YAML_0_2_7
+{
+	KeyIndex::KeyIndex(std::size_t size): m_mask(0)
+	{
+		// keep the load factor at or below one half
+		std::size_t capacity = 8;
+		while(capacity < 2 * size)
+			capacity *= 2;
+		
+		m_entries.resize(capacity);
+		m_mask = capacity - 1;
+	}
+
+	void KeyIndex::Insert(const std::string& key, const Node& value)
+	{
+		const std::size_t hash = Hash(key);
+		for(std::size_t i=hash & m_mask;;i=(i + 1) & m_mask) {
+			Entry& entry = m_entries[i];
+			if(!entry.pKey) {
+				entry.hash = hash;
+				entry.pKey = &key;
+				entry.pValue = &value;
+				return;
+			}
+			if(entry.hash == hash && *entry.pKey == key)
+				return;
+		}
+	}
+
+	const Node *KeyIndex::Find(const std::string& key) const
+	{
+		const std::size_t hash = Hash(key);
+		for(std::size_t i=hash & m_mask;;i=(i + 1) & m_mask) {
+			const Entry& entry = m_entries[i];
+			if(!entry.pKey)
+				return 0;
+			if(entry.hash == hash && *entry.pKey == key)
+				return entry.pValue;
+		}
+	}
+
+	// FNV-1a
+	std::size_t KeyIndex::Hash(const std::string& key)
+	{
+		std::size_t hash = 2166136261u;
+		for(std::string::const_iterator it=key.begin();it!=key.end();++it) {
+			hash ^= static_cast<unsigned char>(*it);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+}
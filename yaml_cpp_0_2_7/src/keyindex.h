@@ -0,0 +1,44 @@
+#ifndef KEYINDEX_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+#define KEYINDEX_H_62B23520_7C8E_11DE_8A39_0800200C9A66
+
+#if defined(_MSC_VER) || (defined(__GNUC__) && (__GNUC__ == 3 && __GNUC_MINOR__ >= 4) || (__GNUC__ >= 4)) // GCC supports "pragma once" correctly since 3.4
+#pragma once
+#endif
+
+
+#include "yaml-cpp-0.2.7/noncopyable.h"
+#include <string>
+#include <vector>
+
+namespace YAML_0_2_7
+{
+	class Node;
+
+	// Open-addressing hash table from the scalar keys of a map node to their values.
+	// Keys are not copied; the index is only valid as long as the map is unchanged.
+	class KeyIndex: private noncopyable
+	{
+	public:
+		explicit KeyIndex(std::size_t size);
+
+		// keeps the first value inserted for a key (i.e., the one that comes first in map order)
+		void Insert(const std::string& key, const Node& value);
+		const Node *Find(const std::string& key) const;
+
+	private:
+		static std::size_t Hash(const std::string& key);
+
+		struct Entry {
+			Entry(): hash(0), pKey(0), pValue(0) {}
+
+			std::size_t hash;
+			const std::string *pKey;
+			const Node *pValue;
+		};
+
+		std::vector<Entry> m_entries;
+		std::size_t m_mask;
+	};
+}
+
+#endif // KEYINDEX_H_62B23520_7C8E_11DE_8A39_0800200C9A66
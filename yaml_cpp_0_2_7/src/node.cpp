@@ -1,5 +1,7 @@
 #include "yaml-cpp-0.2.7/node.h"
+#include "arena.h"
 #include "iterpriv.h"
+#include "keyindex.h"
 #include "nodebuilder.h"
 #include "nodeownership.h"
 #include "scanner.h"
@@ -9,8 +11,12 @@
 #include "yaml-cpp-0.2.7/emitfromevents.h"
 #include "yaml-cpp-0.2.7/emitter.h"
 #include "yaml-cpp-0.2.7/eventhandler.h"
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace YAML_0_2_7
 {
@@ -18,11 +24,11 @@ namespace YAML_0_2_7
 		return *pNode1 < *pNode2;
 	}
 
-	Node::Node(): m_pOwnership(new NodeOwnership), m_type(NodeType::Null)
+	Node::Node(): m_pOwnership(new NodeOwnership), m_type(NodeType::Null), m_pDocument(0), m_pTag(0), m_pScalar(0), m_scalarSize(0), m_pChildren(0), m_childCount(0)
 	{
 	}
 
-	Node::Node(NodeOwnership& owner): m_pOwnership(new NodeOwnership(&owner)), m_type(NodeType::Null)
+	Node::Node(NodeOwnership& document): m_type(NodeType::Null), m_pDocument(&document), m_pTag(0), m_pScalar(0), m_scalarSize(0), m_pChildren(0), m_childCount(0)
 	{
 	}
 
@@ -39,11 +45,18 @@ namespace YAML_0_2_7
 		m_scalarData.clear();
 		m_seqData.clear();
 		m_mapData.clear();
+		m_pKeyIndex.reset();
+		m_pDocument = 0;
+		m_pTag = 0;
+		m_pScalar = 0;
+		m_scalarSize = 0;
+		m_pChildren = 0;
+		m_childCount = 0;
 	}
 	
 	bool Node::IsAliased() const
 	{
-		return m_pOwnership->IsAliased(*this);
+		return IsCompact() ? m_pDocument->IsAliased(*this) : m_pOwnership->IsAliased(*this);
 	}
 
 	Node& Node::CreateNode()
@@ -86,19 +99,32 @@ namespace YAML_0_2_7
 				eventHandler.OnNull(m_mark, anchor);
 				break;
 			case NodeType::Scalar:
-				eventHandler.OnScalar(m_mark, m_tag, anchor, m_scalarData);
+				if(IsCompact())
+					eventHandler.OnScalar(m_mark, Tag(), anchor, std::string(m_pScalar, m_scalarSize));
+				else
+					eventHandler.OnScalar(m_mark, m_tag, anchor, m_scalarData);
 				break;
 			case NodeType::Sequence:
-				eventHandler.OnSequenceStart(m_mark, m_tag, anchor);
-				for(std::size_t i=0;i<m_seqData.size();i++)
-					m_seqData[i]->EmitEvents(am, eventHandler);
+				eventHandler.OnSequenceStart(m_mark, Tag(), anchor);
+				if(IsCompact()) {
+					for(std::size_t i=0;i<m_childCount;i++)
+						m_pChildren[i]->EmitEvents(am, eventHandler);
+				} else {
+					for(std::size_t i=0;i<m_seqData.size();i++)
+						m_seqData[i]->EmitEvents(am, eventHandler);
+				}
 				eventHandler.OnSequenceEnd();
 				break;
 			case NodeType::Map:
-				eventHandler.OnMapStart(m_mark, m_tag, anchor);
-				for(node_map::const_iterator it=m_mapData.begin();it!=m_mapData.end();++it) {
-					it->first->EmitEvents(am, eventHandler);
-					it->second->EmitEvents(am, eventHandler);
+				eventHandler.OnMapStart(m_mark, Tag(), anchor);
+				if(IsCompact()) {
+					for(std::size_t i=0;i<m_childCount;i++)
+						m_pChildren[i]->EmitEvents(am, eventHandler);
+				} else {
+					for(node_map::const_iterator it=m_mapData.begin();it!=m_mapData.end();++it) {
+						it->first->EmitEvents(am, eventHandler);
+						it->second->EmitEvents(am, eventHandler);
+					}
 				}
 				eventHandler.OnMapEnd();
 				break;
@@ -107,6 +133,13 @@ namespace YAML_0_2_7
 
 	void Node::Init(NodeType::value type, const Mark& mark, const std::string& tag)
 	{
+		if(IsCompact()) {
+			m_mark = mark;
+			m_type = type;
+			m_pTag = m_pDocument->GetArena().Intern(tag);
+			return;
+		}
+		
 		Clear();
 		m_mark = mark;
 		m_type = type;
@@ -115,13 +148,21 @@ namespace YAML_0_2_7
 
 	void Node::MarkAsAliased()
 	{
-		m_pOwnership->MarkAsAliased(*this);
+		if(IsCompact())
+			m_pDocument->MarkAsAliased(*this);
+		else
+			m_pOwnership->MarkAsAliased(*this);
 	}
 	
 	void Node::SetScalarData(const std::string& data)
 	{
 		assert(m_type == NodeType::Scalar); // TODO: throw?
-		m_scalarData = data;
+		if(IsCompact()) {
+			m_pScalar = m_pDocument->GetArena().Copy(data);
+			m_scalarSize = data.size();
+		} else {
+			m_scalarData = data;
+		}
 	}
 
 	void Node::Append(Node& node)
@@ -134,6 +175,81 @@ namespace YAML_0_2_7
 	{
 		assert(m_type == NodeType::Map); // TODO: throw?
 		m_mapData[&key] = &value;
+		m_pKeyIndex.reset();
+	}
+
+	namespace
+	{
+		// maps with fewer pairs are searched linearly
+		const std::size_t minIndexedSize = 8;
+	}
+
+	// IndexKeys
+	// . Called by the builder once all pairs of a map are in; lookups never build the index
+	//   themselves, so const access stays free of writes.
+	void Node::IndexKeys()
+	{
+		m_pKeyIndex.reset();
+		if(IsCompact() || m_type != NodeType::Map || m_mapData.size() < minIndexedSize)
+			return;
+		
+		m_pKeyIndex.reset(new KeyIndex(m_mapData.size()));
+		for(node_map::const_iterator it=m_mapData.begin();it!=m_mapData.end();++it) {
+			if(it->first->m_type == NodeType::Scalar)
+				m_pKeyIndex->Insert(it->first->m_scalarData, *it->second);
+		}
+	}
+
+	// UseArena
+	// . Turns this (empty) node into the root of an arena document.
+	void Node::UseArena()
+	{
+		Clear();
+		m_pOwnership->UseArena();
+		m_pDocument = m_pOwnership.get();
+	}
+
+	namespace
+	{
+		typedef std::pair<Node *, Node *> KeyValue;
+		
+		struct ltkey {
+			bool operator()(const KeyValue& kv1, const KeyValue& kv2) const { return *kv1.first < *kv2.first; }
+		};
+	}
+
+	// SetChildren
+	// . Copies all children of a compact sequence or map into the arena at once.
+	// . Map entries come as key/value pairs, in document order; they're put in map order here,
+	//   with the same result as inserting them one by one: a repeated key keeps its first
+	//   key node and its last value.
+	void Node::SetChildren(Node * const *pChildren, std::size_t count)
+	{
+		assert(IsCompact() && (m_type == NodeType::Sequence || m_type == NodeType::Map));
+		
+		m_pChildren = static_cast<Node **>(m_pDocument->GetArena().Allocate(count * sizeof(Node *)));
+		m_childCount = 0;
+		
+		if(m_type == NodeType::Sequence) {
+			std::copy(pChildren, pChildren + count, m_pChildren);
+			m_childCount = count;
+			return;
+		}
+		
+		assert(count % 2 == 0);
+		std::vector<KeyValue> entries(count / 2);
+		for(std::size_t i=0;i<entries.size();i++)
+			entries[i] = KeyValue(pChildren[2 * i], pChildren[2 * i + 1]);
+		std::stable_sort(entries.begin(), entries.end(), ltkey());
+		
+		for(std::size_t i=0;i<entries.size();i++) {
+			if(m_childCount > 0 && m_pChildren[m_childCount - 2]->Compare(*entries[i].first) == 0) {
+				m_pChildren[m_childCount - 1] = entries[i].second;
+				continue;
+			}
+			m_pChildren[m_childCount++] = entries[i].first;
+			m_pChildren[m_childCount++] = entries[i].second;
+		}
 	}
 
 	// begin
@@ -145,8 +261,12 @@ namespace YAML_0_2_7
 			case NodeType::Scalar:
 				return Iterator();
 			case NodeType::Sequence:
+				if(IsCompact())
+					return Iterator(std::auto_ptr<IterPriv>(new IterPriv(IterPriv::IT_COMPACT_SEQ, m_pChildren)));
 				return Iterator(std::auto_ptr<IterPriv>(new IterPriv(m_seqData.begin())));
 			case NodeType::Map:
+				if(IsCompact())
+					return Iterator(std::auto_ptr<IterPriv>(new IterPriv(IterPriv::IT_COMPACT_MAP, m_pChildren)));
 				return Iterator(std::auto_ptr<IterPriv>(new IterPriv(m_mapData.begin())));
 		}
 		
@@ -163,8 +283,12 @@ namespace YAML_0_2_7
 			case NodeType::Scalar:
 				return Iterator();
 			case NodeType::Sequence:
+				if(IsCompact())
+					return Iterator(std::auto_ptr<IterPriv>(new IterPriv(IterPriv::IT_COMPACT_SEQ, m_pChildren + m_childCount)));
 				return Iterator(std::auto_ptr<IterPriv>(new IterPriv(m_seqData.end())));
 			case NodeType::Map:
+				if(IsCompact())
+					return Iterator(std::auto_ptr<IterPriv>(new IterPriv(IterPriv::IT_COMPACT_MAP, m_pChildren + m_childCount)));
 				return Iterator(std::auto_ptr<IterPriv>(new IterPriv(m_mapData.end())));
 		}
 		
@@ -182,9 +306,9 @@ namespace YAML_0_2_7
 			case NodeType::Scalar:
 				return 0;
 			case NodeType::Sequence:
-				return m_seqData.size();
+				return IsCompact() ? m_childCount : m_seqData.size();
 			case NodeType::Map:
-				return m_mapData.size();
+				return IsCompact() ? m_childCount / 2 : m_mapData.size();
 		}
 		
 		assert(false);
@@ -193,8 +317,80 @@ namespace YAML_0_2_7
 
 	const Node *Node::FindAtIndex(std::size_t i) const
 	{
-		if(m_type == NodeType::Sequence)
-			return m_seqData[i];
+		if(m_type != NodeType::Sequence)
+			return 0;
+		if(IsCompact())
+			return i < m_childCount ? m_pChildren[i] : 0;
+		return m_seqData[i];
+	}
+
+	// FindValueForKey
+	// . Same result as the generic version (the first key, in map order, that reads as 'key'),
+	//   but without converting each key to a string.
+	// . Scalar keys sort before the null key, so a null key only matches "~" if no scalar does.
+	const Node *Node::FindValueForKey(const std::string& key) const
+	{
+		if(IsCompact())
+			return FindCompactValueForKey(key);
+		
+		if(m_pKeyIndex.get()) {
+			if(const Node *pValue = m_pKeyIndex->Find(key))
+				return pValue;
+		} else {
+			for(node_map::const_iterator it=m_mapData.begin();it!=m_mapData.end();++it) {
+				if(it->first->m_type == NodeType::Scalar && it->first->m_scalarData == key)
+					return it->second;
+			}
+		}
+		
+		if(key == "~" && !m_mapData.empty()) {
+			node_map::const_reverse_iterator it = m_mapData.rbegin();
+			if(it->first->m_type == NodeType::Null)
+				return it->second;
+		}
+		
+		return 0;
+	}
+
+	namespace
+	{
+		int CompareScalars(const char *data1, std::size_t size1, const char *data2, std::size_t size2)
+		{
+			if(int cmp = std::memcmp(data1, data2, std::min(size1, size2)))
+				return cmp;
+			return size1 < size2 ? -1 : (size1 > size2 ? 1 : 0);
+		}
+	}
+
+	// FindCompactValueForKey
+	// . The scalar keys of a compact map are contiguous and sorted (see Compare), so they're binary searched;
+	//   as above, a null key (the last one, if any) matches "~" if no scalar key does.
+	const Node *Node::FindCompactValueForKey(const std::string& key) const
+	{
+		std::size_t first = 0, last = m_childCount / 2;
+		while(first < last && m_pChildren[2 * first]->m_type != NodeType::Scalar)
+			first++;
+		
+		while(first < last) {
+			const std::size_t middle = first + (last - first) / 2;
+			const Node& middleKey = *m_pChildren[2 * middle];
+			if(middleKey.m_type != NodeType::Scalar) {
+				last = middle;
+				continue;
+			}
+			
+			const int cmp = CompareScalars(middleKey.m_pScalar, middleKey.m_scalarSize, key.data(), key.size());
+			if(cmp == 0)
+				return m_pChildren[2 * middle + 1];
+			if(cmp < 0)
+				first = middle + 1;
+			else
+				last = middle;
+		}
+		
+		if(key == "~" && m_childCount > 0 && m_pChildren[m_childCount - 2]->m_type == NodeType::Null)
+			return m_pChildren[m_childCount - 1];
+		
 		return 0;
 	}
 
@@ -205,7 +401,10 @@ namespace YAML_0_2_7
 				s = "~";
 				return true;
 			case NodeType::Scalar:
-				s = m_scalarData;
+				if(IsCompact())
+					s.assign(m_pScalar, m_scalarSize);
+				else
+					s = m_scalarData;
 				return true;
 			case NodeType::Sequence:
 			case NodeType::Map:
@@ -232,27 +431,29 @@ namespace YAML_0_2_7
 			case NodeType::Null:
 				return 0;
 			case NodeType::Scalar:
-				return m_scalarData.compare(rhs.m_scalarData);
+				return CompareScalars(ScalarData(), ScalarSize(), rhs.ScalarData(), rhs.ScalarSize());
 			case NodeType::Sequence:
-				if(m_seqData.size() < rhs.m_seqData.size())
+				if(size() < rhs.size())
 					return 1;
-				else if(m_seqData.size() > rhs.m_seqData.size())
+				else if(size() > rhs.size())
 					return -1;
-				for(std::size_t i=0;i<m_seqData.size();i++)
-					if(int cmp = m_seqData[i]->Compare(*rhs.m_seqData[i]))
+				for(std::size_t i=0;i<size();i++)
+					if(int cmp = FindAtIndex(i)->Compare(*rhs.FindAtIndex(i)))
 						return cmp;
 				return 0;
 			case NodeType::Map:
-				if(m_mapData.size() < rhs.m_mapData.size())
+				if(size() < rhs.size())
 					return 1;
-				else if(m_mapData.size() > rhs.m_mapData.size())
+				else if(size() > rhs.size())
 					return -1;
-				node_map::const_iterator it = m_mapData.begin();
-				node_map::const_iterator jt = rhs.m_mapData.begin();
-				for(;it!=m_mapData.end() && jt!=rhs.m_mapData.end();it++, jt++) {
-					if(int cmp = it->first->Compare(*jt->first))
+				const Iterator itEnd = end();
+				const Iterator jtEnd = rhs.end();
+				Iterator it = begin();
+				Iterator jt = rhs.begin();
+				for(;it!=itEnd && jt!=jtEnd;++it, ++jt) {
+					if(int cmp = it.first().Compare(jt.first()))
 						return cmp;
-					if(int cmp = it->second->Compare(*jt->second))
+					if(int cmp = it.second().Compare(jt.second()))
 						return cmp;
 				}
 				return 0;
@@ -5,9 +5,11 @@
 
 namespace YAML_0_2_7
 {
-	NodeBuilder::NodeBuilder(Node& root): m_root(root), m_initializedRoot(false), m_finished(false)
+	NodeBuilder::NodeBuilder(Node& root, NodeStorage::value storage): m_root(root), m_initializedRoot(false), m_finished(false)
 	{
 		m_root.Clear();
+		if(storage == NodeStorage::Arena)
+			m_root.UseArena();
 		m_anchors.push_back(0); // since the anchors start at 1
 	}
 	
@@ -50,10 +52,12 @@ namespace YAML_0_2_7
 	{
 		Node& node = Push(anchor);
 		node.Init(NodeType::Sequence, mark, tag);
+		BeginChildren(node);
 	}
 
 	void NodeBuilder::OnSequenceEnd()
 	{
+		EndChildren(Top());
 		Pop();
 	}
 
@@ -62,11 +66,14 @@ namespace YAML_0_2_7
 		Node& node = Push(anchor);
 		node.Init(NodeType::Map, mark, tag);
 		m_didPushKey.push(false);
+		BeginChildren(node);
 	}
 
 	void NodeBuilder::OnMapEnd()
 	{
 		m_didPushKey.pop();
+		EndChildren(Top());
+		Top().IndexKeys();
 		Pop();
 	}
 	
@@ -110,6 +117,13 @@ namespace YAML_0_2_7
 	void NodeBuilder::Insert(Node& node)
 	{
 		Node& curTop = Top();
+		if(curTop.IsCompact()) {
+			// keys and values simply alternate; the map sorts them out in EndChildren
+			assert(curTop.Type() == NodeType::Sequence || curTop.Type() == NodeType::Map);
+			m_children.push_back(&node);
+			return;
+		}
+		
 		switch(curTop.Type()) {
 			case NodeType::Null:
 			case NodeType::Scalar:
@@ -135,6 +149,26 @@ namespace YAML_0_2_7
 		}
 	}
 
+	// BeginChildren, EndChildren
+	// . A compact collection gets all of its children at once, when it ends; until then
+	//   they're kept on top of m_children.
+	void NodeBuilder::BeginChildren(Node& node)
+	{
+		if(node.IsCompact())
+			m_childrenStart.push(m_children.size());
+	}
+
+	void NodeBuilder::EndChildren(Node& node)
+	{
+		if(!node.IsCompact())
+			return;
+		
+		const std::size_t start = m_childrenStart.top();
+		m_childrenStart.pop();
+		node.SetChildren(m_children.empty() ? 0 : &m_children[0] + start, m_children.size() - start);
+		m_children.resize(start);
+	}
+
 	void NodeBuilder::RegisterAnchor(anchor_t anchor, Node& node)
 	{
 		if(anchor) {
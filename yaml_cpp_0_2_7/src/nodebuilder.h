@@ -6,6 +6,7 @@
 #endif
 
 #include "yaml-cpp-0.2.7/eventhandler.h"
+#include "yaml-cpp-0.2.7/nodestorage.h"
 #include <map>
 #include <memory>
 #include <stack>
@@ -18,7 +19,7 @@ namespace YAML_0_2_7
 	class NodeBuilder: public EventHandler
 	{
 	public:
-		explicit NodeBuilder(Node& root);
+		explicit NodeBuilder(Node& root, NodeStorage::value storage = NodeStorage::Heap);
 		virtual ~NodeBuilder();
 
 		virtual void OnDocumentStart(const Mark& mark);
@@ -43,6 +44,9 @@ namespace YAML_0_2_7
 		void Insert(Node& node);
 		void RegisterAnchor(anchor_t anchor, Node& node);
 		
+		void BeginChildren(Node& node);
+		void EndChildren(Node& node);
+		
 	private:
 		Node& m_root;
 		bool m_initializedRoot;
@@ -51,6 +55,10 @@ namespace YAML_0_2_7
 		std::stack<Node *> m_stack;
 		std::stack<Node *> m_pendingKeys;
 		std::stack<bool> m_didPushKey;
+		
+		// children of the open compact collections, innermost last
+		std::vector<Node *> m_children;
+		std::stack<std::size_t> m_childrenStart;
 
 		typedef std::vector<Node *> Anchors;
 		Anchors m_anchors;
@@ -1,5 +1,8 @@
 #include "nodeownership.h"
+#include "arena.h"
 #include "yaml-cpp-0.2.7/node.h"
+#include <cassert>
+#include <new>
 
 namespace YAML_0_2_7
 {
@@ -13,8 +16,17 @@ namespace YAML_0_2_7
 	{
 	}
 
+	void NodeOwnership::UseArena()
+	{
+		assert(m_pOwner == this && m_nodes.empty());
+		m_pArena.reset(new Arena);
+	}
+
 	Node& NodeOwnership::_Create()
 	{
+		if(m_pArena.get())
+			return *new (m_pArena->Allocate(sizeof(Node))) Node(*this);
+		
 		m_nodes.push_back(std::auto_ptr<Node>(new Node));
 		return m_nodes.back();
 	}
@@ -8,10 +8,13 @@
 
 #include "yaml-cpp-0.2.7/noncopyable.h"
 #include "ptr_vector.h"
+#include <memory>
 #include <set>
+#include <string>
 
 namespace YAML_0_2_7
 {
+	class Arena;
 	class Node;
 	
 	class NodeOwnership: private noncopyable
@@ -24,6 +27,11 @@ namespace YAML_0_2_7
 		void MarkAsAliased(const Node& node) { m_pOwner->_MarkAsAliased(node); }
 		bool IsAliased(const Node& node) const { return m_pOwner->_IsAliased(node); }
 		
+		// from now on, Create() places the nodes in an arena (only for the owner of a document)
+		void UseArena();
+		bool HasArena() const { return m_pOwner->m_pArena.get() != 0; }
+		Arena& GetArena() { return *m_pOwner->m_pArena; }
+		
 	private:
 		Node& _Create();
 		void _MarkAsAliased(const Node& node);
@@ -31,6 +39,7 @@ namespace YAML_0_2_7
 		
 	private:
 		ptr_vector<Node> m_nodes;
+		std::auto_ptr<Arena> m_pArena;
 		std::set<const Node *> m_aliasedNodes;
 		NodeOwnership *m_pOwner;
 	};
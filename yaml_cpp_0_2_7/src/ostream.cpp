@@ -1,5 +1,7 @@
 #include "yaml-cpp-0.2.7/ostream.h"
+#include <algorithm>
 #include <cstring>
+#include <iterator>
 
 namespace YAML_0_2_7
 {
@@ -41,11 +43,25 @@ namespace YAML_0_2_7
 			m_col++;
 	}
 
+	void ostream::write(const char *str, std::size_t size)
+	{
+		if(m_pos + size >= m_size)   // an extra space for the NULL terminator
+			reserve(std::max<std::size_t>(m_size * 2, m_pos + size + 1));
+		
+		std::memcpy(m_buffer + m_pos, str, size);
+		m_pos += size;
+		
+		const std::size_t newlines = std::count(str, str + size, '\n');
+		if(newlines > 0) {
+			m_row += newlines;
+			m_col = static_cast<unsigned>(str + size - std::find(std::reverse_iterator<const char *>(str + size), std::reverse_iterator<const char *>(str), '\n').base());
+		} else
+			m_col += size;
+	}
+
 	ostream& operator << (ostream& out, const char *str)
 	{
-		std::size_t length = std::strlen(str);
-		for(std::size_t i=0;i<length;i++)
-			out.put(str[i]);
+		out.write(str, std::strlen(str));
 		return out;
 	}
 	
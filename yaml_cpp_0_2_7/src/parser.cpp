@@ -22,6 +22,11 @@ namespace YAML_0_2_7
 		Load(in);
 	}
 
+	Parser::Parser(const char *data, std::size_t size)
+	{
+		Load(data, size);
+	}
+
 	Parser::~Parser()
 	{
 	}
@@ -37,6 +42,12 @@ namespace YAML_0_2_7
 		m_pDirectives.reset(new Directives);
 	}
 
+	void Parser::Load(const char *data, std::size_t size)
+	{
+		m_pScanner.reset(new Scanner(data, size));
+		m_pDirectives.reset(new Directives);
+	}
+
 	// HandleNextDocument
 	// . Handles the next document
 	// . Throws a ParserException on error.
@@ -60,7 +71,12 @@ namespace YAML_0_2_7
 	// . Throws a ParserException on error.
 	bool Parser::GetNextDocument(Node& document)
 	{
-		NodeBuilder builder(document);
+		return GetNextDocument(document, NodeStorage::Heap);
+	}
+
+	bool Parser::GetNextDocument(Node& document, NodeStorage::value storage)
+	{
+		NodeBuilder builder(document, storage);
 		return HandleNextDocument(builder);
 	}
 
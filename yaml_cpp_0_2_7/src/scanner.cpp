@@ -12,6 +12,11 @@ namespace YAML_0_2_7
 	{
 	}
 
+	Scanner::Scanner(const char *data, std::size_t size)
+		: INPUT(data, size), m_startedStream(false), m_endedStream(false), m_simpleKeyAllowed(false), m_canBeJSONFlow(false)
+	{
+	}
+
 	Scanner::~Scanner()
 	{
 	}
@@ -111,10 +116,10 @@ namespace YAML_0_2_7
 			return ScanDirective();
 
 		// document token
-		if(INPUT.column() == 0 && Exp::DocStart().Matches(INPUT))
+		if(INPUT.column() == 0 && Exp::IsDocStart(INPUT))
 			return ScanDocStart();
 
-		if(INPUT.column() == 0 && Exp::DocEnd().Matches(INPUT))
+		if(INPUT.column() == 0 && Exp::IsDocEnd(INPUT))
 			return ScanDocEnd();
 
 		// flow start/end/entry
@@ -128,10 +133,10 @@ namespace YAML_0_2_7
 			return ScanFlowEntry();
 
 		// block/map stuff
-		if(Exp::BlockEntry().Matches(INPUT))
+		if(Exp::IsBlockEntry(INPUT))
 			return ScanBlockEntry();
 
-		if((InBlockContext() ? Exp::Key() : Exp::KeyInFlow()).Matches(INPUT))
+		if(Exp::IsKey(INPUT, InFlowContext()))
 			return ScanKey();
 
 		if(GetValueRegex().Matches(INPUT))
@@ -153,7 +158,7 @@ namespace YAML_0_2_7
 			return ScanQuotedScalar();
 
 		// plain scalars
-		if((InBlockContext() ? Exp::PlainScalar() : Exp::PlainScalarInFlow()).Matches(INPUT))
+		if(Exp::IsPlainScalar(INPUT, InFlowContext()))
 			return ScanPlainScalar();
 
 		// don't know what it is!
@@ -167,24 +172,24 @@ namespace YAML_0_2_7
 		while(1) {
 			// first eat whitespace
 			while(INPUT && IsWhitespaceToBeEaten(INPUT.peek())) {
-				if(InBlockContext() && Exp::Tab().Matches(INPUT))
+				if(InBlockContext() && INPUT.peek() == '\t')
 					m_simpleKeyAllowed = false;
 				INPUT.eat(1);
 			}
 
 			// then eat a comment
-			if(Exp::Comment().Matches(INPUT)) {
+			if(INPUT.peek() == '#') {
 				// eat until line break
-				while(INPUT && !Exp::Break().Matches(INPUT))
+				while(INPUT && !Exp::IsBreak(INPUT))
 					INPUT.eat(1);
 			}
 
 			// if it's NOT a line break, then we're done!
-			if(!Exp::Break().Matches(INPUT))
+			int n = Exp::MatchBreak(INPUT);
+			if(n < 0)
 				break;
 
 			// otherwise, let's eat the line break and keep going
-			int n = Exp::Break().Match(INPUT);
 			INPUT.eat(n);
 
 			// oh yeah, and let's get rid of that simple key
@@ -315,7 +320,7 @@ namespace YAML_0_2_7
 			const IndentMarker& indent = *m_indents.top();
 			if(indent.column < INPUT.column())
 				break;
-			if(indent.column == INPUT.column() && !(indent.type == IndentMarker::SEQ && !Exp::BlockEntry().Matches(INPUT)))
+			if(indent.column == INPUT.column() && !(indent.type == IndentMarker::SEQ && !Exp::IsBlockEntry(INPUT)))
 				break;
 				
 			PopIndent();
@@ -25,6 +25,7 @@ namespace YAML_0_2_7
 	{
 	public:
 		Scanner(std::istream& in);
+		Scanner(const char *data, std::size_t size);
 		~Scanner();
 
 		// token queue management (hopefully this looks kinda stl-ish)
@@ -32,12 +32,31 @@ namespace YAML_0_2_7
 			
 			std::size_t lastNonWhitespaceChar = scalar.size();
 			bool escapedNewline = false;
-			while(!params.end.Matches(INPUT) && !Exp::Break().Matches(INPUT)) {
+			while(1) {
+				// fast path: copy everything that can't end the line or the scalar, start an
+				// escape or a document indicator with one table lookup per character
+				if(params.endClasses >= 0) {
+					const int stopClasses = params.endClasses | Exp::CC_BREAK | Exp::CC_EOF;
+					while(INPUT.column() != 0) {
+						char ch = INPUT.peek();
+						if((Exp::ClassOf(ch) & stopClasses) || ch == params.escape)
+							break;
+
+						foundNonEmptyLine = true;
+						pastOpeningBreak = true;
+						scalar += INPUT.get();
+						if(!Exp::IsBlank(ch))
+							lastNonWhitespaceChar = scalar.size();
+					}
+				}
+
+				if(params.end->Matches(INPUT) || Exp::IsBreak(INPUT))
+					break;
 				if(!INPUT)
 					break;
 
 				// document indicator?
-				if(INPUT.column() == 0 && Exp::DocIndicator().Matches(INPUT)) {
+				if(INPUT.column() == 0 && Exp::IsDocIndicator(INPUT)) {
 					if(params.onDocIndicator == BREAK)
 						break;
 					else if(params.onDocIndicator == THROW)
@@ -48,7 +67,7 @@ namespace YAML_0_2_7
 				pastOpeningBreak = true;
 
 				// escaped newline? (only if we're escaping on slash)
-				if(params.escape == '\\' && Exp::EscBreak().Matches(INPUT)) {
+				if(params.escape == '\\' && INPUT.peek() == '\\' && Exp::IsBreak(INPUT, 1)) {
 					// eat escape character and get out (but preserve trailing whitespace!)
 					INPUT.get();
 					lastNonWhitespaceChar = scalar.size();
@@ -78,11 +97,11 @@ namespace YAML_0_2_7
 			}
 
 			// doc indicator?
-			if(params.onDocIndicator == BREAK && INPUT.column() == 0 && Exp::DocIndicator().Matches(INPUT))
+			if(params.onDocIndicator == BREAK && INPUT.column() == 0 && Exp::IsDocIndicator(INPUT))
 				break;
 
 			// are we done via character match?
-			int n = params.end.Match(INPUT);
+			int n = params.end->Match(INPUT);
 			if(n >= 0) {
 				if(params.eatEnd)
 					INPUT.eat(n);
@@ -95,7 +114,7 @@ namespace YAML_0_2_7
 			
 			// ********************************
 			// Phase #2: eat line ending
-			n = Exp::Break().Match(INPUT);
+			n = Exp::MatchBreak(INPUT);
 			INPUT.eat(n);
 
 			// ********************************
@@ -110,7 +129,7 @@ namespace YAML_0_2_7
 				params.indent = std::max(params.indent, INPUT.column());
 
 			// and then the rest of the whitespace
-			while(Exp::Blank().Matches(INPUT)) {
+			while(Exp::IsBlank(INPUT.peek())) {
 				// we check for tabs that masquerade as indentation
 				if(INPUT.peek() == '\t'&& INPUT.column() < params.indent && params.onTabInIndentation == THROW)
 					throw ParserException(INPUT.mark(), ErrorMsg::TAB_IN_INDENTATION);
@@ -122,8 +141,8 @@ namespace YAML_0_2_7
 			}
 
 			// was this an empty line?
-			bool nextEmptyLine = Exp::Break().Matches(INPUT);
-			bool nextMoreIndented = Exp::Blank().Matches(INPUT);
+			bool nextEmptyLine = Exp::IsBreak(INPUT);
+			bool nextMoreIndented = Exp::IsBlank(INPUT.peek());
 			if(params.fold == FOLD_BLOCK && foldedNewlineCount == 0 && nextEmptyLine)
 				foldedNewlineStartedMoreIndented = moreIndented;
 
@@ -17,11 +17,12 @@ namespace YAML_0_2_7
 	enum FOLD { DONT_FOLD, FOLD_BLOCK, FOLD_FLOW };
 
 	struct ScanScalarParams {
-		ScanScalarParams(): eatEnd(false), indent(0), detectIndent(false), eatLeadingWhitespace(0), escape(0), fold(DONT_FOLD),
+		ScanScalarParams(): end(0), endClasses(-1), eatEnd(false), indent(0), detectIndent(false), eatLeadingWhitespace(0), escape(0), fold(DONT_FOLD),
 			trimTrailingSpaces(0), chomp(CLIP), onDocIndicator(NONE), onTabInIndentation(NONE), leadingSpaces(false) {}
 
 		// input:
-		RegEx end;                      // what condition ends this scalar?
+		const RegEx *end;               // what condition ends this scalar? (one of the static Exp::End*Scalar*())
+		int endClasses;                 // which character classes (Exp::CharClass) can start 'end'? (-1 for unknown)
 		bool eatEnd;                    // should we eat that condition when we see it?
 		int indent;                     // what level of indentation should be eaten and ignored?
 		bool detectIndent;              // should we try to autodetect the indent?
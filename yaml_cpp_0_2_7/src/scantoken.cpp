@@ -302,7 +302,8 @@ namespace YAML_0_2_7
 
 		// set up the scanning parameters
 		ScanScalarParams params;
-		params.end = (InFlowContext() ? Exp::EndScalarInFlow() : Exp::EndScalar()) || (Exp::BlankOrBreak() + Exp::Comment());
+		params.end = (InFlowContext() ? &Exp::EndPlainScalarInFlow() : &Exp::EndPlainScalar());
+		params.endClasses = (InFlowContext() ? Exp::CC_END_SCALAR_IN_FLOW : Exp::CC_END_SCALAR) | Exp::CC_BLANK | Exp::CC_BREAK;
 		params.eatEnd = false;
 		params.indent = (InFlowContext() ? 0 : GetTopIndent() + 1);
 		params.fold = FOLD_FLOW;
@@ -342,7 +343,8 @@ namespace YAML_0_2_7
 
 		// setup the scanning parameters
 		ScanScalarParams params;
-		params.end = (single ? RegEx(quote) && !Exp::EscSingleQuote() : RegEx(quote));
+		params.end = (single ? &Exp::EndSingleQuotedScalar() : &Exp::EndDoubleQuotedScalar());
+		params.endClasses = Exp::CC_QUOTE;
 		params.eatEnd = true;
 		params.escape = (single ? '\'' : '\\');
 		params.indent = 0;
@@ -422,6 +424,8 @@ namespace YAML_0_2_7
 		if(GetTopIndent() >= 0)
 			params.indent += GetTopIndent();
 
+		params.end = &Exp::EndBlockScalar();
+		params.endClasses = 0; // the end only matches at the end of the input
 		params.eatLeadingWhitespace = false;
 		params.trimTrailingSpaces = false;
 		params.onTabInIndentation = THROW;
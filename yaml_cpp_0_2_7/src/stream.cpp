@@ -177,16 +177,79 @@ namespace YAML_0_2_7
 		}
 	}
 
+	// BufferInput
+	// . Lets the character-set detection and the UTF-16/32 decoders read from a
+	//   contiguous buffer without copying it.
+	struct BufferInput
+	{
+		class Buffer: public std::streambuf
+		{
+		public:
+			Buffer(const char *data, std::size_t size) {
+				char *begin = const_cast<char *>(data);
+				setg(begin, begin, begin + size);
+			}
+			
+			const char *current() const { return gptr(); }
+			const char *end() const { return egptr(); }
+		};
+		
+		BufferInput(const char *data, std::size_t size): buffer(data, size), stream(&buffer) {}
+		
+		Buffer buffer;
+		std::istream stream;
+	};
+
 	Stream::Stream(std::istream& input)
 		: m_input(input), m_nPushedBack(0),
 		m_pPrefetched(new unsigned char[YAML_PREFETCH_SIZE]), 
-		m_nPrefetchedAvailable(0), m_nPrefetchedUsed(0)
+		m_nPrefetchedAvailable(0), m_nPrefetchedUsed(0),
+		m_buffered(false), m_pCurrent(0), m_pEnd(0)
 	{
-		typedef std::istream::traits_type char_traits;
-
 		if(!input)
 			return;
 
+		DetectCharSet();
+		ReadAheadTo(0);
+	}
+
+	Stream::Stream(const char *data, std::size_t size)
+		: m_pBufferInput(new BufferInput(data, size)), m_input(m_pBufferInput->stream), m_nPushedBack(0),
+		m_pPrefetched(new unsigned char[YAML_PREFETCH_SIZE]), 
+		m_nPrefetchedAvailable(0), m_nPrefetchedUsed(0),
+		m_buffered(true), m_pCurrent(0), m_pEnd(0)
+	{
+		m_charSet = utf8;
+		if(size > 0)
+			DetectCharSet();
+
+		if(m_charSet == utf8) {
+			// the bytes pushed back by the detection directly precede the unread ones
+			m_pCurrent = m_pBufferInput->buffer.current() - m_nPushedBack;
+			m_pEnd = m_pBufferInput->buffer.end();
+			m_nPushedBack = 0;
+			return;
+		}
+
+		while(m_input.good()) {
+			if(m_charSet == utf16le || m_charSet == utf16be)
+				StreamInUtf16();
+			else
+				StreamInUtf32();
+		}
+		
+		m_transcoded.assign(m_readahead.begin(), m_readahead.end());
+		m_readahead.clear();
+		m_pCurrent = m_transcoded.data();
+		m_pEnd = m_pCurrent + m_transcoded.size();
+	}
+
+	void Stream::DetectCharSet()
+	{
+		typedef std::istream::traits_type char_traits;
+
+		std::istream& input = m_input;
+
 		// Determine (or guess) the character-set by reading the BOM, if any.  See
 		// the YAML specification for the determination algorithm.
 		char_traits::int_type intro[4];
@@ -217,8 +280,6 @@ namespace YAML_0_2_7
 		case uis_utf32be: m_charSet = utf32be; break;
 		default: m_charSet = utf8; break;
 		}
-
-		ReadAheadTo(0);
 	}
 
 	Stream::~Stream()
@@ -228,6 +289,11 @@ namespace YAML_0_2_7
 
 	char Stream::peek() const
 	{
+		if (m_buffered)
+		{
+			return m_pCurrent < m_pEnd ? *m_pCurrent : Stream::eof();
+		}
+
 		if (m_readahead.empty())
 		{
 			return Stream::eof();
@@ -238,6 +304,11 @@ namespace YAML_0_2_7
 	
 	Stream::operator bool() const
 	{
+		if (m_buffered)
+		{
+			return m_pCurrent < m_pEnd;
+		}
+
 		return m_input.good() || (!m_readahead.empty() && m_readahead[0] != Stream::eof());
 	}
 
@@ -278,6 +349,16 @@ namespace YAML_0_2_7
 
 	void Stream::AdvanceCurrent()
 	{
+		if (m_buffered)
+		{
+			if (m_pCurrent < m_pEnd)
+			{
+				++m_pCurrent;
+				m_mark.pos++;
+			}
+			return;
+		}
+
 		if (!m_readahead.empty())
 		{
 			m_readahead.pop_front();
@@ -12,6 +12,7 @@
 #include <deque>
 #include <ios>
 #include <iostream>
+#include <memory>
 #include <set>
 #include <string>
 
@@ -19,18 +20,22 @@ namespace YAML_0_2_7
 {
 	static const size_t MAX_PARSER_PUSHBACK = 8;
 
+	struct BufferInput;
+
 	class Stream: private noncopyable
 	{
 	public:
 		friend class StreamCharSource;
 		
 		Stream(std::istream& input);
+		Stream(const char *data, std::size_t size); // 'data' must outlive the stream
 		~Stream();
 
 		operator bool() const;
 		bool operator !() const { return !static_cast <bool>(*this); }
 
 		char peek() const;
+		char peek(size_t i) const; // i-th character ahead (eof() past the end)
 		char get();
 		std::string get(int n);
 		void eat(int n = 1);
@@ -46,6 +51,7 @@ namespace YAML_0_2_7
 	private:
 		enum CharacterSet {utf8, utf16le, utf16be, utf32le, utf32be};
 
+		std::auto_ptr<BufferInput> m_pBufferInput;
 		std::istream& m_input;
 		Mark m_mark;
 		
@@ -57,6 +63,13 @@ namespace YAML_0_2_7
 		mutable size_t m_nPrefetchedAvailable;
 		mutable size_t m_nPrefetchedUsed;
 		
+		// contiguous input (UTF-8 is read in place, anything else is transcoded once)
+		bool m_buffered;
+		std::string m_transcoded;
+		const char *m_pCurrent;
+		const char *m_pEnd;
+		
+		void DetectCharSet();
 		void AdvanceCurrent();
 		char CharAt(size_t i) const;
 		bool ReadAheadTo(size_t i) const;
@@ -70,10 +83,18 @@ namespace YAML_0_2_7
 	// CharAt
 	// . Unchecked access
 	inline char Stream::CharAt(size_t i) const {
+		if(m_buffered)
+			return i < static_cast<size_t>(m_pEnd - m_pCurrent) ? m_pCurrent[i] : Stream::eof();
 		return m_readahead[i];
 	}
 	
+	inline char Stream::peek(size_t i) const {
+		return ReadAheadTo(i) ? CharAt(i) : Stream::eof();
+	}
+	
 	inline bool Stream::ReadAheadTo(size_t i) const {
+		if(m_buffered)
+			return i <= static_cast<size_t>(m_pEnd - m_pCurrent);
 		if(m_readahead.size() > i)
 			return true;
 		return _ReadAheadTo(i);
@@ -1,5 +1,6 @@
 #include "tests.h"
 #include "yaml-cpp-0.2.7/yaml.h"
+#include <limits>
 
 namespace Test
 {
@@ -854,6 +855,56 @@ namespace Test
 			out << YAML_0_2_7::EndMap;
 			desiredOutput = "key: \"\"";
 		}
+		
+		void FlowSeqOfNumbers(YAML_0_2_7::Emitter& out, std::string& desiredOutput)
+		{
+			const double doubles[] = {1.5, -2, 0.1 + 0.2, 1e300, 1.0 / 3};
+			const float floats[] = {0.1f, 1.0f / 3};
+			const int ints[] = {0, -20, 300, -2147483647 - 1};
+			out << YAML_0_2_7::BeginMap;
+			out << YAML_0_2_7::Key << "doubles" << YAML_0_2_7::Value;
+			out.WriteFlowSeq(doubles, 5);
+			out << YAML_0_2_7::Key << "floats" << YAML_0_2_7::Value;
+			out.WriteFlowSeq(floats, 2);
+			out << YAML_0_2_7::Key << "ints" << YAML_0_2_7::Value;
+			out.WriteFlowSeq(ints, 4);
+			out << YAML_0_2_7::Key << "empty" << YAML_0_2_7::Value;
+			out.WriteFlowSeq(doubles, 0);
+			out << YAML_0_2_7::Key << "after" << YAML_0_2_7::Value << 1.5;
+			out << YAML_0_2_7::EndMap;
+			
+			desiredOutput =
+				"doubles: [1.5, -2, 0.30000000000000004, 1e+300, 0.3333333333333333]\n"
+				"floats: [0.1, 0.33333334]\n"
+				"ints: [0, -20, 300, -2147483648]\n"
+				"empty: []\n"
+				"after: 1.5";
+		}
+		
+		void FlowSeqOfNumbersWithStride(YAML_0_2_7::Emitter& out, std::string& desiredOutput)
+		{
+			// a column-major 2x3 matrix, by rows
+			const double matrix[] = {1, 4, 2, 5, 3, 6};
+			out << YAML_0_2_7::BeginSeq;
+			out.WriteFlowSeq(matrix, 3, 2);
+			out.WriteFlowSeq(matrix + 1, 3, 2);
+			out << YAML_0_2_7::Flow << YAML_0_2_7::BeginSeq;
+			out.WriteFlowSeq(matrix, 2);
+			out << "x";
+			out.WriteFlowSeq(matrix, 1);
+			out << YAML_0_2_7::EndSeq;
+			out << YAML_0_2_7::EndSeq;
+			
+			desiredOutput = "- [1, 2, 3]\n- [4, 5, 6]\n- [[1, 4], x, [1]]";
+		}
+		
+		void FlowSeqOfSpecialNumbers(YAML_0_2_7::Emitter& out, std::string& desiredOutput)
+		{
+			const double values[] = {std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::quiet_NaN(), -0.0};
+			out.WriteFlowSeq(values, 4);
+			
+			desiredOutput = "[.inf, -.inf, .nan, -0]";
+		}
 
 		////////////////////////////////////////////////////////////////////////////////////////////////////////
 		// incorrect emitting
@@ -1067,6 +1118,9 @@ namespace Test
 		RunEmitterTest(&Emitter::DocStartAndEnd, "doc start and end", passed, total);
 		RunEmitterTest(&Emitter::ImplicitDocStart, "implicit doc start", passed, total);
 		RunEmitterTest(&Emitter::EmptyString, "empty string", passed, total);
+		RunEmitterTest(&Emitter::FlowSeqOfNumbers, "flow seq of numbers", passed, total);
+		RunEmitterTest(&Emitter::FlowSeqOfNumbersWithStride, "flow seq of numbers with stride", passed, total);
+		RunEmitterTest(&Emitter::FlowSeqOfSpecialNumbers, "flow seq of special numbers", passed, total);
 		
 		RunEmitterErrorTest(&Emitter::ExtraEndSeq, "extra EndSeq", passed, total);
 		RunEmitterErrorTest(&Emitter::ExtraEndMap, "extra EndMap", passed, total);
@@ -2,6 +2,7 @@
 #include "yaml-cpp-0.2.7/yaml.h"
 #include <sstream>
 #include <algorithm>
+#include <set>
 
 namespace Test
 {
@@ -880,6 +881,238 @@ namespace Test
 				return false;
 			return true;
 		}
+		
+		bool LargeMapLookup()
+		{
+			std::stringstream input;
+			for(int i=0;i<100;i++)
+				input << "key" << i << ": " << i << "\n";
+			input << "key7: 1000\n";
+			input << "? [key0]\n: seq\n";
+			
+			YAML_0_2_7::Parser parser(input);
+			YAML_0_2_7::Node doc;
+			parser.GetNextDocument(doc);
+			
+			for(int i=0;i<100;i++) {
+				std::stringstream key;
+				key << "key" << i;
+				if(doc[key.str()].to<int>() != (i == 7 ? 1000 : i))
+					return false;
+			}
+			if(doc.FindValue("key100"))
+				return false;
+			if(doc.FindValue("[key0]"))
+				return false;
+			
+			// a clone is built by the node builder as well, and gets its own index
+			std::auto_ptr<YAML_0_2_7::Node> pClone = doc.Clone();
+			for(int i=0;i<100;i++) {
+				std::stringstream key;
+				key << "key" << i;
+				if((*pClone)[key.str()].to<int>() != (i == 7 ? 1000 : i))
+					return false;
+			}
+			if(pClone->FindValue("key100"))
+				return false;
+			return true;
+		}
+		
+		bool NumericConversion()
+		{
+			std::string input = "[12, -7, +3, 010, 0x10, 2147483648, 0.1, -0.0, 1e-5, 2.2250738585072014e-308, 0.10000000000000001, 1.5abc]";
+			std::stringstream stream(input);
+			YAML_0_2_7::Parser parser(stream);
+			YAML_0_2_7::Node doc;
+			parser.GetNextDocument(doc);
+			
+			if(doc[0].to<int>() != 12 || doc[1].to<int>() != -7 || doc[2].to<int>() != 3)
+				return false;
+			if(doc[3].to<int>() != 8 || doc[4].to<int>() != 16) // octal and hex still go through the stream
+				return false;
+			int overflow;
+			if(doc[5].Read(overflow) || doc[5].to<long long>() != 2147483648LL)
+				return false;
+			if(doc[6].to<double>() != 0.1 || doc[6].to<float>() != 0.1f)
+				return false;
+			const double negativeZero = doc[7].to<double>();
+			if(negativeZero != 0.0 || 1.0 / negativeZero > 0.0)
+				return false;
+			if(doc[8].to<double>() != 1e-5 || doc[9].to<double>() != 2.2250738585072014e-308 || doc[10].to<double>() != 0.1)
+				return false;
+			if(doc[11].to<double>() != 1.5) // trailing characters are ignored by the stream
+				return false;
+			return true;
+		}
+		
+		bool BufferInput()
+		{
+			std::string input = "---\nkey: [1, 2]\n---\nsecond\n";
+			YAML_0_2_7::Parser parser(input.data(), input.size());
+			YAML_0_2_7::Node doc;
+			
+			if(!parser.GetNextDocument(doc))
+				return false;
+			if(doc["key"][1].to<int>() != 2)
+				return false;
+			if(!parser.GetNextDocument(doc))
+				return false;
+			if(doc.to<std::string>() != "second")
+				return false;
+			if(parser.GetNextDocument(doc))
+				return false;
+			
+			YAML_0_2_7::Parser empty(input.data(), 0);
+			if(empty.GetNextDocument(doc))
+				return false;
+			return true;
+		}
+		
+		bool TildeKeyLookup()
+		{
+			std::string input = "{~: null, a: 1, b: 2, c: 3, d: 4, e: 5, f: 6, g: 7, h: 8}";
+			std::stringstream stream(input);
+			YAML_0_2_7::Parser parser(stream);
+			YAML_0_2_7::Node doc;
+			parser.GetNextDocument(doc);
+			
+			if(doc["~"].to<std::string>() != "null")
+				return false;
+			
+			std::string withScalar = "{~: null, '~': scalar, a: 1, b: 2, c: 3, d: 4, e: 5, f: 6, g: 7, h: 8}";
+			std::stringstream stream2(withScalar);
+			YAML_0_2_7::Parser parser2(stream2);
+			parser2.GetNextDocument(doc);
+			
+			if(doc["~"].to<std::string>() != "scalar")
+				return false;
+			if(doc["h"].to<int>() != 8)
+				return false;
+			return true;
+		}
+		
+		bool ArenaDocument()
+		{
+			std::string input =
+				"b: &x [1, 2, {c: 3}]\n"
+				"a: !foo bar\n"
+				"b: *x\n"
+				"? [b, a]\n: seq\n"
+				"~: null\n"
+				"'': empty\n"
+				"d: {}\n"
+				"e: 1\n"
+				"e: 2\n";
+			YAML_0_2_7::Parser heapParser(input.data(), input.size());
+			YAML_0_2_7::Node heapDoc;
+			heapParser.GetNextDocument(heapDoc);
+			
+			YAML_0_2_7::Parser parser(input.data(), input.size());
+			YAML_0_2_7::Node doc;
+			parser.GetNextDocument(doc, YAML_0_2_7::NodeStorage::Arena);
+			
+			if(doc.size() != 7 || doc.Compare(heapDoc) != 0)
+				return false;
+			
+			YAML_0_2_7::Emitter heapOut, out;
+			heapOut << heapDoc;
+			out << doc;
+			if(std::string(out.c_str()) != heapOut.c_str())
+				return false;
+			
+			YAML_0_2_7::Iterator it = doc.begin(), jt = heapDoc.begin();
+			for(;it!=doc.end() && jt!=heapDoc.end();++it, ++jt) {
+				if(it.first().Compare(jt.first()) != 0 || it.second().Compare(jt.second()) != 0)
+					return false;
+			}
+			if(it != doc.end() || jt != heapDoc.end())
+				return false;
+			
+			if(doc["a"].Tag() != "!foo" || doc["a"].to<std::string>() != "bar")
+				return false;
+			if(doc["b"][2]["c"].to<int>() != 3 || doc["b"].size() != 3 || doc["b"].FindValue(3))
+				return false;
+			if(!doc["b"].IsAliased() || &doc["b"][0] != &*doc["b"].begin())
+				return false;
+			if(doc["~"].to<std::string>() != "null" || doc[""].to<std::string>() != "empty" || doc.FindValue("c"))
+				return false;
+			if(doc["d"].size() != 0 || doc["d"].begin() != doc["d"].end() || doc["e"].to<int>() != 2)
+				return false;
+			
+			std::auto_ptr<YAML_0_2_7::Node> pClone = doc.Clone();
+			if(pClone->Compare(doc) != 0 || (*pClone)["b"][1].to<int>() != 2)
+				return false;
+			
+			if(parser.GetNextDocument(doc, YAML_0_2_7::NodeStorage::Arena) || doc.Type() != YAML_0_2_7::NodeType::Null)
+				return false;
+			return true;
+		}
+		
+		bool BinaryEvents()
+		{
+			std::string input =
+				"a: &x [1, 2, {c: 3}]\n"
+				"b: !foo bar\n"
+				"c: *x\n"
+				"d: ~\n"
+				"e: \"long enough to need a multi-byte length, long enough to need a multi-byte length, long enough to need a multi-byte length\"\n"
+				"---\n"
+				"- !foo &y one\n"
+				"- *y\n";
+			
+			std::string recording;
+			YAML_0_2_7::BinaryEventWriter writer(recording);
+			YAML_0_2_7::Parser parser(input.data(), input.size());
+			std::set<std::size_t> boundaries;
+			boundaries.insert(recording.size());
+			while(parser.HandleNextDocument(writer))
+				boundaries.insert(recording.size());
+			
+			YAML_0_2_7::Parser textParser(input.data(), input.size());
+			YAML_0_2_7::BinaryEventReader reader(recording.data(), recording.size());
+			YAML_0_2_7::Node textDoc, doc;
+			for(int i=0;i<2;i++) {
+				textParser.GetNextDocument(textDoc);
+				if(!reader || !reader.GetNextDocument(doc, i == 0 ? YAML_0_2_7::NodeStorage::Heap : YAML_0_2_7::NodeStorage::Arena))
+					return false;
+				if(doc.Compare(textDoc) != 0 || doc.GetMark().line != textDoc.GetMark().line)
+					return false;
+				
+				YAML_0_2_7::Emitter textOut, out;
+				textOut << textDoc;
+				out << doc;
+				if(std::string(out.c_str()) != textOut.c_str())
+					return false;
+			}
+			if(reader || reader.GetNextDocument(doc))
+				return false;
+			
+			// every truncation of the recording must be rejected (unless it's a whole number of documents)
+			for(std::size_t size=0;size<recording.size();size++) {
+				try {
+					YAML_0_2_7::BinaryEventReader truncated(recording.data(), size);
+					while(truncated.GetNextDocument(doc))
+						;
+					if(!boundaries.count(size))
+						return false;
+				} catch(const YAML_0_2_7::ParserException&) {
+				}
+			}
+			
+			// and so must a dangling alias
+			std::string corrupt;
+			YAML_0_2_7::BinaryEventWriter corruptWriter(corrupt);
+			corruptWriter.OnDocumentStart(YAML_0_2_7::Mark());
+			corruptWriter.OnAlias(YAML_0_2_7::Mark(), 1);
+			corruptWriter.OnDocumentEnd();
+			try {
+				YAML_0_2_7::BinaryEventReader corruptReader(corrupt.data(), corrupt.size());
+				corruptReader.GetNextDocument(doc);
+				return false;
+			} catch(const YAML_0_2_7::ParserException&) {
+			}
+			return true;
+		}
 	}
 	
 	namespace {
@@ -1037,6 +1270,7 @@ namespace Test
 			}
 
 			std::istream& stream() {return m_yaml;}
+			std::string str() const {return m_yaml.str();}
 			const std::vector<std::string>& entries() {return m_entries;}
 
 		private:
@@ -1064,13 +1298,18 @@ namespace Test
 			}
 		};
 
-		void RunEncodingTest(EncodingFn encoding, bool declareEncoding, const std::string& name, int& passed, int& total)
+		void RunEncodingTest(EncodingFn encoding, bool declareEncoding, bool fromBuffer, const std::string& name, int& passed, int& total)
 		{
 			EncodingTester tester(encoding, declareEncoding);
 			std::string error;
 			bool ok = true;
 			try {
-				YAML_0_2_7::Parser parser(tester.stream());
+				YAML_0_2_7::Parser parser;
+				const std::string buffer = tester.str();
+				if(fromBuffer)
+					parser.Load(buffer.data(), buffer.size());
+				else
+					parser.Load(tester.stream());
 				YAML_0_2_7::Node doc;
 				parser.GetNextDocument(doc);
 
@@ -1159,17 +1398,33 @@ namespace Test
 		RunParserTest(&Parser::Infinity, "infinity", passed, total);
 		RunParserTest(&Parser::NaN, "NaN", passed, total);
 		RunParserTest(&Parser::NonConstKey, "non const key", passed, total);
+		RunParserTest(&Parser::LargeMapLookup, "large map lookup", passed, total);
+		RunParserTest(&Parser::TildeKeyLookup, "tilde key lookup", passed, total);
+		RunParserTest(&Parser::BufferInput, "buffer input", passed, total);
+		RunParserTest(&Parser::NumericConversion, "numeric conversion", passed, total);
+		RunParserTest(&Parser::ArenaDocument, "arena document", passed, total);
+		RunParserTest(&Parser::BinaryEvents, "binary events", passed, total);
 		
-		RunEncodingTest(&EncodeToUtf8, false, "UTF-8, no BOM", passed, total);
-		RunEncodingTest(&EncodeToUtf8, true, "UTF-8 with BOM", passed, total);
-		RunEncodingTest(&EncodeToUtf16LE, false, "UTF-16LE, no BOM", passed, total);
-		RunEncodingTest(&EncodeToUtf16LE, true, "UTF-16LE with BOM", passed, total);
-		RunEncodingTest(&EncodeToUtf16BE, false, "UTF-16BE, no BOM", passed, total);
-		RunEncodingTest(&EncodeToUtf16BE, true, "UTF-16BE with BOM", passed, total);
-		RunEncodingTest(&EncodeToUtf32LE, false, "UTF-32LE, no BOM", passed, total);
-		RunEncodingTest(&EncodeToUtf32LE, true, "UTF-32LE with BOM", passed, total);
-		RunEncodingTest(&EncodeToUtf32BE, false, "UTF-32BE, no BOM", passed, total);
-		RunEncodingTest(&EncodeToUtf32BE, true, "UTF-32BE with BOM", passed, total);
+		RunEncodingTest(&EncodeToUtf8, false, false, "UTF-8, no BOM", passed, total);
+		RunEncodingTest(&EncodeToUtf8, true, false, "UTF-8 with BOM", passed, total);
+		RunEncodingTest(&EncodeToUtf16LE, false, false, "UTF-16LE, no BOM", passed, total);
+		RunEncodingTest(&EncodeToUtf16LE, true, false, "UTF-16LE with BOM", passed, total);
+		RunEncodingTest(&EncodeToUtf16BE, false, false, "UTF-16BE, no BOM", passed, total);
+		RunEncodingTest(&EncodeToUtf16BE, true, false, "UTF-16BE with BOM", passed, total);
+		RunEncodingTest(&EncodeToUtf32LE, false, false, "UTF-32LE, no BOM", passed, total);
+		RunEncodingTest(&EncodeToUtf32LE, true, false, "UTF-32LE with BOM", passed, total);
+		RunEncodingTest(&EncodeToUtf32BE, false, false, "UTF-32BE, no BOM", passed, total);
+		RunEncodingTest(&EncodeToUtf32BE, true, false, "UTF-32BE with BOM", passed, total);
+		RunEncodingTest(&EncodeToUtf8, false, true, "UTF-8, no BOM, from buffer", passed, total);
+		RunEncodingTest(&EncodeToUtf8, true, true, "UTF-8 with BOM, from buffer", passed, total);
+		RunEncodingTest(&EncodeToUtf16LE, false, true, "UTF-16LE, no BOM, from buffer", passed, total);
+		RunEncodingTest(&EncodeToUtf16LE, true, true, "UTF-16LE with BOM, from buffer", passed, total);
+		RunEncodingTest(&EncodeToUtf16BE, false, true, "UTF-16BE, no BOM, from buffer", passed, total);
+		RunEncodingTest(&EncodeToUtf16BE, true, true, "UTF-16BE with BOM, from buffer", passed, total);
+		RunEncodingTest(&EncodeToUtf32LE, false, true, "UTF-32LE, no BOM, from buffer", passed, total);
+		RunEncodingTest(&EncodeToUtf32LE, true, true, "UTF-32LE with BOM, from buffer", passed, total);
+		RunEncodingTest(&EncodeToUtf32BE, false, true, "UTF-32BE, no BOM, from buffer", passed, total);
+		RunEncodingTest(&EncodeToUtf32BE, true, true, "UTF-32BE with BOM, from buffer", passed, total);
 
 		std::cout << "Parser tests: " << passed << "/" << total << " passed\n";
 		return passed == total;
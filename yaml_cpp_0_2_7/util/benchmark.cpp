@@ -0,0 +1,130 @@
+#include "yaml-cpp-0.2.7/yaml.h"
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Loads a large configuration (either the file given on the command line, or a generated one
+// with 'nGroups' maps of 'nKeys' scalar entries each) and reports the time spent parsing it,
+// both from a std::istream and from a contiguous buffer, the time spent looking up every
+// key of every map by name, and the time spent freeing the document; the buffer is parsed
+// into both a heap and an arena document (see NodeStorage).
+
+namespace
+{
+	double Seconds(std::clock_t start)
+	{
+		return static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+	}
+
+	void PrintParseTime(const char *name, double seconds, std::size_t size)
+	{
+		std::cout << name << seconds << " s (" << size / seconds / (1024 * 1024) << " MB/s)\n";
+	}
+
+	std::string GenerateConfig(int nGroups, int nKeys)
+	{
+		std::stringstream out;
+		for(int i=0;i<nGroups;i++) {
+			out << "group_" << i << ":\n";
+			for(int j=0;j<nKeys;j++)
+				out << "  parameter_" << j << ": " << (i * nKeys + j) * 0.5 << "\n";
+		}
+		return out.str();
+	}
+
+	typedef std::vector<std::pair<const YAML_0_2_7::Node *, std::string> > Keys;
+	
+	void CollectKeys(const YAML_0_2_7::Node& node, Keys& keys)
+	{
+		if(node.Type() == YAML_0_2_7::NodeType::Sequence) {
+			for(YAML_0_2_7::Iterator it=node.begin();it!=node.end();++it)
+				CollectKeys(*it, keys);
+		} else if(node.Type() == YAML_0_2_7::NodeType::Map) {
+			for(YAML_0_2_7::Iterator it=node.begin();it!=node.end();++it) {
+				std::string key;
+				if(it.first().GetScalar(key))
+					keys.push_back(std::make_pair(&node, key));
+				CollectKeys(it.second(), keys);
+			}
+		}
+	}
+
+	double LookupTime(const YAML_0_2_7::Node& doc, std::size_t& nFound, std::size_t& nKeys)
+	{
+		Keys keys;
+		CollectKeys(doc, keys);
+
+		std::clock_t start = std::clock();
+		nFound = 0;
+		for(std::size_t i=0;i<keys.size();i++) {
+			if(keys[i].first->FindValue(keys[i].second))
+				nFound++;
+		}
+		nKeys = keys.size();
+		return Seconds(start);
+	}
+
+	double FreeTime(YAML_0_2_7::Node& doc)
+	{
+		std::clock_t start = std::clock();
+		doc.Clear();
+		return Seconds(start);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	std::string input;
+	if(argc == 2) {
+		std::ifstream fin(argv[1]);
+		std::stringstream buffer;
+		buffer << fin.rdbuf();
+		input = buffer.str();
+	} else {
+		int nGroups = argc > 2 ? std::atoi(argv[1]) : 100;
+		int nKeys = argc > 2 ? std::atoi(argv[2]) : 1000;
+		input = GenerateConfig(nGroups, nKeys);
+	}
+
+	try {
+		YAML_0_2_7::Node streamDoc, doc, arenaDoc;
+		
+		std::clock_t start = std::clock();
+		std::stringstream stream(input);
+		YAML_0_2_7::Parser streamParser(stream);
+		streamParser.GetNextDocument(streamDoc);
+		double streamTime = Seconds(start);
+
+		start = std::clock();
+		YAML_0_2_7::Parser bufferParser(input.data(), input.size());
+		bufferParser.GetNextDocument(doc);
+		double bufferTime = Seconds(start);
+
+		start = std::clock();
+		YAML_0_2_7::Parser arenaParser(input.data(), input.size());
+		arenaParser.GetNextDocument(arenaDoc, YAML_0_2_7::NodeStorage::Arena);
+		double arenaTime = Seconds(start);
+
+		std::size_t nFound, nKeys, nArenaFound, nArenaKeys;
+		double lookupTime = LookupTime(doc, nFound, nKeys);
+		double arenaLookupTime = LookupTime(arenaDoc, nArenaFound, nArenaKeys);
+
+		std::cout << "input:  " << input.size() << " bytes\n";
+		PrintParseTime("parse (stream): ", streamTime, input.size());
+		PrintParseTime("parse (buffer): ", bufferTime, input.size());
+		PrintParseTime("parse (arena):  ", arenaTime, input.size());
+		std::cout << "lookup:         " << lookupTime << " s (" << nFound << "/" << nKeys << " keys found)\n";
+		std::cout << "lookup (arena): " << arenaLookupTime << " s (" << nArenaFound << "/" << nArenaKeys << " keys found)\n";
+		std::cout << "free:           " << FreeTime(doc) << " s\n";
+		std::cout << "free (arena):   " << FreeTime(arenaDoc) << " s\n";
+	} catch(const YAML_0_2_7::Exception& e) {
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+
+	return 0;
+}
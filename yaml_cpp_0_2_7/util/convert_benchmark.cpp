@@ -0,0 +1,73 @@
+#include "yaml-cpp-0.2.7/yaml.h"
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Times the conversion of numeric scalars (formatted the way the emitter writes them)
+// with YAML::Convert against a plain std::stringstream extraction.
+
+namespace
+{
+	double Seconds(std::clock_t start)
+	{
+		return static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+	}
+
+	template <typename T>
+	bool StreamConvert(const std::string& input, T& output)
+	{
+		std::stringstream stream(input);
+		stream.unsetf(std::ios::dec);
+		stream >> output;
+		return !!stream;
+	}
+
+	template <typename T>
+	void Run(const char *name, const std::vector<std::string>& scalars, int nRepeats)
+	{
+		T sum = 0, value = 0;
+		std::clock_t start = std::clock();
+		for(int r=0;r<nRepeats;r++)
+			for(std::size_t i=0;i<scalars.size();i++)
+				if(YAML_0_2_7::Convert(scalars[i], value))
+					sum += value;
+		double convertTime = Seconds(start);
+
+		start = std::clock();
+		for(int r=0;r<nRepeats;r++)
+			for(std::size_t i=0;i<scalars.size();i++)
+				if(StreamConvert(scalars[i], value))
+					sum -= value;
+		double streamTime = Seconds(start);
+
+		const double n = static_cast<double>(scalars.size()) * nRepeats;
+		std::cout << name << ": Convert " << convertTime / n * 1e9 << " ns, stringstream "
+			<< streamTime / n * 1e9 << " ns per scalar (" << sum << ")\n";
+	}
+}
+
+int main(int argc, char **argv)
+{
+	int nScalars = argc > 1 ? std::atoi(argv[1]) : 10000;
+	int nRepeats = argc > 2 ? std::atoi(argv[2]) : 20;
+
+	std::srand(0);
+	std::vector<std::string> doubles, ints;
+	for(int i=0;i<nScalars;i++) {
+		YAML_0_2_7::Emitter out;
+		out << (std::rand() - RAND_MAX / 2) / 1e5;
+		doubles.push_back(out.c_str());
+
+		std::stringstream stream;
+		stream << std::rand() - RAND_MAX / 2;
+		ints.push_back(stream.str());
+	}
+
+	Run<double>("double", doubles, nRepeats);
+	Run<float>("float", doubles, nRepeats);
+	Run<int>("int", ints, nRepeats);
+	return 0;
+}
@@ -0,0 +1,77 @@
+#include "yaml-cpp-0.2.7/yaml.h"
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Times emitting a matrix (a block sequence of flow sequences of numbers) value by value
+// against Emitter::WriteFlowSeq, in MB/s of output.
+
+namespace
+{
+	double Seconds(std::clock_t start)
+	{
+		return static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+	}
+
+	template <typename T>
+	void Run(const char *name, const std::vector<T>& values, int nRows, int nRepeats)
+	{
+		const int nCols = static_cast<int>(values.size()) / nRows;
+		std::size_t size = 0;
+
+		std::clock_t start = std::clock();
+		for(int r=0;r<nRepeats;r++) {
+			YAML_0_2_7::Emitter out;
+			out << YAML_0_2_7::BeginSeq;
+			for(int i=0;i<nRows;i++) {
+				out << YAML_0_2_7::Flow << YAML_0_2_7::BeginSeq;
+				for(int j=0;j<nCols;j++)
+					out << values[i * nCols + j];
+				out << YAML_0_2_7::EndSeq;
+			}
+			out << YAML_0_2_7::EndSeq;
+			size = out.size();
+		}
+		double valueTime = Seconds(start);
+		const std::size_t valueSize = size;
+
+		start = std::clock();
+		for(int r=0;r<nRepeats;r++) {
+			YAML_0_2_7::Emitter out;
+			out << YAML_0_2_7::BeginSeq;
+			for(int i=0;i<nRows;i++)
+				out.WriteFlowSeq(&values[i * nCols], nCols);
+			out << YAML_0_2_7::EndSeq;
+			size = out.size();
+		}
+		double bulkTime = Seconds(start);
+
+		const double mb = 1024.0 * 1024.0;
+		std::cout << name << ": value by value " << valueSize * nRepeats / valueTime / mb << " MB/s, WriteFlowSeq "
+			<< size * nRepeats / bulkTime / mb << " MB/s (" << size / mb << " MB)\n";
+	}
+}
+
+int main(int argc, char **argv)
+{
+	int nRows = argc > 1 ? std::atoi(argv[1]) : 1000;
+	int nCols = argc > 2 ? std::atoi(argv[2]) : 100;
+	int nRepeats = argc > 3 ? std::atoi(argv[3]) : 5;
+
+	std::srand(0);
+	std::vector<double> doubles;
+	std::vector<float> floats;
+	std::vector<int> ints;
+	for(int i=0;i<nRows * nCols;i++) {
+		doubles.push_back((std::rand() - RAND_MAX / 2) / 1e5);
+		floats.push_back(static_cast<float>(doubles.back()));
+		ints.push_back(std::rand() - RAND_MAX / 2);
+	}
+
+	Run("double", doubles, nRows, nRepeats);
+	Run("float", floats, nRows, nRepeats);
+	Run("int", ints, nRows, nRepeats);
+	return 0;
+}
@@ -7,6 +7,7 @@
 #ifndef _YAML_EIGEN_UTILITIES_BINARY_UTILITIES_HPP_
     #define _YAML_EIGEN_UTILITIES_BINARY_UTILITIES_HPP_
 
+#include <algorithm>
 #include <yaml_utilities/binary_utilities.hpp>
 #include <yaml_eigen_utilities/yaml_eigen_utilities.hpp>
 
@@ -14,23 +15,110 @@
 namespace yaml_utilities
 {
 
-    template<>
-inline void yaml_write_binary(YAML::Emitter &out, const Eigen::MatrixXd &X)
+/**
+ * @brief Name of a coefficient type in the whole-matrix binary form
+ */
+template<typename Scalar>
+struct binary_dtype;
+
+template<>
+struct binary_dtype<float> { static const char *name() { return "float32"; } };
+template<>
+struct binary_dtype<double> { static const char *name() { return "float64"; } };
+template<>
+struct binary_dtype<int> { static const char *name() { return "int32"; } };
+
+inline bool binary_is_little_endian()
+{
+    const unsigned short value = 1;
+    return *reinterpret_cast<const unsigned char*>(&value) == 1;
+}
+
+/**
+ * @brief yaml_write_binary_matrix Write a whole matrix as one Base 64 blob of its column-major
+ * coefficients, along with their type, byte order and the shape:
+ *   {dtype: float64, byte_order: little, shape: [rows, cols], data: ...}
+ */
+template<typename Derived>
+void yaml_write_binary_matrix(YAML::Emitter &out, const Eigen::PlainObjectBase<Derived> &X)
 {
-    out << YAML::BeginSeq;
-    for (int i = 0; i < X.rows(); ++i)
+    typedef typename Derived::Scalar Scalar;
+    if (Derived::IsRowMajor && X.rows() > 1 && X.cols() > 1)
     {
-        out << YAML::Flow << YAML::BeginSeq;
-        for (int j = 0; j < X.cols(); ++j)
-            yaml_write_binary(out, X.coeff(i, j));
-        out << YAML::EndSeq;
+        yaml_write_binary_matrix(out, Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>(X));
+        return;
     }
-    out << YAML::EndSeq;
+
+    out << YAML::BeginMap
+        << YAML::Key << "dtype" << YAML::Value << binary_dtype<Scalar>::name()
+        << YAML::Key << "byte_order" << YAML::Value << (binary_is_little_endian() ? "little" : "big")
+        << YAML::Key << "shape" << YAML::Value << YAML::Flow << YAML::BeginSeq << X.rows() << X.cols() << YAML::EndSeq
+        << YAML::Key << "data" << YAML::Value;
+    yaml_write_binary(out, X.data(), X.size() * sizeof(Scalar));
+    out << YAML::EndMap;
+}
+
+/**
+ * @brief yaml_read_binary_matrix Read a matrix written by yaml_write_binary_matrix(), decoding
+ * the blob straight into its storage
+ */
+template<typename Derived>
+void yaml_read_binary_matrix(const YAML::Node &in, Eigen::PlainObjectBase<Derived> &X)
+{
+    typedef typename Derived::Scalar Scalar;
+    std::string dtype, byteOrder;
+    in["dtype"] >> dtype;
+    common_assert_msg(dtype == binary_dtype<Scalar>::name(), "Type not equal. Eigen = " << binary_dtype<Scalar>::name() << ", Yaml = " << dtype);
+    in["byte_order"] >> byteOrder;
+    common_assert_msg(byteOrder == "little" || byteOrder == "big", "Invalid byte order: " << byteOrder);
+
+    const YAML::Node &shape = in["shape"];
+    common_assert_msg(shape.size() == 2, "Shape must be [rows, cols]");
+    int rows, cols;
+    shape[0] >> rows;
+    shape[1] >> cols;
+    common_assert_msg(rows >= 0 && cols >= 0, "Invalid shape: " << rows << " x " << cols);
+    common_assert_msg(Derived::RowsAtCompileTime == Eigen::Dynamic || Derived::RowsAtCompileTime == rows, "Rows not equal. Eigen = " << Derived::RowsAtCompileTime << ", Yaml = " << rows);
+    common_assert_msg(Derived::ColsAtCompileTime == Eigen::Dynamic || Derived::ColsAtCompileTime == cols, "Cols not equal. Eigen = " << Derived::ColsAtCompileTime << ", Yaml = " << cols);
+
+    if (Derived::IsRowMajor && rows > 1 && cols > 1)
+    {
+        Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> colMajor;
+        yaml_read_binary_matrix(in, colMajor);
+        X = colMajor;
+        return;
+    }
+
+    X.resize(rows, cols);
+    std::string data;
+    in["data"] >> data;
+    bool decoded = decode_base64(data, X.data(), X.size() * sizeof(Scalar));
+    common_assert_msg(decoded, "Data does not hold " << rows << " x " << cols << " " << dtype << " values");
+
+    if ((byteOrder == "little") != binary_is_little_endian())
+    {
+        unsigned char *bytes = reinterpret_cast<unsigned char*>(X.data());
+        for (int i = 0; i < X.size(); ++i, bytes += sizeof(Scalar))
+            std::reverse(bytes, bytes + sizeof(Scalar));
+    }
+}
+
+    template<>
+inline void yaml_write_binary(YAML::Emitter &out, const Eigen::MatrixXd &X)
+{
+    yaml_write_binary_matrix(out, X);
 }
 
     template<>
 inline void yaml_read_binary(const YAML::Node &out, Eigen::MatrixXd &X)
 {
+    if (out.Type() == YAML::NodeType::Map)
+    {
+        yaml_read_binary_matrix(out, X);
+        return;
+    }
+
+    // Legacy form, with a Base 64 string per coefficient
     int rows = out.size();
     if (rows > 0)
     {
@@ -47,15 +135,19 @@ inline void yaml_read_binary(const YAML::Node &out, Eigen::MatrixXd &X)
     template<>
 inline void yaml_write_binary(YAML::Emitter &out, const Eigen::VectorXd &X)
 {
-    out << YAML::Flow << YAML::BeginSeq;
-    for (int i = 0; i < X.rows(); ++i)
-        yaml_write_binary(out, X.coeff(i));
-    out << YAML::EndSeq;
+    yaml_write_binary_matrix(out, X);
 }
 
     template<>
 inline void yaml_read_binary(const YAML::Node &out, Eigen::VectorXd &X)
 {
+    if (out.Type() == YAML::NodeType::Map)
+    {
+        yaml_read_binary_matrix(out, X);
+        return;
+    }
+
+    // Legacy form, with a Base 64 string per coefficient
     int rows = out.size();
     X.resize(rows);
     for (int i = 0; i < rows; ++i)
@@ -0,0 +1,494 @@
+/**
+ * @brief Event-driven (SAX-style) loading of Eigen matrices, vectors and scalars, without building a YAML::Node tree
+ */
+#ifndef _YAML_EIGEN_UTILITIES_EVENT_LOADER_HPP_
+#define _YAML_EIGEN_UTILITIES_EVENT_LOADER_HPP_
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <Eigen/Dense>
+#include <common_assert/common_assert.hpp>
+#include <yaml_utilities/yaml_utilities.hpp>
+
+// Note the namespacing
+namespace yaml_utilities
+{
+
+/**
+ * @brief Fills bound values straight from the parser events of a document.
+ *
+ * Values are bound by key path: map keys and sequence indices from the document root, separated by '/'
+ * (e.g. "domains/0/alpha"); the empty path is the document itself. Subtrees that do not lead to a bound
+ * path are skipped without being converted or stored.
+ *
+ * Matrices and vectors take the same layouts as YAML::operator>> (a list of rows, a single list, or a
+ * scalar for a one-element vector); the values are collected into a buffer sized from the target, and
+ * copied over with a single resize at the end of the sequence. Other types go through YAML::Convert.
+ *
+ * @code
+ *     EigenEventLoader loader;
+ *     loader.bind("alpha", alpha);
+ *     loader.bind("period", period);
+ *     yaml_handle_file(path, loader);
+ * @endcode
+ *
+ * @note Aliases are only resolved for scalars, and paths bound inside each other are not supported.
+ */
+class EigenEventLoader : public YAML::EventHandler
+{
+public:
+    EigenEventLoader()
+        : m_skipDepth(0), m_skipRole(ROLE_VALUE), m_target(0), m_targetDepth(0)
+    { }
+
+    template<typename Scalar, int Rows, int Cols, int Options, int MaxRows, int MaxCols>
+    void bind(const std::string &path, Eigen::Matrix<Scalar, Rows, Cols, Options, MaxRows, MaxCols> &X)
+    {
+        add_target(path, new MatrixTarget<Eigen::Matrix<Scalar, Rows, Cols, Options, MaxRows, MaxCols> >(path, X));
+    }
+
+    template<typename T>
+    void bind(const std::string &path, T &value)
+    {
+        add_target(path, new ScalarTarget<T>(path, value));
+    }
+
+    /**
+     * @brief Bound paths that did not appear in the last document
+     */
+    std::vector<std::string> missing_paths() const
+    {
+        std::vector<std::string> missing;
+        for (Targets::const_iterator it = m_targets.begin(); it != m_targets.end(); ++it)
+            if (!it->second->loaded)
+                missing.push_back(it->first);
+        return missing;
+    }
+
+    virtual void OnDocumentStart(const YAML::Mark &)
+    {
+        for (Targets::iterator it = m_targets.begin(); it != m_targets.end(); ++it)
+            it->second->loaded = false;
+        m_frames.clear();
+        m_path.clear();
+        m_anchors.clear();
+        m_skipDepth = 0;
+        m_target = 0;
+        m_targetDepth = 0;
+    }
+
+    virtual void OnDocumentEnd()
+    { }
+
+    virtual void OnNull(const YAML::Mark &mark, YAML::anchor_t anchor)
+    {
+        on_scalar(mark, anchor, "~");
+    }
+
+    virtual void OnAlias(const YAML::Mark &mark, YAML::anchor_t anchor)
+    {
+        std::map<YAML::anchor_t, std::string>::const_iterator it = m_anchors.find(anchor);
+        if (it != m_anchors.end())
+        {
+            on_scalar(mark, YAML::NullAnchor, it->second);
+            return;
+        }
+
+        // An aliased collection: it can neither name nor fill a bound value
+        if (m_skipDepth > 0)
+            return;
+        common_assert_msg(!m_target, "Alias of a collection in '" << m_target->path << "'");
+        NodeRole role = begin_node();
+        common_assert_msg(role != ROLE_VALUE || !m_targets.count(m_path), "Alias of a collection bound to '" << m_path << "'");
+        if (role != ROLE_KEY)
+            end_value();
+    }
+
+    virtual void OnScalar(const YAML::Mark &mark, const std::string &, YAML::anchor_t anchor, const std::string &value)
+    {
+        on_scalar(mark, anchor, value);
+    }
+
+    virtual void OnSequenceStart(const YAML::Mark &mark, const std::string &, YAML::anchor_t)
+    {
+        if (m_target)
+        {
+            m_target->on_sequence_start(mark, ++m_targetDepth);
+            return;
+        }
+        if (m_skipDepth > 0)
+        {
+            ++m_skipDepth;
+            return;
+        }
+
+        NodeRole role = begin_node();
+        if (role == ROLE_VALUE)
+        {
+            Targets::iterator it = m_targets.find(m_path);
+            if (it != m_targets.end())
+            {
+                m_target = it->second.get();
+                m_targetDepth = 1;
+                m_target->begin();
+                m_target->on_sequence_start(mark, m_targetDepth);
+                return;
+            }
+        }
+        begin_collection(role, false);
+    }
+
+    virtual void OnSequenceEnd()
+    {
+        if (m_target)
+        {
+            m_target->on_sequence_end(m_targetDepth);
+            if (--m_targetDepth == 0)
+            {
+                m_target->end();
+                m_target = 0;
+                end_value();
+            }
+            return;
+        }
+        end_collection();
+    }
+
+    virtual void OnMapStart(const YAML::Mark &, const std::string &, YAML::anchor_t)
+    {
+        common_assert_msg(!m_target, "Unexpected map in '" << m_target->path << "'");
+        if (m_skipDepth > 0)
+        {
+            ++m_skipDepth;
+            return;
+        }
+
+        NodeRole role = begin_node();
+        common_assert_msg(role != ROLE_VALUE || !m_targets.count(m_path), "Unexpected map at '" << m_path << "'");
+        begin_collection(role, true);
+    }
+
+    virtual void OnMapEnd()
+    {
+        end_collection();
+    }
+
+private:
+    /**
+     * @brief A bound value, fed the events of its node; depth is the number of enclosing sequences
+     * within that node
+     */
+    class Target
+    {
+    public:
+        Target(const std::string &path_)
+            : path(path_), loaded(false)
+        { }
+        virtual ~Target()
+        { }
+
+        virtual void begin() = 0;
+        virtual void on_scalar(const YAML::Mark &mark, const std::string &value, int depth) = 0;
+        virtual void on_sequence_start(const YAML::Mark &mark, int depth) = 0;
+        virtual void on_sequence_end(int depth) = 0;
+        virtual void end() = 0;
+
+        const std::string path;
+        bool loaded;
+
+    protected:
+        template<typename T>
+        static void convert(const YAML::Mark &mark, const std::string &value, T &x)
+        {
+            if (!YAML::Convert(value, x))
+                throw YAML::InvalidScalar(mark);
+        }
+    };
+
+    template<typename T>
+    class ScalarTarget : public Target
+    {
+    public:
+        ScalarTarget(const std::string &path, T &value)
+            : Target(path), m_value(value)
+        { }
+
+        virtual void begin()
+        {
+            loaded = true;
+        }
+        virtual void on_scalar(const YAML::Mark &mark, const std::string &value, int)
+        {
+            convert(mark, value, m_value);
+        }
+        virtual void on_sequence_start(const YAML::Mark &, int)
+        {
+            common_assert_msg(false, "Expected a scalar for '" << path << "'");
+        }
+        virtual void on_sequence_end(int)
+        { }
+        virtual void end()
+        { }
+
+    private:
+        T &m_value;
+    };
+
+    template<typename Matrix>
+    class MatrixTarget : public Target
+    {
+    public:
+        typedef typename Matrix::Scalar Scalar;
+
+        MatrixTarget(const std::string &path, Matrix &X)
+            : Target(path), m_X(X), m_rows(0), m_cols(0), m_rowStart(0), m_nested(false)
+        { }
+
+        virtual void begin()
+        {
+            loaded = true;
+            m_values.clear();
+            // The current size is the best guess there is (exact for fixed-size and presized targets)
+            m_values.reserve(m_X.size());
+            m_rows = 0;
+            m_cols = 0;
+            m_nested = false;
+        }
+
+        virtual void on_scalar(const YAML::Mark &mark, const std::string &value, int depth)
+        {
+            common_assert_msg(depth != 1 || !m_nested, "Mixed scalars and rows in '" << path << "'");
+            Scalar x;
+            convert(mark, value, x);
+            m_values.push_back(x);
+        }
+
+        virtual void on_sequence_start(const YAML::Mark &, int depth)
+        {
+            if (depth == 1)
+                return;
+            common_assert_msg(depth == 2 && !Matrix::IsVectorAtCompileTime, "Too many nested lists in '" << path << "'");
+            common_assert_msg(m_nested || m_values.empty(), "Mixed scalars and rows in '" << path << "'");
+            m_nested = true;
+            m_rowStart = m_values.size();
+        }
+
+        virtual void on_sequence_end(int depth)
+        {
+            if (depth != 2)
+                return;
+            int cols = m_values.size() - m_rowStart;
+            if (m_rows == 0)
+            {
+                m_cols = cols;
+                if ((int)m_X.cols() == cols)
+                    m_values.reserve(m_X.rows() * cols);
+            }
+            common_assert_msg(cols == m_cols, "Row " << m_rows << " of '" << path << "' has " << cols << " entries, expected " << m_cols);
+            ++m_rows;
+        }
+
+        virtual void end()
+        {
+            if (m_nested)
+            {
+                if (Matrix::SizeAtCompileTime == Eigen::Dynamic)
+                    m_X.resize(m_rows, m_cols);
+                common_assert_msg(m_X.rows() == m_rows, "Rows not equal. Eigen = " << m_X.rows() << ", Yaml = " << m_rows);
+                common_assert_msg(m_X.cols() == m_cols, "Cols not equal. Eigen = " << m_X.cols() << ", Yaml = " << m_cols);
+                m_X = Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> >(m_values.empty() ? 0 : &m_values[0], m_rows, m_cols);
+                return;
+            }
+
+            // A single list (or scalar) is read as a vector, i.e. a row for matrices
+            int size = m_values.size();
+            if (Matrix::SizeAtCompileTime == Eigen::Dynamic)
+            {
+                if (Matrix::IsVectorAtCompileTime)
+                    m_X.resize(Matrix::RowsAtCompileTime == 1 ? 1 : size, Matrix::RowsAtCompileTime == 1 ? size : 1);
+                else if (size == 0)
+                    m_X.resize(0, 0);
+                else
+                    m_X.resize(1, size);
+            }
+            common_assert_msg(m_X.size() == size, "Size not equal. Eigen = " << m_X.size() << ", Yaml = " << size);
+            for (int i = 0; i < size; ++i)
+                m_X(i) = m_values[i];
+        }
+
+    private:
+        Matrix &m_X;
+        std::vector<Scalar> m_values;
+        int m_rows;
+        int m_cols;
+        int m_rowStart;
+        bool m_nested;
+    };
+
+    typedef std::map<std::string, boost::shared_ptr<Target> > Targets;
+
+    /**
+     * @brief An open map or sequence that leads to a bound path
+     */
+    struct Frame
+    {
+        bool isMap;
+        bool haveKey;
+        bool keyValid;
+        std::string key;
+        int index;
+        std::size_t pathSize;
+    };
+
+    enum NodeRole
+    {
+        ROLE_KEY,
+        ROLE_VALUE,
+        ROLE_UNREACHABLE ///< Value of a key that cannot be part of a path
+    };
+
+    void add_target(const std::string &path, Target *target)
+    {
+        m_targets[path].reset(target);
+        for (std::size_t i = path.find('/'); i != std::string::npos; i = path.find('/', i + 1))
+            m_prefixes.insert(path.substr(0, i));
+        if (!path.empty())
+            m_prefixes.insert(std::string());
+    }
+
+    /**
+     * @brief Takes the next node of the innermost frame; for values, m_path becomes its path
+     */
+    NodeRole begin_node()
+    {
+        if (m_frames.empty())
+        {
+            m_path.clear();
+            return ROLE_VALUE;
+        }
+
+        Frame &frame = m_frames.back();
+        m_path.resize(frame.pathSize);
+        if (frame.isMap && !frame.haveKey)
+        {
+            frame.haveKey = true;
+            frame.keyValid = false;
+            return ROLE_KEY;
+        }
+        if (frame.isMap && !frame.keyValid)
+            return ROLE_UNREACHABLE;
+
+        if (!m_path.empty())
+            m_path += '/';
+        if (frame.isMap)
+            m_path += frame.key;
+        else
+            append_index(frame.index);
+        return ROLE_VALUE;
+    }
+
+    void end_value()
+    {
+        if (m_frames.empty())
+            return;
+        Frame &frame = m_frames.back();
+        if (frame.isMap)
+            frame.haveKey = false;
+        else
+            ++frame.index;
+    }
+
+    void on_scalar(const YAML::Mark &mark, YAML::anchor_t anchor, const std::string &value)
+    {
+        if (anchor)
+            m_anchors[anchor] = value;
+        if (m_target)
+        {
+            m_target->on_scalar(mark, value, m_targetDepth);
+            return;
+        }
+        if (m_skipDepth > 0)
+            return;
+
+        NodeRole role = begin_node();
+        if (role == ROLE_KEY)
+        {
+            m_frames.back().key = value;
+            m_frames.back().keyValid = true;
+            return;
+        }
+        if (role == ROLE_VALUE)
+        {
+            Targets::iterator it = m_targets.find(m_path);
+            if (it != m_targets.end())
+            {
+                it->second->begin();
+                it->second->on_scalar(mark, value, 0);
+                it->second->end();
+            }
+        }
+        end_value();
+    }
+
+    void begin_collection(NodeRole role, bool isMap)
+    {
+        if (role == ROLE_VALUE && m_prefixes.count(m_path))
+        {
+            Frame frame;
+            frame.isMap = isMap;
+            frame.haveKey = false;
+            frame.keyValid = false;
+            frame.index = 0;
+            frame.pathSize = m_path.size();
+            m_frames.push_back(frame);
+            return;
+        }
+        m_skipDepth = 1;
+        m_skipRole = role;
+    }
+
+    void end_collection()
+    {
+        if (m_skipDepth > 0)
+        {
+            if (--m_skipDepth == 0 && m_skipRole != ROLE_KEY)
+                end_value();
+            return;
+        }
+        m_frames.pop_back();
+        end_value();
+    }
+
+    void append_index(int index)
+    {
+        char digits[16];
+        int n = 0;
+        do
+        {
+            digits[n++] = '0' + index % 10;
+            index /= 10;
+        } while (index > 0);
+        while (n > 0)
+            m_path += digits[--n];
+    }
+
+    Targets m_targets;
+    std::set<std::string> m_prefixes; ///< Paths of the maps and sequences that contain a bound path
+
+    std::vector<Frame> m_frames;
+    std::string m_path;
+    std::map<YAML::anchor_t, std::string> m_anchors; ///< Scalars only
+
+    int m_skipDepth; ///< Depth within a skipped map or sequence
+    NodeRole m_skipRole;
+    Target *m_target; ///< Target being filled, and the depth within it
+    int m_targetDepth;
+};
+
+} // namespace yaml_utilities
+
+#endif
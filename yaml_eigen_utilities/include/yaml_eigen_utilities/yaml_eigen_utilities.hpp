@@ -87,13 +87,55 @@ void eigen_read_matrix(const Node &in, Eigen::MatrixBase<Derived> &X)
 
 // Writing 
 
+// Vectors of these go through Emitter::WriteFlowSeq() (exact, and much faster than value by value)
+template<typename Scalar>
+struct eigen_flow_seq_scalar { enum { value = 0 }; };
+template<>
+struct eigen_flow_seq_scalar<double> { enum { value = 1 }; };
+template<>
+struct eigen_flow_seq_scalar<float> { enum { value = 1 }; };
+template<>
+struct eigen_flow_seq_scalar<int> { enum { value = 1 }; };
+
+template<typename Derived,
+    int FlowSeq = eigen_flow_seq_scalar<typename Derived::Scalar>::value,
+    int DirectAccess = (Derived::Flags & Eigen::DirectAccessBit) ? 1 : 0>
+struct eigen_vector_writer
+{
+    static void write(Emitter &out, const Eigen::MatrixBase<Derived> &X)
+    {
+        out << Flow << BeginSeq;
+        for (uint i = 0; i < (uint)X.size(); ++i)
+            out << X.coeff(i);
+        out << EndSeq;
+    }
+};
+
+// Coefficients in memory (e.g., rows of column-major matrices), written where they are
+template<typename Derived>
+struct eigen_vector_writer<Derived, 1, 1>
+{
+    static void write(Emitter &out, const Eigen::MatrixBase<Derived> &X)
+    {
+        out.WriteFlowSeq(X.derived().data(), X.size(), X.innerStride());
+    }
+};
+
+// Other expressions, evaluated first
+template<typename Derived>
+struct eigen_vector_writer<Derived, 1, 0>
+{
+    static void write(Emitter &out, const Eigen::MatrixBase<Derived> &X)
+    {
+        const typename Derived::PlainObject plain = X;
+        out.WriteFlowSeq(plain.data(), plain.size());
+    }
+};
+
 template<typename Derived>
 void eigen_write_vector(Emitter &out, const Eigen::MatrixBase<Derived> &X)
 {
-    out << Flow << BeginSeq;
-    for (uint i = 0; i < (uint)X.size(); ++i)
-        out << X.coeff(i);
-    out << EndSeq;
+    eigen_vector_writer<Derived>::write(out, X);
 }
 
 template<typename Derived>
@@ -10,6 +10,7 @@
 #include <yaml_utilities/yaml_utilities.hpp>
 #include <yaml_eigen_utilities/yaml_eigen_utilities.hpp>
 #include <yaml_eigen_utilities/binary_utilities.hpp>
+#include <yaml_eigen_utilities/event_loader.hpp>
 
 using namespace std;
 using namespace YAML;
@@ -49,6 +50,48 @@ TEST(yaml_utilities, MatrixWrite)
     EXPECT_EQ(expected, actual);
 }
 
+/**
+ * @brief MatrixWriteExact Values read back exactly, from matrices, strided rows and expressions alike
+ */
+TEST(yaml_utilities, MatrixWriteExact)
+{
+    MatrixXd X = MatrixXd::Random(3, 5);
+    X(0, 0) = 0.1 + 0.2;
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> Y = X;
+    Eigen::MatrixXi Z(2, 2);
+    Z << 1, -2, 30, 400;
+
+    Emitter out;
+    out << BeginMap
+        << Key << "X" << Value << X
+        << Key << "Y" << Value << Y
+        << Key << "twice" << Value << MatrixXd(2 * X)
+        << Key << "expression" << Value << 2 * X.col(1)
+        << Key << "row" << Value << X.row(2)
+        << Key << "Z" << Value << Z
+        << EndMap;
+
+    Node node;
+    yaml_read_string(out.c_str(), node);
+    MatrixXd X_actual, twice_actual;
+    VectorXd expression_actual;
+    Eigen::RowVectorXd row_actual;
+    Eigen::MatrixXi Z_actual;
+    node["X"] >> X_actual;
+    EXPECT_EQ(X, X_actual);
+    node["Y"] >> X_actual;
+    EXPECT_EQ(X, X_actual);
+    node["twice"] >> twice_actual;
+    EXPECT_EQ(2 * X, twice_actual);
+    node["expression"] >> expression_actual;
+    EXPECT_EQ(2 * X.col(1), expression_actual);
+    node["row"] >> row_actual;
+    EXPECT_EQ(X.row(2), row_actual);
+    node["Z"] >> Z_actual;
+    EXPECT_EQ(Z, Z_actual);
+    EXPECT_EQ(node["Z"][1][0].to<string>(), "30");
+}
+
 /**
  * @brief MatrixRead Read a dynamically sized matrix
  */
@@ -172,6 +215,78 @@ TEST(yaml_utilities, BinaryReadAndWriteMatrix)
 }
 
 
+TEST(yaml_utilities, BinaryMatrixBlob)
+{
+    MatrixXd x_expected(2, 3);
+    x_expected <<
+        1, 2, 3,
+        4, 5, 6;
+    {
+        Emitter out;
+        yaml_write_binary(out, x_expected);
+
+        Node node;
+        yaml_read_string(out.c_str(), node);
+        EXPECT_EQ(node["dtype"].to<string>(), "float64");
+        EXPECT_EQ(node["shape"][0].to<int>(), 2);
+        EXPECT_EQ(node["shape"][1].to<int>(), 3);
+
+        // Row-major and fixed-size targets
+        Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> x_row;
+        yaml_read_binary_matrix(node, x_row);
+        EXPECT_EQ(x_expected, MatrixXd(x_row));
+        Eigen::Matrix<double, 2, 3> x_fixed;
+        yaml_read_binary_matrix(node, x_fixed);
+        EXPECT_EQ(x_expected, MatrixXd(x_fixed));
+        Eigen::Matrix3d x_wrong;
+        EXPECT_THROW(yaml_read_binary_matrix(node, x_wrong), common::assert_error);
+        Eigen::MatrixXf x_float;
+        EXPECT_THROW(yaml_read_binary_matrix(node, x_float), common::assert_error);
+    }
+
+    {
+        // Written on a machine of the other byte order
+        MatrixXd x_swapped = x_expected;
+        unsigned char *bytes = reinterpret_cast<unsigned char*>(x_swapped.data());
+        for (int i = 0; i < x_swapped.size(); ++i)
+            std::reverse(bytes + i * sizeof(double), bytes + (i + 1) * sizeof(double));
+        Emitter out;
+        out << BeginMap
+            << Key << "dtype" << Value << "float64"
+            << Key << "byte_order" << Value << (binary_is_little_endian() ? "big" : "little")
+            << Key << "shape" << Value << Flow << BeginSeq << 2 << 3 << EndSeq
+            << Key << "data" << Value << encode_base64(bytes, x_swapped.size() * sizeof(double))
+            << EndMap;
+
+        MatrixXd x_actual;
+        Node node;
+        yaml_read_string(out.c_str(), node);
+        yaml_read_binary(node, x_actual);
+        EXPECT_EQ(x_expected, x_actual);
+    }
+
+    {
+        // Legacy form, with a string per coefficient
+        Emitter out;
+        out << BeginSeq;
+        for (int i = 0; i < x_expected.rows(); ++i)
+        {
+            out << Flow << BeginSeq;
+            for (int j = 0; j < x_expected.cols(); ++j)
+                yaml_write_binary(out, x_expected(i, j));
+            out << EndSeq;
+        }
+        out << EndSeq;
+
+        MatrixXd x_actual;
+        Node node;
+        yaml_read_string(out.c_str(), node);
+        yaml_read_binary(node, x_actual);
+        EXPECT_EQ(x_expected, x_actual);
+    }
+}
+
+
 
 /**
  * @brief VectorRead Read a stl vector of doubles into a dynamically sized vector
@@ -194,6 +309,114 @@ TEST(yaml_utilities, BinaryReadAndWriteSTLVector)
     EXPECT_EQ(expected, actual);
 }
 
+/**
+ * @brief EventLoaderReadsBoundPaths Fill matrices, vectors and scalars by key path, skipping everything else
+ */
+TEST(yaml_utilities, EventLoaderReadsBoundPaths)
+{
+    string input =
+            "name: &n walk\n"
+            "skipped: {a: [1, 2, [3]], b: *n}\n"
+            "domains:\n"
+            "  - {alpha: [[1, 2, 3], [4, 5, 6]], tau: [0.5, 1]}\n"
+            "  - {alpha: [[7, 8], [9, 10]], period: 0.25}\n"
+            "? [complex, key]\n"
+            ": {alpha: [[0]]}\n"
+            "? *n\n"
+            ": [1, 2, 3, 4]\n"
+            "row: [5, 6, 7]\n"
+            "single: 3\n";
+
+    MatrixXd alpha0, alpha1;
+    VectorXd tau, single;
+    Eigen::Matrix2d fixed;
+    Eigen::Matrix<double, 1, Eigen::Dynamic> row;
+    double period = 0;
+    string name;
+    int missing = -1;
+
+    EigenEventLoader loader;
+    loader.bind("domains/0/alpha", alpha0);
+    loader.bind("domains/0/tau", tau);
+    loader.bind("domains/1/alpha", alpha1);
+    loader.bind("domains/1/period", period);
+    loader.bind("walk", fixed);
+    loader.bind("row", row);
+    loader.bind("single", single);
+    loader.bind("name", name);
+    loader.bind("domains/2/missing", missing);
+    yaml_handle_string(input, loader);
+
+    Node node;
+    yaml_read_string(input, node);
+    MatrixXd expected;
+    node["domains"][0]["alpha"] >> expected;
+    EXPECT_EQ(expected, alpha0);
+    node["domains"][1]["alpha"] >> expected;
+    EXPECT_EQ(expected, alpha1);
+    VectorXd tau_expected;
+    node["domains"][0]["tau"] >> tau_expected;
+    EXPECT_EQ(tau_expected, tau);
+    EXPECT_EQ(0.25, period);
+    EXPECT_EQ("walk", name);
+    Eigen::Matrix2d fixed_expected;
+    fixed_expected << 1, 3, 2, 4;
+    EXPECT_EQ(fixed_expected, fixed);
+    EXPECT_EQ(1, row.rows());
+    EXPECT_EQ(3, row.cols());
+    EXPECT_EQ(7, row(2));
+    EXPECT_EQ(1, single.size());
+    EXPECT_EQ(3, single(0));
+    EXPECT_EQ(-1, missing);
+
+    vector<string> missing_paths = loader.missing_paths();
+    ASSERT_EQ(1u, missing_paths.size());
+    EXPECT_EQ("domains/2/missing", missing_paths[0]);
+}
+
+/**
+ * @brief EventLoaderMatchesNodeReader Load a large matrix both ways
+ */
+TEST(yaml_utilities, EventLoaderMatchesNodeReader)
+{
+    MatrixXd X = MatrixXd::Random(200, 30);
+    Emitter out;
+    out << BeginMap << Key << "X" << Value << X << EndMap;
+    string input;
+    yaml_write_string(input, out);
+
+    Node node;
+    yaml_read_string(input, node);
+    MatrixXd expected;
+    node["X"] >> expected;
+
+    MatrixXd actual(200, 30);
+    EigenEventLoader loader;
+    loader.bind("X", actual);
+    yaml_handle_string(input, loader);
+    EXPECT_EQ(expected, actual);
+    EXPECT_TRUE(loader.missing_paths().empty());
+}
+
+/**
+ * @brief EventLoaderRejectsMismatches Sizes and shapes are checked like the node reader does
+ */
+TEST(yaml_utilities, EventLoaderRejectsMismatches)
+{
+    Eigen::Matrix2d fixed;
+    EigenEventLoader fixed_loader;
+    fixed_loader.bind("X", fixed);
+    EXPECT_THROW(yaml_handle_string("X: [[1, 2, 3], [4, 5, 6]]", fixed_loader), common::assert_error);
+
+    MatrixXd ragged;
+    EigenEventLoader ragged_loader;
+    ragged_loader.bind("X", ragged);
+    EXPECT_THROW(yaml_handle_string("X: [[1, 2], [3]]", ragged_loader), common::assert_error);
+    EXPECT_THROW(yaml_handle_string("X: [1, [2, 3]]", ragged_loader), common::assert_error);
+    EXPECT_THROW(yaml_handle_string("X: {a: 1}", ragged_loader), common::assert_error);
+    EXPECT_THROW(yaml_handle_string("X: [[1, a]]", ragged_loader), YAML::InvalidScalar);
+}
+
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -22,13 +22,47 @@ namespace yaml_utilities
  */
 std::string encode_base64(const unsigned char *data, std::size_t size);
 
+/**
+ * @brief base64_encoded_size Number of characters encoding a set of bytes
+ */
+std::size_t base64_encoded_size(std::size_t size);
+
+/**
+ * @brief encode_base64 Encode a set of bytes to Base 64 into a preallocated buffer
+ * @param out Room for base64_encoded_size(size) characters (not null-terminated)
+ */
+void encode_base64(const unsigned char *data, std::size_t size, char *out);
+
+/**
+ * @brief encode_base64 Encode a set of bytes to Base 64, reusing the storage of a string
+ */
+void encode_base64(const unsigned char *data, std::size_t size, std::string &out);
+
 /**
  * @brief decode_base64 Decode a set of bytes from Base 64 to a string
  * @param input
- * @param ret
+ * @param ret Cleared if the input is not Base 64
  */
 void decode_base64(const std::string& input, std::vector<unsigned char> &ret);
 
+/**
+ * @brief decode_base64 Decode a set of bytes from Base 64 straight into a buffer of known size
+ * @return false if the input is not Base 64 or does not decode to exactly size bytes
+ */
+bool decode_base64(const std::string& input, void *data, std::size_t size);
+
+/**
+ * @brief decode_base64 Same as above for input that is not held by a string
+ * @param inputSize Number of characters of input (not null-terminated)
+ */
+bool decode_base64(const char *input, std::size_t inputSize, void *data, std::size_t size);
+
+/**
+ * @brief decode_base64_in_place Replace a Base 64 string by the bytes it encodes
+ * @return false (leaving the buffer undefined) if the input is not Base 64
+ */
+bool decode_base64_in_place(std::string &buffer);
+
 /**
  * @brief yaml_read_binary Read a string and interpret as a Base 64 array of bytes
  * @param node
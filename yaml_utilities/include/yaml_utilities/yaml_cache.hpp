@@ -0,0 +1,33 @@
+/**
+ * @brief Cache the parse of a YAML file in a compact binary recording next to it, so that
+ * large configuration files load quickly on later runs
+ */
+#ifndef _YAML_UTILITIES_YAML_CACHE_H
+    #define _YAML_UTILITIES_YAML_CACHE_H
+
+#include <yaml_utilities/yaml_utilities.hpp>
+
+namespace yaml_utilities
+{
+
+/**
+ * @brief yaml_cache_path Path of the cache kept for a YAML file ('<file>.ycache')
+ */
+boost::filesystem::path yaml_cache_path(const boost::filesystem::path &filePath);
+
+/**
+ * @brief yaml_read_file_cached Same as yaml_read_file(), but replays the first document from
+ * the cache if it matches the file (path, size, modification time and content hash), and
+ * (re)writes the cache otherwise
+ * @note Failing to write the cache (e.g., a read-only directory) is not an error
+ */
+void yaml_read_file_cached(const boost::filesystem::path &filePath, YAML::Node &doc);
+
+/**
+ * @brief yaml_handle_file_cached Same as yaml_handle_file(), with the cache of yaml_read_file_cached()
+ */
+void yaml_handle_file_cached(const boost::filesystem::path &filePath, YAML::EventHandler &handler);
+
+} // namespace yaml_utilities
+
+#endif // _YAML_UTILITIES_YAML_CACHE_H
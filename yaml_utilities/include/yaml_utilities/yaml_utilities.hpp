@@ -8,6 +8,7 @@
 
 #include <ostream>
 #include <yaml-cpp-0.2.7/yaml.h>
+#include <yaml-cpp-0.2.7/eventhandler.h>
 #include <boost/filesystem.hpp>
 
 #ifndef YAML_UTITILIES_NO_ALIAS
@@ -23,6 +24,13 @@ void yaml_write_file(const boost::filesystem::path &filePath, const YAML::Emitte
 void yaml_read_string(const std::string &str, YAML::Node &doc);
 void yaml_write_string(std::string &str, YAML::Emitter const &out);
 
+/**
+ * \brief Feed the parser events of the first document straight to a handler, without building a YAML::Node.
+ */
+void yaml_handle_stream(std::istream &stream, YAML::EventHandler &handler);
+void yaml_handle_file(const boost::filesystem::path &filePath, YAML::EventHandler &handler);
+void yaml_handle_string(const std::string &str, YAML::EventHandler &handler);
+
 
 /**
  * \brief Read one line from std::cin.
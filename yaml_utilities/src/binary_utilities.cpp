@@ -1,9 +1,27 @@
 /**
  * @author Eric Cousineau <eacousineau@gmail.com>, member of Dr. Aaron
  * Ames's AMBER Lab
+ *
+ * The Base 64 codec handles bulk data with SIMD kernels chosen at runtime (see
+ * alt_math_utilities/CpuFeatures.hpp), each compiled with a function-level
+ * target attribute, and leaves the tail and the padding to the scalar loops.
+ * The kernels stop at the first block with a character outside the alphabet,
+ * which the scalar loop then rejects.
  */
 #include "yaml_utilities/binary_utilities.hpp"
 
+#include <alt_math_utilities/CpuFeatures.hpp>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    #define BASE64_KERNEL_AVX2
+    #include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+    #define BASE64_KERNEL_NEON
+    #include <arm_neon.h>
+#endif
+
 using namespace std;
 using namespace YAML;
 
@@ -12,24 +30,43 @@ namespace yaml_utilities
 
 static const char encoding[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-std::string encode_base64(const unsigned char *data, std::size_t size)
+// 255 for characters outside the alphabet (including the padding)
+static const unsigned char decoding[] = {
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255, 62,255,255,255, 63,
+     52, 53, 54, 55, 56, 57, 58, 59, 60, 61,255,255,255,255,255,255,
+    255,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+     15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25,255,255,255,255,255,
+    255, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+     41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+};
+
+namespace
+{
+
+void encode_scalar(const unsigned char *data, std::size_t size, char *out)
 {
     const char PAD = '=';
-   
-    std::string ret;
-    ret.resize(4 * size / 3 + 3);
-    char *out = &ret[0];
-   
+
     std::size_t chunks = size / 3;
     std::size_t remainder = size % 3;
-   
+
     for(std::size_t i=0;i<chunks;i++, data += 3) {
         *out++ = encoding[data[0] >> 2];
         *out++ = encoding[((data[0] & 0x3) << 4) | (data[1] >> 4)];
         *out++ = encoding[((data[1] & 0xf) << 2) | (data[2] >> 6)];
         *out++ = encoding[data[2] & 0x3f];
     }
-   
+
     switch(remainder) {
         case 0:
             break;
@@ -46,60 +83,311 @@ std::string encode_base64(const unsigned char *data, std::size_t size)
             *out++ = PAD;
             break;
     }
-   
-    ret.resize(out - &ret[0]);
-    return ret;
 }
 
-static const unsigned char decoding[] = {
-    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
-    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
-    255,255,255,255,255,255,255,255,255,255,255, 62,255,255,255, 63,
-     52, 53, 54, 55, 56, 57, 58, 59, 60, 61,255,255,255,  0,255,255,
-    255,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
-     15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25,255,255,255,255,255,
-    255, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
-     41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51,255,255,255,255,255,
-    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
-    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
-    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
-    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
-    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
-    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
-    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
-    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
-};
+/**
+ * Decode whole groups of 4 characters, reading each group before writing its
+ * 3 bytes (so out may alias input for an in-place decode)
+ */
+bool decode_scalar(const char *input, std::size_t chunks, unsigned char *out)
+{
+    const unsigned char *in = reinterpret_cast<const unsigned char*>(input);
+    for (std::size_t i = 0; i < chunks; ++i, in += 4)
+    {
+        const unsigned char a = decoding[in[0]], b = decoding[in[1]], c = decoding[in[2]], d = decoding[in[3]];
+        if ((a | b | c | d) == 255)
+            return false;
+        *out++ = (a << 2) | (b >> 4);
+        *out++ = (b << 4) | (c >> 2);
+        *out++ = (c << 6) | d;
+    }
+    return true;
+}
 
-void decode_base64(const std::string& input, std::vector<unsigned char> &ret)
+#ifdef BASE64_KERNEL_AVX2
+
+/**
+ * Encode 24 bytes per iteration into 32 characters (W. Mula, D. Lemire, "Faster
+ * Base64 Encoding and Decoding Using AVX2 Instructions", 2018)
+ * @return Number of bytes encoded (a multiple of 3)
+ */
+__attribute__((target("avx2")))
+std::size_t encode_avx2(const unsigned char *data, std::size_t size, char *out)
 {
-    typedef std::vector<unsigned char> ret_type;
-    ret.clear();
-    if(input.empty())
-        return;
-   
-    ret.resize(3 * input.size() / 4 + 1);
-    unsigned char *out = &ret[0];
-   
-    unsigned value = 0;
-    for(std::size_t i=0;i<input.size();i++) {
-        unsigned char d = decoding[static_cast<unsigned>(input[i])];
-        if(d == 255)
+    // Each 32 bit lane gets the bytes [b1, b0, b2, b1] of a group of 3
+    const __m256i shuffle = _mm256_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    // Offsets from the 6 bit values (by range) to their characters
+    const __m256i offsets = _mm256_setr_epi8(
+        65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+        65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+
+    std::size_t i = 0;
+    // The loads read 4 bytes past the 24 that are encoded
+    for (; i + 28 <= size; i += 24, out += 32)
+    {
+        __m256i in = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 12)), 1);
+        in = _mm256_shuffle_epi8(in, shuffle);
+
+        // Move the 6 bit values to the bytes of each lane
+        const __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+        const __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+        const __m256i values = _mm256_or_si256(t0, t1);
+
+        __m256i index = _mm256_subs_epu8(values, _mm256_set1_epi8(51));
+        index = _mm256_sub_epi8(index, _mm256_cmpgt_epi8(values, _mm256_set1_epi8(25)));
+        const __m256i chars = _mm256_add_epi8(values, _mm256_shuffle_epi8(offsets, index));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), chars);
+    }
+    return i;
+}
+
+/**
+ * Decode 32 characters per iteration into 24 bytes (same reference). Each
+ * store ends before the next load starts, so out may alias input.
+ * @param outSize Room at out (the stores write 32 bytes)
+ * @return Number of characters decoded (a multiple of 4)
+ */
+__attribute__((target("avx2")))
+std::size_t decode_avx2(const char *input, std::size_t size, unsigned char *out, std::size_t outSize)
+{
+    // Classes of the low and high nibbles, which share a bit only for invalid characters
+    const __m256i lut_lo = _mm256_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a,
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const __m256i lut_hi = _mm256_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    // Offsets from the characters (by high nibble, '/' apart) to their 6 bit values
+    const __m256i lut_roll = _mm256_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask_2f = _mm256_set1_epi8(0x2f);
+    // Packs the 3 bytes of each 32 bit lane, then the 6 lanes with data
+    const __m256i pack = _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i permute = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1);
+
+    std::size_t i = 0, o = 0;
+    for (; i + 32 <= size && o + 32 <= outSize; i += 32, o += 24)
+    {
+        __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), mask_2f);
+        const __m256i lo_nibbles = _mm256_and_si256(in, mask_2f);
+        const __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+        const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+        if (!_mm256_testz_si256(lo, hi))
+            break;
+
+        const __m256i eq_2f = _mm256_cmpeq_epi8(in, mask_2f);
+        in = _mm256_add_epi8(in, _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2f, hi_nibbles)));
+
+        // Merge the 6 bit values: pairs into 12 bits, then into 24 bits per lane
+        in = _mm256_maddubs_epi16(in, _mm256_set1_epi32(0x01400140));
+        in = _mm256_madd_epi16(in, _mm256_set1_epi32(0x00011000));
+        in = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(in, pack), permute);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + o), in);
+    }
+    return i;
+}
+
+#endif // BASE64_KERNEL_AVX2
+
+#ifdef BASE64_KERNEL_NEON
+
+/**
+ * Encode 48 bytes per iteration into 64 characters, deinterleaving with vld3
+ * @return Number of bytes encoded (a multiple of 3)
+ */
+std::size_t encode_neon(const unsigned char *data, std::size_t size, char *out)
+{
+    const unsigned char *alphabet = reinterpret_cast<const unsigned char*>(encoding);
+    uint8x16x4_t table;
+    for (int k = 0; k < 4; ++k)
+        table.val[k] = vld1q_u8(alphabet + 16 * k);
+    const uint8x16_t mask_3f = vdupq_n_u8(0x3f);
+
+    std::size_t i = 0;
+    for (; i + 48 <= size; i += 48, out += 64)
+    {
+        const uint8x16x3_t in = vld3q_u8(data + i);
+        uint8x16x4_t chars;
+        chars.val[0] = vshrq_n_u8(in.val[0], 2);
+        chars.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask_3f);
+        chars.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask_3f);
+        chars.val[3] = vandq_u8(in.val[2], mask_3f);
+        for (int k = 0; k < 4; ++k)
+            chars.val[k] = vqtbl4q_u8(table, chars.val[k]);
+        vst4q_u8(reinterpret_cast<uint8_t*>(out), chars);
+    }
+    return i;
+}
+
+/**
+ * Decode 64 characters per iteration into 48 bytes, looking the characters up
+ * in the two halves of the table. Each store ends before the next load
+ * starts, so out may alias input.
+ * @return Number of characters decoded (a multiple of 4)
+ */
+std::size_t decode_neon(const char *input, std::size_t size, unsigned char *out)
+{
+    uint8x16x4_t table_lo, table_hi;
+    for (int k = 0; k < 4; ++k)
+    {
+        table_lo.val[k] = vld1q_u8(decoding + 16 * k);
+        table_hi.val[k] = vld1q_u8(decoding + 64 + 16 * k);
+    }
+    const uint8x16_t offset = vdupq_n_u8(64);
+
+    std::size_t i = 0;
+    for (; i + 64 <= size; i += 64, out += 48)
+    {
+        uint8x16x4_t values = vld4q_u8(reinterpret_cast<const uint8_t*>(input + i));
+        // The top bit is set by invalid characters and by values from beyond the table
+        uint8x16_t error = vdupq_n_u8(0);
+        for (int k = 0; k < 4; ++k)
         {
-            ret.clear();
-            return;
+            const uint8x16_t chars = values.val[k];
+            values.val[k] = vqtbx4q_u8(vqtbl4q_u8(table_lo, chars), table_hi, vsubq_u8(chars, offset));
+            error = vorrq_u8(error, vorrq_u8(chars, values.val[k]));
         }
+        if (vmaxvq_u8(error) & 0x80)
+            break;
 
-        value = (value << 6) | d;
-        if(i % 4 == 3) {
-            *out++ = value >> 16;
-            if(i > 0 && input[i - 1] != '=')
-                *out++ = value >> 8;
-            if(input[i] != '=')
-                *out++ = value;
-        }
+        uint8x16x3_t bytes;
+        bytes.val[0] = vorrq_u8(vshlq_n_u8(values.val[0], 2), vshrq_n_u8(values.val[1], 4));
+        bytes.val[1] = vorrq_u8(vshlq_n_u8(values.val[1], 4), vshrq_n_u8(values.val[2], 2));
+        bytes.val[2] = vorrq_u8(vshlq_n_u8(values.val[2], 6), values.val[3]);
+        vst3q_u8(out, bytes);
+    }
+    return i;
+}
+
+#endif // BASE64_KERNEL_NEON
+
+/**
+ * Size of the data encoded by input, or false if its length or padding is invalid
+ */
+bool decoded_size(const char *input, std::size_t size, std::size_t &decoded)
+{
+    if (size % 4 != 0)
+        return false;
+    std::size_t padding = 0;
+    if (size > 0 && input[size - 1] == '=')
+        padding = input[size - 2] == '=' ? 2 : 1;
+    decoded = 3 * (size / 4) - padding;
+    return true;
+}
+
+/**
+ * Decode input, whose decoded size has been checked to be size
+ */
+bool decode(const char *input, std::size_t inputSize, unsigned char *out, std::size_t size)
+{
+    const std::size_t padding = 3 * (inputSize / 4) - size;
+    const std::size_t full = inputSize - (padding ? 4 : 0);
+
+    std::size_t done = 0;
+#ifdef BASE64_KERNEL_AVX2
+    if (alt_math_utilities::activeSimdLevel() >= alt_math_utilities::SIMD_AVX2)
+        done = decode_avx2(input, full, out, size);
+#endif
+#ifdef BASE64_KERNEL_NEON
+    done = decode_neon(input, full, out);
+#endif
+
+    if (!decode_scalar(input + done, (full - done) / 4, out + done / 4 * 3))
+        return false;
+
+    if (padding)
+    {
+        const unsigned char *in = reinterpret_cast<const unsigned char*>(input + full);
+        const unsigned char a = decoding[in[0]], b = decoding[in[1]];
+        const unsigned char c = padding == 1 ? decoding[in[2]] : 0;
+        if ((a | b | c) == 255)
+            return false;
+        out += full / 4 * 3;
+        *out++ = (a << 2) | (b >> 4);
+        if (padding == 1)
+            *out++ = (b << 4) | (c >> 2);
     }
-   
-    ret.resize(out - &ret[0]);
+    return true;
+}
+
+} // anonymous namespace
+
+std::size_t base64_encoded_size(std::size_t size)
+{
+    return 4 * ((size + 2) / 3);
+}
+
+void encode_base64(const unsigned char *data, std::size_t size, char *out)
+{
+    std::size_t done = 0;
+#ifdef BASE64_KERNEL_AVX2
+    if (alt_math_utilities::activeSimdLevel() >= alt_math_utilities::SIMD_AVX2)
+        done = encode_avx2(data, size, out);
+#endif
+#ifdef BASE64_KERNEL_NEON
+    done = encode_neon(data, size, out);
+#endif
+    encode_scalar(data + done, size - done, out + done / 3 * 4);
+}
+
+void encode_base64(const unsigned char *data, std::size_t size, std::string &out)
+{
+    out.resize(base64_encoded_size(size));
+    if (!out.empty())
+        encode_base64(data, size, &out[0]);
+}
+
+std::string encode_base64(const unsigned char *data, std::size_t size)
+{
+    std::string ret;
+    encode_base64(data, size, ret);
+    return ret;
+}
+
+bool decode_base64(const char *input, std::size_t inputSize, void *data, std::size_t size)
+{
+    std::size_t decoded;
+    if (!decoded_size(input, inputSize, decoded) || decoded != size)
+        return false;
+    return decode(input, inputSize, static_cast<unsigned char*>(data), size);
+}
+
+bool decode_base64(const std::string& input, void *data, std::size_t size)
+{
+    return decode_base64(input.data(), input.size(), data, size);
+}
+
+bool decode_base64_in_place(std::string &buffer)
+{
+    std::size_t size;
+    if (!decoded_size(buffer.data(), buffer.size(), size))
+        return false;
+    if (size > 0 && !decode(buffer.data(), buffer.size(), reinterpret_cast<unsigned char*>(&buffer[0]), size))
+        return false;
+    buffer.resize(size);
+    return true;
+}
+
+void decode_base64(const std::string& input, std::vector<unsigned char> &ret)
+{
+    std::size_t size;
+    if (!decoded_size(input.data(), input.size(), size))
+    {
+        ret.clear();
+        return;
+    }
+
+    ret.resize(size);
+    if (size > 0 && !decode(input.data(), input.size(), &ret[0], size))
+        ret.clear();
 }
 
 void yaml_read_binary(const Node &node, std::vector<unsigned char> &data)
@@ -111,10 +399,11 @@ void yaml_read_binary(const Node &node, std::vector<unsigned char> &data)
 
 void yaml_read_binary(const Node &node, void *data, size_t size)
 {
-    std::vector<unsigned char> buf;
-    yaml_read_binary(node, buf);
-    assert(buf.size() == size);
-    memcpy(data, buf.data(), size);
+    string tmp;
+    node >> tmp;
+    bool decoded = decode_base64(tmp, data, size);
+    assert(decoded);
+    (void)decoded;
 }
 
 void yaml_write_binary(Emitter &out, const void *data, size_t size)
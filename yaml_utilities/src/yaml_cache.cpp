@@ -0,0 +1,230 @@
+/**
+ * Layout of a cache file, with all integers 64 bit little endian:
+ *   magic, source size, source modification time, source hash, source path (size and bytes),
+ *   recording size, recording hash, recording (see YAML::BinaryEventWriter)
+ */
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <boost/cstdint.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <yaml_utilities/yaml_cache.hpp>
+
+namespace yaml_utilities
+{
+
+namespace
+{
+
+const char cache_magic[] = "YCACHE01";
+const std::size_t cache_magic_size = sizeof(cache_magic) - 1;
+
+struct CacheKey
+{
+    boost::uint64_t size;
+    boost::int64_t mtime;
+    boost::uint64_t hash;
+    std::string path;
+};
+
+/**
+ * @brief FNV-1a
+ */
+boost::uint64_t hash_bytes(const char *data, std::size_t size)
+{
+    boost::uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+void append_uint64(std::string &out, boost::uint64_t value)
+{
+    for (int i = 0; i < 8; ++i)
+        out += static_cast<char>((value >> (8 * i)) & 0xff);
+}
+
+bool read_uint64(const char *&pos, const char *end, boost::uint64_t &value)
+{
+    if (end - pos < 8)
+        return false;
+    value = 0;
+    for (int i = 0; i < 8; ++i)
+        value |= static_cast<boost::uint64_t>(static_cast<unsigned char>(pos[i])) << (8 * i);
+    pos += 8;
+    return true;
+}
+
+/**
+ * @brief The recording of the first document, either mapped from the cache or freshly made
+ */
+struct CachedRecording
+{
+    boost::iostreams::mapped_file_source file;
+    std::string buffer;
+    const char *data;
+    std::size_t size;
+};
+
+/**
+ * @brief Map the cache and point at its recording if it's valid for the key
+ */
+bool open_cache(const boost::filesystem::path &cachePath, const CacheKey &key, CachedRecording &recording)
+{
+    boost::system::error_code error;
+    const boost::uintmax_t cacheSize = boost::filesystem::file_size(cachePath, error);
+    if (error || cacheSize < cache_magic_size)
+        return false;
+
+    try
+    {
+        recording.file.open(cachePath.string());
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+
+    const char *pos = recording.file.data();
+    const char *end = pos + recording.file.size();
+    if (std::memcmp(pos, cache_magic, cache_magic_size) != 0)
+        return false;
+    pos += cache_magic_size;
+
+    boost::uint64_t size, mtime, hash, pathSize, recordingSize, recordingHash;
+    if (!read_uint64(pos, end, size) || size != key.size
+            || !read_uint64(pos, end, mtime) || static_cast<boost::int64_t>(mtime) != key.mtime
+            || !read_uint64(pos, end, hash) || hash != key.hash
+            || !read_uint64(pos, end, pathSize) || pathSize != key.path.size()
+            || static_cast<boost::uint64_t>(end - pos) < pathSize || key.path.compare(0, key.path.size(), pos, pathSize) != 0)
+        return false;
+    pos += pathSize;
+
+    if (!read_uint64(pos, end, recordingSize) || !read_uint64(pos, end, recordingHash)
+            || static_cast<boost::uint64_t>(end - pos) != recordingSize || hash_bytes(pos, recordingSize) != recordingHash)
+        return false;
+
+    recording.data = pos;
+    recording.size = recordingSize;
+    return true;
+}
+
+/**
+ * @brief Write the cache next to the file, going through a temporary file so that concurrent
+ * readers never see a partial cache
+ */
+void write_cache(const boost::filesystem::path &cachePath, const CacheKey &key, const std::string &recording)
+{
+    std::string header(cache_magic, cache_magic_size);
+    append_uint64(header, key.size);
+    append_uint64(header, key.mtime);
+    append_uint64(header, key.hash);
+    append_uint64(header, key.path.size());
+    header += key.path;
+    append_uint64(header, recording.size());
+    append_uint64(header, hash_bytes(recording.data(), recording.size()));
+
+    boost::system::error_code error;
+    boost::filesystem::path tempPath = cachePath.parent_path() / boost::filesystem::unique_path(cachePath.filename().string() + ".%%%%-%%%%", error);
+    if (error)
+        return;
+
+    {
+        std::ofstream fout(tempPath.string().c_str(), std::ios::binary);
+        fout.write(header.data(), header.size());
+        fout.write(recording.data(), recording.size());
+        fout.close();
+        if (!fout)
+        {
+            boost::filesystem::remove(tempPath, error);
+            return;
+        }
+    }
+
+    boost::filesystem::rename(tempPath, cachePath, error);
+    if (error)
+        boost::filesystem::remove(tempPath, error);
+}
+
+/**
+ * @brief Get the recording of the first document of the file, from the cache if possible
+ * @return false if the file is empty
+ */
+bool load_recording(const char *function, const boost::filesystem::path &filePath, CachedRecording &recording)
+{
+    if (!boost::filesystem::exists(filePath))
+    {
+        std::ostringstream os;
+        os << function << ": file '" << filePath << "' does not exist";
+        throw std::runtime_error(os.str());
+    }
+
+    CacheKey key;
+    key.size = boost::filesystem::file_size(filePath);
+    if (key.size == 0)
+        return false;
+    key.mtime = boost::filesystem::last_write_time(filePath);
+    key.path = boost::filesystem::absolute(filePath).string();
+
+    boost::iostreams::mapped_file_source file(filePath.string());
+    key.hash = hash_bytes(file.data(), file.size());
+
+    const boost::filesystem::path cachePath = yaml_cache_path(filePath);
+    if (open_cache(cachePath, key, recording))
+        return true;
+    if (recording.file.is_open())
+        recording.file.close();
+
+    YAML::BinaryEventWriter writer(recording.buffer);
+    YAML::Parser parser(file.data(), file.size());
+    parser.HandleNextDocument(writer);
+    write_cache(cachePath, key, recording.buffer);
+
+    recording.data = recording.buffer.data();
+    recording.size = recording.buffer.size();
+    return true;
+}
+
+} // anonymous namespace
+
+boost::filesystem::path yaml_cache_path(const boost::filesystem::path &filePath)
+{
+    boost::filesystem::path cachePath = filePath;
+    cachePath += ".ycache";
+    return cachePath;
+}
+
+void yaml_read_file_cached(const boost::filesystem::path &filePath, YAML::Node &doc)
+{
+    CachedRecording recording;
+    if (!load_recording("yaml_read_file_cached", filePath, recording))
+    {
+        yaml_read_string(std::string(), doc);
+        return;
+    }
+
+    YAML::BinaryEventReader reader(recording.data, recording.size);
+    if (!reader.GetNextDocument(doc, YAML::NodeStorage::Arena))
+        doc.Clear();
+}
+
+void yaml_handle_file_cached(const boost::filesystem::path &filePath, YAML::EventHandler &handler)
+{
+    CachedRecording recording;
+    if (!load_recording("yaml_handle_file_cached", filePath, recording))
+    {
+        yaml_handle_string(std::string(), handler);
+        return;
+    }
+
+    YAML::BinaryEventReader reader(recording.data, recording.size);
+    reader.HandleNextDocument(handler);
+}
+
+} // namespace yaml_utilities
@@ -9,6 +9,8 @@
 #include <fstream>
 #include <sstream>
 
+#include <boost/iostreams/device/mapped_file.hpp>
+
 #include <yaml_utilities/yaml_utilities.hpp>
 
 using namespace YAML;
@@ -17,31 +19,73 @@ using namespace std;
 namespace yaml_utilities
 {
 
-void yaml_read_stream(std::istream &stream, YAML::Node &doc)
+namespace
 {
-    YAML::Parser parser(stream);
-    parser.GetNextDocument(doc);
-}
 
-void yaml_read_file(boost::filesystem::path const &filePath, YAML::Node &doc)
+void assert_file_exists(const char *function, boost::filesystem::path const &filePath)
 {
     if (!boost::filesystem::exists(filePath))
     {
         ostringstream os;
-        os << "yaml_read_file: file '" << filePath << "' does not exist";
+        os << function << ": file '" << filePath << "' does not exist";
         cout << os.str() << endl;
         throw std::runtime_error(os.str());
     }
+}
+
+} // anonymous namespace
+
+void yaml_read_stream(std::istream &stream, YAML::Node &doc)
+{
+    YAML::Parser parser(stream);
+    parser.GetNextDocument(doc, YAML::NodeStorage::Arena);
+}
+
+void yaml_read_file(boost::filesystem::path const &filePath, YAML::Node &doc)
+{
+    assert_file_exists("yaml_read_file", filePath);
 
-    std::ifstream fin(filePath.string().c_str());
-    yaml_read_stream(fin, doc);
-    fin.close();
+    // Parse straight out of a memory mapping (empty files cannot be mapped)
+    if (boost::filesystem::file_size(filePath) == 0)
+    {
+        yaml_read_string(std::string(), doc);
+        return;
+    }
+    boost::iostreams::mapped_file_source file(filePath.string());
+    YAML::Parser parser(file.data(), file.size());
+    parser.GetNextDocument(doc, YAML::NodeStorage::Arena);
 }
 
 void yaml_read_string(std::string const &str, YAML::Node &doc)
 {
-    std::istringstream sstr(str);
-    yaml_read_stream(sstr, doc);
+    YAML::Parser parser(str.data(), str.size());
+    parser.GetNextDocument(doc, YAML::NodeStorage::Arena);
+}
+
+void yaml_handle_stream(std::istream &stream, YAML::EventHandler &handler)
+{
+    YAML::Parser parser(stream);
+    parser.HandleNextDocument(handler);
+}
+
+void yaml_handle_file(boost::filesystem::path const &filePath, YAML::EventHandler &handler)
+{
+    assert_file_exists("yaml_handle_file", filePath);
+
+    if (boost::filesystem::file_size(filePath) == 0)
+    {
+        yaml_handle_string(std::string(), handler);
+        return;
+    }
+    boost::iostreams::mapped_file_source file(filePath.string());
+    YAML::Parser parser(file.data(), file.size());
+    parser.HandleNextDocument(handler);
+}
+
+void yaml_handle_string(std::string const &str, YAML::EventHandler &handler)
+{
+    YAML::Parser parser(str.data(), str.size());
+    parser.HandleNextDocument(handler);
 }
 
 void yaml_write_stream(std::ostream &stream, YAML::Emitter const &out)
@@ -72,7 +116,7 @@ void yaml_read_stdin(Node &doc, bool ignoreFirst)
 
     istream line(&buffer);
     Parser parser(line);
-    parser.GetNextDocument(doc);
+    parser.GetNextDocument(doc, YAML::NodeStorage::Arena);
 }
 
 } // end namespace common
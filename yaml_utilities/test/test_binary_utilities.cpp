@@ -5,6 +5,9 @@
  */
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
+#include <alt_math_utilities/CpuFeatures.hpp>
 #include <common_assert/common_assert.hpp>
 #include <stl_utilities/container_utilities.hpp>
 #include <yaml_utilities/yaml_utilities.hpp>
@@ -45,3 +48,79 @@ TEST(binary_utilities, BasicRead)
         EXPECT_EQ(x_expected, x_actual);
     }
 }
+
+/**
+ * @brief Base64Codec Round trips through every SIMD level, compared with the
+ * scalar codec, for sizes around the kernels' block sizes
+ */
+TEST(binary_utilities, Base64Codec)
+{
+    using namespace alt_math_utilities;
+    const SimdLevel supported = supportedSimdLevel();
+
+    vector<unsigned char> data(1000);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = (unsigned char)(i * 7919 + (i >> 3));
+
+    for (size_t size = 0; size <= data.size(); size += (size < 200 ? 1 : 97))
+    {
+        setSimdLevel(SIMD_SCALAR);
+        const string expected = encode_base64(&data[0], size);
+        ASSERT_EQ(base64_encoded_size(size), expected.size());
+
+        for (int level = SIMD_SCALAR; level <= supported; ++level)
+        {
+            setSimdLevel((SimdLevel)level);
+            string encoded = "reused";
+            encode_base64(&data[0], size, encoded);
+            ASSERT_EQ(expected, encoded) << "size " << size << ", " << simdLevelName((SimdLevel)level);
+
+            vector<unsigned char> decoded(size + 1, 0xaa);
+            ASSERT_TRUE(decode_base64(encoded.data(), encoded.size(), &decoded[0], size));
+            EXPECT_TRUE(equal(data.begin(), data.begin() + size, decoded.begin()));
+            EXPECT_EQ(0xaa, decoded[size]);
+            EXPECT_FALSE(decode_base64(encoded, &decoded[0], size + 1));
+
+            ASSERT_TRUE(decode_base64_in_place(encoded));
+            ASSERT_EQ(size, encoded.size());
+            EXPECT_TRUE(equal(data.begin(), data.begin() + size, (const unsigned char*)encoded.data()));
+        }
+    }
+    setSimdLevel(supported);
+}
+
+/**
+ * @brief Base64Validation Characters outside the alphabet are rejected wherever they are
+ */
+TEST(binary_utilities, Base64Validation)
+{
+    using namespace alt_math_utilities;
+    const SimdLevel supported = supportedSimdLevel();
+
+    vector<unsigned char> data(100, 0x5a);
+    const string encoded = encode_base64(&data[0], data.size());
+    const char invalid[] = { '=', ' ', '\n', '-', '_', '.', '@', '[', '`', '{', '\x80', '\xff', '\0' };
+
+    for (int level = SIMD_SCALAR; level <= supported; ++level)
+    {
+        setSimdLevel((SimdLevel)level);
+        for (size_t i = 0; i < encoded.size(); ++i)
+            for (size_t k = 0; k < sizeof(invalid); ++k)
+            {
+                string corrupt = encoded;
+                corrupt[i] = invalid[k];
+                if (corrupt == encoded)
+                    continue;
+                EXPECT_FALSE(decode_base64(corrupt, &data[0], data.size())) << "position " << i << ", " << simdLevelName((SimdLevel)level);
+            }
+    }
+    setSimdLevel(supported);
+
+    vector<unsigned char> ret(1);
+    decode_base64("QUJD\n", ret);
+    EXPECT_TRUE(ret.empty());
+    decode_base64("QUI=", ret);
+    EXPECT_EQ(2u, ret.size());
+    string buffer = "A===";
+    EXPECT_FALSE(decode_base64_in_place(buffer));
+}
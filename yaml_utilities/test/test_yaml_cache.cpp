@@ -0,0 +1,86 @@
+/**
+ * @brief Unittests for the binary cache of parsed YAML files
+ */
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+
+#include <yaml_utilities/yaml_utilities.hpp>
+#include <yaml_utilities/yaml_cache.hpp>
+
+using namespace std;
+using namespace YAML;
+using namespace yaml_utilities;
+
+namespace
+{
+
+void write_text(const boost::filesystem::path &path, const string &text)
+{
+    ofstream fout(path.string().c_str(), ios::binary);
+    fout << text;
+}
+
+string read_text(const boost::filesystem::path &path)
+{
+    ifstream fin(path.string().c_str(), ios::binary);
+    return string(istreambuf_iterator<char>(fin), istreambuf_iterator<char>());
+}
+
+} // anonymous namespace
+
+/**
+ * @brief CacheLifecycle Cache is written on first load, reused afterwards, and rebuilt when the
+ * source changes or the cache is damaged
+ */
+TEST(yaml_cache, CacheLifecycle)
+{
+    boost::filesystem::path dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::create_directories(dir);
+    boost::filesystem::path filePath = dir / "config.yml";
+    boost::filesystem::path cachePath = yaml_cache_path(filePath);
+
+    write_text(filePath, "gains: &g [1.5, 2, 3]\nname: !tag arm\ncopy: *g\n");
+    ASSERT_FALSE(boost::filesystem::exists(cachePath));
+
+    Node expected, actual;
+    yaml_read_file(filePath, expected);
+    yaml_read_file_cached(filePath, actual);
+    EXPECT_EQ(0, actual.Compare(expected));
+    ASSERT_TRUE(boost::filesystem::exists(cachePath));
+
+    // Reused as is
+    string cache = read_text(cachePath);
+    yaml_read_file_cached(filePath, actual);
+    EXPECT_EQ(0, actual.Compare(expected));
+    EXPECT_EQ(actual["copy"][0].to<double>(), 1.5);
+    EXPECT_EQ(cache, read_text(cachePath));
+
+    // Same size and (possibly) the same modification time, but different content
+    write_text(filePath, "gains: &g [2.5, 2, 3]\nname: !tag arm\ncopy: *g\n");
+    yaml_read_file_cached(filePath, actual);
+    EXPECT_EQ(actual["copy"][0].to<double>(), 2.5);
+    EXPECT_NE(cache, read_text(cachePath));
+
+    // Damaged cache
+    cache = read_text(cachePath);
+    cache[cache.size() - 2] ^= 0x55;
+    write_text(cachePath, cache);
+    yaml_read_file_cached(filePath, actual);
+    EXPECT_EQ(actual["gains"][0].to<double>(), 2.5);
+    EXPECT_EQ(actual["name"].Tag(), "!tag");
+
+    write_text(cachePath, "garbage");
+    yaml_read_file_cached(filePath, actual);
+    EXPECT_EQ(actual["gains"].size(), 3);
+
+    // Empty source
+    write_text(filePath, "");
+    yaml_read_file_cached(filePath, actual);
+    EXPECT_EQ(actual.Type(), NodeType::Null);
+
+    EXPECT_THROW(yaml_read_file_cached(dir / "missing.yml", actual), std::runtime_error);
+
+    boost::filesystem::remove_all(dir);
+}
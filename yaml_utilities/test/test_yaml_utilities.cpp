@@ -55,6 +55,18 @@ TEST(yaml_utilies, FileWriteAndRead)
     EXPECT_EQ(expected, actual);
 }
 
+/**
+ * @brief EmptyFileReadTest Ensure that an empty file (which cannot be memory-mapped) reads as a null node
+ */
+TEST(yaml_utilities, EmptyFileReadTest)
+{
+    std::ofstream("/tmp/test_yaml_utilities_empty.yaml").close();
+
+    Node node;
+    yaml_read_file("/tmp/test_yaml_utilities_empty.yaml", node);
+    EXPECT_EQ(NodeType::Null, node.Type());
+}
+
 /**
  * @brief FileDoesNotExistTest Ensure that an exception is thrown if we try to read a nonexistant file
  */
@@ -0,0 +1,180 @@
+/**
+ * @brief Throughput of the Base 64 codec at each SIMD level the CPU supports,
+ * against the previous byte-at-a-time implementation (kept here as reference)
+ *
+ * Usage: yaml_utilities_base64_benchmark [SIZE]
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <time.h>
+
+#include <alt_math_utilities/CpuFeatures.hpp>
+#include <yaml_utilities/binary_utilities.hpp>
+
+using namespace yaml_utilities;
+using namespace alt_math_utilities;
+
+namespace
+{
+
+/// Minimum measurement time per case [s]
+const double min_duration = 0.2;
+
+double get_time()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1.0e-9;
+}
+
+const char reference_encoding[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+std::string reference_encode(const unsigned char *data, std::size_t size)
+{
+    std::string ret;
+    ret.resize(4 * size / 3 + 3);
+    char *out = &ret[0];
+    for (std::size_t i = 0; i < size / 3; i++, data += 3)
+    {
+        *out++ = reference_encoding[data[0] >> 2];
+        *out++ = reference_encoding[((data[0] & 0x3) << 4) | (data[1] >> 4)];
+        *out++ = reference_encoding[((data[1] & 0xf) << 2) | (data[2] >> 6)];
+        *out++ = reference_encoding[data[2] & 0x3f];
+    }
+    switch (size % 3)
+    {
+    case 1:
+        *out++ = reference_encoding[data[0] >> 2];
+        *out++ = reference_encoding[((data[0] & 0x3) << 4)];
+        *out++ = '=';
+        *out++ = '=';
+        break;
+    case 2:
+        *out++ = reference_encoding[data[0] >> 2];
+        *out++ = reference_encoding[((data[0] & 0x3) << 4) | (data[1] >> 4)];
+        *out++ = reference_encoding[((data[1] & 0xf) << 2)];
+        *out++ = '=';
+        break;
+    }
+    ret.resize(out - &ret[0]);
+    return ret;
+}
+
+void reference_decode(const std::string &input, std::vector<unsigned char> &ret)
+{
+    static unsigned char decoding[256];
+    if (!decoding[0])
+    {
+        for (int c = 0; c < 256; ++c)
+            decoding[c] = 255;
+        for (int i = 0; i < 64; ++i)
+            decoding[(unsigned char)reference_encoding[i]] = i;
+        decoding[(unsigned char)'='] = 0;
+    }
+
+    ret.clear();
+    if (input.empty())
+        return;
+    ret.resize(3 * input.size() / 4 + 1);
+    unsigned char *out = &ret[0];
+    unsigned value = 0;
+    for (std::size_t i = 0; i < input.size(); i++)
+    {
+        unsigned char d = decoding[(unsigned char)input[i]];
+        if (d == 255)
+        {
+            ret.clear();
+            return;
+        }
+        value = (value << 6) | d;
+        if (i % 4 == 3)
+        {
+            *out++ = value >> 16;
+            if (i > 0 && input[i - 1] != '=')
+                *out++ = value >> 8;
+            if (input[i] != '=')
+                *out++ = value;
+        }
+    }
+    ret.resize(out - &ret[0]);
+}
+
+void report(const char *name, const char *operation, std::size_t bytes, int iterations, double duration)
+{
+    std::printf("%-10s %-24s %10.1f MB/s\n", name, operation, bytes * (double)iterations / duration / 1.0e6);
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    const std::size_t size = argc > 1 ? std::atol(argv[1]) : 1 << 20;
+    std::vector<unsigned char> data(size);
+    for (std::size_t i = 0; i < size; ++i)
+        data[i] = (unsigned char)(i * 7919 + (i >> 3));
+    const std::string encoded = reference_encode(size ? &data[0] : NULL, size);
+    std::vector<unsigned char> decoded(size + 1);
+
+    std::printf("%lu bytes, throughput in bytes of binary data\n", (unsigned long)size);
+
+    int iterations = 0;
+    double start = get_time(), duration;
+    do
+    {
+        std::string out = reference_encode(&data[0], size);
+        ++iterations;
+    } while ((duration = get_time() - start) < min_duration);
+    report("reference", "encode", size, iterations, duration);
+
+    iterations = 0;
+    start = get_time();
+    do
+    {
+        reference_decode(encoded, decoded);
+        ++iterations;
+    } while ((duration = get_time() - start) < min_duration);
+    report("reference", "decode", size, iterations, duration);
+
+    for (int level = SIMD_SCALAR; level <= supportedSimdLevel(); ++level)
+    {
+        // The kernels only distinguish scalar and AVX2
+        if (level == SIMD_SSE2 || level == SIMD_AVX512)
+            continue;
+        setSimdLevel((SimdLevel)level);
+        const char *name = simdLevelName((SimdLevel)level);
+
+        std::string out;
+        iterations = 0;
+        start = get_time();
+        do
+        {
+            encode_base64(&data[0], size, out);
+            ++iterations;
+        } while ((duration = get_time() - start) < min_duration);
+        report(name, "encode", size, iterations, duration);
+        if (out != encoded)
+            std::printf("%s: encoding differs from reference\n", name);
+
+        iterations = 0;
+        start = get_time();
+        do
+        {
+            decode_base64(encoded, &decoded[0], size);
+            ++iterations;
+        } while ((duration = get_time() - start) < min_duration);
+        report(name, "decode", size, iterations, duration);
+
+        iterations = 0;
+        start = get_time();
+        do
+        {
+            out = encoded;
+            decode_base64_in_place(out);
+            ++iterations;
+        } while ((duration = get_time() - start) < min_duration);
+        report(name, "decode (copy + in place)", size, iterations, duration);
+    }
+    return 0;
+}